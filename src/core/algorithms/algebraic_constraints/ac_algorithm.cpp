@@ -1,7 +1,8 @@
 #include "ac_algorithm.h"
 
+#include <algorithm>
 #include <cmath>
-#include <functional>
+#include <cstdlib>
 #include <iostream>
 #include <random>
 
@@ -10,7 +11,10 @@
 #include "config/exceptions.h"
 #include "config/names_and_descriptions.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "model/table/relation_session.h"
 #include "types/create_type.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -25,19 +29,12 @@ void ACAlgorithm::RegisterOptions() {
     using namespace config::descriptions;
     using config::Option;
 
-    auto check_and_set_binop = [this](Binop bin_operation) {
+    auto check_binop = [](Binop bin_operation) {
         switch (bin_operation) {
             case +Binop::Addition:
-                binop_pointer_ = &model::INumericType::Add;
-                break;
             case +Binop::Subtraction:
-                binop_pointer_ = &model::INumericType::Sub;
-                break;
             case +Binop::Multiplication:
-                binop_pointer_ = &model::INumericType::Mul;
-                break;
             case +Binop::Division:
-                binop_pointer_ = &model::INumericType::Div;
                 break;
             default:
                 throw config::ConfigurationError(
@@ -65,7 +62,7 @@ void ACAlgorithm::RegisterOptions() {
 
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(Option{&bin_operation_, kBinaryOperation, kDBinaryOperation}.SetValueCheck(
-            check_and_set_binop));
+            check_binop));
     RegisterOption(Option{&fuzziness_, kFuzziness, kDFuzziness}.SetValueCheck(check_fuzziness));
     RegisterOption(Option{&p_fuzz_, kFuzzinessProbability, kDFuzzinessProbability}.SetValueCheck(
             check_p_fuzz));
@@ -75,17 +72,18 @@ void ACAlgorithm::RegisterOptions() {
     RegisterOption(Option{&iterations_limit_, kIterationsLimit, kDIterationsLimit}.SetValueCheck(
             check_positive));
     RegisterOption(Option{&seed_, kACSeed, kDACSeed});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void ACAlgorithm::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_,
-                                                                       false);  // nulls are ignored
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, false);  // nulls are ignored
+    numeric_columns_ = algebraic_constraints::NumericColumns(typed_relation_->GetColumnData());
 }
 
 void ACAlgorithm::MakeExecuteOptsAvailable() {
     using namespace config::names;
     MakeOptionsAvailable({kFuzziness, kFuzzinessProbability, kWeight, kBumpsLimit, kIterationsLimit,
-                          kACSeed, kBinaryOperation});
+                          kACSeed, kBinaryOperation, config::kThreadNumberOpt.GetName()});
 }
 
 void ACAlgorithm::ResetState() {
@@ -124,74 +122,100 @@ size_t ACAlgorithm::CalculateSampleSize(size_t k_bumps) const {
     return sample_size;
 }
 
-std::vector<std::byte const*> ACAlgorithm::Sampling(std::vector<model::TypedColumnData> const& data,
-                                                    size_t lhs_i, size_t rhs_i) {
-    ACPairs ac_pairs;
-    std::vector<std::byte const*> ranges;
+template <typename T>
+ACAlgorithm::ColumnPairSample ACAlgorithm::Sampling(size_t lhs_i, size_t rhs_i) const {
+    /* Results are computed for all rows at once, iterations only choose the sample */
+    std::vector<T> results;
+    std::vector<bool> valid;
+    numeric_columns_.ComputeBinop(bin_operation_, lhs_i, rhs_i, results);
+    numeric_columns_.GetValidRows<T>(bin_operation_, lhs_i, rhs_i, valid);
+
+    std::vector<size_t> sorted_sample;
+    std::vector<size_t> ranges;
     size_t k_bumps = 1;
     size_t i = 0;
     size_t sample_size = CalculateSampleSize(k_bumps);
     size_t new_k_bumps = 1;
-    size_t n_rows = data.at(lhs_i).GetData().size();
+    size_t n_rows = results.size();
     while (i < iterations_limit_ &&
            (ranges.empty() || sample_size < CalculateSampleSize(new_k_bumps))) {
         k_bumps = new_k_bumps;
         sample_size = CalculateSampleSize(k_bumps);
         double probability = sample_size / static_cast<double>(n_rows);
-        ranges = SamplingIteration(data, lhs_i, rhs_i, probability, ac_pairs);
+        ranges = SamplingIteration(results, valid, probability, sorted_sample);
         new_k_bumps = ranges.size() / 2;
         if (new_k_bumps == 0) {
             new_k_bumps = k_bumps + 1;
         }
         ++i;
     }
-    RestrictRangesAmount(ranges);
-    ac_pairs_.emplace_back(ACPairsCollection(
-            model::CreateSpecificType<model::INumericType>(data.at(lhs_i).GetTypeId(), true),
-            std::move(ac_pairs), lhs_i, rhs_i));
-    return ranges;
+
+    std::vector<T> sorted_results;
+    sorted_results.reserve(sorted_sample.size());
+    for (size_t row : sorted_sample) {
+        sorted_results.push_back(results[row]);
+    }
+    RestrictRangesAmount(sorted_results, ranges);
+
+    std::vector<model::TypedColumnData> const& data = GetTypedData();
+    std::vector<std::byte const*> const& lhs = data[lhs_i].GetData();
+    std::vector<std::byte const*> const& rhs = data[rhs_i].GetData();
+    model::INumericType const& num_type = static_cast<model::INumericType const&>(
+            data[lhs_i].GetType());
+    ColumnPairSample sample;
+    sample.ac_pairs.reserve(sorted_sample.size());
+    for (size_t row : sorted_sample) {
+        auto res = std::unique_ptr<std::byte[]>(num_type.Allocate());
+        model::Type::GetValue<T>(res.get()) = results[row];
+        sample.ac_pairs.emplace_back(std::make_unique<ACPair>(
+                ACPair::ColumnValueIndex{lhs_i, row}, ACPair::ColumnValueIndex{rhs_i, row},
+                lhs[row], rhs[row], std::move(res)));
+    }
+    sample.ranges.reserve(ranges.size());
+    for (size_t border : ranges) {
+        sample.ranges.push_back(sample.ac_pairs[border]->GetRes());
+    }
+    return sample;
 }
 
-std::vector<std::byte const*> ACAlgorithm::SamplingIteration(
-        std::vector<model::TypedColumnData> const& data, size_t lhs_i, size_t rhs_i,
-        double probability, ACPairs& ac_pairs) {
-    std::vector<std::byte const*> const& lhs = data.at(lhs_i).GetData();
-    std::vector<std::byte const*> const& rhs = data.at(rhs_i).GetData();
-    ac_pairs.clear();
+template <typename T>
+std::vector<size_t> ACAlgorithm::SamplingIteration(std::vector<T> const& results,
+                                                   std::vector<bool> const& valid,
+                                                   double probability,
+                                                   std::vector<size_t>& sorted_sample) const {
+    sorted_sample.clear();
     std::mt19937 gen(seed_);
 
     std::bernoulli_distribution d(probability);
-    for (size_t i = 0; i < lhs.size(); ++i) {
-        if (d(gen)) {
-            std::byte const* l = lhs.at(i);
-            std::byte const* r = rhs.at(i);
-            if (data[lhs_i].IsNullOrEmpty(i) || data[rhs_i].IsNullOrEmpty(i)) {
-                continue;
-            }
-            auto res = std::unique_ptr<std::byte[]>(num_type_->Allocate());
-            num_type_->ValueFromStr(res.get(), "0");
-            if (bin_operation_ == +Binop::Division &&
-                num_type_->Compare(r, res.get()) == model::CompareResult::kEqual) {
-                continue;
-            }
-            InvokeBinop(l, r, res.get());
-            auto ac = std::make_unique<ACPair>(ACPair::ColumnValueIndex{lhs_i, i},
-                                               ACPair::ColumnValueIndex{rhs_i, i}, l, r,
-                                               std::move(res));
-            ac_pairs.emplace_back(std::move(ac));
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (d(gen) && valid[i]) {
+            sorted_sample.push_back(i);
         }
     }
 
-    std::sort(ac_pairs.begin(), ac_pairs.end(),
-              [this](std::unique_ptr<ACPair> const& a, std::unique_ptr<ACPair> const& b) {
-                  return model::CompareResult::kLess ==
-                         this->num_type_->Compare(a->GetRes(), b->GetRes());
-              });
+    std::sort(sorted_sample.begin(), sorted_sample.end(),
+              [&results](size_t a, size_t b) { return results[a] < results[b]; });
+
+    std::vector<T> sorted_results;
+    sorted_results.reserve(sorted_sample.size());
+    for (size_t row : sorted_sample) {
+        sorted_results.push_back(results[row]);
+    }
+    return ConstructDisjunctiveRanges(sorted_results);
+}
+
+namespace {
 
-    return ConstructDisjunctiveRanges(ac_pairs);
+template <typename T>
+double Dist(T l, T r) {
+    return std::abs(l - r);
 }
 
-void ACAlgorithm::RestrictRangesAmount(std::vector<std::byte const*>& ranges) const {
+}  // namespace
+
+template <typename T>
+void ACAlgorithm::RestrictRangesAmount(std::vector<T> const& sorted_results,
+                                       std::vector<size_t>& ranges) const {
     if (bumps_limit_ == 0) {
         return;
     }
@@ -206,7 +230,7 @@ void ACAlgorithm::RestrictRangesAmount(std::vector<std::byte const*>& ranges) co
         double min_dist = -1;
         size_t min_index = 1;
         for (size_t i = min_index; i < bumps * 2 - 1; i += 2) {
-            double dist = num_type_->Dist(ranges.at(i), ranges.at(i + 1));
+            double dist = Dist(sorted_results[ranges[i]], sorted_results[ranges[i + 1]]);
             if (min_dist == -1 || dist < min_dist) {
                 min_dist = dist;
                 min_index = i;
@@ -260,39 +284,40 @@ void ACAlgorithm::PrintRanges(std::vector<model::TypedColumnData> const& data) c
     }
 }
 
-std::vector<std::byte const*> ACAlgorithm::ConstructDisjunctiveRanges(
-        ACPairs const& ac_pairs) const {
-    std::vector<std::byte const*> ranges;
-    if (ac_pairs.size() < 2) {
-        ranges = std::vector<std::byte const*>();
+template <typename T>
+std::vector<size_t> ACAlgorithm::ConstructDisjunctiveRanges(
+        std::vector<T> const& sorted_results) const {
+    std::vector<size_t> ranges;
+    if (sorted_results.size() < 2) {
         return ranges;
     }
 
-    ACPair const* l_border = ac_pairs.front().get();
-    ACPair const* r_border = nullptr;
+    size_t const last = sorted_results.size() - 1;
+    size_t l_border = 0;
+    size_t r_border = 0;
 
     if (weight_ < 1) {
-        double delta = num_type_->Dist(ac_pairs.front()->GetRes(), ac_pairs.back()->GetRes()) *
+        double delta = Dist(sorted_results.front(), sorted_results.back()) *
                        (weight_ / (1 - weight_));
 
-        for (size_t i = 0; i < ac_pairs.size() - 1; ++i) {
-            if (num_type_->Dist(ac_pairs[i]->GetRes(), ac_pairs[i + 1]->GetRes()) <= delta) {
-                r_border = ac_pairs[i + 1].get();
+        for (size_t i = 0; i < last; ++i) {
+            if (Dist(sorted_results[i], sorted_results[i + 1]) <= delta) {
+                r_border = i + 1;
             } else {
-                ranges.emplace_back(l_border->GetRes());
-                ranges.emplace_back(ac_pairs[i]->GetRes());
-                l_border = ac_pairs[i + 1].get();
-                r_border = ac_pairs[i + 1].get();
+                ranges.push_back(l_border);
+                ranges.push_back(i);
+                l_border = i + 1;
+                r_border = i + 1;
             }
         }
     } else {
         assert(weight_ == 1);
-        r_border = ac_pairs.back().get();
+        r_border = last;
     }
 
-    if (r_border == ac_pairs.back().get()) {
-        ranges.emplace_back(l_border->GetRes());
-        ranges.emplace_back(r_border->GetRes());
+    if (r_border == last) {
+        ranges.push_back(l_border);
+        ranges.push_back(r_border);
     }
 
     return ranges;
@@ -303,8 +328,24 @@ RangesCollection ACAlgorithm::ReconstructRangesByColumns(size_t lhs_i, size_t rh
     SetOption(config::names::kWeight, weight);
     ACPairsCollection const& constraints_collection = GetACPairsByColumns(lhs_i, rhs_i);
     ACPairs const& ac_pairs = constraints_collection.ac_pairs;
-    std::vector<std::byte const*> ranges = ConstructDisjunctiveRanges(ac_pairs);
     model::TypeId type_id = constraints_collection.col_pair.num_type->GetTypeId();
+
+    auto construct_ranges = [this, &ac_pairs]<typename T>() {
+        std::vector<T> sorted_results;
+        sorted_results.reserve(ac_pairs.size());
+        for (auto const& ac_pair : ac_pairs) {
+            sorted_results.push_back(model::Type::GetValue<T>(ac_pair->GetRes()));
+        }
+        return ConstructDisjunctiveRanges(sorted_results);
+    };
+    std::vector<size_t> borders = type_id == +model::TypeId::kInt
+                                          ? construct_ranges.operator()<model::Int>()
+                                          : construct_ranges.operator()<model::Double>();
+    std::vector<std::byte const*> ranges;
+    ranges.reserve(borders.size());
+    for (size_t border : borders) {
+        ranges.push_back(ac_pairs[border]->GetRes());
+    }
     return RangesCollection{model::CreateSpecificType<model::INumericType>(type_id, true),
                             std::move(ranges), lhs_i, rhs_i};
 }
@@ -316,29 +357,48 @@ unsigned long long ACAlgorithm::ExecuteInternal() {
     }
     auto start_time = std::chrono::system_clock::now();
 
+    std::vector<std::pair<size_t, size_t>> column_pairs;
     for (size_t col_i = 0; col_i < data.size() - 1; ++col_i) {
         if (!data.at(col_i).GetType().IsNumeric()) continue;
-        num_type_ =
-                model::CreateSpecificType<model::INumericType>(data.at(col_i).GetTypeId(), true);
         for (size_t col_k = col_i + 1; col_k < data.size(); ++col_k) {
             if (data.at(col_i).GetTypeId() == data.at(col_k).GetTypeId()) {
-                ranges_.emplace_back(
-                        RangesCollection{model::CreateSpecificType<model::INumericType>(
-                                                 data.at(col_i).GetTypeId(), true),
-                                         Sampling(data, col_i, col_k), col_i, col_k});
+                column_pairs.emplace_back(col_i, col_k);
                 /* Because of asymmetry and division by 0, we need to rediscover ranges.
                  * We don't need to do that for minus: (column1 - column2) lies in *some ranges*
                  * there we can express one column through another without possible problems */
                 if (bin_operation_ == +Binop::Division) {
-                    ranges_.emplace_back(
-                            RangesCollection{model::CreateSpecificType<model::INumericType>(
-                                                     data.at(col_i).GetTypeId(), true),
-                                             Sampling(data, col_k, col_i), col_k, col_i});
+                    column_pairs.emplace_back(col_k, col_i);
                 }
             }
         }
     }
 
+    std::vector<ColumnPairSample> samples(column_pairs.size());
+    auto sample_pair = [this, &data, &column_pairs, &samples](size_t i) {
+        auto [lhs_i, rhs_i] = column_pairs[i];
+        samples[i] = data[lhs_i].GetTypeId() == +model::TypeId::kInt
+                             ? Sampling<model::Int>(lhs_i, rhs_i)
+                             : Sampling<model::Double>(lhs_i, rhs_i);
+    };
+    if (threads_num_ > 1 && column_pairs.size() > 1) {
+        util::WorkerThreadPool pool(threads_num_);
+        pool.ExecIndex(sample_pair, column_pairs.size());
+    } else {
+        for (size_t i = 0; i < column_pairs.size(); ++i) {
+            sample_pair(i);
+        }
+    }
+
+    for (size_t i = 0; i < column_pairs.size(); ++i) {
+        auto [lhs_i, rhs_i] = column_pairs[i];
+        model::TypeId type_id = data[lhs_i].GetTypeId();
+        ac_pairs_.emplace_back(
+                model::CreateSpecificType<model::INumericType>(type_id, true),
+                std::move(samples[i].ac_pairs), lhs_i, rhs_i);
+        ranges_.emplace_back(model::CreateSpecificType<model::INumericType>(type_id, true),
+                             std::move(samples[i].ranges), lhs_i, rhs_i);
+    }
+
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
     PrintRanges(data);
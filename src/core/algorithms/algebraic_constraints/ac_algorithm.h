@@ -1,6 +1,5 @@
 #pragma once
 
-#include <functional>
 #include <unordered_map>
 #include <vector>
 
@@ -13,8 +12,10 @@
 #include "algorithms/algorithm.h"
 #include "bin_operation_enum.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_typed_relation_data.h"
 #include "model/types/types.h"
+#include "numeric_columns.h"
 #include "ranges_collection.h"
 #include "typed_column_pair.h"
 
@@ -32,7 +33,8 @@ namespace algos {
  * creates sample selection of value pairs and constructs ranges using that sample.
  * Also allows discovering exceptions, where exception is a (a_i, b_i) value pair
  * from columns A and B, that has result of binary operation not belonging to any
- * range discovered for (A, B) column pair */
+ * range discovered for (A, B) column pair.
+ * Column pairs are processed independently, in parallel if threads > 1. */
 class ACAlgorithm : public Algorithm {
 private:
     using TypedRelation = model::ColumnLayoutTypedRelationData;
@@ -52,41 +54,50 @@ private:
      * by ratio of exceptional records */
     double p_fuzz_;
     size_t iterations_limit_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    config::ThreadNumType threads_num_ = 1;
+    std::shared_ptr<TypedRelation> typed_relation_;
+    algebraic_constraints::NumericColumns numeric_columns_;
     std::unique_ptr<algebraic_constraints::ACExceptionFinder> ac_exception_finder_;
     double seed_;
     std::vector<ACPairsCollection> ac_pairs_;
     std::vector<RangesCollection> ranges_;
-    model::INumericType::NumericBinop binop_pointer_ = nullptr;
-    std::unique_ptr<model::INumericType> num_type_;
-
-    /* Returns vector with ranges boundaries constructed for columns with lhs_i and rhs_i indices.
-     * Value pairs (by which ranges constructed) fall into sample selection with chosen probability.
-     */
-    std::vector<std::byte const*> SamplingIteration(std::vector<model::TypedColumnData> const& data,
-                                                    size_t lhs_i, size_t rhs_i, double probability,
-                                                    ACPairs& ac_pairs);
-    /* Returns vector with ranges boundaries constructed for columns with lhs_i and rhs_i indices.
-     * These ranges are part of AC for that column pair (as in AC definition). Uses iterative
-     * algorithm that uses SamplingIteration method. In the vast majority of cases there is less
-     *  than 4 iterations.  */
-    std::vector<std::byte const*> Sampling(std::vector<model::TypedColumnData> const& data,
-                                           size_t lhs_i, size_t rhs_i);
-    /* Returns vector with ranges boundaries. Ranges constructed by grouping results of binary
-     * operation between values in ac_pairs. */
-    std::vector<std::byte const*> ConstructDisjunctiveRanges(ACPairs const& ac_pairs) const;
+
+    /* Sampled value pairs of a column pair sorted by the result of binary operation and borders
+     * of the ranges, which point to results of these pairs */
+    struct ColumnPairSample {
+        ACPairs ac_pairs;
+        std::vector<std::byte const*> ranges;
+    };
+
+    /* Returns indices (in sorted_sample) of ranges boundaries constructed for the results of
+     * binary operation in results. Value pairs (by which ranges constructed) fall into sample
+     * selection with chosen probability, rows of the sample are put to sorted_sample in the
+     * order of their results. */
+    template <typename T>
+    std::vector<size_t> SamplingIteration(std::vector<T> const& results,
+                                          std::vector<bool> const& valid, double probability,
+                                          std::vector<size_t>& sorted_sample) const;
+    /* Returns ranges constructed for columns with lhs_i and rhs_i indices and the sample they
+     * are constructed by. These ranges are part of AC for that column pair (as in AC
+     * definition). Uses iterative algorithm that uses SamplingIteration method. In the vast
+     * majority of cases there is less than 4 iterations. Does not modify the state, so column
+     * pairs may be sampled concurrently. */
+    template <typename T>
+    ColumnPairSample Sampling(size_t lhs_i, size_t rhs_i) const;
+    /* Returns indices of ranges boundaries in sorted_results. Ranges constructed by grouping
+     * results of binary operation, which are given in ascending order. */
+    template <typename T>
+    std::vector<size_t> ConstructDisjunctiveRanges(std::vector<T> const& sorted_results) const;
     /* Greedily combines ranges if there is more than bumps_limit_ */
-    void RestrictRangesAmount(std::vector<std::byte const*>& ranges) const;
+    template <typename T>
+    void RestrictRangesAmount(std::vector<T> const& sorted_results,
+                              std::vector<size_t>& ranges) const;
     void RegisterOptions();
     void LoadDataInternal() override;
     void MakeExecuteOptsAvailable() override;
     void ResetState() override;
 
 public:
-    void InvokeBinop(std::byte const* l, std::byte const* r, std::byte* res) const {
-        std::invoke(binop_pointer_, num_type_, l, r, res);
-    }
-
     size_t CalculateSampleSize(size_t k_bumps) const;
     /* Returns ranges reconstucted with new weight for pair of columns */
     RangesCollection ReconstructRangesByColumns(size_t lhs_i, size_t rhs_i, double weight);
@@ -106,6 +117,10 @@ public:
         return typed_relation_->GetColumnData();
     }
 
+    algebraic_constraints::NumericColumns const& GetNumericColumns() const {
+        return numeric_columns_;
+    }
+
     Binop GetBinOperation() const {
         return bin_operation_;
     }
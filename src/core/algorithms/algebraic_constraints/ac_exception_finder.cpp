@@ -1,74 +1,65 @@
 #include "ac_exception_finder.h"
 
+#include <algorithm>
+
 #include "ac_algorithm.h"
 #include "bin_operation_enum.h"
 
 namespace algos::algebraic_constraints {
 
-bool ACExceptionFinder::ValueBelongsToRanges(RangesCollection const& ranges_collection,
-                                             std::byte const* val) {
-    model::INumericType* num_type = ranges_collection.col_pair.num_type.get();
-    for (size_t i = 0; i < ranges_collection.ranges.size() - 1; i += 2) {
-        std::byte const* l_border = ranges_collection.ranges[i];
-        std::byte const* r_border = ranges_collection.ranges[i + 1];
-        if (num_type->Compare(l_border, val) == model::CompareResult::kEqual ||
-            num_type->Compare(val, r_border) == model::CompareResult::kEqual) {
-            return true;
-        }
-        if (num_type->Compare(l_border, val) == model::CompareResult::kLess &&
-            num_type->Compare(val, r_border) == model::CompareResult::kLess) {
-            return true;
-        }
-    }
-    return false;
-}
+template <typename T>
+std::vector<size_t> ACExceptionFinder::CollectColumnPairExceptions(
+        RangesCollection const& ranges_collection) {
+    size_t lhs_i = ranges_collection.col_pair.col_i.first;
+    size_t rhs_i = ranges_collection.col_pair.col_i.second;
+    NumericColumns const& columns = ac_alg_->GetNumericColumns();
+    std::vector<T> results;
+    std::vector<bool> valid;
+    columns.ComputeBinop(ac_alg_->GetBinOperation(), lhs_i, rhs_i, results);
+    columns.GetValidRows<T>(ac_alg_->GetBinOperation(), lhs_i, rhs_i, valid);
 
-void ACExceptionFinder::AddException(size_t row_i, std::pair<size_t, size_t> const& col_pair) {
-    auto equal = [row_i](ACException const& e) { return e.row_i == row_i; };
-    auto exception_i = std::find_if(exceptions_.begin(), exceptions_.end(), equal);
-    if (exception_i == exceptions_.end()) {
-        exceptions_.push_back(ACException(row_i, col_pair));
-    } else {
-        exception_i->column_pairs.push_back(col_pair);
+    /* Ranges are disjoint and ascending, so a value can only belong to the last range that
+     * starts not after it */
+    std::vector<T> l_borders;
+    std::vector<T> r_borders;
+    for (size_t i = 0; i + 1 < ranges_collection.ranges.size(); i += 2) {
+        l_borders.push_back(model::Type::GetValue<T>(ranges_collection.ranges[i]));
+        r_borders.push_back(model::Type::GetValue<T>(ranges_collection.ranges[i + 1]));
     }
-}
 
-void ACExceptionFinder::CollectColumnPairExceptions(std::vector<model::TypedColumnData> const& data,
-                                                    RangesCollection const& ranges_collection) {
-    size_t lhs_i = ranges_collection.col_pair.col_i.first;
-    size_t rhs_i = ranges_collection.col_pair.col_i.second;
-    std::vector<std::byte const*> const& lhs = data.at(lhs_i).GetData();
-    std::vector<std::byte const*> const& rhs = data.at(rhs_i).GetData();
-    std::unique_ptr<model::INumericType> num_type =
-            model::CreateSpecificType<model::INumericType>(data.at(lhs_i).GetTypeId(), true);
-    for (size_t i = 0; i < lhs.size(); ++i) {
-        std::byte const* l = lhs.at(i);
-        std::byte const* r = rhs.at(i);
-        if (data[lhs_i].IsNullOrEmpty(i) || data[rhs_i].IsNullOrEmpty(i)) {
-            continue;
-        }
-        auto res = std::unique_ptr<std::byte[]>(num_type->Allocate());
-        num_type->ValueFromStr(res.get(), "0");
-        if (ac_alg_->GetBinOperation() == +Binop::Division &&
-            num_type->Compare(r, res.get()) == model::CompareResult::kEqual) {
-            continue;
-        }
-        ac_alg_->InvokeBinop(l, r, res.get());
-        if (!ValueBelongsToRanges(ranges_collection, res.get())) {
-            AddException(i, {lhs_i, rhs_i});
+    std::vector<size_t> exception_rows;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!valid[i]) continue;
+        auto range = std::upper_bound(l_borders.begin(), l_borders.end(), results[i]);
+        if (range == l_borders.begin() ||
+            !(results[i] <= r_borders[std::distance(l_borders.begin(), range) - 1])) {
+            exception_rows.push_back(i);
         }
     }
+    return exception_rows;
 }
 
 void ACExceptionFinder::CollectExceptions(algos::ACAlgorithm const* ac_alg) {
     ac_alg_ = ac_alg;
     std::vector<model::TypedColumnData> const& data = ac_alg_->GetTypedData();
     std::vector<RangesCollection> const& ranges = ac_alg_->GetRangesCollections();
+    /* Column pairs of every row, in the order of ranges collections */
+    std::vector<std::vector<std::pair<size_t, size_t>>> row_column_pairs(
+            data.empty() ? 0 : data.front().GetNumRows());
     for (auto const& ranges_collection : ranges) {
-        CollectColumnPairExceptions(data, ranges_collection);
+        std::pair<size_t, size_t> const& col_pair = ranges_collection.col_pair.col_i;
+        std::vector<size_t> exception_rows =
+                ranges_collection.col_pair.num_type->GetTypeId() == +model::TypeId::kInt
+                        ? CollectColumnPairExceptions<model::Int>(ranges_collection)
+                        : CollectColumnPairExceptions<model::Double>(ranges_collection);
+        for (size_t row_i : exception_rows) {
+            row_column_pairs[row_i].push_back(col_pair);
+        }
+    }
+    for (size_t row_i = 0; row_i < row_column_pairs.size(); ++row_i) {
+        if (row_column_pairs[row_i].empty()) continue;
+        exceptions_.emplace_back(row_i, std::move(row_column_pairs[row_i]));
     }
-    auto comp = [](ACException const& a, ACException const& b) { return a.row_i < b.row_i; };
-    std::sort(exceptions_.begin(), exceptions_.end(), comp);
 }
 
 }  // namespace algos::algebraic_constraints
@@ -16,12 +16,9 @@ class ACExceptionFinder {
 private:
     std::vector<ACException> exceptions_;
     ACAlgorithm const* ac_alg_;
-    static bool ValueBelongsToRanges(RangesCollection const& ranges_collection,
-                                     std::byte const* val);
-    /* Creates new ACException and adds it to exceptions_ or adds col_pair to existing one */
-    void AddException(size_t row_i, std::pair<size_t, size_t> const& col_pair);
-    void CollectColumnPairExceptions(std::vector<model::TypedColumnData> const& data,
-                                     RangesCollection const& ranges_collection);
+    /* Returns rows whose result of binary operation does not belong to any of the ranges */
+    template <typename T>
+    std::vector<size_t> CollectColumnPairExceptions(RangesCollection const& ranges_collection);
 
 public:
     void CollectExceptions(ACAlgorithm const* ac_alg);
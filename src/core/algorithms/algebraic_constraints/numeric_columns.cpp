@@ -0,0 +1,44 @@
+#include "numeric_columns.h"
+
+#include "model/types/type.h"
+
+namespace algos::algebraic_constraints {
+
+namespace {
+
+template <typename T>
+std::vector<T> GetColumnValues(model::TypedColumnData const& column) {
+    std::vector<T> values(column.GetNumRows(), T{0});
+    bool const has_missing = column.GetNumNulls() != 0 || column.GetNumEmpties() != 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (has_missing && column.IsNullOrEmpty(i)) continue;
+        values[i] = model::Type::GetValue<T>(column.GetValue(i));
+    }
+    return values;
+}
+
+}  // namespace
+
+NumericColumns::NumericColumns(std::vector<model::TypedColumnData> const& data)
+    : ints_(data.size()), doubles_(data.size()), missing_(data.size()) {
+    for (std::size_t column = 0; column < data.size(); ++column) {
+        model::TypedColumnData const& column_data = data[column];
+        switch (column_data.GetTypeId()) {
+            case model::TypeId::kInt:
+                ints_[column] = GetColumnValues<model::Int>(column_data);
+                break;
+            case model::TypeId::kDouble:
+                doubles_[column] = GetColumnValues<model::Double>(column_data);
+                break;
+            default:
+                continue;
+        }
+        if (column_data.GetNumNulls() == 0 && column_data.GetNumEmpties() == 0) continue;
+        missing_[column].resize(column_data.GetNumRows());
+        for (std::size_t i = 0; i < column_data.GetNumRows(); ++i) {
+            missing_[column][i] = column_data.IsNullOrEmpty(i);
+        }
+    }
+}
+
+}  // namespace algos::algebraic_constraints
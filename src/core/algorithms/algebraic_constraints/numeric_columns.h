@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "bin_operation_enum.h"
+#include "model/table/typed_column_data.h"
+#include "model/types/builtin.h"
+
+namespace algos::algebraic_constraints {
+
+/* Values of numeric columns stored as contiguous typed arrays indexed by row, so that a binary
+ * operation over a column pair is a tight loop over two arrays that the compiler can vectorize,
+ * instead of a virtual call through INumericType per row. Null and empty values are stored as
+ * zeros and are marked as missing. */
+class NumericColumns {
+private:
+    std::vector<std::vector<model::Int>> ints_;
+    std::vector<std::vector<model::Double>> doubles_;
+    /* Empty for columns without nulls and empties */
+    std::vector<std::vector<bool>> missing_;
+
+    template <typename T, typename Op>
+    static void ApplyBinop(std::vector<T> const& lhs, std::vector<T> const& rhs,
+                           std::vector<T>& res, Op op) {
+        std::size_t const size = lhs.size();
+        res.resize(size);
+        T const* l = lhs.data();
+        T const* r = rhs.data();
+        T* out = res.data();
+        for (std::size_t i = 0; i < size; ++i) {
+            out[i] = op(l[i], r[i]);
+        }
+    }
+
+public:
+    NumericColumns() = default;
+    explicit NumericColumns(std::vector<model::TypedColumnData> const& data);
+
+    template <typename T>
+    std::vector<T> const& GetValues(std::size_t column) const {
+        if constexpr (std::is_same_v<T, model::Int>) {
+            return ints_[column];
+        } else {
+            return doubles_[column];
+        }
+    }
+
+    /* Results of lhs_i binop rhs_i for every row. Results of rows that are not valid (see
+     * GetValidRows) are meaningless */
+    template <typename T>
+    void ComputeBinop(Binop binop, std::size_t lhs_i, std::size_t rhs_i,
+                      std::vector<T>& res) const {
+        std::vector<T> const& lhs = GetValues<T>(lhs_i);
+        std::vector<T> const& rhs = GetValues<T>(rhs_i);
+        switch (binop) {
+            case +Binop::Addition:
+                ApplyBinop(lhs, rhs, res, std::plus<T>{});
+                break;
+            case +Binop::Subtraction:
+                ApplyBinop(lhs, rhs, res, std::minus<T>{});
+                break;
+            case +Binop::Multiplication:
+                ApplyBinop(lhs, rhs, res, std::multiplies<T>{});
+                break;
+            case +Binop::Division:
+                /* Rows with zero divisor are not valid, dividing them by one keeps the loop
+                 * branchless and integer division from trapping */
+                ApplyBinop(lhs, rhs, res, [](T l, T r) { return l / (r == T{0} ? T{1} : r); });
+                break;
+        }
+    }
+
+    /* Rows where both values are present and, for division, the divisor is not zero */
+    template <typename T>
+    void GetValidRows(Binop binop, std::size_t lhs_i, std::size_t rhs_i,
+                      std::vector<bool>& valid) const {
+        std::vector<T> const& rhs = GetValues<T>(rhs_i);
+        valid.assign(rhs.size(), true);
+        for (std::size_t column : {lhs_i, rhs_i}) {
+            if (missing_[column].empty()) continue;
+            for (std::size_t i = 0; i < valid.size(); ++i) {
+                if (missing_[column][i]) valid[i] = false;
+            }
+        }
+        if (binop == +Binop::Division) {
+            for (std::size_t i = 0; i < valid.size(); ++i) {
+                if (rhs[i] == T{0}) valid[i] = false;
+            }
+        }
+    }
+};
+
+}  // namespace algos::algebraic_constraints
@@ -1,6 +1,10 @@
 #include "algorithms/algorithm.h"
 
 #include <cassert>
+#include <exception>
+#include <typeinfo>
+
+#include <easylogging++.h>
 
 #include "config/exceptions.h"
 
@@ -20,6 +24,44 @@ void Algorithm::AddSpecificNeededOptions(
 
 void Algorithm::MakeExecuteOptsAvailable() {}
 
+std::string Algorithm::SerializeResult() const {
+    throw std::logic_error("The algorithm does not support caching of results.");
+}
+
+void Algorithm::LoadResult(std::string const&) {
+    throw std::logic_error("The algorithm does not support caching of results.");
+}
+
+std::optional<std::string> Algorithm::GetResultCacheKey() const {
+    // Without the fingerprints of the tables the key would not tell the datasets apart
+    if (result_cache_ == nullptr || !CanCacheResult() || table_fingerprints_.empty()) {
+        return std::nullopt;
+    }
+    return ResultCache::MakeKey(typeid(*this).name(), GetOptValues(), table_fingerprints_);
+}
+
+bool Algorithm::LoadCachedResult(std::string const& key) {
+    std::optional<std::string> data = result_cache_->Find(key);
+    if (!data.has_value()) return false;
+    try {
+        LoadResult(*data);
+    } catch (std::invalid_argument const& e) {
+        LOG(WARNING) << "Ignoring a broken result cache entry: " << e.what();
+        ResetState();
+        return false;
+    }
+    return true;
+}
+
+void Algorithm::StoreResult(std::string const& key) const {
+    // The results are already there, failing to cache them must not lose them
+    try {
+        result_cache_->Store(key, SerializeResult());
+    } catch (std::exception const& e) {
+        LOG(WARNING) << "Failed to cache the results: " << e.what();
+    }
+}
+
 void Algorithm::ClearOptions() noexcept {
     available_options_.clear();
     opt_parents_.clear();
@@ -67,7 +109,24 @@ void Algorithm::MakeOptionsAvailable(std::vector<std::string_view> const& option
 void Algorithm::LoadData() {
     if (!GetNeededOptions().empty())
         throw std::logic_error("All options need to be set before starting processing.");
-    LoadDataInternal();
+    table_fingerprints_.clear();
+    try {
+        CheckCancelled();
+        if (result_cache_ != nullptr && CanCacheResult()) {
+            for (auto const& [name, opt_value] : GetOptValues()) {
+                std::optional<std::string> fingerprint =
+                        ResultCache::GetTablesFingerprint(opt_value);
+                if (fingerprint.has_value()) {
+                    table_fingerprints_.emplace(name, std::move(*fingerprint));
+                }
+            }
+        }
+        LoadDataInternal();
+    } catch (...) {
+        cancel_requested_ = false;
+        throw;
+    }
+    cancel_requested_ = false;
     ExecutePrepare();
 }
 
@@ -79,7 +138,20 @@ unsigned long long Algorithm::Execute() {
         throw std::logic_error("All options need to be set before execution.");
     progress_.ResetProgress();
     ResetState();
-    auto time_ms = ExecuteInternal();
+    unsigned long long time_ms = 0;
+    std::optional<std::string> const cache_key = GetResultCacheKey();
+    bool const result_loaded = cache_key.has_value() && LoadCachedResult(*cache_key);
+    try {
+        CheckCancelled();
+        if (!result_loaded) time_ms = ExecuteInternal();
+    } catch (...) {
+        cancel_requested_ = false;
+        throw;
+    }
+    cancel_requested_ = false;
+    if (cache_key.has_value() && !result_loaded) {
+        StoreResult(*cache_key);
+    }
     for (auto const& opt_name : available_options_) {
         possible_options_.at(opt_name)->Unset();
     }
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <string_view>
 #include <typeindex>
 #include <unordered_map>
@@ -10,6 +15,7 @@
 
 #include <boost/any.hpp>
 
+#include "algorithms/result_cache.h"
 #include "config/ioption.h"
 #include "config/option.h"
 #include "model/table/idataset_stream.h"
@@ -18,9 +24,16 @@
 
 namespace algos {
 
+// Thrown from LoadData and Execute when they stop early because Cancel was called.
+class ExecutionCancelled : public std::runtime_error {
+public:
+    ExecutionCancelled() : std::runtime_error("Execution was cancelled") {}
+};
+
 class Algorithm {
 private:
     util::Progress progress_;
+    std::atomic<bool> cancel_requested_ = false;
     // All options the algorithm may use
     std::unordered_map<std::string_view, std::unique_ptr<config::IOption>> possible_options_;
     // All options that can be set at the moment
@@ -30,6 +43,10 @@ private:
 
     bool data_loaded_ = false;
 
+    std::shared_ptr<ResultCache> result_cache_;
+    // Fingerprints of the tables given to LoadData, by option name
+    std::unordered_map<std::string_view, std::string> table_fingerprints_;
+
     // Clear the necessary fields for Execute to run repeatedly with different
     // configuration parameters on the same dataset.
     virtual void ResetState() = 0;
@@ -39,6 +56,11 @@ private:
     virtual void LoadDataInternal() = 0;
     virtual unsigned long long ExecuteInternal() = 0;
 
+    std::optional<std::string> GetResultCacheKey() const;
+    // Returns whether the results were loaded
+    bool LoadCachedResult(std::string const& key);
+    void StoreResult(std::string const& key) const;
+
 protected:
     void AddProgress(double val) noexcept {
         progress_.AddProgress(val);
@@ -52,6 +74,12 @@ protected:
         progress_.ToNextProgressPhase();
     }
 
+    // Cancellation point: call it where it is safe to abandon the run, e.g. once per lattice
+    // level or per main loop iteration. May be called from worker threads.
+    void CheckCancelled() const {
+        if (cancel_requested_.load(std::memory_order_relaxed)) throw ExecutionCancelled();
+    }
+
     void MakeOptionsAvailable(std::vector<std::string_view> const& option_names);
 
     template <typename T>
@@ -78,6 +106,17 @@ protected:
     // given through LoadData
     virtual void MakeExecuteOptsAvailable();
 
+    // Override these three to let a result cache keep the results of Execute. The results must
+    // depend only on the tables and the option values, not on the previous executions.
+    virtual bool CanCacheResult() const noexcept {
+        return false;
+    }
+
+    virtual std::string SerializeResult() const;
+    // Called after ResetState, instead of ExecuteInternal. Throws std::invalid_argument if the
+    // data is not a serialized result for the loaded tables.
+    virtual void LoadResult(std::string const& data);
+
 public:
     constexpr static double kTotalProgressPercent = util::Progress::kTotalProgressPercent;
 
@@ -101,6 +140,30 @@ public:
 
     void UnsetOption(std::string_view option_name) noexcept;
 
+    // Makes LoadData fingerprint the tables and Execute return the results kept in the cache for
+    // the same tables and options, if the algorithm supports it. Must be set before LoadData.
+    // Pass nullptr to stop using the cache.
+    void SetResultCache(std::shared_ptr<ResultCache> result_cache) noexcept {
+        result_cache_ = std::move(result_cache);
+    }
+
+    std::shared_ptr<ResultCache> const& GetResultCache() const noexcept {
+        return result_cache_;
+    }
+
+    // Thread-safe. Makes the running LoadData or Execute (or the next one, if none is running)
+    // throw ExecutionCancelled at its next cancellation point. The request is dropped when that
+    // call returns. Results of a cancelled Execute are incomplete and must not be used.
+    void Cancel() noexcept {
+        cancel_requested_.store(true, std::memory_order_relaxed);
+    }
+
+    // Drops a cancellation request no LoadData or Execute has picked up, e.g. one that came right
+    // after the call it was meant for had returned.
+    void ClearCancelRequest() noexcept {
+        cancel_requested_.store(false, std::memory_order_relaxed);
+    }
+
     // See util::Progress::GetProgress description
     std::pair<uint8_t, double> GetProgress() const noexcept {
         return progress_.GetProgress();
@@ -11,7 +11,8 @@ using AlgorithmTypes =
                    Apriori, metric::MetricVerifier, DataStats, fd_verifier::FDVerifier, HyUCC,
                    PyroUCC, HPIValid, cfd::FDFirstAlgorithm, ACAlgorithm, UCCVerifier, Faida,
                    Spider, Mind, INDVerifier, Fastod, GfdValidation, EGfdValidation,
-                   NaiveGfdValidation, order::Order, dd::Split, Cords, hymd::HyMD, PFDVerifier>;
+                   NaiveGfdValidation, order::Order, dd::Split, Cords, hymd::HyMD, PFDVerifier,
+                   dynfd::DynFD>;
 
 // clang-format off
 /* Enumeration of all supported non-pipeline algorithms. If you implement a new
@@ -89,7 +90,10 @@ BETTER_ENUM(AlgorithmType, char,
     hymd,
 
 /* PFD verifier algorithm */
-    pfd_verifier
+    pfd_verifier,
+
+/* FD mining algorithm for dynamic tables */
+    dynfd
 )
 // clang-format on
 
@@ -13,6 +13,7 @@
 #include "config/exceptions.h"
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
+#include "config/thread_number/option.h"
 
 // see algorithms/cfd/LICENSE
 
@@ -30,6 +31,7 @@ void FDFirstAlgorithm::RegisterOptions() {
     RegisterOption(Option{&min_conf_, kCfdMinimumConfidence, kDCfdMinimumConfidence, 0.0});
     RegisterOption(Option{&max_lhs_, kCfdMaximumLhs, kDCfdMaximumLhs, 0u});
     RegisterOption(Option{&substrategy_, kCfdSubstrategy, kDCfdSubstrategy, default_val});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void FDFirstAlgorithm::ResetStateCFD() {
@@ -39,13 +41,17 @@ void FDFirstAlgorithm::ResetStateCFD() {
     free_map_.clear();
     free_itemsets_.clear();
     rules_.clear();
+    pending_steps_.clear();
+    pending_scan_size_ = 0;
 }
 
 unsigned long long FDFirstAlgorithm::ExecuteInternal() {
     max_cfd_size_ = max_lhs_ + 1;
     CheckForIncorrectInput();
     auto start_time = std::chrono::system_clock::now();
+    pool_ = threads_num_ > 1 ? std::make_unique<util::WorkerThreadPool>(threads_num_) : nullptr;
     FdsFirstDFS();
+    pool_.reset();
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
     unsigned long long apriori_millis = elapsed_milliseconds.count();
@@ -93,31 +99,37 @@ void FDFirstAlgorithm::CheckForIncorrectInput() const {
 void FDFirstAlgorithm::MakeExecuteOptsAvailable() {
     using namespace config::names;
 
-    MakeOptionsAvailable(
-            {kCfdMinimumSupport, kCfdMinimumConfidence, kCfdMaximumLhs, kCfdSubstrategy});
+    MakeOptionsAvailable({kCfdMinimumSupport, kCfdMinimumConfidence, kCfdMaximumLhs,
+                          kCfdSubstrategy, kThreads});
 }
 
-bool FDFirstAlgorithm::Precedes(Itemset const& a, Itemset const& b) {
-    if (a.size() > b.size() || a == b) return false;
+Itemset FDFirstAlgorithm::GetPattern(Itemset const& items) const {
     Itemset pattern(relation_->GetAttrsNumber());
-    for (int v : b) {
+    for (int v : items) {
         if (v > 0) {
             pattern[relation_->GetAttrIndex(v)] = v;
         } else {
             pattern[-1 - v] = v;
         }
     }
+    return pattern;
+}
+
+// b_pattern is GetPattern(b), it is built once for all the itemsets compared with b
+bool FDFirstAlgorithm::Precedes(Itemset const& a, Itemset const& b,
+                                Itemset const& b_pattern) const {
+    if (a.size() > b.size() || a == b) return false;
     for (int i : a) {
         if (i > 0) {
-            if (pattern[relation_->GetAttrIndex(i)] != i) return false;
-        } else if (pattern[-1 - i] == 0) {
+            if (b_pattern[relation_->GetAttrIndex(i)] != i) return false;
+        } else if (b_pattern[-1 - i] == 0) {
             return false;
         }
     }
     return true;
 }
 
-bool FDFirstAlgorithm::IsConstRule(PartitionTIdList const& items, int rhs_a) {
+bool FDFirstAlgorithm::IsConstRule(PartitionTIdList const& items, int rhs_a) const {
     int rhs_value;
     bool first = true;
     for (size_t pos_index = 0; pos_index <= items.tids.size(); pos_index++) {
@@ -136,37 +148,46 @@ bool FDFirstAlgorithm::IsConstRule(PartitionTIdList const& items, int rhs_a) {
     return true;
 }
 
-void FDFirstAlgorithm::MineFD(MinerNode<PartitionTIdList> const& inode, Itemset const& lhs,
-                              int rhs) {
-    if (inode.tids.sets_number == 1 || IsConstRule(inode.tids, -1 - rhs)) return;
+std::optional<double> FDFirstAlgorithm::ComputeFDConfidence(
+        MinerNode<PartitionTIdList> const& inode, Itemset const& lhs, int rhs) const {
+    if (inode.tids.sets_number == 1 || IsConstRule(inode.tids, -1 - rhs)) return std::nullopt;
     auto const stored_sub = store_.find(lhs);
     if (stored_sub == store_.end()) {
-        return;
+        return std::nullopt;
     }
+    // Here the confidence computing method from the paper is used
+    double e = stored_sub->second.PartitionError(inode.tids);
+    return 1 - (e / TIdUtil::Support(stored_sub->second));
+}
+
+void FDFirstAlgorithm::MineFD(NodeMining const& step) {
+    Itemset const& lhs = step.lhs;
+    int const rhs = step.rhs;
     bool lhs_gen = true;
     if (free_itemsets_.find(lhs) == free_itemsets_.end()) {
         lhs_gen = false;
     }
-    if (rules_.find(rhs) != rules_.end()) {
-        for (auto const& sub_rule : rules_[rhs]) {
+    if (auto const rules = rules_.find(rhs); lhs_gen && rules != rules_.end()) {
+        Itemset const lhs_pattern = GetPattern(lhs);
+        for (auto const& sub_rule : rules->second) {
             if (!std::any_of(sub_rule.begin(), sub_rule.end(),
                              [](int si) -> bool { return si < 0; }))
                 continue;
-            if (Precedes(sub_rule, lhs)) {
+            if (Precedes(sub_rule, lhs, lhs_pattern)) {
                 lhs_gen = false;
+                break;
             }
         }
     }
-    if (lhs_gen) {
-        // Here the confidence computing method from the paper is used
-        double e = stored_sub->second.PartitionError(inode.tids);
-        double conf = 1 - (e / TIdUtil::Support(stored_sub->second));
-        if (conf >= min_conf_) {
-            cfd_list_.emplace_back(lhs, rhs);
-        }
-        if (conf >= 1) {
-            rules_[rhs].push_back(lhs);
-        }
+    if (!lhs_gen) return;
+    std::optional<double> const conf =
+            step.scanned ? step.fd_confidence : ComputeFDConfidence(*step.inode, lhs, rhs);
+    if (!conf.has_value()) return;
+    if (*conf >= min_conf_) {
+        cfd_list_.emplace_back(lhs, rhs);
+    }
+    if (*conf >= 1) {
+        rules_[rhs].push_back(lhs);
     }
 }
 
@@ -183,7 +204,93 @@ void FDFirstAlgorithm::FdsFirstDFS() {
     cand_store_ = PrefixTree<Itemset, Itemset>();
     store_[Itemset()] = PartitionTIdList(Iota(relation_->Size()));
     cand_store_.Insert(Itemset(), all_attrs_);
-    FdsFirstDFS(Itemset(), items, substrategy_);
+    FdsFirstDFS(Itemset(), items);
+}
+
+std::vector<PartitionTIdList> FDFirstAlgorithm::ConstructIntersections(
+        PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses) const {
+    size_t const chunks_num = std::min<size_t>(threads_num_, rhses.size());
+    if (pool_ == nullptr || chunks_num < 2 ||
+        lhs.tids.size() * rhses.size() < min_parallel_intersection_size_) {
+        return PartitionTIdListUtil::ConstructIntersection(lhs, rhses);
+    }
+
+    // Every chunk indexes the tids of lhs once
+    std::vector<std::vector<PartitionTIdList>> chunks(chunks_num);
+    pool_->ExecIndex(
+            [&](size_t chunk) {
+                std::vector<PartitionTIdList const*> const chunk_rhses(
+                        rhses.begin() + rhses.size() * chunk / chunks_num,
+                        rhses.begin() + rhses.size() * (chunk + 1) / chunks_num);
+                chunks[chunk] = PartitionTIdListUtil::ConstructIntersection(lhs, chunk_rhses);
+            },
+            chunks_num);
+    std::vector<PartitionTIdList> res;
+    res.reserve(rhses.size());
+    for (auto& chunk : chunks) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(res));
+    }
+    return res;
+}
+
+void FDFirstAlgorithm::ScanNode(NodeMining& step) const {
+    RuleIxs rule_ixs;
+    std::vector<int> rhses;
+    FillMinePatternsVars(step.partitions, step.rhses_pairs, rule_ixs, rhses, step.lhs, step.rhs,
+                         step.inode->tids);
+}
+
+void FDFirstAlgorithm::ApplyStep(NodeMining& step) {
+    MineFD(step);
+    if (!step.scanned) {
+        ScanNode(step);
+    }
+
+    if (substrategy_ == +Substrategy::dfs) {
+        MinePatternsDFS(step.lhs, step.rhs, step.partitions, step.rhses_pairs);
+    } else if (substrategy_ == +Substrategy::bfs) {
+        MinePatternsBFS(step.lhs, step.rhs, step.partitions, step.rhses_pairs);
+    }
+}
+
+void FDFirstAlgorithm::ApplyStep(FreeSetCheck const& step) {
+    auto const free_map_elem = free_map_.find(step.support_and_sets);
+    if (free_map_elem != free_map_.end()) {
+        for (auto const& sub_cand : free_map_elem->second) {
+            if (IsSubsetOf(sub_cand, step.new_set)) {
+                return;
+            }
+        }
+    }
+    free_map_[step.support_and_sets].push_back(step.new_set);
+    free_itemsets_.insert(step.new_set);
+}
+
+// Steps refer to the nodes of the traversal, so they are applied before the nodes are destroyed
+void FDFirstAlgorithm::ApplyPendingSteps() {
+    if (pool_ != nullptr && pending_scan_size_ >= min_parallel_scan_size_) {
+        std::vector<NodeMining*> scans;
+        for (MiningStep& step : pending_steps_) {
+            if (auto* node_mining = std::get_if<NodeMining>(&step)) {
+                scans.push_back(node_mining);
+            }
+        }
+        // FD confidences are computed in advance, even for the FDs that turn out to be pruned
+        pool_->ExecIndex(
+                [this, &scans](size_t i) {
+                    NodeMining& step = *scans[i];
+                    step.fd_confidence = ComputeFDConfidence(*step.inode, step.lhs, step.rhs);
+                    ScanNode(step);
+                    step.scanned = true;
+                },
+                scans.size());
+    }
+
+    for (MiningStep& pending_step : pending_steps_) {
+        std::visit([this](auto& step) { ApplyStep(step); }, pending_step);
+    }
+    pending_steps_.clear();
+    pending_scan_size_ = 0;
 }
 
 std::pair<std::vector<PartitionTIdList const*>, FDFirstAlgorithm::PIdListMiners>
@@ -220,21 +327,14 @@ FDFirstAlgorithm::ExpandMiningFd(MinerNode<PartitionTIdList> const& inode, int i
     return {expands, tmp_suffix};
 }
 
-void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& items,
-                                   Substrategy ss) {
+void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& items) {
     for (int ix = static_cast<int>(items.size()) - 1; ix >= 0; ix--) {
         MinerNode<PartitionTIdList> const& inode = items[ix];
         Itemset const iset = Join(prefix, inode.item);
         auto const insect = ConstructIntersection(iset, inode.candidates);
         for (int out : insect) {
-            Itemset const sub = ConstructSubset(iset, out);
-            MineFD(inode, sub, out);
-
-            if (ss == +Substrategy::dfs) {
-                MinePatternsDFS(sub, out, inode.tids);
-            } else if (ss == +Substrategy::bfs) {
-                MinePatternsBFS(sub, out, inode.tids);
-            }
+            pending_steps_.emplace_back(NodeMining(&inode, ConstructSubset(iset, out), out));
+            pending_scan_size_ += inode.tids.tids.size();
         }
 
         if (inode.candidates.empty()) continue;
@@ -244,27 +344,13 @@ void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& i
 
         auto const [expands, tmp_suffix] = ExpandMiningFd(inode, ix, iset, items);
 
-        auto const exps = PartitionTIdListUtil::ConstructIntersection(items[ix].tids, expands);
+        auto exps = ConstructIntersections(items[ix].tids, expands);
         PIdListMiners suffix;
         for (size_t e = 0; e < exps.size(); e++) {
-            bool gen = true;
-            auto const new_set = Join(tmp_suffix[e].prefix, tmp_suffix[e].item);
+            auto new_set = Join(tmp_suffix[e].prefix, tmp_suffix[e].item);
             auto const sp = std::make_pair(TIdUtil::Support(exps[e]), exps[e].sets_number);
-            auto const free_map_elem = free_map_.find(sp);
-            if (free_map_elem != free_map_.end()) {
-                auto const free_cands = free_map_elem->second;
-                for (auto const& sub_cand : free_cands) {
-                    if (IsSubsetOf(sub_cand, new_set)) {
-                        gen = false;
-                        break;
-                    }
-                }
-            }
-            if (gen) {
-                free_map_[sp].push_back(new_set);
-                free_itemsets_.insert(new_set);
-            }
-            auto new_node = MinerNode<PartitionTIdList>(tmp_suffix[e].item, exps[e]);
+            pending_steps_.emplace_back(FreeSetCheck{std::move(new_set), sp});
+            auto new_node = MinerNode<PartitionTIdList>(tmp_suffix[e].item, std::move(exps[e]));
             new_node.candidates = tmp_suffix[e].candidates;
             new_node.prefix = tmp_suffix[e].prefix;
             suffix.push_back(std::move(new_node));
@@ -273,9 +359,10 @@ void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& i
             std::sort(suffix.begin(), suffix.end(), [](auto const& a, auto const& b) {
                 return a.tids.sets_number < b.tids.sets_number;
             });
-            FdsFirstDFS(iset, suffix, ss);
+            FdsFirstDFS(iset, suffix);
         }
     }
+    ApplyPendingSteps();
 }
 
 void FDFirstAlgorithm::FillMinePatternsVars(PartitionList& partitions, RhsesPair2DList& pair_rhses,
@@ -310,17 +397,19 @@ void FDFirstAlgorithm::FillMinePatternsVars(PartitionList& partitions, RhsesPair
 }
 
 void FDFirstAlgorithm::AddCFDToCFDList(std::vector<int> const& sub, int out,
-                                       MinerNode<SimpleTIdList> const& inode,
+                                       MinerNode<CompressedTIdList> const& inode,
                                        PartitionList const& partitions) {
     bool lhs_gen = true;
 
-    if (rules_.find(out) != rules_.end()) {
-        for (auto const& sub_rule : rules_[out]) {
+    if (auto const rules = rules_.find(out); rules != rules_.end()) {
+        Itemset const sub_pattern = GetPattern(sub);
+        for (auto const& sub_rule : rules->second) {
             if (out < 0 && !std::any_of(sub_rule.begin(), sub_rule.end(),
                                         [](int si) -> bool { return si < 0; }))
                 continue;
-            if (Precedes(sub_rule, sub)) {
+            if (Precedes(sub_rule, sub, sub_pattern)) {
                 lhs_gen = false;
+                break;
             }
         }
     }
@@ -343,7 +432,8 @@ void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const
                                              PartitionList const& partitions,
                                              std::vector<unsigned> const& p_supps,
                                              TIdListMiners& items, Itemset const& lhs) {
-    unsigned p_supp = PartitionUtil::GetPartitionSupport(item.second, p_supps);
+    CompressedTIdList pids(item.second);
+    unsigned p_supp = PartitionUtil::GetPartitionSupport(pids, p_supps);
     if (p_supp < min_supp_) {
         return;
     }
@@ -357,7 +447,7 @@ void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const
     auto const sp = std::make_pair(p_supp, nr_parts.size());
     auto const free_map_pair = free_map_.find(sp);
     if (free_map_pair != free_map_.end()) {
-        auto const free_cands = free_map_pair->second;
+        auto const& free_cands = free_map_pair->second;
         for (auto const& sub_cand : free_cands) {
             if (IsSubsetOf(sub_cand, ns)) {
                 gen = false;
@@ -369,12 +459,12 @@ void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const
         free_map_[sp].push_back(ns);
         free_itemsets_.insert(ns);
     }
-    items.emplace_back(item.first, item.second, p_supp);
+    items.emplace_back(item.first, std::move(pids), p_supp);
 }
 
 bool FDFirstAlgorithm::FillFreeMapAndItemsets(PartitionList const& partitions, Itemset const& lhs,
-                                              Itemset const& new_set, SimpleTIdList const& ij_tids,
-                                              unsigned ij_supp) {
+                                              Itemset const& new_set,
+                                              CompressedTIdList const& ij_tids, unsigned ij_supp) {
     if (ij_supp < min_supp_) {
         return false;
     }
@@ -389,7 +479,7 @@ bool FDFirstAlgorithm::FillFreeMapAndItemsets(PartitionList const& partitions, I
     auto const sp = std::make_pair(ij_supp, nr_parts.size());
     auto const free_map_pair = free_map_.find(sp);
     if (free_map_pair != free_map_.end()) {
-        auto const free_cands = free_map_pair->second;
+        auto const& free_cands = free_map_pair->second;
         for (auto const& sub_cand : free_cands) {
             if (IsSubsetOf(sub_cand, ns)) {
                 gen = false;
@@ -404,14 +494,9 @@ bool FDFirstAlgorithm::FillFreeMapAndItemsets(PartitionList const& partitions, I
     return true;
 }
 
-void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
-                                       PartitionTIdList const& all_tids) {
+void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs, PartitionList& partitions,
+                                       RhsesPair2DList& rhses_pairs) {
     std::map<int, SimpleTIdList> pid_lists;
-    PartitionList partitions;
-    RhsesPair2DList rhses_pairs;
-    RuleIxs rule_ixs;
-    std::vector<int> rhses;
-    FillMinePatternsVars(partitions, rhses_pairs, rule_ixs, rhses, lhs, rhs, all_tids);
     TIdListMiners items;
     std::vector<unsigned> p_supps(partitions.size());
     int ri = 0;
@@ -435,7 +520,8 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
             Itemset iset = inode.prefix;
             iset.push_back(inode.item);
             auto const node_attrs = relation_->GetAttrVectorItems(iset);
-            int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pairs[inode.tids[0]]) : rhs;
+            int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pairs[inode.tids.Front()])
+                                                  : rhs;
             auto const sub = Join(iset, SetDiff(lhs, node_attrs));
 
             if (out > 0 || !PartitionUtil::IsConstRulePartition(inode.tids, rhses_pairs)) {
@@ -450,7 +536,7 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
                 Itemset jset = jnode.prefix;
                 jset.push_back(jnode.item);
                 Itemset new_set = Join(jset, inode.item);
-                SimpleTIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
+                CompressedTIdList ij_tids = inode.tids.Intersection(jnode.tids);
                 unsigned ij_supp = PartitionUtil::GetPartitionSupport(ij_tids, p_supps);
                 bool result = FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp);
                 if (!result) continue;
@@ -463,14 +549,9 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
     }
 }
 
-void FDFirstAlgorithm::MinePatternsDFS(Itemset const& lhs, int rhs,
-                                       PartitionTIdList const& all_tids) {
+void FDFirstAlgorithm::MinePatternsDFS(Itemset const& lhs, int rhs, PartitionList& partitions,
+                                       RhsesPair2DList& rhses_pairs) {
     std::map<int, SimpleTIdList> pid_lists;
-    PartitionList partitions;
-    RhsesPair2DList rhses_pairs;
-    RuleIxs rule_ixs;
-    std::vector<int> rhses;
-    FillMinePatternsVars(partitions, rhses_pairs, rule_ixs, rhses, lhs, rhs, all_tids);
     TIdListMiners items;
     std::vector<unsigned> p_supps(partitions.size());
     int ri = 0;
@@ -495,12 +576,12 @@ void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners& ite
                                        PartitionList& partitions, std::vector<unsigned>& psupps) {
     for (int ix = static_cast<int>(items.size()) - 1; ix >= 0; ix--) {
         auto const& inode = items[ix];
-        if (inode.tids.empty() && items[ix].tids.empty()) {
+        if (inode.tids.Empty() && items[ix].tids.Empty()) {
             LOG(INFO) << ix;
         }
         Itemset const iset = Join(prefix, inode.item);
         auto const node_attrs = relation_->GetAttrVectorItems(iset);
-        int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pair[inode.tids[0]]) : rhs;
+        int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pair[inode.tids.Front()]) : rhs;
         auto const sub = Join(iset, SetDiff(lhs, node_attrs));
 
         if (out > 0 || !PartitionUtil::IsConstRulePartition(inode.tids, rhses_pair)) {
@@ -513,12 +594,12 @@ void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners& ite
                                    -1 - relation_->GetAttrIndex(jnode.item)))
                 continue;
             Itemset const new_set = Join(iset, jnode.item);
-            SimpleTIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
+            CompressedTIdList ij_tids = inode.tids.Intersection(jnode.tids);
             unsigned ij_supp = PartitionUtil::GetPartitionSupport(ij_tids, psupps);
 
             bool result = FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp);
             if (!result) continue;
-            suffix.emplace_back(jnode.item, ij_tids, ij_supp);
+            suffix.emplace_back(jnode.item, std::move(ij_tids), ij_supp);
         }
         if (!suffix.empty()) {
             std::sort(suffix.begin(), suffix.end(), [](auto const& a, auto const& b) {
@@ -532,20 +613,22 @@ void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners& ite
 // This method is used to get all partition singletons using MinerNode<PartitionTidList>
 FDFirstAlgorithm::PIdListMiners FDFirstAlgorithm::GetPartitionSingletons() {
     std::vector<std::vector<std::vector<unsigned>>> partitions(relation_->GetAttrsNumber());
-    std::unordered_map<int, std::pair<int, int>> attr_indices;
+    // Items are numbered from 1, attr_indices[item - 1] is the attribute of the item and the
+    // index of the item in the attribute domain
+    std::vector<std::pair<unsigned, unsigned>> attr_indices(relation_->GetItemsNumber());
 
     for (size_t a = 0; a < relation_->GetAttrsNumber(); a++) {
         auto const& dom = relation_->GetDomain(a);
         partitions[a] = std::vector<std::vector<unsigned>>(dom.size());
         for (unsigned i = 0; i < dom.size(); i++) {
             partitions[a][i].reserve(relation_->Frequency(dom[i]));
-            attr_indices[dom[i]] = std::make_pair(a, i);
+            attr_indices[dom[i] - 1] = std::make_pair(a, i);
         }
     }
     for (size_t row = 0; row < relation_->Size(); row++) {
         auto const& tup = relation_->GetRow(row);
         for (int item : tup) {
-            auto const& attr_node_ix = attr_indices.at(item);
+            auto const& attr_node_ix = attr_indices[item - 1];
             partitions[attr_node_ix.first][attr_node_ix.second].push_back(row);
         }
     }
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
+
+#include "algorithms/cfd/model/compressed_tidlist.h"
 #include "algorithms/cfd/model/partition_tidlist.h"
 #include "algorithms/cfd/util/prefix_tree.h"
 #include "cfd_discovery.h"
+#include "config/thread_number/type.h"
 #include "enums.h"
 #include "miner_node.h"
+#include "util/worker_thread_pool.h"
 
 // see algorithms/cfd/LICENSE
 
@@ -12,7 +20,32 @@ namespace algos::cfd {
 
 class FDFirstAlgorithm : public algos::cfd::CFDDiscovery {
     using PIdListMiners = std::vector<MinerNode<PartitionTIdList>>;
-    using TIdListMiners = std::vector<MinerNode<SimpleTIdList>>;
+    using TIdListMiners = std::vector<MinerNode<CompressedTIdList>>;
+
+    // Mining of lhs -> rhs of a node of the FD lattice. The scan of the node partition does not
+    // depend on previously discovered CFDs, its results are kept until the step is applied.
+    struct NodeMining {
+        NodeMining(MinerNode<PartitionTIdList> const *inode, Itemset lhs, int rhs)
+            : inode(inode), lhs(std::move(lhs)), rhs(rhs) {}
+
+        MinerNode<PartitionTIdList> const *inode;
+        Itemset lhs;
+        int rhs;
+
+        // Set when the partition was scanned in advance
+        bool scanned = false;
+        std::optional<double> fd_confidence;
+        PartitionList partitions;
+        RhsesPair2DList rhses_pairs;
+    };
+
+    // Registration of a newly built node of the FD lattice as a free itemset
+    struct FreeSetCheck {
+        Itemset new_set;
+        std::pair<int, unsigned> support_and_sets;
+    };
+
+    using MiningStep = std::variant<NodeMining, FreeSetCheck>;
 
 private:
     unsigned min_supp_;
@@ -20,6 +53,8 @@ private:
     unsigned max_lhs_;
     double min_conf_;
     Substrategy substrategy_ = Substrategy::dfs;
+    config::ThreadNumType threads_num_ = 1;
+    std::unique_ptr<util::WorkerThreadPool> pool_;
 
     std::map<Itemset, PartitionTIdList> store_;
     PrefixTree<Itemset, Itemset> cand_store_;
@@ -27,23 +62,38 @@ private:
     std::map<std::pair<int, int>, std::vector<Itemset>> free_map_;
     std::set<Itemset> free_itemsets_;
     std::unordered_map<int, std::vector<Itemset>> rules_;
+    // The lattice traversal does not depend on the discovered CFDs, so mining steps are recorded
+    // as the traversal goes and applied in the same order later. Partitions of the pending steps
+    // are scanned in parallel.
+    std::vector<MiningStep> pending_steps_;
+    size_t pending_scan_size_ = 0;
 
     void ResetStateCFD() final;
     void CheckForIncorrectInput() const;
 
     void FdsFirstDFS();
-    void FdsFirstDFS(Itemset const &, std::vector<MinerNode<PartitionTIdList>> const &,
-                     Substrategy = Substrategy::dfs);
-    void MinePatternsBFS(Itemset const &lhs, int rhs, PartitionTIdList const &all_tids);
-    void MinePatternsDFS(Itemset const &lhs, int rhs, PartitionTIdList const &all_tids);
-    void MinePatternsDFS(Itemset const &, std::vector<MinerNode<SimpleTIdList>> &, Itemset const &,
+    void FdsFirstDFS(Itemset const &, std::vector<MinerNode<PartitionTIdList>> const &);
+    void ApplyPendingSteps();
+    void ScanNode(NodeMining &step) const;
+    void ApplyStep(NodeMining &step);
+    void ApplyStep(FreeSetCheck const &step);
+    std::vector<PartitionTIdList> ConstructIntersections(
+            PartitionTIdList const &lhs, std::vector<PartitionTIdList const *> const &rhses) const;
+    void MinePatternsBFS(Itemset const &lhs, int rhs, PartitionList &partitions,
+                         RhsesPair2DList &rhses_pairs);
+    void MinePatternsDFS(Itemset const &lhs, int rhs, PartitionList &partitions,
+                         RhsesPair2DList &rhses_pairs);
+    void MinePatternsDFS(Itemset const &, TIdListMiners &, Itemset const &,
                          int, RhsesPair2DList &, PartitionList &, std::vector<unsigned> &);
     std::vector<MinerNode<PartitionTIdList>> GetPartitionSingletons();
 
-    bool Precedes(Itemset const &a, Itemset const &b);
-    bool IsConstRule(PartitionTIdList const &items, int rhs_a);
+    Itemset GetPattern(Itemset const &items) const;
+    bool Precedes(Itemset const &a, Itemset const &b, Itemset const &b_pattern) const;
+    bool IsConstRule(PartitionTIdList const &items, int rhs_a) const;
 
-    void MineFD(MinerNode<PartitionTIdList> const &inode, Itemset const &lhs, int rhs);
+    std::optional<double> ComputeFDConfidence(MinerNode<PartitionTIdList> const &inode,
+                                              Itemset const &lhs, int rhs) const;
+    void MineFD(NodeMining const &step);
     std::pair<std::vector<PartitionTIdList const *>, std::vector<MinerNode<PartitionTIdList>>>
     ExpandMiningFd(MinerNode<PartitionTIdList> const &inode, int ix, Itemset const &iset,
                    std::vector<MinerNode<PartitionTIdList>> const &items) const;
@@ -52,16 +102,21 @@ private:
                               Itemset const &, int, PartitionTIdList const &) const;
 
     void AddCFDToCFDList(std::vector<int> const &sub, int out,
-                         MinerNode<SimpleTIdList> const &inode, PartitionList const &partitions);
+                         MinerNode<CompressedTIdList> const &inode,
+                         PartitionList const &partitions);
 
     void AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const &, PartitionList const &,
                                std::vector<unsigned> const &,
-                               std::vector<MinerNode<SimpleTIdList>> &, Itemset const &);
+                               TIdListMiners &, Itemset const &);
 
     bool FillFreeMapAndItemsets(PartitionList const &partitions, Itemset const &lhs,
-                                Itemset const &new_set, SimpleTIdList const &ij_tids, unsigned);
+                                Itemset const &new_set, CompressedTIdList const &ij_tids, unsigned);
 
 protected:
+    // Below these numbers of tids partitions are processed on one thread
+    size_t min_parallel_intersection_size_ = 1 << 16;
+    size_t min_parallel_scan_size_ = 1 << 16;
+
     void RegisterOptions();
     void MakeExecuteOptsAvailable() override;
     unsigned long long ExecuteInternal() final;
@@ -17,28 +17,32 @@ size_t CFDRelationData::GetNumRows() const {
     return data_rows_.size();
 }
 
+Item CFDRelationData::GetOrAddItem(ItemDictionary& item_dictionary,
+                                   ColumnesValuesDict& columns_values_dict,
+                                   std::vector<ItemInfo>& items, std::string& value,
+                                   AttributeIndex attr, int& unique_elems_number) {
+    // The value is moved into the dictionary only if it is not there yet
+    auto [it, inserted] = item_dictionary[attr].try_emplace(std::move(value), unique_elems_number);
+    if (inserted) {
+        items.emplace_back(it->first, attr);
+        columns_values_dict[attr].push_back(unique_elems_number++);
+    }
+    items[it->second - 1].frequency++;
+    return it->second;
+}
+
 void CFDRelationData::AddNewItemsInFullTable(ItemDictionary& item_dictionary,
                                              ColumnesValuesDict& columns_values_dict,
                                              std::vector<ItemInfo>& items,
-                                             std::vector<std::string> const& string_row,
-                                             std::vector<int>& int_row,
+                                             std::vector<std::string>& string_row,
                                              std::vector<Transaction>& data_rows,
                                              int& unique_elems_number, unsigned num_columns) {
-    int it;
+    Transaction int_row(num_columns);
     for (size_t i = 0; i < num_columns; i++) {
-        auto ptr = item_dictionary.find(std::make_pair(i, string_row[i]));
-        if (ptr != item_dictionary.end()) {
-            it = ptr->second;
-        } else {
-            items.emplace_back(string_row[i], i);
-            columns_values_dict[static_cast<AttributeIndex>(i)].push_back(unique_elems_number);
-            item_dictionary[std::make_pair(i, string_row[i])] = unique_elems_number;
-            it = unique_elems_number++;
-        }
-        int_row[i] = it;
-        items[it - 1].frequency++;
+        int_row[i] = GetOrAddItem(item_dictionary, columns_values_dict, items, string_row[i],
+                                  static_cast<AttributeIndex>(i), unique_elems_number);
     }
-    data_rows.push_back(int_row);
+    data_rows.push_back(std::move(int_row));
 }
 
 std::unique_ptr<CFDRelationData> CFDRelationData::CreateFrom(model::IDatasetStream& parser,
@@ -60,16 +64,11 @@ std::unique_ptr<CFDRelationData> CFDRelationData::CreateFrom(model::IDatasetStre
     unsigned num_columns = parser.GetNumberOfColumns();
     std::vector<std::string> line;
     num_columns = std::min(num_columns, columns_number);
-    std::vector<std::string> string_row(num_columns);
+    item_dictionary.resize(num_columns);
     while (parser.HasNextRow() && data_rows.size() < tuples_number) {
         line = parser.GetNextRow();
-        std::vector<int> int_row(num_columns);
-        for (size_t k = 0; k < num_columns; k++) {
-            string_row[k] = line[k];
-        }
-
-        AddNewItemsInFullTable(item_dictionary, columns_values_dict, items, string_row, int_row,
-                               data_rows, unique_elems_number, num_columns);
+        AddNewItemsInFullTable(item_dictionary, columns_values_dict, items, line, data_rows,
+                               unique_elems_number, num_columns);
     }
 
     std::vector<CFDColumnData> column_data;
@@ -88,32 +87,22 @@ std::unique_ptr<CFDRelationData> CFDRelationData::CreateFrom(model::IDatasetStre
 void CFDRelationData::AddNewItemsInPartialTable(ItemDictionary& item_dictionary,
                                                 ColumnesValuesDict& columns_values_dict,
                                                 std::vector<ItemInfo>& items,
-                                                std::vector<std::string> const& string_row,
+                                                std::vector<std::string>& string_row,
                                                 std::vector<int> const& columns_numbers_list,
                                                 std::vector<Transaction>& data_rows,
                                                 int& unique_elems_number, int size) {
-    std::vector<int> int_row(size);
+    Transaction int_row(size);
     AttributeIndex j = 0;
-    int it;
     for (size_t i = 0; i < string_row.size(); i++) {
         if (!std::binary_search(columns_numbers_list.begin(), columns_numbers_list.end(), i)) {
             continue;
         }
-        auto ptr = item_dictionary.find(std::make_pair(j, string_row[i]));
-        if (ptr != item_dictionary.end()) {
-            it = ptr->second;
-        } else {
-            items.emplace_back(string_row[i], j);
-            columns_values_dict[j].push_back(unique_elems_number);
-            item_dictionary[std::make_pair(j, string_row[i])] = unique_elems_number;
-            it = unique_elems_number++;
-        }
-        items[it - 1].frequency++;
-        int_row[j] = it;
+        int_row[j] = GetOrAddItem(item_dictionary, columns_values_dict, items, string_row[i], j,
+                                  unique_elems_number);
         j++;
     }
     if (j > 0) {
-        data_rows.push_back(int_row);
+        data_rows.push_back(std::move(int_row));
     }
 }
 
@@ -137,6 +126,7 @@ std::unique_ptr<CFDRelationData> CFDRelationData::CreateFrom(model::IDatasetStre
     columns_numbers_list =
             std::vector<int>(columns_numbers_list.begin(), columns_numbers_list.begin() + size);
     std::sort(columns_numbers_list.begin(), columns_numbers_list.end());
+    item_dictionary.resize(size);
     while (file_input.HasNextRow()) {
         if (uni(rng) >= r_sample) {
             continue;
@@ -208,7 +198,7 @@ int CFDRelationData::GetAttr(std::string const& s) const {
 }
 
 int CFDRelationData::GetItem(int attr, std::string const& str_value) const {
-    return item_dictionary_.at(std::make_pair(attr, str_value));
+    return item_dictionary_.at(attr).at(str_value);
 }
 
 void CFDRelationData::Sort() {
@@ -1,10 +1,10 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
+#include <unordered_map>
 #include <utility>
-
-#include <boost/functional/hash.hpp>
-#include <boost/unordered_map.hpp>
+#include <vector>
 
 #include "cfd_column_data.h"
 #include "cfd_types.h"
@@ -18,7 +18,9 @@ namespace algos::cfd {
 // Data presentation class that CFDDiscovery uses.
 class CFDRelationData : public AbstractRelationData<CFDColumnData> {
 private:
-    using ItemDictionary = boost::unordered_map<std::pair<int, std::string>, int, PairHash>;
+    // For every attribute, maps a value string to the corresponding item id. Lookups take the
+    // cell string as is, the string is stored once per distinct value.
+    using ItemDictionary = std::vector<std::unordered_map<std::string, Item>>;
     using ColumnesValuesDict = std::unordered_map<AttributeIndex, std::vector<int>>;
 
     // ItemInfo contains info about one elem in the table.
@@ -35,19 +37,19 @@ private:
 
     // array of data represented as rows of integers
     std::vector<Transaction> data_rows_;
-    // maps a value string for the given attribute index to corresponding item id
-    boost::unordered_map<std::pair<int, std::string>, int, PairHash> item_dictionary_;
+    ItemDictionary item_dictionary_;
     std::vector<ItemInfo> items_;
 
     static void AddNewItemsInFullTable(ItemDictionary &, ColumnesValuesDict &,
-                                       std::vector<ItemInfo> &, std::vector<std::string> const &,
-                                       std::vector<int> &, std::vector<Transaction> &, int &,
-                                       unsigned);
+                                       std::vector<ItemInfo> &, std::vector<std::string> &,
+                                       std::vector<Transaction> &, int &, unsigned);
 
     static void AddNewItemsInPartialTable(ItemDictionary &, ColumnesValuesDict &,
-                                          std::vector<ItemInfo> &, std::vector<std::string> const &,
+                                          std::vector<ItemInfo> &, std::vector<std::string> &,
                                           std::vector<int> const &, std::vector<Transaction> &,
                                           int &, int);
+    static Item GetOrAddItem(ItemDictionary &, ColumnesValuesDict &, std::vector<ItemInfo> &,
+                             std::string &, AttributeIndex, int &);
 
 public:
     unsigned Size() const;
@@ -80,8 +82,7 @@ public:
 
     CFDRelationData(std::unique_ptr<RelationalSchema> schema,
                     std::vector<CFDColumnData> column_data, std::vector<Transaction> data,
-                    boost::unordered_map<std::pair<int, std::string>, int, PairHash> item_dict,
-                    std::vector<ItemInfo> items)
+                    ItemDictionary item_dict, std::vector<ItemInfo> items)
         : AbstractRelationData(std::move(schema), std::move(column_data)),
           data_rows_(std::move(data)),
           item_dictionary_(std::move(item_dict)),
@@ -30,7 +30,6 @@ using Itemset = std::vector<Item>;
 
 // the set of tids of tuples (indexes of rows in a table) that support concrete Item.
 using SimpleTIdList = std::vector<Item>;
-using PairHash = boost::hash<std::pair<int, std::string>>;
 
 // Representation of CFD of the form left items -> right item
 using ItemsetCFD = std::pair<Itemset, Item>;
@@ -0,0 +1,229 @@
+#include "compressed_tidlist.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <utility>
+
+#if defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+namespace algos::cfd {
+
+namespace {
+
+using Array = std::vector<std::uint16_t>;
+using Bitmap = std::vector<std::uint64_t>;
+
+// First position in [from, a.size()) with a[pos] >= value, found by doubling the step
+std::size_t Gallop(Array const& a, std::size_t from, std::uint16_t value) {
+    std::size_t step = 1;
+    std::size_t lo = from;
+    std::size_t hi = from;
+    while (hi < a.size() && a[hi] < value) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+    }
+    hi = std::min(hi, a.size());
+    return std::lower_bound(a.begin() + lo, a.begin() + hi, value) - a.begin();
+}
+
+void IntersectGalloping(Array const& small, Array const& large, Array& out) {
+    std::size_t j = 0;
+    for (std::uint16_t value : small) {
+        j = Gallop(large, j, value);
+        if (j == large.size()) return;
+        if (large[j] == value) out.push_back(value);
+    }
+}
+
+void IntersectMerge(Array const& a, Array const& b, std::size_t i, std::size_t j, Array& out) {
+    while (i < a.size() && j < b.size()) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            out.push_back(a[i]);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+void IntersectArrays(Array const& a, Array const& b, Array& out) {
+    // Galloping pays off when one array is much shorter than the other
+    constexpr std::size_t kGallopRatio = 32;
+    if (a.size() * kGallopRatio < b.size()) {
+        IntersectGalloping(a, b, out);
+        return;
+    }
+    if (b.size() * kGallopRatio < a.size()) {
+        IntersectGalloping(b, a, out);
+        return;
+    }
+    out.reserve(std::min(a.size(), b.size()));
+    std::size_t i = 0;
+    std::size_t j = 0;
+#if defined(__SSE4_2__)
+    // Compare every element of an 8-element block of a with every element of a block of b
+    constexpr std::size_t kBlock = 8;
+    constexpr int kMode = _SIDD_UWORD_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+    while (i + kBlock <= a.size() && j + kBlock <= b.size()) {
+        __m128i const v_a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a.data() + i));
+        __m128i const v_b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b.data() + j));
+        auto mask = static_cast<unsigned>(
+                _mm_cvtsi128_si32(_mm_cmpestrm(v_b, kBlock, v_a, kBlock, kMode)));
+        while (mask != 0) {
+            out.push_back(a[i + std::countr_zero(mask)]);
+            mask &= mask - 1;
+        }
+        std::uint16_t const a_max = a[i + kBlock - 1];
+        std::uint16_t const b_max = b[j + kBlock - 1];
+        if (a_max <= b_max) i += kBlock;
+        if (b_max <= a_max) j += kBlock;
+    }
+    // Elements of a block that were already output are less than every element left in the other
+    // array, so the merge below skips them
+#endif
+    IntersectMerge(a, b, i, j, out);
+}
+
+void IntersectArrayBitmap(Array const& a, Bitmap const& b, Array& out) {
+    for (std::uint16_t value : a) {
+        if ((b[value / 64] >> (value % 64)) & 1) out.push_back(value);
+    }
+}
+
+Array BitmapToArray(Bitmap const& bitmap, std::size_t size) {
+    Array array;
+    array.reserve(size);
+    for (std::size_t word = 0; word < bitmap.size(); ++word) {
+        std::uint64_t bits = bitmap[word];
+        while (bits != 0) {
+            array.push_back(static_cast<std::uint16_t>(word * 64 + std::countr_zero(bits)));
+            bits &= bits - 1;
+        }
+    }
+    return array;
+}
+
+}  // namespace
+
+CompressedTIdList::Iterator::Iterator(std::vector<Chunk> const* chunks, std::size_t chunk)
+    : chunks_(chunks), chunk_(chunk) {
+    SkipToSetBit();
+}
+
+void CompressedTIdList::Iterator::SkipToSetBit() {
+    if (chunk_ == chunks_->size()) return;
+    Chunk const& chunk = (*chunks_)[chunk_];
+    if (!chunk.IsBitmap()) return;
+    while (pos_ < kChunkSize) {
+        std::uint64_t const bits = chunk.bitmap[pos_ / 64] >> (pos_ % 64);
+        if (bits != 0) {
+            pos_ += std::countr_zero(bits);
+            return;
+        }
+        pos_ = (pos_ / 64 + 1) * 64;
+    }
+}
+
+int CompressedTIdList::Iterator::operator*() const {
+    Chunk const& chunk = (*chunks_)[chunk_];
+    std::size_t const low = chunk.IsBitmap() ? pos_ : chunk.array[pos_];
+    return static_cast<int>((std::size_t{chunk.key} << kChunkBits) | low);
+}
+
+CompressedTIdList::Iterator& CompressedTIdList::Iterator::operator++() {
+    Chunk const& chunk = (*chunks_)[chunk_];
+    ++pos_;
+    if (chunk.IsBitmap()) {
+        SkipToSetBit();
+        if (pos_ < kChunkSize) return *this;
+    } else if (pos_ < chunk.array.size()) {
+        return *this;
+    }
+    ++chunk_;
+    pos_ = 0;
+    SkipToSetBit();
+    return *this;
+}
+
+void CompressedTIdList::AddChunk(Chunk chunk) {
+    if (chunk.size == 0) return;
+    if (chunk.IsBitmap() && chunk.size <= kMaxArraySize) {
+        chunk.array = BitmapToArray(chunk.bitmap, chunk.size);
+        chunk.bitmap.clear();
+    } else if (!chunk.IsBitmap() && chunk.size > kMaxArraySize) {
+        chunk.bitmap.assign(kBitmapWords, 0);
+        for (std::uint16_t value : chunk.array) {
+            chunk.bitmap[value / 64] |= std::uint64_t{1} << (value % 64);
+        }
+        chunk.array.clear();
+    }
+    size_ += chunk.size;
+    chunks_.push_back(std::move(chunk));
+}
+
+CompressedTIdList::CompressedTIdList(SimpleTIdList const& tids) {
+    assert(std::is_sorted(tids.begin(), tids.end()));
+    auto it = tids.begin();
+    while (it != tids.end()) {
+        auto const key = static_cast<std::uint32_t>(*it) >> kChunkBits;
+        auto const chunk_end = std::find_if(it, tids.end(), [key](int tid) {
+            return (static_cast<std::uint32_t>(tid) >> kChunkBits) != key;
+        });
+        Chunk chunk{key, static_cast<std::uint32_t>(chunk_end - it), {}, {}};
+        chunk.array.reserve(chunk.size);
+        for (; it != chunk_end; ++it) {
+            chunk.array.push_back(static_cast<std::uint16_t>(*it));
+        }
+        AddChunk(std::move(chunk));
+    }
+}
+
+SimpleTIdList CompressedTIdList::ToVector() const {
+    return {begin(), end()};
+}
+
+CompressedTIdList CompressedTIdList::Intersection(CompressedTIdList const& other) const {
+    CompressedTIdList result;
+    auto lhs = chunks_.begin();
+    auto rhs = other.chunks_.begin();
+    while (lhs != chunks_.end() && rhs != other.chunks_.end()) {
+        if (lhs->key < rhs->key) {
+            ++lhs;
+            continue;
+        }
+        if (rhs->key < lhs->key) {
+            ++rhs;
+            continue;
+        }
+        Chunk chunk{lhs->key, 0, {}, {}};
+        if (lhs->IsBitmap() && rhs->IsBitmap()) {
+            chunk.bitmap.resize(kBitmapWords);
+            for (std::size_t word = 0; word < kBitmapWords; ++word) {
+                chunk.bitmap[word] = lhs->bitmap[word] & rhs->bitmap[word];
+                chunk.size += std::popcount(chunk.bitmap[word]);
+            }
+        } else {
+            if (lhs->IsBitmap()) {
+                IntersectArrayBitmap(rhs->array, lhs->bitmap, chunk.array);
+            } else if (rhs->IsBitmap()) {
+                IntersectArrayBitmap(lhs->array, rhs->bitmap, chunk.array);
+            } else {
+                IntersectArrays(lhs->array, rhs->array, chunk.array);
+            }
+            chunk.size = chunk.array.size();
+        }
+        result.AddChunk(std::move(chunk));
+        ++lhs;
+        ++rhs;
+    }
+    return result;
+}
+
+}  // namespace algos::cfd
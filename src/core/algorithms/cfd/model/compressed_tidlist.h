@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "algorithms/cfd/model/cfd_types.h"
+
+namespace algos::cfd {
+
+// Sorted set of tids in the Roaring layout. Tids are split into chunks of 2^16 by their high
+// bits. A chunk with few tids keeps their low bits in a sorted array, a dense chunk keeps a bitmap
+// of them. Intersections of arrays compare blocks of 8 tids with SSE4.2 when it is available,
+// intersections with bitmaps are done a word or a bit test at a time.
+class CompressedTIdList {
+public:
+    static constexpr unsigned kChunkBits = 16;
+    static constexpr std::size_t kChunkSize = std::size_t{1} << kChunkBits;
+    static constexpr std::size_t kBitmapWords = kChunkSize / 64;
+    // A bitmap takes as much memory as an array of that many tids
+    static constexpr std::size_t kMaxArraySize = 4096;
+
+private:
+    struct Chunk {
+        std::uint32_t key;
+        std::uint32_t size;
+        // Sorted low bits of the tids if size <= kMaxArraySize, empty otherwise
+        std::vector<std::uint16_t> array;
+        // kBitmapWords words if size > kMaxArraySize, empty otherwise
+        std::vector<std::uint64_t> bitmap;
+
+        bool IsBitmap() const noexcept {
+            return !bitmap.empty();
+        }
+
+        bool operator==(Chunk const&) const = default;
+    };
+
+    std::vector<Chunk> chunks_;
+    std::size_t size_ = 0;
+
+    void AddChunk(Chunk chunk);
+
+public:
+    class Iterator {
+    private:
+        std::vector<Chunk> const* chunks_ = nullptr;
+        std::size_t chunk_ = 0;
+        // Index in the array or the bit of the bitmap
+        std::size_t pos_ = 0;
+
+        // Moves a bitmap chunk position to the next set bit or to kChunkSize if there is none
+        void SkipToSetBit();
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = int const*;
+        using reference = int;
+
+        Iterator() = default;
+        Iterator(std::vector<Chunk> const* chunks, std::size_t chunk);
+
+        int operator*() const;
+        Iterator& operator++();
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(Iterator const& other) const noexcept {
+            return chunk_ == other.chunk_ && pos_ == other.pos_;
+        }
+    };
+
+    CompressedTIdList() = default;
+    // tids must be sorted and distinct
+    explicit CompressedTIdList(SimpleTIdList const& tids);
+
+    std::size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    int Front() const {
+        return *begin();
+    }
+
+    Iterator begin() const {
+        return {&chunks_, 0};
+    }
+
+    Iterator end() const {
+        return {&chunks_, chunks_.size()};
+    }
+
+    SimpleTIdList ToVector() const;
+
+    CompressedTIdList Intersection(CompressedTIdList const& other) const;
+
+    bool operator==(CompressedTIdList const&) const = default;
+};
+
+}  // namespace algos::cfd
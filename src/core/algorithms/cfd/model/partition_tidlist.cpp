@@ -1,7 +1,30 @@
 #include "partition_tidlist.h"
 
+#include <algorithm>
+
 namespace algos::cfd {
 
+namespace {
+// Values indexed by tid, so that partitions are intersected and compared by array lookups instead
+// of hashing every tid. All the entries are zero between the calls: only the entries of the tids
+// that were set are cleared afterwards, which keeps the cost proportional to the partition sizes.
+thread_local std::vector<unsigned> tid_values;
+
+void Reserve(std::vector<unsigned>& values, int tid) {
+    if (static_cast<size_t>(tid) >= values.size()) {
+        values.resize(tid + 1, 0);
+    }
+}
+
+void Clear(std::vector<unsigned>& values, SimpleTIdList const& tids) {
+    for (int tid : tids) {
+        if (tid != PartitionTIdList::kSep) {
+            values[tid] = 0;
+        }
+    }
+}
+}  // namespace
+
 int const PartitionTIdList::kSep = -1;
 
 bool PartitionTIdList::operator==(PartitionTIdList const& b) const {
@@ -26,76 +49,98 @@ SimpleTIdList PartitionTIdList::Convert() const {
 }
 
 PartitionTIdList PartitionTIdList::Intersection(PartitionTIdList const& rhs) const {
-    std::unordered_map<int, int> eq_indices;
-    eq_indices.reserve(this->tids.size() + 1 - this->sets_number);
-    std::vector<std::vector<int> > eq_classes(this->sets_number);
-
-    int eix = 0;
-    int count = 0;
-    for (unsigned ix = 0; ix <= this->tids.size(); ix++) {
-        count++;
-        if (ix == this->tids.size() || this->tids[ix] == PartitionTIdList::kSep) {
-            eq_classes[eix].reserve(count);
-            count = 0;
+    return Intersections({&rhs}).front();
+}
+
+std::vector<PartitionTIdList> PartitionTIdList::Intersections(
+        std::vector<PartitionTIdList const*> const& rhses) const {
+    // Index of the equivalence class of every tid of this partition, plus one
+    std::vector<unsigned>& eq_indices = tid_values;
+    unsigned eix = 0;
+    for (int tid : tids) {
+        if (tid == kSep) {
             eix++;
         } else {
-            eq_indices[this->tids[ix]] = eix + 1;
+            Reserve(eq_indices, tid);
+            eq_indices[tid] = eix + 1;
         }
     }
-    PartitionTIdList res;
-    res.sets_number = 0;
-    for (unsigned ix = 0; ix <= rhs.tids.size(); ix++) {
-        if (ix == rhs.tids.size() || rhs.tids[ix] == PartitionTIdList::kSep) {
-            for (auto& eqcl : eq_classes) {
-                if (!eqcl.empty()) {
-                    res.tids.insert(res.tids.end(), eqcl.begin(), eqcl.end());
-                    res.tids.push_back(PartitionTIdList::kSep);
-                    res.sets_number++;
-                    eqcl.clear();
-                }
+    std::vector<std::vector<int>> eq_classes(tids.empty() ? 0 : eix + 1);
+    // Classes of this partition that the current class of rhs intersects
+    std::vector<unsigned> touched;
+
+    std::vector<PartitionTIdList> res;
+    res.reserve(rhses.size());
+    for (PartitionTIdList const* rhs : rhses) {
+        PartitionTIdList p_tid_list;
+        p_tid_list.tids.reserve(tids.size());
+        auto flush = [&]() {
+            std::sort(touched.begin(), touched.end());
+            for (unsigned eq_index : touched) {
+                auto& eqcl = eq_classes[eq_index];
+                p_tid_list.tids.insert(p_tid_list.tids.end(), eqcl.begin(), eqcl.end());
+                p_tid_list.tids.push_back(kSep);
+                p_tid_list.sets_number++;
+                eqcl.clear();
             }
-        } else {
-            int const jt = rhs.tids[ix];
-            if (eq_indices[jt]) {
-                eq_classes[eq_indices[jt] - 1].push_back(jt);
+            touched.clear();
+        };
+        for (int jt : rhs->tids) {
+            if (jt == kSep) {
+                flush();
+                continue;
+            }
+            if (static_cast<size_t>(jt) >= eq_indices.size() || eq_indices[jt] == 0) continue;
+            unsigned const eq_index = eq_indices[jt] - 1;
+            if (eq_classes[eq_index].empty()) {
+                touched.push_back(eq_index);
             }
+            eq_classes[eq_index].push_back(jt);
         }
+        flush();
+        if (!p_tid_list.tids.empty()) {
+            p_tid_list.tids.pop_back();
+        }
+        res.push_back(std::move(p_tid_list));
     }
-    if (!res.tids.empty() && res.tids.back() == PartitionTIdList::kSep) {
-        res.tids.pop_back();
-    }
+
+    Clear(eq_indices, tids);
     return res;
 }
 
 int PartitionTIdList::PartitionError(PartitionTIdList const& xa) const {
-    int e = 0;
-
-    std::map<int, int> bigt;
-    int count = 0;
+    // Sizes of the classes of xa, stored at the last tid of every class
+    std::vector<unsigned>& class_sizes = tid_values;
+    unsigned count = 0;
     for (unsigned pi = 0; pi <= xa.tids.size(); pi++) {
-        if (pi == xa.tids.size() || xa.tids[pi] == PartitionTIdList::kSep) {
-            bigt[xa.tids[pi - 1]] = count;
+        if (pi == xa.tids.size() || xa.tids[pi] == kSep) {
+            if (count != 0) {
+                Reserve(class_sizes, xa.tids[pi - 1]);
+                class_sizes[xa.tids[pi - 1]] = count;
+            }
             count = 0;
         } else {
             count++;
         }
     }
 
-    count = 0;
-    int m = 0;
-    for (unsigned cix = 0; cix <= this->tids.size(); cix++) {
-        if (cix == this->tids.size() || this->tids[cix] == PartitionTIdList::kSep) {
+    int e = 0;
+    unsigned m = 0;
+    for (unsigned cix = 0; cix <= tids.size(); cix++) {
+        if (cix == tids.size() || tids[cix] == kSep) {
             e += count - m;
             m = 0;
             count = 0;
         } else {
             count++;
-            int t = this->tids[cix];
-            if (bigt.count(t) && bigt[t] > m) {
-                m = bigt[t];
+            auto const t = static_cast<size_t>(tids[cix]);
+            if (t < class_sizes.size() && class_sizes[t] > m) {
+                m = class_sizes[t];
             }
         }
     }
+
+    Clear(class_sizes, xa.tids);
     return e;
 }
 }  // namespace algos::cfd
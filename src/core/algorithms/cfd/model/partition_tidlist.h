@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "cfd_types.h"
 
 namespace algos::cfd {
@@ -25,6 +27,10 @@ struct PartitionTIdList {
     SimpleTIdList Convert() const;
 
     PartitionTIdList Intersection(PartitionTIdList const &rhs) const;
+    // Intersections with every partition of rhses. Equivalence classes of a result come in the
+    // order of the classes of rhs, each split in the order of the classes of this partition.
+    std::vector<PartitionTIdList> Intersections(
+            std::vector<PartitionTIdList const *> const &rhses) const;
 
     int PartitionError(PartitionTIdList const &) const;
 };
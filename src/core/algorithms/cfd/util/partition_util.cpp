@@ -6,7 +6,7 @@
 
 namespace algos::cfd {
 
-unsigned PartitionUtil::GetPartitionSupport(SimpleTIdList const& pids,
+unsigned PartitionUtil::GetPartitionSupport(CompressedTIdList const& pids,
                                             std::vector<unsigned> const& psupps) {
     unsigned res = 0;
     for (int p : pids) {
@@ -15,7 +15,7 @@ unsigned PartitionUtil::GetPartitionSupport(SimpleTIdList const& pids,
     return res;
 }
 
-unsigned PartitionUtil::GetPartitionError(SimpleTIdList const& pids,
+unsigned PartitionUtil::GetPartitionError(CompressedTIdList const& pids,
                                           PartitionList const& partitions) {
     unsigned res = 0;
     for (int p : pids) {
@@ -28,7 +28,8 @@ unsigned PartitionUtil::GetPartitionError(SimpleTIdList const& pids,
     return res;
 }
 
-bool PartitionUtil::IsConstRulePartition(SimpleTIdList const& items, RhsesPair2DList const& rhses) {
+bool PartitionUtil::IsConstRulePartition(CompressedTIdList const& items,
+                                         RhsesPair2DList const& rhses) {
     int rhs_value;
     bool first = true;
     for (int pi : items) {
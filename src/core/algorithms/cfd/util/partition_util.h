@@ -1,6 +1,7 @@
 #pragma once
 
 #include "algorithms/cfd/model/cfd_types.h"
+#include "algorithms/cfd/model/compressed_tidlist.h"
 
 // see algorithms/cfd/LICENSE
 
@@ -8,9 +9,11 @@ namespace algos::cfd {
 
 class PartitionUtil {
 public:
-    static bool IsConstRulePartition(SimpleTIdList const& items, RhsesPair2DList const& rhses);
-    static unsigned GetPartitionSupport(SimpleTIdList const& pids,
+    static bool IsConstRulePartition(CompressedTIdList const& items,
+                                     RhsesPair2DList const& rhses);
+    static unsigned GetPartitionSupport(CompressedTIdList const& pids,
                                         std::vector<unsigned> const& partitions);
-    static unsigned GetPartitionError(SimpleTIdList const& pids, PartitionList const& partitions);
+    static unsigned GetPartitionError(CompressedTIdList const& pids,
+                                      PartitionList const& partitions);
 };
 }  // namespace algos::cfd
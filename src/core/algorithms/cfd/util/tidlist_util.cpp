@@ -22,4 +22,8 @@ unsigned TIdUtil::Hash(SimpleTIdList const& tids) {
 int TIdUtil::Support(SimpleTIdList const& tids) {
     return tids.size();
 }
+
+int TIdUtil::Support(CompressedTIdList const& tids) {
+    return tids.Size();
+}
 }  // namespace algos::cfd
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "algorithms/cfd/model/cfd_types.h"
+#include "algorithms/cfd/model/compressed_tidlist.h"
 #include "algorithms/cfd/model/partition_tidlist.h"
 
 // see algorithms/cfd/LICENSE
@@ -13,5 +14,6 @@ public:
     static unsigned Hash(PartitionTIdList const& tids);
     static int Support(SimpleTIdList const& tids);
     static unsigned Hash(SimpleTIdList const& tids);
+    static int Support(CompressedTIdList const& tids);
 };
 }  // namespace algos::cfd
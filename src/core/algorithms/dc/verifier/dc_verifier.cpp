@@ -23,7 +23,7 @@
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
 #include "model/table/column_index.h"
-#include "model/table/column_layout_relation_data.h"
+#include "model/table/relation_session.h"
 #include "table/typed_column_data.h"
 #include "util/get_preallocated_vector.h"
 #include "util/kdtree.h"
@@ -54,9 +54,7 @@ void DCVerifier::MakeExecuteOptsAvailable() {
 }
 
 void DCVerifier::LoadDataInternal() {
-    data_ = model::CreateTypedColumnData(*input_table_, true);
-    input_table_->Reset();
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, true);
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, true);
 }
 
 unsigned long long int DCVerifier::ExecuteInternal() {
@@ -69,7 +67,7 @@ unsigned long long int DCVerifier::ExecuteInternal() {
         return 0;
     }
 
-    bool has_header = !relation_->GetSchema()->GetColumns().front().get()->GetName().empty();
+    bool has_header = !typed_relation_->GetSchema()->GetColumns().front().get()->GetName().empty();
     index_offset_ = 1 + static_cast<size_t>(has_header);
     result_ = Verify(dc);
 
@@ -157,7 +155,7 @@ bool DCVerifier::VerifyMixed(dc::DC const& dc) {
     util::KDTree<Point> s_tree, t_tree;
     bool res = true;
     std::vector<mo::ColumnIndex> all_cols = dc.GetColumnIndices();
-    for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
+    for (size_t i = 0; i < typed_relation_->GetNumRows(); ++i) {
         if (ContainsNullOrEmpty(all_cols, i)) continue;
 
         ProcessMixed(s_predicates, s_tree, t_tree, mixed_dc, i, all_cols, res);
@@ -191,7 +189,7 @@ void DCVerifier::ProcessMixed(std::vector<dc::Predicate> const& preds, Tree& ins
 
 bool DCVerifier::VerifyOneTuple(dc::DC const& dc) {
     std::vector<mo::ColumnIndex> all_cols = dc.GetColumnIndices();
-    for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
+    for (size_t i = 0; i < typed_relation_->GetNumRows(); ++i) {
         if (ContainsNullOrEmpty(all_cols, i)) continue;
         std::vector<std::byte const*> row = GetRow(i);
         if (Eval(row, dc.GetPredicates())) return false;
@@ -209,7 +207,7 @@ bool DCVerifier::VerifyTwoTuples(dc::DC const& dc) {
 
     std::vector<Point> points;
     std::unordered_map<Point, util::KDTree<Point>, Point::Hasher> hash;
-    for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
+    for (size_t i = 0; i < typed_relation_->GetNumRows(); ++i) {
         if (ContainsNullOrEmpty(all_cols, i)) continue;
 
         std::vector<std::byte const*> row = GetRow(i);
@@ -230,7 +228,7 @@ bool DCVerifier::VerifyTwoTuples(dc::DC const& dc) {
 bool DCVerifier::VerifyAllEquality(dc::DC const& dc) {
     std::vector<mo::ColumnIndex> eq_cols = dc.GetColumnIndices();
     std::unordered_set<Point, Point::Hasher> res_tuples;
-    for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
+    for (size_t i = 0; i < typed_relation_->GetNumRows(); ++i) {
         if (ContainsNullOrEmpty(eq_cols, i)) continue;
         std::vector<std::byte const*> row = GetRow(i);
         Point point = MakePoint(row, eq_cols);
@@ -251,15 +249,15 @@ bool DCVerifier::VerifyOneInequality(dc::DC const& dc) {
 
     mo::ColumnIndex ind_a = ineq_pred.GetLeftOperand().GetColumn()->GetIndex();
     mo::ColumnIndex ind_b = ineq_pred.GetRightOperand().GetColumn()->GetIndex();
-    mo::Type const& type_a = data_[ind_a].GetType();
-    mo::Type const& type_b = data_[ind_b].GetType();
+    mo::Type const& type_a = GetColumnData()[ind_a].GetType();
+    mo::Type const& type_b = GetColumnData()[ind_b].GetType();
 
     std::vector<mo::ColumnIndex> const eq_cols = dc.GetColumnIndicesWithOperator(
             [](dc::Operator op) { return op.GetType() == dc::OperatorType::kEqual; });
     std::unordered_map<Point, dc::Component, Point::Hasher> min_a, min_b, max_a, max_b;
     std::vector<mo::ColumnIndex> all_cols = dc.GetColumnIndices();
 
-    for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
+    for (size_t i = 0; i < typed_relation_->GetNumRows(); ++i) {
         if (ContainsNullOrEmpty(all_cols, i)) continue;
 
         auto min_comp = dc::Component(nullptr, &type_a, dc::ValType::kPlusInf);
@@ -298,9 +296,9 @@ bool DCVerifier::VerifyOneInequality(dc::DC const& dc) {
 }
 
 std::vector<std::byte const*> DCVerifier::GetRow(size_t row) {
-    auto res = std::vector<std::byte const*>(data_.size());
+    auto res = std::vector<std::byte const*>(GetColumnData().size());
     auto get_val = [row](auto const& col) { return col.GetValue(row); };
-    std::transform(data_.begin(), data_.end(), res.begin(), get_val);
+    std::transform(GetColumnData().begin(), GetColumnData().end(), res.begin(), get_val);
 
     return res;
 }
@@ -385,8 +383,8 @@ std::pair<util::Rect<Point>, util::Rect<Point>> DCVerifier::SearchRanges(
         while (ineq_cols[left_ind] != left) left_ind++;
         while (ineq_cols[right_ind] != right) right_ind++;
 
-        auto right_comp = dc::Component(row[right], &data_[right].GetType());
-        auto left_comp = dc::Component(row[left], &data_[left].GetType());
+        auto right_comp = dc::Component(row[right], &GetColumnData()[right].GetType());
+        auto left_comp = dc::Component(row[left], &GetColumnData()[left].GetType());
 
         if (op_type == dc::OperatorType::kLessEqual or op_type == dc::OperatorType::kLess) {
             upper_bound[left_ind] = std::min(upper_bound[left_ind], right_comp);
@@ -457,8 +455,8 @@ std::vector<dc::Predicate> DCVerifier::SplitDC(std::string const& dc_string) {
             boost::trim(predicate_parts[i]);
         }
 
-        auto left_op = dc::ColumnOperand(predicate_parts.front(), *relation_->GetSchema());
-        auto right_op = dc::ColumnOperand(predicate_parts[2], *relation_->GetSchema());
+        auto left_op = dc::ColumnOperand(predicate_parts.front(), *typed_relation_->GetSchema());
+        auto right_op = dc::ColumnOperand(predicate_parts[2], *typed_relation_->GetSchema());
         auto oper = dc::Operator(predicate_parts[1]);
         predicates.emplace_back(oper, left_op, right_op);
 
@@ -473,8 +471,8 @@ bool DCVerifier::Eval(std::vector<std::byte const*> tuple, std::vector<dc::Predi
     for (auto const& pred : preds) {
         size_t left_ind = pred.GetLeftOperand().GetColumn()->GetIndex();
         size_t right_ind = pred.GetRightOperand().GetColumn()->GetIndex();
-        auto left = dc::Component(tuple[left_ind], &data_[left_ind].GetType());
-        auto right = dc::Component(tuple[right_ind], &data_[right_ind].GetType());
+        auto left = dc::Component(tuple[left_ind], &GetColumnData()[left_ind].GetType());
+        auto right = dc::Component(tuple[right_ind], &GetColumnData()[right_ind].GetType());
         if (!dc::Component::Eval(left, right, pred.GetOperator())) return false;
     }
 
@@ -486,7 +484,7 @@ Point DCVerifier::MakePoint(std::vector<std::byte const*> const& vec,
                             dc::ValType val_type /* = kFinite */) {
     std::vector<dc::Component> pt;
     for (auto ind : indices) {
-        mo::Type const& type = data_[ind].GetType();
+        mo::Type const& type = GetColumnData()[ind].GetType();
         pt.emplace_back(vec[ind], &type, val_type);
     }
 
@@ -495,7 +493,9 @@ Point DCVerifier::MakePoint(std::vector<std::byte const*> const& vec,
 
 bool DCVerifier::ContainsNullOrEmpty(std::vector<mo::ColumnIndex> const& indices,
                                      size_t tuple_ind) const {
-    auto l = [this, tuple_ind](mo::ColumnIndex ind) { return data_[ind].IsNullOrEmpty(tuple_ind); };
+    auto l = [this, tuple_ind](mo::ColumnIndex ind) {
+        return GetColumnData()[ind].IsNullOrEmpty(tuple_ind);
+    };
     return std::any_of(indices.begin(), indices.end(), l);
 }
 
@@ -13,7 +13,7 @@
 #include "algorithms/dc/model/point.h"
 #include "config/tabular_data/input_table/option.h"
 #include "config/tabular_data/input_table_type.h"
-#include "model/table/column_layout_relation_data.h"
+#include "model/table/column_layout_typed_relation_data.h"
 #include "table/typed_column_data.h"
 #include "util/kdtree.h"
 
@@ -21,8 +21,7 @@ namespace algos {
 
 class DCVerifier final : public Algorithm {
 private:
-    std::unique_ptr<ColumnLayoutRelationData> relation_;
-    std::vector<model::TypedColumnData> data_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
     config::InputTable input_table_;
     std::string dc_string_;
     size_t index_offset_;
@@ -30,6 +29,10 @@ private:
 
     void RegisterOptions();
 
+    std::vector<model::TypedColumnData> const& GetColumnData() const {
+        return typed_relation_->GetColumnData();
+    }
+
     void MakeExecuteOptsAvailable();
 
     bool Verify(dc::DC const& dc);
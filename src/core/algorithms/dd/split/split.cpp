@@ -1,13 +1,18 @@
 #include "algorithms/dd/split/split.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
-#include <deque>
+#include <cstdint>
+#include <iterator>
 #include <limits>
 #include <list>
+#include <map>
+#include <memory>
+#include <numeric>
 #include <regex>
-#include <set>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
@@ -16,12 +21,27 @@
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
 #include "model/table/column_index.h"
+#include "model/table/relation_session.h"
 #include "model/types/numeric_type.h"
 #include "util/levenshtein_distance.h"
 
 namespace algos::dd {
 
+namespace {
+
+constexpr std::size_t kWordBits = 64;
+// Distances are calculated for blocks of whole bitmap words, so threads never write to the same
+// word.
+constexpr std::size_t kBlockWords = 256;
+
+std::size_t GetNumWords(std::size_t num_pairs) {
+    return (num_pairs + kWordBits - 1) / kWordBits;
+}
+
+}  // namespace
+
 Split::Split() : Algorithm({}) {
     RegisterOptions();
     MakeOptionsAvailable({config::kTableOpt.GetName()});
@@ -36,20 +56,20 @@ void Split::RegisterOptions() {
     RegisterOption(Option{&difference_table_, kDifferenceTable, kDDifferenceTable, default_table});
     RegisterOption(Option{&num_rows_, kNumRows, kDNumRows, 0U});
     RegisterOption(Option{&num_columns_, kNumColumns, kDNUmColumns, 0U});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void Split::MakeExecuteOptsAvailable() {
     using namespace config::names;
 
-    MakeOptionsAvailable({kDifferenceTable, kNumRows, kNumColumns});
+    MakeOptionsAvailable(
+            {kDifferenceTable, kNumRows, kNumColumns, config::kThreadNumberOpt.GetName()});
 }
 
 void Split::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, false);  // nulls are
-                                                                             // ignored
+    relation_ = model::GetSharedRelation(*input_table_, false);  // nulls are ignored
     input_table_->Reset();
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_,
-                                                                       false);  // nulls are ignored
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, false);  // nulls are ignored
 }
 
 void Split::SetLimits() {
@@ -222,7 +242,7 @@ unsigned Split::RemoveTransitiveDDs() {
 }
 
 double Split::CalculateDistance(model::ColumnIndex column_index,
-                                std::pair<std::size_t, std::size_t> tuple_pair) {
+                                std::pair<std::size_t, std::size_t> tuple_pair) const {
     model::TypedColumnData const& column = typed_relation_->GetColumnData(column_index);
     model::TypeId type_id = column.GetTypeId();
 
@@ -250,121 +270,70 @@ double Split::CalculateDistance(model::ColumnIndex column_index,
     return dif;
 }
 
-// must be inline for optimization (gcc 11.4.0)
-inline bool Split::CheckDF(DF const& dif_func, std::pair<std::size_t, std::size_t> tuple_pair) {
+Split::DFBitmaps Split::GetBitmaps(DF const& dif_func) const {
+    DFBitmaps bitmaps;
     for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
-        double const dif = distances_[column_index][tuple_pair.first][tuple_pair.second];
-        if (dif < dif_func[column_index].lower_bound || dif > dif_func[column_index].upper_bound) {
-            return false;
+        if (dif_func[column_index] == min_max_dif_[column_index]) continue;
+        std::vector<ConstraintPairs> const& constraints = column_constraints_[column_index];
+        auto it = std::find_if(constraints.begin(), constraints.end(),
+                               [&dif_func, column_index](ConstraintPairs const& constraint) {
+                                   return constraint.constraint == dif_func[column_index];
+                               });
+        if (it == constraints.end()) {
+            throw std::logic_error("DF constraint is not among the constraints of its column");
         }
+        bitmaps.push_back(it->pairs.data());
     }
-    return true;
+    return bitmaps;
 }
 
-bool Split::VerifyDD(DD const& dep) {
-    for (std::size_t i = 0; i < num_rows_; i++) {
-        for (std::size_t j = i + 1; j < num_rows_; j++) {
-            if (CheckDF(dep.lhs, {i, j}) && !CheckDF(dep.rhs, {i, j})) return false;
-        }
+// Returns the bits of the pairs of the word that satisfy the DF
+// must be inline for optimization (gcc 11.4.0)
+inline std::uint64_t Split::CheckDF(DFBitmaps const& dif_func, std::size_t word) const {
+    std::uint64_t pairs = ~std::uint64_t{0};
+    if (std::size_t const rest = num_pairs_ - word * kWordBits; rest < kWordBits) {
+        pairs >>= kWordBits - rest;
     }
-    return true;
-}
-
-void Split::InsertDistance(model::ColumnIndex column_index, std::size_t first_index,
-                           std::size_t second_index, double& min_dif, double& max_dif) {
-    if (first_index < second_index) {
-        double const dif = CalculateDistance(column_index, {first_index, second_index});
-        max_dif = std::max(max_dif, dif);
-        min_dif = std::min(min_dif, dif);
-        distances_[column_index][first_index][second_index] = dif;
-    } else if (first_index == second_index) {
-        distances_[column_index][first_index][second_index] = 0;
-    } else {
-        distances_[column_index][first_index][second_index] =
-                distances_[column_index][second_index][first_index];
+    for (std::uint64_t const* bitmap : dif_func) {
+        pairs &= bitmap[word];
     }
+    return pairs;
 }
 
-void Split::CalculateAllDistances() {
-    distances_ = std::vector<std::vector<std::vector<double>>>(
-            num_columns_,
-            std::vector<std::vector<double>>(num_rows_, std::vector<double>(num_rows_, 0)));
-    min_max_dif_ = std::vector<model::DFConstraint>(num_columns_, {0, 0});
-
-    for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
-        std::shared_ptr<model::PLI const> pli =
-                relation_->GetColumnData(column_index).GetPliOwnership();
-        std::deque<model::PLI::Cluster> const& index = pli->GetIndex();
-        std::shared_ptr<std::vector<int> const> probing_table = pli->CalculateAndGetProbingTable();
-        model::PLI::Cluster const& pt = *probing_table.get();
-
-        double max_dif = 0, min_dif = std::numeric_limits<double>::max();
-        for (std::size_t i = 0; i < index.size(); i++) {
-            for (std::size_t j = 0; j < index.size(); j++) {
-                std::size_t const first_index = index[i][0];
-                std::size_t const second_index = index[j][0];
-                if (first_index < num_rows_ && second_index < num_rows_) {
-                    InsertDistance(column_index, first_index, second_index, min_dif, max_dif);
-                }
-            }
-        }
-        for (std::size_t i = 0; i < num_rows_; i++) {
-            for (std::size_t j = 0; j < num_rows_; j++) {
-                if (pt[i] != 0 && pt[j] != 0) {
-                    distances_[column_index][i][j] =
-                            distances_[column_index][index[pt[i] - 1][0]][index[pt[j] - 1][0]];
-                    if (i != j && pt[i] == pt[j]) {
-                        min_dif = 0;
-                    }
-                } else {
-                    InsertDistance(column_index, i, j, min_dif, max_dif);
-                }
-            }
-        }
-        min_max_dif_[column_index] = {min_dif, max_dif};
+bool Split::VerifyDD(DD const& dep) const {
+    DFBitmaps const lhs = GetBitmaps(dep.lhs);
+    DFBitmaps const rhs = GetBitmaps(dep.rhs);
+    std::size_t const num_words = GetNumWords(num_pairs_);
+    for (std::size_t word = 0; word < num_words; word++) {
+        if (CheckDF(lhs, word) & ~CheckDF(rhs, word)) return false;
     }
+    return true;
 }
 
-bool Split::IsFeasible(DF const& d) {
-    for (std::size_t i = 0; i < num_rows_; i++) {
-        for (std::size_t j = i + 1; j < num_rows_; j++) {
-            if (CheckDF(d, {i, j})) return true;
+Split::TuplePairs Split::SelectViolatingPairs(TuplePairs const& tuple_pairs,
+                                              DD const& dep) const {
+    DFBitmaps const lhs = GetBitmaps(dep.lhs);
+    DFBitmaps const rhs = GetBitmaps(dep.rhs);
+    TuplePairs violating_pairs;
+    for (std::size_t i = 0; i < tuple_pairs.words.size(); i++) {
+        std::size_t const word = tuple_pairs.word_indices[i];
+        std::uint64_t const pairs =
+                tuple_pairs.words[i] & CheckDF(lhs, word) & ~CheckDF(rhs, word);
+        if (pairs != 0) {
+            violating_pairs.word_indices.push_back(word);
+            violating_pairs.words.push_back(pairs);
         }
     }
-    return false;
+    return violating_pairs;
 }
 
-std::vector<DF> Split::SearchSpace(model::ColumnIndex index) {
-    std::vector<DF> dfs;
-    DF d = min_max_dif_;
-    dfs.push_back(d);
-
-    if (!has_dif_table_) {
-        // differential functions should be put in this exact order for further reducing
-        for (int i = num_dfs_per_column_ - 1; i >= 0; i--) {
-            if (i >= min_max_dif_[index].lower_bound && i < min_max_dif_[index].upper_bound) {
-                d[index] = {min_max_dif_[index].lower_bound, (double)i};
-                dfs.push_back(d);
-            }
-        }
-        return dfs;
-    }
-
+std::vector<model::DFConstraint> Split::ParseDifferenceIntervals(model::ColumnIndex index) const {
     std::size_t dif_num_rows = difference_typed_relation_->GetNumRows();
 
     model::TypedColumnData const& dif_column = difference_typed_relation_->GetColumnData(index);
     model::Type const& type = dif_column.GetType();
 
-    auto pair_compare = [](model::DFConstraint const& first_pair,
-                           model::DFConstraint const& second_pair) {
-        double const first_pair_length = first_pair.upper_bound - first_pair.lower_bound;
-        double const second_pair_length = second_pair.upper_bound - second_pair.lower_bound;
-        return (first_pair_length > second_pair_length) ||
-               (first_pair_length == second_pair_length &&
-                (first_pair.lower_bound > second_pair.lower_bound));
-    };
-
-    std::set<model::DFConstraint, decltype(pair_compare)> limits(pair_compare);
+    std::vector<model::DFConstraint> intervals;
 
     // accepts a string in the following format: [a;b], where a and b are double type values
     std::regex df_regex(R"(\[(\d{1,19}(\.\d*)?)\;(\d{1,19}(\.\d*)?)\]$)");
@@ -390,23 +359,168 @@ std::vector<DF> Split::SearchSpace(model::ColumnIndex index) {
             if (std::regex_match(df_str, matches, df_regex)) {
                 double const lower_limit = model::TypeConverter<double>::kConvert(matches[1].str());
                 double const upper_limit = model::TypeConverter<double>::kConvert(matches[3].str());
+                if (lower_limit <= upper_limit) intervals.push_back({lower_limit, upper_limit});
+            }
+        }
+    }
 
-                if (upper_limit >= min_max_dif_[index].lower_bound &&
-                    lower_limit <= min_max_dif_[index].upper_bound && lower_limit <= upper_limit) {
-                    model::DFConstraint intersect = {
-                            std::max(lower_limit, min_max_dif_[index].lower_bound),
-                            std::min(upper_limit, min_max_dif_[index].upper_bound)};
-                    if (intersect != min_max_dif_[index]) {
-                        limits.insert(intersect);
-                    }
+    auto interval_less = [](model::DFConstraint const& first, model::DFConstraint const& second) {
+        return std::make_pair(first.lower_bound, first.upper_bound) <
+               std::make_pair(second.lower_bound, second.upper_bound);
+    };
+    std::sort(intervals.begin(), intervals.end(), interval_less);
+    intervals.erase(std::unique(intervals.begin(), intervals.end()), intervals.end());
+    return intervals;
+}
+
+model::DFConstraint Split::CalculateDistances(model::ColumnIndex column_index,
+                                              std::vector<model::DFConstraint> const& intervals,
+                                              std::vector<std::size_t> const& row_starts,
+                                              std::vector<PairBitmap>& bitmaps,
+                                              util::WorkerThreadPool* pool) const {
+    std::vector<int> const& probing_table =
+            relation_->GetColumnData(column_index).GetProbingTable();
+    std::size_t const num_words = GetNumWords(num_pairs_);
+    std::size_t const num_blocks = (num_words + kBlockWords - 1) / kBlockWords;
+    bitmaps.assign(intervals.size(), PairBitmap(num_words, 0));
+    std::vector<model::DFConstraint> block_min_max(num_blocks);
+
+    auto calculate_block = [&](std::size_t block) {
+        std::size_t pair = block * kBlockWords * kWordBits;
+        std::size_t const end = std::min(num_pairs_, pair + kBlockWords * kWordBits);
+        auto const next_row = std::upper_bound(row_starts.begin(), row_starts.end(), pair);
+        std::size_t first_index = std::distance(row_starts.begin(), next_row) - 1;
+        std::size_t second_index = first_index + 1 + (pair - row_starts[first_index]);
+        double max_dif = 0, min_dif = std::numeric_limits<double>::max();
+        for (; pair != end; pair++) {
+            double dif = 0;
+            // rows from the same cluster hold equal values
+            if (probing_table[first_index] == model::PLI::kSingletonValueId ||
+                probing_table[first_index] != probing_table[second_index]) {
+                dif = CalculateDistance(column_index, {first_index, second_index});
+                max_dif = std::max(max_dif, dif);
+            }
+            min_dif = std::min(min_dif, dif);
+            std::uint64_t const bit = std::uint64_t{1} << (pair % kWordBits);
+            for (std::size_t i = 0; i < intervals.size(); i++) {
+                if (intervals[i].lower_bound <= dif && dif <= intervals[i].upper_bound) {
+                    bitmaps[i][pair / kWordBits] |= bit;
                 }
             }
+            if (++second_index == num_rows_) {
+                first_index++;
+                second_index = first_index + 1;
+            }
+        }
+        block_min_max[block] = {min_dif, max_dif};
+    };
+    if (pool != nullptr) {
+        pool->ExecIndex(calculate_block, num_blocks);
+    } else {
+        for (std::size_t block = 0; block < num_blocks; block++) calculate_block(block);
+    }
+
+    model::DFConstraint min_max = {std::numeric_limits<double>::max(), 0};
+    for (auto const& [min_dif, max_dif] : block_min_max) {
+        min_max.lower_bound = std::min(min_max.lower_bound, min_dif);
+        min_max.upper_bound = std::max(min_max.upper_bound, max_dif);
+    }
+    return min_max;
+}
+
+// Every distance lies within the column range, so the pairs inside an interval are the pairs
+// inside its intersection with the range. Only the intersections make it into the search space.
+void Split::SelectColumnConstraints(model::ColumnIndex column_index,
+                                    std::vector<model::DFConstraint> const& intervals,
+                                    std::vector<PairBitmap>& bitmaps) {
+    model::DFConstraint const& min_max = min_max_dif_[column_index];
+    std::vector<ConstraintPairs>& constraints = column_constraints_[column_index];
+
+    if (!has_dif_table_) {
+        for (std::size_t i = 0; i < intervals.size(); i++) {
+            double const upper_limit = intervals[i].upper_bound;
+            if (upper_limit >= min_max.lower_bound && upper_limit < min_max.upper_bound) {
+                constraints.push_back({{min_max.lower_bound, upper_limit}, std::move(bitmaps[i])});
+            }
+        }
+        return;
+    }
+
+    auto pair_compare = [](model::DFConstraint const& first_pair,
+                           model::DFConstraint const& second_pair) {
+        double const first_pair_length = first_pair.upper_bound - first_pair.lower_bound;
+        double const second_pair_length = second_pair.upper_bound - second_pair.lower_bound;
+        return (first_pair_length > second_pair_length) ||
+               (first_pair_length == second_pair_length &&
+                (first_pair.lower_bound > second_pair.lower_bound));
+    };
+
+    std::map<model::DFConstraint, std::size_t, decltype(pair_compare)> limits(pair_compare);
+    for (std::size_t i = 0; i < intervals.size(); i++) {
+        auto const [lower_limit, upper_limit] = intervals[i];
+        if (upper_limit >= min_max.lower_bound && lower_limit <= min_max.upper_bound) {
+            model::DFConstraint intersect = {std::max(lower_limit, min_max.lower_bound),
+                                             std::min(upper_limit, min_max.upper_bound)};
+            if (intersect != min_max) {
+                limits.emplace(intersect, i);
+            }
+        }
+    }
+    for (auto const& [limit, i] : limits) {
+        constraints.push_back({limit, std::move(bitmaps[i])});
+    }
+}
+
+void Split::CalculateAllDistances() {
+    num_pairs_ = num_rows_ < 2 ? 0 : std::size_t{num_rows_} * (num_rows_ - 1) / 2;
+    // index of the first pair (i, i + 1) of each row i
+    std::vector<std::size_t> row_starts(num_rows_, 0);
+    for (std::size_t i = 1; i < num_rows_; i++) {
+        row_starts[i] = row_starts[i - 1] + num_rows_ - i;
+    }
+    min_max_dif_ = std::vector<model::DFConstraint>(num_columns_, {0, 0});
+    column_constraints_ = std::vector<std::vector<ConstraintPairs>>(num_columns_);
+
+    std::unique_ptr<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool = std::make_unique<util::WorkerThreadPool>(threads_num_);
+    }
+
+    // without a difference table, differential functions bound distances from above by
+    // 0, 1, ..., num_dfs_per_column_ - 1
+    std::vector<model::DFConstraint> intervals;
+    if (!has_dif_table_) {
+        for (int i = num_dfs_per_column_ - 1; i >= 0; i--) {
+            intervals.push_back({std::numeric_limits<double>::lowest(), (double)i});
         }
     }
 
+    for (model::ColumnIndex column_index = 0; column_index < num_columns_; column_index++) {
+        if (has_dif_table_) intervals = ParseDifferenceIntervals(column_index);
+        std::vector<PairBitmap> bitmaps;
+        min_max_dif_[column_index] =
+                CalculateDistances(column_index, intervals, row_starts, bitmaps, pool.get());
+        SelectColumnConstraints(column_index, intervals, bitmaps);
+    }
+}
+
+bool Split::IsFeasible(DF const& d) const {
+    DFBitmaps const bitmaps = GetBitmaps(d);
+    std::size_t const num_words = GetNumWords(num_pairs_);
+    for (std::size_t word = 0; word < num_words; word++) {
+        if (CheckDF(bitmaps, word) != 0) return true;
+    }
+    return false;
+}
+
+std::vector<DF> Split::SearchSpace(model::ColumnIndex index) {
+    std::vector<DF> dfs;
+    DF d = min_max_dif_;
+    dfs.push_back(d);
+
     // differential functions should be put in this exact order for further reducing
-    for (auto limit : limits) {
-        d[index] = limit;
+    for (ConstraintPairs const& column_constraint : column_constraints_[index]) {
+        d[index] = column_constraint.constraint;
         dfs.push_back(d);
     }
     return dfs;
@@ -580,22 +694,19 @@ std::list<DD> Split::HybridPruningReduce(DF const& rhs, std::vector<DF> const& s
     return dds;
 }
 
-std::list<DD> Split::InstanceExclusionReduce(
-        std::vector<std::pair<std::size_t, std::size_t>> const& tuple_pairs,
-        std::vector<DF> const& search, DF const& rhs, unsigned& cnt) {
+std::list<DD> Split::InstanceExclusionReduce(TuplePairs const& tuple_pairs,
+                                             std::vector<DF> const& search, DF const& rhs,
+                                             unsigned& cnt) {
     if (!search.size()) return {};
 
     std::list<DD> dds;
     DF const first_df = *search.begin();
     DF const last_df = *search.rbegin();
-    std::vector<std::pair<std::size_t, std::size_t>> remaining_tuple_pairs;
 
     cnt++;
-    for (auto pair : tuple_pairs) {
-        if (CheckDF(first_df, pair) && !CheckDF(rhs, pair)) remaining_tuple_pairs.push_back(pair);
-    }
+    TuplePairs const remaining_tuple_pairs = SelectViolatingPairs(tuple_pairs, {first_df, rhs});
 
-    if (!remaining_tuple_pairs.size()) {
+    if (remaining_tuple_pairs.words.empty()) {
         dds.push_back({first_df, rhs});
         std::vector<DF> remainder = DoPositivePruning(search, first_df);
         std::list<DD> remaining_dds = InstanceExclusionReduce(tuple_pairs, remainder, rhs, cnt);
@@ -603,15 +714,8 @@ std::list<DD> Split::InstanceExclusionReduce(
         return dds;
     }
 
-    std::vector<std::pair<std::size_t, std::size_t>> other_remaining_tuple_pairs;
-
     cnt++;
-    for (auto pair : tuple_pairs) {
-        if (CheckDF(last_df, pair) && !CheckDF(rhs, pair))
-            other_remaining_tuple_pairs.push_back(pair);
-    }
-
-    if (other_remaining_tuple_pairs.size()) {
+    if (!SelectViolatingPairs(tuple_pairs, {last_df, rhs}).words.empty()) {
         std::vector<DF> remainder = DoNegativePruning(search, last_df);
         return InstanceExclusionReduce(tuple_pairs, remainder, rhs, cnt);
     }
@@ -629,10 +733,13 @@ std::list<DD> Split::InstanceExclusionReduce(
 }
 
 void Split::CalculateTuplePairs() {
-    for (std::size_t i = 0; i < num_rows_; i++) {
-        for (std::size_t j = i + 1; j < num_rows_; j++) {
-            tuple_pairs_.push_back({i, j});
-        }
+    std::size_t const num_words = GetNumWords(num_pairs_);
+    tuple_pairs_.word_indices.resize(num_words);
+    std::iota(tuple_pairs_.word_indices.begin(), tuple_pairs_.word_indices.end(), 0);
+    tuple_pairs_.words.resize(num_words);
+    for (std::size_t word = 0; word < num_words; word++) {
+        // all pairs satisfy the DF without constraints
+        tuple_pairs_.words[word] = CheckDF({}, word);
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <list>
 #include <memory>
@@ -10,10 +11,12 @@
 #include "algorithms/algorithm.h"
 #include "algorithms/dd/dd.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "enums.h"
 #include "model/table/column_index.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/column_layout_typed_relation_data.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos::dd {
 
@@ -22,6 +25,25 @@ using DD = model::DD;
 
 class Split : public Algorithm {
 private:
+    /* Bitmap over the pairs (i, j), i < j, of the first num_rows_ rows. The pairs are numbered
+     * in lexicographic order. */
+    using PairBitmap = std::vector<std::uint64_t>;
+
+    /* A constraint of the search space on one column and the tuple pairs that satisfy it */
+    struct ConstraintPairs {
+        model::DFConstraint constraint;
+        PairBitmap pairs;
+    };
+
+    /* Bitmaps of the constraints of a DF that are narrower than the column range */
+    using DFBitmaps = std::vector<std::uint64_t const*>;
+
+    /* A set of tuple pairs, only the non-zero words of its bitmap are stored */
+    struct TuplePairs {
+        std::vector<std::size_t> word_indices;
+        std::vector<std::uint64_t> words;
+    };
+
     config::InputTable input_table_;
 
     std::shared_ptr<ColumnLayoutRelationData> relation_;
@@ -36,10 +58,13 @@ private:
 
     Reduce const reduce_method_ = Reduce::IEHybrid;  // currently, the fastest method
     unsigned const num_dfs_per_column_ = 5;
+    config::ThreadNumType threads_num_;
 
+    std::size_t num_pairs_ = 0;
     std::vector<model::DFConstraint> min_max_dif_;
-    std::vector<std::vector<std::vector<double>>> distances_;
-    std::vector<std::pair<std::size_t, std::size_t>> tuple_pairs_;
+    /* for each column, its constraints in the order they are put into the search space */
+    std::vector<std::vector<ConstraintPairs>> column_constraints_;
+    TuplePairs tuple_pairs_;
     std::list<DD> dd_collection_;
 
     void RegisterOptions();
@@ -51,13 +76,22 @@ private:
     }
 
     double CalculateDistance(model::ColumnIndex column_index,
-                             std::pair<std::size_t, std::size_t> tuple_pair);
-    void InsertDistance(model::ColumnIndex column_index, std::size_t first_index,
-                        std::size_t second_index, double& min_dif, double& max_dif);
-    bool CheckDF(DF const& dep, std::pair<std::size_t, std::size_t> tuple_pair);
-    bool VerifyDD(DD const& dep);
+                             std::pair<std::size_t, std::size_t> tuple_pair) const;
+    std::vector<model::DFConstraint> ParseDifferenceIntervals(model::ColumnIndex index) const;
+    model::DFConstraint CalculateDistances(model::ColumnIndex column_index,
+                                           std::vector<model::DFConstraint> const& intervals,
+                                           std::vector<std::size_t> const& row_starts,
+                                           std::vector<PairBitmap>& bitmaps,
+                                           util::WorkerThreadPool* pool) const;
+    void SelectColumnConstraints(model::ColumnIndex column_index,
+                                 std::vector<model::DFConstraint> const& intervals,
+                                 std::vector<PairBitmap>& bitmaps);
+    DFBitmaps GetBitmaps(DF const& dif_func) const;
+    std::uint64_t CheckDF(DFBitmaps const& dif_func, std::size_t word) const;
+    TuplePairs SelectViolatingPairs(TuplePairs const& tuple_pairs, DD const& dep) const;
+    bool VerifyDD(DD const& dep) const;
     void CalculateAllDistances();
-    bool IsFeasible(DF const& d);
+    bool IsFeasible(DF const& d) const;
     std::vector<DF> SearchSpace(std::vector<model::ColumnIndex>& indices);
     std::vector<DF> SearchSpace(model::ColumnIndex index);
     bool Subsume(DF const& df1, DF const& df2);
@@ -72,9 +106,9 @@ private:
     std::list<DD> NegativePruningReduce(DF const& rhs, std::vector<DF> const& search,
                                         unsigned& cnt);
     std::list<DD> HybridPruningReduce(DF const& rhs, std::vector<DF> const& search, unsigned& cnt);
-    std::list<DD> InstanceExclusionReduce(
-            std::vector<std::pair<std::size_t, std::size_t>> const& tuple_pairs,
-            std::vector<DF> const& search, DF const& rhs, unsigned& cnt);
+    std::list<DD> InstanceExclusionReduce(TuplePairs const& tuple_pairs,
+                                          std::vector<DF> const& search, DF const& rhs,
+                                          unsigned& cnt);
     void CalculateTuplePairs();
     unsigned ReduceDDs(auto const& start_time);
     unsigned RemoveRedundantDDs();
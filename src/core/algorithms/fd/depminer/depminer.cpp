@@ -6,6 +6,7 @@
 
 #include <easylogging++.h>
 
+#include "config/thread_number/option.h"
 #include "model/table/agree_set_factory.h"
 #include "model/table/relational_schema.h"
 
@@ -13,7 +14,23 @@ namespace algos {
 
 Depminer::Depminer(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : PliBasedFDAlgorithm({"AgreeSets generation", "Finding CMAXSets", "Finding LHS"},
-                          relation_manager) {}
+                          relation_manager) {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void Depminer::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+template <typename Func>
+void Depminer::ForEachColumn(Func func) {
+    std::size_t const num_columns = schema_->GetNumColumns();
+    if (pool_ != nullptr) {
+        pool_->ExecIndex(func, num_columns);
+    } else {
+        for (std::size_t i = 0; i < num_columns; ++i) func(i);
+    }
+}
 
 using boost::dynamic_bitset, std::make_shared, std::shared_ptr, std::setw, std::vector, std::list,
         std::dynamic_pointer_cast;
@@ -24,10 +41,15 @@ unsigned long long Depminer::ExecuteInternal() {
     schema_ = relation_->GetSchema();
 
     progress_step_ = kTotalProgressPercent / schema_->GetNumColumns();
+    pool_ = threads_num_ > 1 ? std::make_unique<util::WorkerThreadPool>(threads_num_) : nullptr;
 
     // Agree sets
-    model::AgreeSetFactory const agree_set_factory =
-            model::AgreeSetFactory(relation_.get(), model::AgreeSetFactory::Configuration(), this);
+    model::AgreeSetFactory const agree_set_factory = model::AgreeSetFactory(
+            relation_.get(),
+            model::AgreeSetFactory::Configuration(model::AgreeSetsGenMethod::kUsingCompressedRows,
+                                                  model::MCGenMethod::kUsingCalculateSupersets,
+                                                  threads_num_),
+            this);
     auto const agree_sets = agree_set_factory.GenAgreeSets();
     ToNextProgressPhase();
 
@@ -38,10 +60,11 @@ unsigned long long Depminer::ExecuteInternal() {
     // LHS
     auto const lhs_time = std::chrono::system_clock::now();
     // 1
-    for (auto const& column : schema_->GetColumns()) {
-        LhsForColumn(column, c_max_cets);
+    ForEachColumn([&](std::size_t column_index) {
+        LhsForColumn(schema_->GetColumns()[column_index], c_max_cets);
         AddProgress(progress_step_);
-    }
+    });
+    pool_.reset();
 
     auto const lhs_elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - lhs_time);
@@ -56,9 +79,15 @@ std::vector<CMAXSet> Depminer::GenerateCmaxSets(std::unordered_set<Vertical> con
     auto const start_time = std::chrono::system_clock::now();
 
     std::vector<CMAXSet> c_max_cets;
+    c_max_cets.reserve(schema_->GetNumColumns());
+    for (auto const& column : schema_->GetColumns()) {
+        c_max_cets.emplace_back(*column);
+    }
 
-    for (auto const& column : this->schema_->GetColumns()) {
-        CMAXSet result(*column);
+    ForEachColumn([&](std::size_t column_index) {
+        CheckCancelled();
+        Column const* column = schema_->GetColumns()[column_index].get();
+        CMAXSet& result = c_max_cets[column_index];
 
         // finding all sets, which doesn't contain column
         for (auto const& ag : agree_sets) {
@@ -98,9 +127,8 @@ std::vector<CMAXSet> Depminer::GenerateCmaxSets(std::unordered_set<Vertical> con
             result_super_sets.insert(combination.Invert());
         }
         result.MakeNewCombinations(std::move(result_super_sets));
-        c_max_cets.push_back(result);
         AddProgress(progress_step_);
-    }
+    });
 
     auto const elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
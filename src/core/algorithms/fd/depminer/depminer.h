@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
+
 #include "algorithms/fd/depminer/cmax_set.h"
 #include "algorithms/fd/pli_based_fd_algorithm.h"
+#include "config/thread_number/type.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -19,6 +23,14 @@ private:
     double progress_step_ = 0;
     RelationalSchema const* schema_ = nullptr;
 
+    config::ThreadNumType threads_num_ = 1;
+    // Both CMAX sets and LHSs are found for every column independently
+    std::unique_ptr<util::WorkerThreadPool> pool_;
+
+    template <typename Func>
+    void ForEachColumn(Func func);
+
+    void MakeExecuteOptsAvailableFDInternal() final;
     void ResetStateFd() final {}
 
     unsigned long long ExecuteInternal() final;
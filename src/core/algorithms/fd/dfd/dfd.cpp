@@ -1,6 +1,7 @@
 #include "dfd.h"
 
-#include <boost/asio.hpp>
+#include <memory>
+
 #include <easylogging++.h>
 
 #include "config/max_lhs/option.h"
@@ -9,9 +10,18 @@
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/position_list_index.h"
 #include "model/table/relational_schema.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
+namespace {
+
+// Memory limits of the PLI cache of every traversal thread and of the tier shared between them.
+constexpr std::size_t kThreadPliMemory = std::size_t{128} << 20;
+constexpr std::size_t kSharedPliMemory = std::size_t{512} << 20;
+
+}  // namespace
+
 DFD::DFD(std::optional<ColumnLayoutRelationDataManager> relation_manager)
     : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
     RegisterOptions();
@@ -30,8 +40,7 @@ void DFD::ResetStateFd() {
 }
 
 unsigned long long DFD::ExecuteInternal() {
-    auto partition_storage = std::make_unique<PartitionStorage>(
-            relation_.get(), CachingMethod::kAllCaching, CacheEvictionMethod::kMedainUsage);
+    SharedPartitions shared_partitions(relation_.get(), kSharedPliMemory);
     RelationalSchema const* const schema = relation_->GetSchema();
 
     auto start_time = std::chrono::system_clock::now();
@@ -49,37 +58,49 @@ unsigned long long DFD::ExecuteInternal() {
     }
 
     double progress_step = 100.0 / schema->GetNumColumns();
-    boost::asio::thread_pool search_space_pool(number_of_threads_);
-
-    for (auto& rhs : schema->GetColumns()) {
-        boost::asio::post(search_space_pool, [this, &rhs, schema, progress_step,
-                                              &partition_storage]() {
-            ColumnData const& rhs_data = relation_->GetColumnData(rhs->GetIndex());
-            model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
-
-            /* if all the rows have the same value, then we register FD with empty LHS
-             * if we have minimal FD like []->RHS, it is impossible to find smaller FD with
-             * this RHS, so we register it and move to the next RHS
-             * */
-            if (rhs_pli->GetNepAsLong() == relation_->GetNumTuplePairs()) {
-                RegisterFd(*(schema->empty_vertical_), *rhs, relation_->GetSharedPtrSchema());
-                AddProgress(progress_step);
-                return;
-            }
-
-            auto search_space = LatticeTraversal(rhs.get(), relation_.get(), unique_columns_,
-                                                 partition_storage.get());
-            auto const minimal_deps = search_space.FindLHSs();
-
-            for (auto const& minimal_dependency_lhs : minimal_deps) {
-                RegisterFd(minimal_dependency_lhs, *rhs, relation_->GetSharedPtrSchema());
-            }
+    // Every thread traverses lattices of its own RHSs with its own PLI cache, so traversals only
+    // synchronize when they use the PLIs promoted to the shared tier.
+    auto search_rhs = [this, schema, progress_step](std::size_t rhs_index,
+                                                    std::unique_ptr<PartitionStorage>& storage) {
+        CheckCancelled();
+        Column const* const rhs = schema->GetColumn(rhs_index);
+        ColumnData const& rhs_data = relation_->GetColumnData(rhs_index);
+        model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
+
+        /* if all the rows have the same value, then we register FD with empty LHS
+         * if we have minimal FD like []->RHS, it is impossible to find smaller FD with
+         * this RHS, so we register it and move to the next RHS
+         * */
+        if (rhs_pli->GetNepAsLong() == relation_->GetNumTuplePairs()) {
+            RegisterFd(*(schema->empty_vertical_), *rhs, relation_->GetSharedPtrSchema());
             AddProgress(progress_step);
-            LOG(INFO) << static_cast<int>(GetProgress().second);
-        });
-    }
+            return;
+        }
+
+        auto search_space =
+                LatticeTraversal(rhs, relation_.get(), unique_columns_, storage.get());
+        auto const minimal_deps = search_space.FindLHSs();
 
-    search_space_pool.join();
+        for (auto const& minimal_dependency_lhs : minimal_deps) {
+            RegisterFd(minimal_dependency_lhs, *rhs, relation_->GetSharedPtrSchema());
+        }
+        AddProgress(progress_step);
+        LOG(INFO) << static_cast<int>(GetProgress().second);
+    };
+    auto make_storage = [&shared_partitions]() {
+        return std::make_unique<PartitionStorage>(shared_partitions, kThreadPliMemory);
+    };
+
+    std::size_t const columns_num = schema->GetNumColumns();
+    if (number_of_threads_ > 1) {
+        util::WorkerThreadPool pool(number_of_threads_);
+        pool.ExecIndexWithResource(search_rhs, make_storage, columns_num);
+    } else {
+        auto storage = make_storage();
+        for (std::size_t rhs_index = 0; rhs_index != columns_num; ++rhs_index) {
+            search_rhs(rhs_index, storage);
+        }
+    }
     SetProgress(100);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
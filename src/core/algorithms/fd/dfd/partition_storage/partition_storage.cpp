@@ -1,47 +1,87 @@
 #include "partition_storage.h"
 
+#include <algorithm>
+
 #include <boost/format.hpp>
 #include <boost/optional.hpp>
 #include <easylogging++.h>
 
-#include "model/table/vertical_map.h"
+namespace {
 
-model::PositionListIndex* PartitionStorage::Get(Vertical const& vertical) {
-    return index_->Get(vertical).get();
+std::size_t GetPliMemoryUsage(model::PositionListIndex const& pli) {
+    return sizeof(model::PositionListIndex) + pli.GetSize() * sizeof(int) +
+           pli.GetNumNonSingletonCluster() * sizeof(model::PositionListIndex::Cluster);
 }
 
-PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data,
-                                   CachingMethod caching_method,
-                                   CacheEvictionMethod eviction_method)
+}  // namespace
+
+SharedPartitions::SharedPartitions(ColumnLayoutRelationData* relation_data,
+                                   std::size_t memory_limit)
     : relation_data_(relation_data),
-      index_(std::make_unique<model::BlockingVerticalMap<model::PositionListIndex>>(
-              relation_data->GetSchema())),
-      caching_method_(caching_method),
-      eviction_method_(eviction_method) {
-    for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
-        index_->Put(static_cast<Vertical>(*column_ptr),
-                    relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
+      promoted_(relation_data->GetSchema()),
+      memory_limit_(memory_limit) {
+    column_plis_.reserve(relation_data->GetNumColumns());
+    for (ColumnData& column_data : relation_data->GetColumnData()) {
+        column_plis_.push_back(column_data.GetPliOwnership());
+    }
+}
+
+bool SharedPartitions::Promote(Vertical const& vertical,
+                               std::shared_ptr<model::PositionListIndex> pli) {
+    std::size_t const memory = GetPliMemoryUsage(*pli);
+    std::size_t usage = memory_usage_.load(std::memory_order_relaxed);
+    do {
+        if (usage + memory > memory_limit_) return false;
+    } while (!memory_usage_.compare_exchange_weak(usage, usage + memory,
+                                                  std::memory_order_relaxed));
+    if (promoted_.Put(vertical, std::move(pli)) != nullptr) {
+        // Another traversal has promoted the same PLI in the meantime
+        memory_usage_.fetch_sub(memory, std::memory_order_relaxed);
     }
+    LOG(DEBUG) << boost::format{"PLI for %1% promoted to the shared tier."} % vertical.ToString();
+    return true;
 }
 
-PartitionStorage::~PartitionStorage() {}
+PartitionStorage::PartitionStorage(SharedPartitions& shared, std::size_t memory_limit)
+    : shared_(shared),
+      index_(shared.GetRelationData()->GetSchema()),
+      memory_limit_(memory_limit) {}
 
 // obtains or calculates a PositionListIndex using cache
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
-    std::scoped_lock lock(getting_pli_mutex_);
+std::shared_ptr<model::PositionListIndex const> PartitionStorage::GetOrCreateFor(
+        Vertical const& vertical) {
     LOG(DEBUG) << boost::format{"PLI for %1% requested: "} % vertical.ToString();
 
+    if (vertical.GetArity() == 1) {
+        return shared_.GetColumnPli(vertical.GetColumnIndices().find_first());
+    }
     // is PLI already cached?
-    model::PositionListIndex* pli = Get(vertical);
-    if (pli != nullptr) {
-        pli->IncFreq();
+    if (auto it = cached_.find(vertical); it != cached_.end()) {
         LOG(DEBUG) << boost::format{"Served from PLI cache."};
-        // addToUsageCounter
+        std::shared_ptr<model::PositionListIndex> pli = index_.Get(vertical);
+        if (++it->second.uses == kPromotionUses && shared_.Promote(vertical, pli)) {
+            Uncache(vertical);
+        }
         return pli;
     }
+    if (auto pli = shared_.GetPromoted(vertical); pli != nullptr) {
+        LOG(DEBUG) << boost::format{"Served from shared PLI tier."};
+        return pli;
+    }
+    return Intersect(vertical);
+}
+
+std::shared_ptr<model::PositionListIndex> PartitionStorage::Intersect(Vertical const& vertical) {
     // look for cached PLIs to construct the requested one
-    auto subset_entries = index_->GetSubsetEntries(vertical);
+    auto subset_entries = index_.GetSubsetEntries(vertical);
+    auto promoted_entries = shared_.GetPromotedSubsetEntries(vertical);
+    subset_entries.insert(subset_entries.end(), std::make_move_iterator(promoted_entries.begin()),
+                          std::make_move_iterator(promoted_entries.end()));
+    for (auto const* column : vertical.GetColumns()) {
+        subset_entries.emplace_back(static_cast<Vertical>(*column),
+                                    shared_.GetColumnPli(column->GetIndex()));
+    }
+
     boost::optional<PositionListIndexRank> smallest_pli_rank;
     std::vector<PositionListIndexRank> ranks;
     ranks.reserve(subset_entries.size());
@@ -58,104 +98,120 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     }
     assert(smallest_pli_rank);  // check if smallest_pli_rank is initialized
 
+    std::size_t const columns_num = shared_.GetRelationData()->GetNumColumns();
     std::vector<PositionListIndexRank> operands;
-    boost::dynamic_bitset<> cover(relation_data_->GetNumColumns());
-    boost::dynamic_bitset<> cover_tester(relation_data_->GetNumColumns());
-    if (smallest_pli_rank) {
-        smallest_pli_rank->pli_->IncFreq();
-        operands.push_back(*smallest_pli_rank);
-        cover |= smallest_pli_rank->vertical_->GetColumnIndices();
-
-        while (cover.count() < vertical.GetArity() && !ranks.empty()) {
-            boost::optional<PositionListIndexRank> best_rank;
-            // erase ranks with low added_arity_
-            ranks.erase(std::remove_if(ranks.begin(), ranks.end(),
-                                       [&cover_tester, &cover](auto& rank) {
-                                           cover_tester.reset();
-                                           cover_tester |= rank.vertical_->GetColumnIndices();
-                                           cover_tester -= cover;
-                                           rank.added_arity_ = cover_tester.count();
-                                           return rank.added_arity_ < 2;
-                                       }),
-                        ranks.end());
-
-            for (auto& rank : ranks) {
-                if (!best_rank || best_rank->added_arity_ < rank.added_arity_ ||
-                    (best_rank->added_arity_ == rank.added_arity_ &&
-                     best_rank->pli_->GetSize() > rank.pli_->GetSize())) {
-                    best_rank = rank;
-                }
+    boost::dynamic_bitset<> cover(columns_num);
+    boost::dynamic_bitset<> cover_tester(columns_num);
+    operands.push_back(*smallest_pli_rank);
+    cover |= smallest_pli_rank->vertical_->GetColumnIndices();
+
+    while (cover.count() < vertical.GetArity() && !ranks.empty()) {
+        boost::optional<PositionListIndexRank> best_rank;
+        // erase ranks with low added_arity_
+        ranks.erase(std::remove_if(ranks.begin(), ranks.end(),
+                                   [&cover_tester, &cover](auto& rank) {
+                                       cover_tester.reset();
+                                       cover_tester |= rank.vertical_->GetColumnIndices();
+                                       cover_tester -= cover;
+                                       rank.added_arity_ = cover_tester.count();
+                                       return rank.added_arity_ < 2;
+                                   }),
+                    ranks.end());
+
+        for (auto& rank : ranks) {
+            if (!best_rank || best_rank->added_arity_ < rank.added_arity_ ||
+                (best_rank->added_arity_ == rank.added_arity_ &&
+                 best_rank->pli_->GetSize() > rank.pli_->GetSize())) {
+                best_rank = rank;
             }
+        }
 
-            if (best_rank) {
-                best_rank->pli_->IncFreq();
-                operands.push_back(*best_rank);
-                cover |= best_rank->vertical_->GetColumnIndices();
-            }
+        if (best_rank) {
+            operands.push_back(*best_rank);
+            cover |= best_rank->vertical_->GetColumnIndices();
         }
     }
 
     std::vector<std::unique_ptr<Vertical>> vertical_columns;
-
     for (auto& column : vertical.GetColumns()) {
         if (!cover[column->GetIndex()]) {
             vertical_columns.push_back(std::make_unique<Vertical>(static_cast<Vertical>(*column)));
-            auto column_pli = index_->Get(**vertical_columns.rbegin());
-            operands.emplace_back(vertical_columns.rbegin()->get(), column_pli, 1);
-            column_pli->IncFreq();
+            operands.emplace_back(vertical_columns.back().get(),
+                                  shared_.GetColumnPli(column->GetIndex()), 1);
         }
     }
     // sort operands by ascending order
     std::sort(operands.begin(), operands.end(),
               [](auto& el1, auto& el2) { return el1.pli_->GetSize() < el2.pli_->GetSize(); });
 
-    LOG(DEBUG) << boost::format{"Intersecting %1%."} % "[UNIMPLEMENTED]";
-
-    if (operands.empty()) {
-        throw std::logic_error("Current implementation assumes operands.size() > 0");
-    }
-
     // Intersect and cache
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-            variant_intersection_pli;
+    std::shared_ptr<model::PositionListIndex> intersection_pli;
     if (operands.size() >= 4) {
-        PositionListIndexRank base_pli_rank = operands[0];
-        auto intersection_pli = base_pli_rank.pli_->ProbeAll(
-                vertical.Without(*base_pli_rank.vertical_), *relation_data_);
-        variant_intersection_pli = CachingProcess(vertical, std::move(intersection_pli));
+        PositionListIndexRank const& base_pli_rank = operands[0];
+        intersection_pli = base_pli_rank.pli_->ProbeAll(vertical.Without(*base_pli_rank.vertical_),
+                                                        *shared_.GetRelationData());
+        Cache(vertical, intersection_pli);
     } else {
         Vertical current_vertical = *operands.begin()->vertical_;
-        variant_intersection_pli = operands.begin()->pli_.get();
+        intersection_pli = operands.begin()->pli_;
 
         for (size_t i = 1; i < operands.size(); i++) {
             current_vertical = current_vertical.Union(*operands[i].vertical_);
-            variant_intersection_pli =
-                    std::holds_alternative<model::PositionListIndex*>(variant_intersection_pli)
-                            ? std::get<model::PositionListIndex*>(variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get())
-                            : std::get<std::unique_ptr<model::PositionListIndex>>(
-                                      variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get());
-            variant_intersection_pli = CachingProcess(
-                    current_vertical, std::move(std::get<std::unique_ptr<model::PositionListIndex>>(
-                                              variant_intersection_pli)));
+            intersection_pli = intersection_pli->Intersect(operands[i].pli_.get());
+            Cache(current_vertical, intersection_pli);
         }
     }
 
     LOG(DEBUG) << boost::format{"Calculated from %1% sub-PLIs (saved %2% intersections)."} %
                           operands.size() % (vertical.GetArity() - operands.size());
 
-    return variant_intersection_pli;
+    return intersection_pli;
 }
 
-size_t PartitionStorage::Size() const {
-    return index_->GetSize();
+void PartitionStorage::Cache(Vertical const& vertical,
+                             std::shared_ptr<model::PositionListIndex> const& pli) {
+    std::size_t const memory = GetPliMemoryUsage(*pli);
+    if (!cached_.try_emplace(vertical, CachedPli{memory, 0}).second) return;
+    index_.Put(vertical, pli);
+    memory_usage_ += memory;
+    if (memory_usage_ > memory_limit_) {
+        EvictRarelyUsed(vertical);
+    }
+}
+
+void PartitionStorage::Uncache(Vertical const& vertical) {
+    auto it = cached_.find(vertical);
+    index_.Remove(vertical);
+    memory_usage_ -= it->second.memory_usage;
+    cached_.erase(it);
 }
 
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::CachingProcess(Vertical const& vertical,
-                                 std::unique_ptr<model::PositionListIndex> pli) {
-    auto pli_pointer = pli.get();
-    index_->Put(vertical, std::move(pli));
-    return pli_pointer;
+/* Evicts PLIs used no more often than the median, the remaining ones have their use counts halved,
+ * so that PLIs that were popular long ago get evicted eventually too.
+ */
+void PartitionStorage::EvictRarelyUsed(Vertical const& keep) {
+    std::vector<unsigned> uses;
+    uses.reserve(cached_.size());
+    for (auto const& [vertical, cached_pli] : cached_) {
+        uses.push_back(cached_pli.uses);
+    }
+    auto median = uses.begin() + uses.size() / 2;
+    std::nth_element(uses.begin(), median, uses.end());
+    unsigned const median_uses = *median;
+
+    for (auto it = cached_.begin(); it != cached_.end();) {
+        if (it->second.uses <= median_uses && it->first != keep) {
+            index_.Remove(it->first);
+            memory_usage_ -= it->second.memory_usage;
+            it = cached_.erase(it);
+        } else {
+            it->second.uses /= 2;
+            ++it;
+        }
+    }
+    LOG(DEBUG) << boost::format{"PLI cache shrunk to %1% PLIs."} % cached_.size();
+}
+
+size_t PartitionStorage::Size() const {
+    return index_.GetSize();
 }
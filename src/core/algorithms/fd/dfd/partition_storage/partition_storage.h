@@ -1,14 +1,64 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
-#include "cache_eviction_method.h"
-#include "caching_method.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/vertical_map.h"
 
+/* PLIs shared by all lattice traversals of a DFD run.
+ * Single-column PLIs are immutable and are read without any locking. PLIs of column combinations
+ * that turned out to be popular in some traversal are promoted into a read-mostly tier, so that
+ * other traversals don't have to intersect them again. The tier stops accepting PLIs once it
+ * reaches its memory limit, nothing is ever evicted from it.
+ */
+class SharedPartitions {
+private:
+    ColumnLayoutRelationData* relation_data_;
+    std::vector<std::shared_ptr<model::PositionListIndex>> column_plis_;
+    model::BlockingVerticalMap<model::PositionListIndex> promoted_;
+    std::size_t const memory_limit_;
+    std::atomic<std::size_t> memory_usage_ = 0;
+
+public:
+    SharedPartitions(ColumnLayoutRelationData* relation_data, std::size_t memory_limit);
+
+    ColumnLayoutRelationData* GetRelationData() const noexcept {
+        return relation_data_;
+    }
+
+    std::shared_ptr<model::PositionListIndex> const& GetColumnPli(std::size_t column_index) const {
+        return column_plis_[column_index];
+    }
+
+    std::shared_ptr<model::PositionListIndex const> GetPromoted(Vertical const& vertical) const {
+        return promoted_.Get(vertical);
+    }
+
+    std::vector<model::VerticalMap<model::PositionListIndex>::Entry> GetPromotedSubsetEntries(
+            Vertical const& vertical) const {
+        return promoted_.GetSubsetEntries(vertical);
+    }
+
+    // Returns false if the tier is full.
+    bool Promote(Vertical const& vertical, std::shared_ptr<model::PositionListIndex> pli);
+};
+
+/* PLI cache of a single worker thread. Intersected PLIs are cached locally without any
+ * synchronization; once the cache exceeds its memory limit, PLIs used no more often than the
+ * median are evicted. A PLI served from the cache kPromotionUses times is moved to the shared tier.
+ * Returned PLIs are shared pointers, so they stay valid after eviction.
+ */
 class PartitionStorage {
 private:
+    struct CachedPli {
+        std::size_t memory_usage;
+        unsigned uses;
+    };
+
     class PositionListIndexRank {
     public:
         Vertical const* vertical_;
@@ -17,34 +67,26 @@ private:
 
         PositionListIndexRank(Vertical const* vertical,
                               std::shared_ptr<model::PositionListIndex> pli, int initial_arity)
-            : vertical_(vertical), pli_(pli), added_arity_(initial_arity) {}
+            : vertical_(vertical), pli_(std::move(pli)), added_arity_(initial_arity) {}
     };
 
-    ColumnLayoutRelationData* relation_data_;
-    std::unique_ptr<model::VerticalMap<model::PositionListIndex>> index_;
+    static constexpr unsigned kPromotionUses = 4;
 
-    int saved_intersections_ = 0;
+    SharedPartitions& shared_;
+    model::VerticalMap<model::PositionListIndex> index_;
+    std::unordered_map<Vertical, CachedPli> cached_;
+    std::size_t const memory_limit_;
+    std::size_t memory_usage_ = 0;
 
-    mutable std::mutex getting_pli_mutex_;
-
-    CachingMethod caching_method_;
-    CacheEvictionMethod eviction_method_;
-    double caching_method_value_;
-
-    double median_inverted_entropy_;
-
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    CachingProcess(Vertical const& vertical, std::unique_ptr<model::PositionListIndex> pli);
+    std::shared_ptr<model::PositionListIndex> Intersect(Vertical const& vertical);
+    void Cache(Vertical const& vertical, std::shared_ptr<model::PositionListIndex> const& pli);
+    void Uncache(Vertical const& vertical);
+    void EvictRarelyUsed(Vertical const& keep);
 
 public:
-    PartitionStorage(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
-                     CacheEvictionMethod eviction_method);
+    PartitionStorage(SharedPartitions& shared, std::size_t memory_limit);
 
-    model::PositionListIndex* Get(Vertical const& vertical);
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    GetOrCreateFor(Vertical const& vertical);
+    std::shared_ptr<model::PositionListIndex const> GetOrCreateFor(Vertical const& vertical);
 
     size_t Size() const;
-
-    virtual ~PartitionStorage();
 };
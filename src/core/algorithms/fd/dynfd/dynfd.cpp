@@ -0,0 +1,573 @@
+#include "algorithms/fd/dynfd/dynfd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <set>
+#include <stdexcept>
+
+#include <easylogging++.h>
+
+#include "algorithms/fd/hyfd/hyfd.h"
+#include "algorithms/fd/hyfd/inductor.h"
+#include "config/equal_nulls/option.h"
+#include "config/exceptions.h"
+#include "config/max_lhs/option.h"
+#include "config/tabular_data/crud_operations/operations.h"
+#include "config/tabular_data/input_table/option.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/position_list_index.h"
+
+namespace algos::dynfd {
+
+namespace {
+
+template <typename Witness>
+bool IsCovered(boost::dynamic_bitset<> const& lhs,
+               std::map<boost::dynamic_bitset<>, Witness> const& non_fds) {
+    return std::any_of(non_fds.begin(), non_fds.end(),
+                       [&lhs](auto const& non_fd) { return lhs.is_subset_of(non_fd.first); });
+}
+
+/* Sorts non-FDs by descending arity, specializing the positive cover by larger non-FDs first
+ * leaves fewer candidates to be specialized by the smaller ones */
+std::vector<boost::dynamic_bitset<>> SortByArityDescending(
+        std::vector<boost::dynamic_bitset<>> lhss) {
+    std::stable_sort(lhss.begin(), lhss.end(),
+                     [](auto const& lhs1, auto const& lhs2) { return lhs1.count() > lhs2.count(); });
+    return lhss;
+}
+
+}  // namespace
+
+DynFD::DynFD() : FDAlgorithm({}) {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
+}
+
+void DynFD::RegisterOptions() {
+    auto check_inserts = [this](config::InputTable insert_batch) {
+        if (insert_batch == nullptr || !insert_batch->HasNextRow()) {
+            return;
+        }
+        if (insert_batch->GetNumberOfColumns() != input_table_->GetNumberOfColumns()) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: insert statements must have the same number of columns as "
+                    "the input table");
+        }
+        for (std::size_t i = 0; i < input_table_->GetNumberOfColumns(); ++i) {
+            if (insert_batch->GetColumnName(i) != input_table_->GetColumnName(i)) {
+                throw config::ConfigurationError(
+                        "Schema mismatch: insert statements' column names must match the input "
+                        "table");
+            }
+        }
+    };
+
+    auto check_deletes = [this](std::unordered_set<std::size_t> const& delete_batch) {
+        for (std::size_t id : delete_batch) {
+            if (!IsRowIndexValid(id)) {
+                throw config::ConfigurationError("Attempt to delete a non-existing row");
+            }
+        }
+    };
+
+    auto check_updates = [this](config::InputTable update_batch) {
+        if (update_batch == nullptr || !update_batch->HasNextRow()) {
+            return;
+        }
+        if (update_batch->GetNumberOfColumns() != input_table_->GetNumberOfColumns() + 1) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: update statements must have the number of columns one more "
+                    "than the input table");
+        }
+        for (std::size_t i = 0; i < input_table_->GetNumberOfColumns(); ++i) {
+            if (update_batch->GetColumnName(i + 1) != input_table_->GetColumnName(i)) {
+                throw config::ConfigurationError(
+                        "Schema mismatch: update statements column names, except of first one, "
+                        "must match the input table");
+            }
+        }
+        std::unordered_set<std::size_t> rows_to_update;
+        while (update_batch->HasNextRow()) {
+            auto row = update_batch->GetNextRow();
+            std::size_t id = std::stoull(row.front());
+            if (!IsRowIndexValid(id)) {
+                throw config::ConfigurationError("Attempt to update a non-existing row");
+            }
+            if (!rows_to_update.emplace(id).second) {
+                throw config::ConfigurationError("Update statements have duplicates");
+            }
+        }
+        update_batch->Reset();
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(
+            config::kInsertStatementsOpt(&insert_statements_table_).SetValueCheck(check_inserts));
+    RegisterOption(
+            config::kDeleteStatementsOpt(&delete_statement_indices_).SetValueCheck(check_deletes));
+    RegisterOption(
+            config::kUpdateStatementsOpt(&update_statements_table_).SetValueCheck(check_updates));
+}
+
+void DynFD::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable(kCrudOptions);
+}
+
+int DynFD::EncodeValue(std::string const& value) {
+    if (value.empty()) {
+        return is_null_equal_null_ ? kNullValueId : next_value_id_++;
+    }
+    auto [it, is_value_new] = value_dictionary_.try_emplace(value, next_value_id_);
+    if (is_value_new) {
+        next_value_id_++;
+    }
+    return it->second;
+}
+
+DynFD::Row DynFD::ParseRow(std::vector<std::string>::const_iterator row_begin) {
+    Row row;
+    row.reserve(GetNumColumns());
+    for (std::size_t column = 0; column != GetNumColumns(); ++column) {
+        row.push_back(EncodeValue(*(row_begin + column)));
+    }
+    return row;
+}
+
+void DynFD::LoadDataInternal() {
+    std::size_t const num_columns = input_table_->GetNumberOfColumns();
+    if (num_columns == 0) {
+        throw std::runtime_error("Got an empty dataset: FD mining is meaningless.");
+    }
+
+    columns_.assign(num_columns, {});
+    while (input_table_->HasNextRow()) {
+        std::vector<std::string> const row = input_table_->GetNextRow();
+        if (row.size() != num_columns) {
+            LOG(WARNING) << "Unexpected number of columns for a row, skipping (expected "
+                         << num_columns << ", got " << row.size() << ")";
+            continue;
+        }
+        Row const encoded = ParseRow(row.begin());
+        for (std::size_t column = 0; column != num_columns; ++column) {
+            columns_[column].push_back(encoded[column]);
+        }
+    }
+
+    plis_.clear();
+    for (std::vector<int> const& column : columns_) {
+        std::vector<model::DynPLI::ClusterValue> values;
+        values.reserve(column.size());
+        for (int value : column) {
+            values.push_back({value});
+        }
+        plis_.push_back(model::DynPLI::CreateFor(values));
+    }
+
+    FindInitialCovers();
+    BuildNegativeCover();
+}
+
+/* The relation HyFD works on is built from the encoded columns, so the table is read only once.
+ * Nulls that are not equal to each other have distinct codes and end up in no cluster, just like
+ * in a relation parsed from the table */
+std::shared_ptr<ColumnLayoutRelationData> DynFD::CreateRelation() const {
+    auto schema = std::make_unique<RelationalSchema>(input_table_->GetRelationName());
+    std::vector<ColumnData> column_data;
+    for (std::size_t i = 0; i != GetNumColumns(); ++i) {
+        schema->AppendColumn(Column(schema.get(), input_table_->GetColumnName(i), i));
+        std::vector<int> values = columns_[i];
+        column_data.emplace_back(schema->GetColumn(i),
+                                 model::PositionListIndex::CreateFor(values, is_null_equal_null_));
+    }
+    schema->Init();
+    return std::make_shared<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
+}
+
+void DynFD::FindInitialCovers() {
+    std::shared_ptr<ColumnLayoutRelationData> relation = CreateRelation();
+    hyfd::HyFD hyfd({{&input_table_, &is_null_equal_null_, &relation}});
+    hyfd.LoadData();
+    hyfd.SetOption(config::kMaxLhsOpt.GetName());
+    hyfd.Execute();
+    schema_ = relation->GetSharedPtrSchema();
+
+    positive_cover_ = std::make_shared<hyfd::fd_tree::FDTree>(GetNumColumns());
+    boost::dynamic_bitset<> const empty_lhs(GetNumColumns());
+    for (std::size_t rhs = 0; rhs != GetNumColumns(); ++rhs) {
+        positive_cover_->Remove(empty_lhs, rhs);
+    }
+    for (FD const& fd : hyfd.FdList()) {
+        RawFD const raw_fd = fd.ToRawFD();
+        positive_cover_->AddFD(raw_fd.lhs_, raw_fd.rhs_);
+    }
+}
+
+/* The maximal non-FDs of an attribute are the complements of the minimal sets intersecting the
+ * LHS of every its minimal FD. The minimal sets are found by the inductor: a set that misses
+ * the LHS X is invalid for "non-FD" U \ X, where U consists of the other attributes. */
+void DynFD::BuildNegativeCover() {
+    std::size_t const num_columns = GetNumColumns();
+    auto transversals = std::make_shared<hyfd::fd_tree::FDTree>(num_columns);
+    hyfd::Inductor dualizer(transversals);
+    for (RawFD const& fd : positive_cover_->FillFDs()) {
+        boost::dynamic_bitset<> complement = ~fd.lhs_;
+        complement.reset(fd.rhs_);
+        dualizer.SpecializeTreeForNonFd(complement, fd.rhs_);
+    }
+
+    std::map<boost::dynamic_bitset<>, boost::dynamic_bitset<>> non_fd_rhss;
+    for (RawFD const& transversal : transversals->FillFDs()) {
+        boost::dynamic_bitset<> lhs = ~transversal.lhs_;
+        lhs.reset(transversal.rhs_);
+        auto [it, _] = non_fd_rhss.try_emplace(std::move(lhs), num_columns);
+        it->second.set(transversal.rhs_);
+    }
+
+    negative_cover_.assign(num_columns, {});
+    for (auto const& [lhs, rhss] : non_fd_rhss) {
+        std::vector<std::optional<Witness>> const witnesses = FindWitnesses(lhs, rhss);
+        for (std::size_t rhs = rhss.find_first(); rhs != boost::dynamic_bitset<>::npos;
+             rhs = rhss.find_next(rhs)) {
+            if (!witnesses[rhs].has_value()) {
+                throw std::logic_error("Non-FD derived from the positive cover is not violated");
+            }
+            negative_cover_[rhs].emplace(lhs, *witnesses[rhs]);
+        }
+    }
+}
+
+bool DynFD::AgreeOn(boost::dynamic_bitset<> const& columns, std::size_t row1,
+                    std::size_t row2) const {
+    for (std::size_t column = columns.find_first(); column != boost::dynamic_bitset<>::npos;
+         column = columns.find_next(column)) {
+        if (columns_[column][row1] != columns_[column][row2]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+boost::dynamic_bitset<> DynFD::GetAgreeSet(std::size_t row1, std::size_t row2) const {
+    boost::dynamic_bitset<> agree_set(GetNumColumns());
+    for (std::size_t column = 0; column != GetNumColumns(); ++column) {
+        if (columns_[column][row1] == columns_[column][row2]) {
+            agree_set.set(column);
+        }
+    }
+    return agree_set;
+}
+
+std::vector<std::vector<std::size_t>> DynFD::GetClusters(
+        boost::dynamic_bitset<> const& lhs) const {
+    std::vector<std::vector<std::size_t>> clusters;
+    if (lhs.none()) {
+        std::vector<std::size_t>& all_rows = clusters.emplace_back();
+        for (std::size_t row = 0; row != GetNumRowsTotal(); ++row) {
+            if (!deleted_rows_.contains(row)) all_rows.push_back(row);
+        }
+        if (all_rows.size() < 2) clusters.clear();
+        return clusters;
+    }
+
+    // Start from the column with the most clusters, the others only split them further
+    std::size_t first_column = lhs.find_first();
+    for (std::size_t column = lhs.find_next(first_column); column != boost::dynamic_bitset<>::npos;
+         column = lhs.find_next(column)) {
+        if (plis_[column]->GetNumCluster() > plis_[first_column]->GetNumCluster()) {
+            first_column = column;
+        }
+    }
+    for (auto const& [value, cluster] : plis_[first_column]->GetClusters()) {
+        if (cluster.size() > 1) clusters.emplace_back(cluster.begin(), cluster.end());
+    }
+
+    std::unordered_map<int, std::vector<std::size_t>> groups;
+    for (std::size_t column = lhs.find_first(); column != boost::dynamic_bitset<>::npos;
+         column = lhs.find_next(column)) {
+        if (column == first_column) continue;
+        std::vector<std::vector<std::size_t>> refined;
+        for (std::vector<std::size_t> const& cluster : clusters) {
+            groups.clear();
+            for (std::size_t row : cluster) {
+                groups[columns_[column][row]].push_back(row);
+            }
+            for (auto& [value, group] : groups) {
+                if (group.size() > 1) refined.push_back(std::move(group));
+            }
+        }
+        clusters = std::move(refined);
+    }
+    return clusters;
+}
+
+std::vector<std::optional<DynFD::Witness>> DynFD::FindWitnesses(
+        boost::dynamic_bitset<> const& lhs, boost::dynamic_bitset<> const& rhss) const {
+    std::vector<std::optional<Witness>> witnesses(GetNumColumns());
+    boost::dynamic_bitset<> pending = rhss;
+    for (std::vector<std::size_t> const& cluster : GetClusters(lhs)) {
+        std::size_t const first_row = cluster.front();
+        for (std::size_t row : cluster) {
+            for (std::size_t rhs = pending.find_first(); rhs != boost::dynamic_bitset<>::npos;
+                 rhs = pending.find_next(rhs)) {
+                if (columns_[rhs][row] != columns_[rhs][first_row]) {
+                    witnesses[rhs] = Witness{first_row, row};
+                    pending.reset(rhs);
+                }
+            }
+            if (pending.none()) return witnesses;
+        }
+    }
+    return witnesses;
+}
+
+void DynFD::RebuildPositiveCover(std::size_t rhs) {
+    boost::dynamic_bitset<> all_columns(GetNumColumns());
+    all_columns.set();
+    for (boost::dynamic_bitset<> const& lhs : positive_cover_->GetFdAndGenerals(all_columns, rhs)) {
+        positive_cover_->Remove(lhs, rhs);
+    }
+    positive_cover_->AddFD(boost::dynamic_bitset<>(GetNumColumns()), rhs);
+
+    std::vector<boost::dynamic_bitset<>> non_fds;
+    for (auto const& [lhs, witness] : negative_cover_[rhs]) {
+        non_fds.push_back(lhs);
+    }
+    hyfd::Inductor inductor(positive_cover_);
+    for (boost::dynamic_bitset<> const& lhs : SortByArityDescending(std::move(non_fds))) {
+        inductor.SpecializeTreeForNonFd(lhs, rhs);
+    }
+}
+
+void DynFD::DeleteRows(std::unordered_set<std::size_t> const& rows) {
+    if (rows.empty()) return;
+
+    deleted_rows_.insert(rows.begin(), rows.end());
+    std::vector<std::pair<std::optional<std::size_t>, model::DynPLI::ClusterValue>> no_inserts;
+    for (std::unique_ptr<model::DynPLI>& pli : plis_) {
+        pli->UpdateWith(no_inserts, rows);
+    }
+
+    std::map<boost::dynamic_bitset<>, boost::dynamic_bitset<>> lost_witnesses;
+    for (std::size_t rhs = 0; rhs != GetNumColumns(); ++rhs) {
+        std::erase_if(negative_cover_[rhs], [&](auto const& non_fd) {
+            auto const& [lhs, witness] = non_fd;
+            if (IsRowIndexValid(witness.first) && IsRowIndexValid(witness.second)) return false;
+            auto [it, _] = lost_witnesses.try_emplace(lhs, GetNumColumns());
+            it->second.set(rhs);
+            return true;
+        });
+    }
+
+    std::vector<std::vector<boost::dynamic_bitset<>>> valid_lhss(GetNumColumns());
+    for (auto const& [lhs, rhss] : lost_witnesses) {
+        std::vector<std::optional<Witness>> const witnesses = FindWitnesses(lhs, rhss);
+        for (std::size_t rhs = rhss.find_first(); rhs != boost::dynamic_bitset<>::npos;
+             rhs = rhss.find_next(rhs)) {
+            if (witnesses[rhs].has_value()) {
+                negative_cover_[rhs].emplace(lhs, *witnesses[rhs]);
+            } else {
+                valid_lhss[rhs].push_back(lhs);
+            }
+        }
+    }
+
+    for (std::size_t rhs = 0; rhs != GetNumColumns(); ++rhs) {
+        if (valid_lhss[rhs].empty()) continue;
+        GeneralizeNegativeCover(rhs, std::move(valid_lhss[rhs]));
+        RebuildPositiveCover(rhs);
+    }
+}
+
+/* Every set that is still violated is a subset of a remaining non-FD or of a former non-FD that
+ * became valid. The subsets of the latter are traversed top-down until they are either covered
+ * by a non-FD or violated themselves. */
+void DynFD::GeneralizeNegativeCover(std::size_t rhs,
+                                    std::vector<boost::dynamic_bitset<>> valid_lhss) {
+    NonFDs& non_fds = negative_cover_[rhs];
+    boost::dynamic_bitset<> rhs_bits(GetNumColumns());
+    rhs_bits.set(rhs);
+
+    std::deque<boost::dynamic_bitset<>> queue(valid_lhss.begin(), valid_lhss.end());
+    std::set<boost::dynamic_bitset<>> visited;
+    std::vector<boost::dynamic_bitset<>> found;
+    while (!queue.empty()) {
+        boost::dynamic_bitset<> const lhs = std::move(queue.front());
+        queue.pop_front();
+        for (std::size_t column = lhs.find_first(); column != boost::dynamic_bitset<>::npos;
+             column = lhs.find_next(column)) {
+            boost::dynamic_bitset<> subset = lhs;
+            subset.reset(column);
+            if (!visited.insert(subset).second || IsCovered(subset, non_fds)) continue;
+            std::optional<Witness> const witness = FindWitnesses(subset, rhs_bits)[rhs];
+            if (witness.has_value()) {
+                non_fds.emplace(subset, *witness);
+                found.push_back(std::move(subset));
+            } else {
+                queue.push_back(std::move(subset));
+            }
+        }
+    }
+
+    // Non-FDs found at different depths may contain each other
+    for (boost::dynamic_bitset<> const& lhs : found) {
+        bool const is_maximal = std::none_of(non_fds.begin(), non_fds.end(), [&](auto const& other) {
+            return lhs.is_proper_subset_of(other.first);
+        });
+        if (!is_maximal) non_fds.erase(lhs);
+    }
+}
+
+void DynFD::InsertRows(std::vector<RowInsertion> const& rows) {
+    if (rows.empty()) return;
+
+    std::vector<std::size_t> inserted_rows;
+    inserted_rows.reserve(rows.size());
+    for (auto const& [update_id, row] : rows) {
+        std::size_t const id = update_id.value_or(GetNumRowsTotal());
+        for (std::size_t column = 0; column != GetNumColumns(); ++column) {
+            if (update_id.has_value()) {
+                columns_[column][id] = row[column];
+            } else {
+                columns_[column].push_back(row[column]);
+            }
+        }
+        deleted_rows_.erase(id);
+        inserted_rows.push_back(id);
+    }
+    for (std::size_t column = 0; column != GetNumColumns(); ++column) {
+        std::vector<std::pair<std::optional<std::size_t>, model::DynPLI::ClusterValue>> inserts;
+        inserts.reserve(rows.size());
+        for (auto const& [update_id, row] : rows) {
+            inserts.emplace_back(update_id, model::DynPLI::ClusterValue{row[column]});
+        }
+        plis_[column]->UpdateWith(inserts, {});
+    }
+
+    NonFDs const violations = CollectViolations(inserted_rows);
+    std::vector<boost::dynamic_bitset<>> agree_sets;
+    agree_sets.reserve(violations.size());
+    for (auto const& [agree_set, witness] : violations) {
+        agree_sets.push_back(agree_set);
+    }
+
+    hyfd::Inductor inductor(positive_cover_);
+    for (boost::dynamic_bitset<> const& agree_set : SortByArityDescending(std::move(agree_sets))) {
+        Witness const& witness = violations.at(agree_set);
+        for (std::size_t rhs = 0; rhs != GetNumColumns(); ++rhs) {
+            NonFDs& non_fds = negative_cover_[rhs];
+            if (agree_set.test(rhs) || IsCovered(agree_set, non_fds)) continue;
+            std::erase_if(non_fds, [&agree_set](auto const& non_fd) {
+                return non_fd.first.is_proper_subset_of(agree_set);
+            });
+            non_fds.emplace(agree_set, witness);
+            inductor.SpecializeTreeForNonFd(agree_set, rhs);
+        }
+    }
+}
+
+/* An FD that held before the insertion is violated only by pairs containing an inserted row. Such
+ * pairs agree on the LHS of an FD from the positive cover, so the rows to compare an inserted row
+ * with are taken from the smallest PLI cluster of its values in the LHS columns. The agree sets
+ * of the violating pairs together with the previous negative cover describe all non-FDs. */
+DynFD::NonFDs DynFD::CollectViolations(std::vector<std::size_t> const& inserted_rows) const {
+    std::map<boost::dynamic_bitset<>, boost::dynamic_bitset<>> cover;
+    for (RawFD const& fd : positive_cover_->FillFDs()) {
+        auto [it, _] = cover.try_emplace(fd.lhs_, GetNumColumns());
+        it->second.set(fd.rhs_);
+    }
+
+    NonFDs violations;
+    std::unordered_set<std::size_t> compared_rows;
+    std::vector<model::DynPLI::Cluster const*> row_clusters(GetNumColumns());
+    for (std::size_t inserted_row : inserted_rows) {
+        CheckCancelled();
+        compared_rows.clear();
+        for (std::size_t column = 0; column != GetNumColumns(); ++column) {
+            row_clusters[column] =
+                    &plis_[column]->GetClusters().at({columns_[column][inserted_row]});
+        }
+
+        auto compare = [&](std::size_t row, boost::dynamic_bitset<> const& lhs,
+                           boost::dynamic_bitset<> const& rhss) {
+            if (row == inserted_row || compared_rows.contains(row) ||
+                !AgreeOn(lhs, inserted_row, row) || AgreeOn(rhss, inserted_row, row)) {
+                return;
+            }
+            compared_rows.insert(row);
+            violations.try_emplace(GetAgreeSet(inserted_row, row), inserted_row, row);
+        };
+
+        for (auto const& [lhs, rhss] : cover) {
+            if (lhs.none()) {
+                for (std::size_t row = 0; row != GetNumRowsTotal(); ++row) {
+                    if (!deleted_rows_.contains(row)) compare(row, lhs, rhss);
+                }
+                continue;
+            }
+            model::DynPLI::Cluster const* candidates = row_clusters[lhs.find_first()];
+            for (std::size_t column = lhs.find_next(lhs.find_first());
+                 column != boost::dynamic_bitset<>::npos; column = lhs.find_next(column)) {
+                if (row_clusters[column]->size() < candidates->size()) {
+                    candidates = row_clusters[column];
+                }
+            }
+            for (int row : *candidates) {
+                compare(row, lhs, rhss);
+            }
+        }
+    }
+    return violations;
+}
+
+void DynFD::RegisterFDs() {
+    for (RawFD const& fd : positive_cover_->FillFDs()) {
+        RegisterFd(Vertical(schema_.get(), fd.lhs_), *schema_->GetColumn(fd.rhs_), schema_);
+    }
+}
+
+unsigned long long DynFD::ExecuteInternal() {
+    auto const start_time = std::chrono::system_clock::now();
+
+    std::vector<RowInsertion> inserts;
+    std::unordered_set<std::size_t> removed_rows{delete_statement_indices_};
+    if (insert_statements_table_ != nullptr) {
+        while (insert_statements_table_->HasNextRow()) {
+            std::vector<std::string> const row = insert_statements_table_->GetNextRow();
+            if (row.size() != GetNumColumns()) {
+                LOG(WARNING) << "Received row with size " << row.size() << ", but expected "
+                             << GetNumColumns();
+                continue;
+            }
+            inserts.emplace_back(std::nullopt, ParseRow(row.begin()));
+        }
+        insert_statements_table_->Reset();
+    }
+    if (update_statements_table_ != nullptr) {
+        while (update_statements_table_->HasNextRow()) {
+            std::vector<std::string> const row = update_statements_table_->GetNextRow();
+            if (row.size() != GetNumColumns() + 1) {
+                LOG(WARNING) << "Received row with size " << row.size() << ", but expected "
+                             << GetNumColumns() + 1;
+                continue;
+            }
+            std::size_t const row_id = std::stoull(row.front());
+            inserts.emplace_back(row_id, ParseRow(row.begin() + 1));
+            removed_rows.insert(row_id);
+        }
+        update_statements_table_->Reset();
+    }
+
+    // An update is a deletion of the old row followed by an insertion to the same place
+    DeleteRows(removed_rows);
+    InsertRows(inserts);
+    RegisterFDs();
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+}  // namespace algos::dynfd
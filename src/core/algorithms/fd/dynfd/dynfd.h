@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "algorithms/fd/fd_algorithm.h"
+#include "algorithms/fd/hyfd/model/fd_tree.h"
+#include "config/equal_nulls/type.h"
+#include "config/tabular_data/input_table_type.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/dynamic_position_list_index.h"
+#include "model/table/relational_schema.h"
+
+namespace algos::dynfd {
+
+/**
+ * Maintains the minimal FDs of a table under batches of inserted, deleted and updated rows.
+ *
+ * The FDs of the initial table are discovered by HyFD. Afterwards every execution applies the
+ * CRUD options to the table and updates two covers instead of mining the FDs again:
+ *  - the positive cover, the HyFD prefix tree of the minimal FDs;
+ *  - the negative cover, the maximal LHSs that do not determine an attribute. Each of them keeps
+ *    a witness, a pair of rows agreeing on the LHS and disagreeing on the attribute.
+ * Inserted rows may only invalidate FDs. They are compared with the rows from the clusters of
+ * the column PLIs that share their values on the LHS of some FD, the agree sets of violating pairs
+ * extend the negative cover and specialize the positive cover like the HyFD inductor does.
+ * Deleted rows may only make FDs valid, and only those non-FDs whose witness was deleted have to be
+ * checked again. If no other witness exists, the non-FD is replaced by its maximal subsets that are
+ * still violated, and the FDs of the attribute are derived from its negative cover again.
+ *
+ * Inspired by Philipp Schirmer, Thorsten Papenbrock, Sebastian Kruse, Felix Naumann, Dennis
+ * Hempfing, Torben Mayer, and Daniel Neuschäfer-Rube. 2019. DynFD: Functional Dependency Discovery
+ * in Dynamic Datasets. In Proceedings of the 22nd International Conference on Extending Database
+ * Technology (EDBT '19), 253–264. https://doi.org/10.5441/002/edbt.2019.23
+ */
+class DynFD : public FDAlgorithm {
+private:
+    using Witness = std::pair<std::size_t, std::size_t>;
+    using NonFDs = std::map<boost::dynamic_bitset<>, Witness>;
+    using Row = std::vector<int>;
+    using RowInsertion = std::pair<std::optional<std::size_t>, Row>;
+
+    config::InputTable input_table_;
+    config::EqNullsType is_null_equal_null_;
+    config::InputTable insert_statements_table_ = nullptr;
+    config::InputTable update_statements_table_ = nullptr;
+    std::unordered_set<std::size_t> delete_statement_indices_;
+
+    std::shared_ptr<RelationalSchema const> schema_;
+    std::unordered_map<std::string, int> value_dictionary_;
+    int next_value_id_ = 1;
+    static constexpr int kNullValueId = -1;
+
+    /* Encoded values by column. Deleted rows keep their place, updated rows are overwritten */
+    std::vector<std::vector<int>> columns_;
+    std::unordered_set<std::size_t> deleted_rows_;
+    /* PLIs of single columns, the value of a cluster is the encoded value of the column */
+    std::vector<std::unique_ptr<model::DynPLI>> plis_;
+
+    std::shared_ptr<hyfd::fd_tree::FDTree> positive_cover_;
+    /* Maximal non-FDs by RHS */
+    std::vector<NonFDs> negative_cover_;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
+    void LoadDataInternal() final;
+    unsigned long long ExecuteInternal() final;
+    void ResetStateFd() final {}
+
+    int EncodeValue(std::string const& value);
+    Row ParseRow(std::vector<std::string>::const_iterator row_begin);
+
+    std::size_t GetNumColumns() const noexcept {
+        return columns_.size();
+    }
+
+    std::size_t GetNumRowsTotal() const noexcept {
+        return columns_.front().size();
+    }
+
+    bool IsRowIndexValid(std::size_t row) const {
+        return row < GetNumRowsTotal() && !deleted_rows_.contains(row);
+    }
+
+    bool AgreeOn(boost::dynamic_bitset<> const& columns, std::size_t row1, std::size_t row2) const;
+    boost::dynamic_bitset<> GetAgreeSet(std::size_t row1, std::size_t row2) const;
+
+    /* Clusters of the rows which are equal on lhs, without the clusters of single rows */
+    std::vector<std::vector<std::size_t>> GetClusters(boost::dynamic_bitset<> const& lhs) const;
+    std::vector<std::optional<Witness>> FindWitnesses(boost::dynamic_bitset<> const& lhs,
+                                                      boost::dynamic_bitset<> const& rhss) const;
+
+    std::shared_ptr<ColumnLayoutRelationData> CreateRelation() const;
+    void FindInitialCovers();
+    void BuildNegativeCover();
+    void RebuildPositiveCover(std::size_t rhs);
+
+    void DeleteRows(std::unordered_set<std::size_t> const& rows);
+    void GeneralizeNegativeCover(std::size_t rhs, std::vector<boost::dynamic_bitset<>> valid_lhss);
+    void InsertRows(std::vector<RowInsertion> const& rows);
+    NonFDs CollectViolations(std::vector<std::size_t> const& inserted_rows) const;
+
+    void RegisterFDs();
+
+public:
+    DynFD();
+};
+
+}  // namespace algos::dynfd
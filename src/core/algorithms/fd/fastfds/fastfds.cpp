@@ -85,6 +85,7 @@ unsigned long long FastFDs::ExecuteInternal() {
         pool.join();
     } else {
         for (std::unique_ptr<Column> const& column : schema_->GetColumns()) {
+            CheckCancelled();
             task(column);
         }
     }
@@ -267,6 +268,7 @@ vector<FastFDs::DiffSet> FastFDs::GetDiffSetsMod(Column const& col) const {
 
 void FastFDs::GenDiffSets() {
     model::AgreeSetFactory::Configuration c;
+    c.as_gen_method = model::AgreeSetsGenMethod::kUsingCompressedRows;
     c.threads_num = threads_num_;
     if (threads_num_ > 1) {
         // Not implemented properly, check the description of AgreeSetFactory::GenMcParallel()
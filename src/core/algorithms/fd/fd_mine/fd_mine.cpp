@@ -1,17 +1,26 @@
 #include "fd_mine.h"
 
 #include <queue>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/unordered_map.hpp>
 #include <easylogging++.h>
 
+#include "config/thread_number/option.h"
+
 namespace algos {
 
 using boost::dynamic_bitset;
 
 FdMine::FdMine(std::optional<ColumnLayoutRelationDataManager> relation_manager)
-    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {}
+    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void FdMine::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
 
 void FdMine::ResetStateFd() {
     candidate_set_.clear();
@@ -40,17 +49,20 @@ unsigned long long FdMine::ExecuteInternal() {
     for (auto const& candidate : candidate_set_) {
         closure_[candidate] = dynamic_bitset<>(schema_->GetNumColumns());
     }
+    pool_ = threads_num_ > 1 ? std::make_unique<util::WorkerThreadPool>(threads_num_) : nullptr;
 
     // 2
     while (!candidate_set_.empty()) {
+        CheckCancelled();
+        ComputeNonTrivialClosures();
         for (auto const& candidate : candidate_set_) {
-            ComputeNonTrivialClosure(candidate);
             ObtainFDandKey(candidate);
         }
         ObtainEqSet();
         PruneCandidates();
         GenerateNextLevelCandidates();
     }
+    pool_.reset();
 
     // 3
     Reconstruct();
@@ -61,40 +73,61 @@ unsigned long long FdMine::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-void FdMine::ComputeNonTrivialClosure(dynamic_bitset<> const& xi) {
-    if (!closure_.count(xi)) {
-        closure_[xi] = dynamic_bitset<>(xi.size());
+void FdMine::StoreIntersections(std::vector<Intersection> const& intersections) {
+    std::vector<std::shared_ptr<model::PositionListIndex const>> results(intersections.size());
+    auto intersect = [&](std::size_t i) {
+        results[i] = intersections[i].first->Intersect(intersections[i].second);
+    };
+    if (pool_ != nullptr) {
+        pool_->ExecIndex(intersect, intersections.size());
+    } else {
+        for (std::size_t i = 0; i < intersections.size(); ++i) intersect(i);
     }
-    for (size_t column_index = 0; column_index < schema_->GetNumColumns(); column_index++) {
-        if ((relation_indices_ - xi - closure_[xi])[column_index]) {
+    for (std::size_t i = 0; i < intersections.size(); ++i) {
+        plis_[intersections[i].result_indices] = std::move(results[i]);
+    }
+}
+
+void FdMine::ComputeNonTrivialClosures() {
+    struct ClosureCandidate {
+        dynamic_bitset<> const* xi;
+        model::PositionListIndex const* xi_pli;
+        dynamic_bitset<> columns;
+    };
+    std::vector<ClosureCandidate> closure_candidates;
+    std::vector<Intersection> intersections;
+    std::unordered_set<dynamic_bitset<>> intersected;
+
+    // PLIs of every candidate extended by one column that are not known yet are computed first
+    for (auto const& xi : candidate_set_) {
+        if (!closure_.count(xi)) {
+            closure_[xi] = dynamic_bitset<>(xi.size());
+        }
+        model::PositionListIndex const* xi_pli =
+                xi.count() == 1 ? relation_->GetColumnData(xi.find_first()).GetPositionListIndex()
+                                : plis_[xi].get();
+        dynamic_bitset<> columns = relation_indices_ - xi - closure_[xi];
+        for (size_t column_index = columns.find_first(); column_index != dynamic_bitset<>::npos;
+             column_index = columns.find_next(column_index)) {
             dynamic_bitset<> candidate_xy = xi;
-            dynamic_bitset<> candidate_y(schema_->GetNumColumns());
             candidate_xy[column_index] = 1;
-            candidate_y[column_index] = 1;
-
-            if (xi.count() == 1) {
-                auto candidate_x_pli =
-                        relation_->GetColumnData(xi.find_first()).GetPositionListIndex();
-                auto candidate_y_pli =
-                        relation_->GetColumnData(column_index).GetPositionListIndex();
-
-                plis_[candidate_xy] = candidate_x_pli->Intersect(candidate_y_pli);
-
-                if (candidate_x_pli->GetNumCluster() == plis_[candidate_xy]->GetNumCluster()) {
-                    closure_[xi][column_index] = 1;
-                }
-
-                continue;
-            }
-
-            if (!plis_.count(candidate_xy)) {
-                auto candidate_y_pli =
-                        relation_->GetColumnData(candidate_y.find_first()).GetPositionListIndex();
-                plis_[candidate_xy] = plis_[xi]->Intersect(candidate_y_pli);
+            if (!plis_.count(candidate_xy) && intersected.insert(candidate_xy).second) {
+                intersections.push_back(
+                        {std::move(candidate_xy), xi_pli,
+                         relation_->GetColumnData(column_index).GetPositionListIndex()});
             }
+        }
+        closure_candidates.push_back({&xi, xi_pli, std::move(columns)});
+    }
+    StoreIntersections(intersections);
 
-            if (plis_[xi]->GetNumCluster() == plis_[candidate_xy]->GetNumCluster()) {
-                closure_[xi][column_index] = 1;
+    for (auto const& [xi, xi_pli, columns] : closure_candidates) {
+        for (size_t column_index = columns.find_first(); column_index != dynamic_bitset<>::npos;
+             column_index = columns.find_next(column_index)) {
+            dynamic_bitset<> candidate_xy = *xi;
+            candidate_xy[column_index] = 1;
+            if (xi_pli->GetNumCluster() == plis_[candidate_xy]->GetNumCluster()) {
+                closure_[*xi][column_index] = 1;
             }
         }
     }
@@ -148,6 +181,14 @@ void FdMine::PruneCandidates() {
 
 void FdMine::GenerateNextLevelCandidates() {
     std::vector<dynamic_bitset<>> candidates(candidate_set_.begin(), candidate_set_.end());
+    std::vector<Intersection> intersections;
+    std::unordered_set<dynamic_bitset<>> intersected;
+    auto get_pli = [this](dynamic_bitset<> const& candidate) -> model::PositionListIndex const* {
+        if (candidate.count() == 1) {
+            return relation_->GetColumnData(candidate.find_first()).GetPositionListIndex();
+        }
+        return plis_[candidate].get();
+    };
 
     dynamic_bitset<> candidate_i;
     dynamic_bitset<> candidate_j;
@@ -181,15 +222,10 @@ void FdMine::GenerateNextLevelCandidates() {
 
                 if (!(candidate_j).is_subset_of(fd_set_[candidate_i]) &&
                     !(candidate_i).is_subset_of(fd_set_[candidate_j])) {
-                    if (candidate_i.count() == 1) {
-                        auto candidate_i_pli = relation_->GetColumnData(candidate_i.find_first())
-                                                       .GetPositionListIndex();
-                        auto candidate_j_pli = relation_->GetColumnData(candidate_j.find_first())
-                                                       .GetPositionListIndex();
-                        plis_[candidate_ij] = candidate_i_pli->Intersect(candidate_j_pli);
-                    } else {
-                        plis_[candidate_ij] =
-                                plis_[candidate_i]->Intersect(plis_[candidate_j].get());
+                    // The PLI may be known from the closure computation already
+                    if (!plis_.count(candidate_ij) && intersected.insert(candidate_ij).second) {
+                        intersections.push_back({candidate_ij, get_pli(candidate_i),
+                                                 get_pli(candidate_j)});
                     }
 
                     auto closure_ij = closure_[candidate_i] | closure_[candidate_j];
@@ -204,6 +240,7 @@ void FdMine::GenerateNextLevelCandidates() {
 
         candidate_set_.erase(candidate_i);
     }
+    StoreIntersections(intersections);
 }
 
 void FdMine::Reconstruct() {
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <set>
 
 #include <boost/dynamic_bitset.hpp>
 #include <boost/unordered_map.hpp>
 
 #include "algorithms/fd/pli_based_fd_algorithm.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/position_list_index.h"
 #include "model/table/vertical.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -28,7 +31,18 @@ private:
             plis_;
     boost::dynamic_bitset<> relation_indices_;
 
-    void ComputeNonTrivialClosure(boost::dynamic_bitset<> const& xi);
+    config::ThreadNumType threads_num_ = 1;
+    std::unique_ptr<util::WorkerThreadPool> pool_;
+
+    struct Intersection {
+        boost::dynamic_bitset<> result_indices;
+        model::PositionListIndex const* first;
+        model::PositionListIndex const* second;
+    };
+
+    // Intersections are independent, so they are computed by all threads
+    void StoreIntersections(std::vector<Intersection> const& intersections);
+    void ComputeNonTrivialClosures();
     void ObtainFDandKey(boost::dynamic_bitset<> const& xi);
     void ObtainEqSet();
     void PruneCandidates();
@@ -36,6 +50,7 @@ private:
     void Reconstruct();
     void Display();
 
+    void MakeExecuteOptsAvailableFDInternal() final;
     void ResetStateFd() final;
     unsigned long long ExecuteInternal() override;
 
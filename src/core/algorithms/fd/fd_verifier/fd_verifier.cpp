@@ -1,7 +1,9 @@
 #include "algorithms/fd/fd_verifier/fd_verifier.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 
 #include "config/equal_nulls/option.h"
@@ -10,6 +12,9 @@
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/prefix_pli_cache.h"
+#include "model/table/relation_session.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos::fd_verifier {
 
@@ -36,13 +41,12 @@ void FDVerifier::MakeExecuteOptsAvailable() {
 }
 
 void FDVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::GetSharedRelation(*input_table_, is_null_equal_null_);
     input_table_->Reset();
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: FD verifying is meaningless.");
     }
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, is_null_equal_null_);
 }
 
 unsigned long long FDVerifier::ExecuteInternal() {
@@ -82,6 +86,52 @@ std::shared_ptr<model::PLI const> FDVerifier::CalculatePLI(
     return pli;
 }
 
+std::vector<FDStats> FDVerifier::VerifyFDs(
+        std::vector<std::pair<config::IndicesType, config::IndicesType>> fds,
+        config::ThreadNumType threads) const {
+    if (relation_ == nullptr) {
+        throw std::logic_error("Data must be loaded before verifying FDs.");
+    }
+    std::vector<config::IndicesType> combinations;
+    combinations.reserve(fds.size() * 2);
+    for (auto& [lhs, rhs] : fds) {
+        config::NormalizeAndValidateIndices(lhs, relation_->GetNumColumns());
+        config::NormalizeAndValidateIndices(rhs, relation_->GetNumColumns());
+        combinations.push_back(lhs);
+        combinations.push_back(rhs);
+    }
+    model::PrefixPLICache plis(*relation_, combinations);
+
+    // FDs with a common LHS prefix are verified one after another, so PLIs of shared prefixes
+    // are released soon after they are computed.
+    std::vector<std::size_t> order(fds.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&fds](std::size_t i1, std::size_t i2) { return fds[i1] < fds[i2]; });
+
+    std::vector<FDStats> stats(fds.size());
+    auto verify = [&](std::size_t i) {
+        auto const& [lhs, rhs] = fds[order[i]];
+        std::shared_ptr<model::PLI const> lhs_pli = plis.GetPLI(lhs);
+        std::shared_ptr<model::PLI const> rhs_pli = plis.GetPLI(rhs);
+        if (lhs_pli->GetNumCluster() == lhs_pli->Intersect(rhs_pli.get())->GetNumCluster()) {
+            stats[order[i]] = {true, 0, 0, 0};
+            return;
+        }
+        StatsCalculator calculator(relation_, typed_relation_, lhs, rhs);
+        calculator.CalculateStatistics(lhs_pli.get(), rhs_pli.get());
+        stats[order[i]] = {false, calculator.GetNumErrorClusters(), calculator.GetNumErrorRows(),
+                           calculator.GetError()};
+    };
+    if (threads > 1 && fds.size() > 1) {
+        util::WorkerThreadPool pool(threads);
+        pool.ExecIndex(verify, fds.size());
+    } else {
+        for (std::size_t i = 0; i < fds.size(); ++i) verify(i);
+    }
+    return stats;
+}
+
 void FDVerifier::SortHighlightsByProportionAscending() const {
     assert(stats_calculator_);
     stats_calculator_->SortHighlights(StatsCalculator::CompareHighlightsByProportionAscending());
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <deque>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "algorithms/algorithm.h"
@@ -10,9 +11,18 @@
 #include "config/equal_nulls/type.h"
 #include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 
 namespace algos::fd_verifier {
 
+/* Statistics of one of the FDs checked by FDVerifier::VerifyFDs */
+struct FDStats {
+    bool holds;
+    size_t num_error_clusters;
+    size_t num_error_rows;
+    long double error;
+};
+
 /* Algorithm used for verifying a particular FD and retrieving useful information about this FD in
  * case it doesn't hold */
 class FDVerifier : public Algorithm {
@@ -92,6 +102,14 @@ public:
         return stats_calculator_->CompareHighlightsByLhsAscending();
     }
 
+    /* Verifies FDs given as (LHS indices, RHS indices) pairs against the loaded table without
+     * changing the state of the algorithm, the LHS and RHS options do not need to be set.
+     * PLIs of column combinations shared by the FDs are computed once. Returns the statistics
+     * of each FD in the order of the input. */
+    std::vector<FDStats> VerifyFDs(
+            std::vector<std::pair<config::IndicesType, config::IndicesType>> fds,
+            config::ThreadNumType threads = 1) const;
+
     FDVerifier();
 };
 
@@ -1,7 +1,13 @@
 #include "fun.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include <easylogging++.h>
 
+#include "config/thread_number/option.h"
+
 namespace algos {
 
 FunQuadruple FunQuadruple::Union(Column const& that) const {
@@ -21,7 +27,25 @@ bool FunQuadruple::Contains(Vertical const& that) const {
 }
 
 FUN::FUN(std::optional<ColumnLayoutRelationDataManager> relation_manager)
-    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {}
+    : PliBasedFDAlgorithm({kDefaultPhaseName}, relation_manager) {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void FUN::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+template <typename Func>
+void FUN::ForEachIn(Level& level, Func func) const {
+    if (pool_ == nullptr) {
+        for (FunQuadruple& l : level) func(l);
+        return;
+    }
+    std::vector<FunQuadruple*> elements;
+    elements.reserve(level.size());
+    for (FunQuadruple& l : level) elements.push_back(&l);
+    pool_->ExecIndex([&](std::size_t i) { func(*elements[i]); }, elements.size());
+}
 
 void FUN::ResetStateFd() {
     fds_.clear();
@@ -69,9 +93,10 @@ void FUN::PurePrune(Level const& l_k_minus_1, Level& l_k) const {
 }
 
 void FUN::ComputeClosure(Level& l_k_minus_1, Level const& l_k) const {
-    for (FunQuadruple& l : l_k_minus_1) {
+    // Every element only changes its own closure, counts and candidates are only read
+    ForEachIn(l_k_minus_1, [&](FunQuadruple& l) {
         if (IsKey(l)) {
-            continue;
+            return;
         }
         l.SetClosure(l.GetQuasiclosure());
         for (Column const* a : r_prime_.Without(l.GetQuasiclosure()).GetColumns()) {
@@ -79,11 +104,11 @@ void FUN::ComputeClosure(Level& l_k_minus_1, Level const& l_k) const {
                 l.SetClosure(l.GetClosure().Union(*a));
             }
         }
-    }
+    });
 }
 
 void FUN::ComputeQuasiClosure(Level const& l_k_minus_1, Level& l_k) const {
-    for (FunQuadruple& l : l_k) {
+    ForEachIn(l_k, [&](FunQuadruple& l) {
         if (IsKey(l)) {
             l.SetClosure(r_);
         }
@@ -93,29 +118,7 @@ void FUN::ComputeQuasiClosure(Level const& l_k_minus_1, Level& l_k) const {
                 l.SetQuasiclosure(l.GetQuasiclosure().Union(s.GetClosure()));
             }
         }
-    }
-}
-
-unsigned long FUN::Count(Vertical const& l) const {
-    std::vector<ColumnData> const& column_data = relation_->GetColumnData();
-    size_t first_column_index = l.GetColumnIndices().find_first();
-
-    model::PositionListIndex const* pli = column_data.at(first_column_index).GetPositionListIndex();
-
-    if (l.GetColumnIndices().count() == 1) {
-        return pli->GetNumCluster();
-    }
-
-    //  workaround to avoid auto-destruction of plis
-    std::unique_ptr<model::PositionListIndex> holder;
-
-    for (size_t i = l.GetColumnIndices().find_next(first_column_index);
-         i != boost::dynamic_bitset<>::npos; i = l.GetColumnIndices().find_next(i)) {
-        pli->Intersect(column_data.at(i).GetPositionListIndex()).swap(holder);
-        pli = holder.get();
-    }
-
-    return pli->GetNumCluster();
+    });
 }
 
 unsigned long FUN::FastCount(Level const& l_k_minus_1, Level const& l_k,
@@ -134,20 +137,38 @@ unsigned long FUN::FastCount(Level const& l_k_minus_1, Level const& l_k,
 }
 
 std::list<FunQuadruple> FUN::GenerateCandidate(Level const& l_k) const {
-    std::set<FunQuadruple> l_k_plus_1;
+    // Every candidate is counted once, by intersecting the PLI of the first of its subsets that
+    // produces it with the PLI of the added column.
+    std::map<Vertical, std::pair<model::PositionListIndex const*, Column const*>> sources;
     for (FunQuadruple const& l_prime : l_k) {
         if (IsKey(l_prime)) {
             continue;
         }
         for (Column const* a : r_prime_.Without(l_prime.GetCandidate()).GetColumns()) {
-            FunQuadruple l = l_prime.Union(*a);
-            if (l_k_plus_1.find(l) == l_k_plus_1.end()) {
-                l.SetCount(Count(l.GetCandidate()));
-                l_k_plus_1.emplace(l);
-            }
+            sources.try_emplace(l_prime.GetCandidate().Union(*a), l_prime.GetPli().get(), a);
         }
     }
-    return {l_k_plus_1.begin(), l_k_plus_1.end()};
+
+    Level l_k_plus_1;
+    std::vector<std::pair<FunQuadruple*, decltype(sources)::mapped_type>> tasks;
+    tasks.reserve(sources.size());
+    for (auto const& [candidate, source] : sources) {
+        tasks.emplace_back(&l_k_plus_1.emplace_back(candidate), source);
+    }
+    auto count = [&](std::size_t i) {
+        auto const& [l, source] = tasks[i];
+        auto const& [subset_pli, column] = source;
+        std::shared_ptr<model::PositionListIndex const> pli = subset_pli->Intersect(
+                relation_->GetColumnData(column->GetIndex()).GetPositionListIndex());
+        l->SetCount(pli->GetNumCluster());
+        l->SetPli(std::move(pli));
+    };
+    if (pool_ != nullptr) {
+        pool_->ExecIndex(count, tasks.size());
+    } else {
+        for (std::size_t i = 0; i < tasks.size(); ++i) count(i);
+    }
+    return l_k_plus_1;
 }
 
 unsigned long long FUN::ExecuteInternal() {
@@ -156,6 +177,7 @@ unsigned long long FUN::ExecuteInternal() {
     double progress_step = kTotalProgressPercent / (schema_->GetNumColumns() + 1);
     AddProgress(progress_step);
     Vertical empty_vertical = *schema_->empty_vertical_;
+    pool_ = threads_num_ > 1 ? std::make_unique<util::WorkerThreadPool>(threads_num_) : nullptr;
 
     r_ = empty_vertical;
     r_prime_ = empty_vertical;
@@ -163,7 +185,8 @@ unsigned long long FUN::ExecuteInternal() {
     Level l_k;
     for (std::unique_ptr<Column> const& a : schema_->GetColumns()) {
         FunQuadruple attribute(*a);
-        attribute.SetCount(Count(attribute.GetCandidate()));
+        attribute.SetPli(relation_->GetColumnData(a->GetIndex()).GetPliOwnership());
+        attribute.SetCount(attribute.GetPli()->GetNumCluster());
         l_k.push_back(attribute);
         r_ = r_.Union(*a);
         if (!IsKey(attribute)) {
@@ -175,15 +198,20 @@ unsigned long long FUN::ExecuteInternal() {
     }
 
     while (!l_k.empty()) {
+        CheckCancelled();
         ComputeClosure(l_k_minus_1, l_k);
         ComputeQuasiClosure(l_k_minus_1, l_k);
         DisplayFD(l_k_minus_1);
         PurePrune(l_k_minus_1, l_k);
         l_k_minus_1 = l_k;
         l_k = GenerateCandidate(l_k);
+        for (FunQuadruple& l : l_k_minus_1) {
+            l.SetPli(nullptr);
+        }
         AddProgress(progress_step);
     }
     DisplayFD(l_k_minus_1);
+    pool_.reset();
 
     int total_fds = 0;
     for (auto const& [rhs, lverticals] : fds_) {
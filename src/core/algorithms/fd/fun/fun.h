@@ -1,9 +1,13 @@
 #pragma once
 
+#include <memory>
 #include <set>
 
 #include "algorithms/fd/pli_based_fd_algorithm.h"
+#include "config/thread_number/type.h"
+#include "model/table/position_list_index.h"
 #include "util/custom_hashes.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -13,6 +17,8 @@ private:
     unsigned long count_;
     Vertical quasiclosure_;
     Vertical closure_;
+    // Only kept while the next level is generated
+    std::shared_ptr<model::PositionListIndex const> pli_;
 
 public:
     explicit FunQuadruple(Vertical const& candidate)
@@ -39,6 +45,14 @@ public:
         return quasiclosure_;
     }
 
+    std::shared_ptr<model::PositionListIndex const> const& GetPli() const {
+        return pli_;
+    }
+
+    void SetPli(std::shared_ptr<model::PositionListIndex const> pli) {
+        pli_ = std::move(pli);
+    }
+
     void SetCount(unsigned long new_count) {
         count_ = new_count;
     }
@@ -85,17 +99,23 @@ private:
     Vertical r_;
     Vertical r_prime_;
 
+    config::ThreadNumType threads_num_ = 1;
+    std::unique_ptr<util::WorkerThreadPool> pool_;
+
     using Level = std::list<FunQuadruple>;
 
+    void MakeExecuteOptsAvailableFDInternal() final;
     void ResetStateFd() final;
     unsigned long long ExecuteInternal() final;
 
+    // Runs func for every element of the level, in parallel if there are several threads
+    template <typename Func>
+    void ForEachIn(Level& level, Func func) const;
+
     Level GenerateCandidate(Level const& l_k) const;
 
     void ComputeClosure(Level& l_k_minus_1, Level const& l_k) const;
 
-    unsigned long Count(Vertical const& l) const;
-
     unsigned long FastCount(Level const& l_k_minus_1, Level const& l_k,
                             FunQuadruple const& l) const;
 
@@ -74,8 +74,7 @@ public:
 namespace algos::hy {
 
 template <typename F>
-void Sampler::RunWindowImpl(Efficiency& efficiency, model::PositionListIndex const& pli,
-                            F store_match) {
+void Sampler::RunWindowImpl(Efficiency& efficiency, Clusters const& clusters, F store_match) {
     efficiency.IncrementWindow();
 
     size_t const num_attributes = agree_sets_->NumAttributes();
@@ -84,7 +83,7 @@ void Sampler::RunWindowImpl(Efficiency& efficiency, model::PositionListIndex con
     unsigned comparisons = 0;
     unsigned const window = efficiency.GetWindow();
 
-    for (model::PLI::Cluster const& cluster : pli.GetIndex()) {
+    for (model::PLI::Cluster const& cluster : clusters) {
         boost::dynamic_bitset<> equal_attrs(num_attributes);
         for (size_t i = 0; window < cluster.size() && i < cluster.size() - window; ++i) {
             int const pivot_id = cluster[i];
@@ -106,20 +105,20 @@ void Sampler::RunWindowImpl(Efficiency& efficiency, model::PositionListIndex con
 }
 
 std::vector<boost::dynamic_bitset<>> Sampler::RunWindowRet(Efficiency& efficiency,
-                                                           model::PositionListIndex const& pli) {
+                                                           Clusters const& clusters) {
     std::vector<boost::dynamic_bitset<>> matched;
     auto store_match = [&matched](boost::dynamic_bitset<> const& equal_attrs) {
         matched.push_back(equal_attrs);
     };
-    RunWindowImpl(efficiency, pli, store_match);
+    RunWindowImpl(efficiency, clusters, store_match);
     return matched;
 }
 
-void Sampler::RunWindow(Efficiency& efficiency, model::PositionListIndex const& pli) {
+void Sampler::RunWindow(Efficiency& efficiency, Clusters const& clusters) {
     auto store_match = [this](boost::dynamic_bitset<> const& equal_attrs) {
         agree_sets_->Add(equal_attrs);
     };
-    RunWindowImpl(efficiency, pli, store_match);
+    RunWindowImpl(efficiency, clusters, store_match);
 }
 
 void Sampler::ProcessComparisonSuggestions(IdPairs const& comparison_suggestions) {
@@ -134,14 +133,14 @@ void Sampler::ProcessComparisonSuggestions(IdPairs const& comparison_suggestions
 }
 
 void Sampler::SortClustersParallel() {
-    ColumnSlider column_slider(plis_->size());
+    ColumnSlider column_slider(clusters_.size());
     std::vector<boost::unique_future<void>> sort_futures;
-    for (model::PLI* pli : *plis_) {
+    for (Clusters& clusters : clusters_) {
         ClusterComparator cluster_comparator(compressed_records_.get(),
                                              column_slider.GetLeftNeighbor(),
                                              column_slider.GetRightNeighbor());
-        auto sort = [pli, cluster_comparator]() {
-            for (model::PLI::Cluster& cluster : pli->GetIndex()) {
+        auto sort = [&clusters, cluster_comparator]() {
+            for (model::PLI::Cluster& cluster : clusters) {
                 std::sort(cluster.begin(), cluster.end(), cluster_comparator);
             }
         };
@@ -154,12 +153,12 @@ void Sampler::SortClustersParallel() {
 }
 
 void Sampler::SortClustersSeq() {
-    ColumnSlider column_slider(plis_->size());
-    for (model::PLI* pli : *plis_) {
+    ColumnSlider column_slider(clusters_.size());
+    for (Clusters& clusters : clusters_) {
         ClusterComparator cluster_comparator(compressed_records_.get(),
                                              column_slider.GetLeftNeighbor(),
                                              column_slider.GetRightNeighbor());
-        for (model::PLI::Cluster& cluster : pli->GetIndex()) {
+        for (model::PLI::Cluster& cluster : clusters) {
             std::sort(cluster.begin(), cluster.end(), cluster_comparator);
         }
         column_slider.ToNextColumn();
@@ -181,7 +180,7 @@ void Sampler::InitializeEfficiencyQueueParallel() {
     for (size_t attr = 0; attr < plis_->size(); ++attr) {
         auto run_window = [attr, this]() {
             Efficiency efficiency(attr);
-            return std::make_pair(efficiency, RunWindowRet(efficiency, *(*plis_)[attr]));
+            return std::make_pair(efficiency, RunWindowRet(efficiency, clusters_[attr]));
         };
         boost::packaged_task<EfficiencyAndMatches> task(std::move(run_window));
         futures.push_back(task.get_future());
@@ -212,7 +211,7 @@ void Sampler::InitializeEfficiencyQueueParallel() {
 void Sampler::InitializeEfficiencyQueueSeq() {
     for (size_t attr = 0; attr < plis_->size(); ++attr) {
         Efficiency efficiency(attr);
-        RunWindow(efficiency, *(*plis_)[attr]);
+        RunWindow(efficiency, clusters_[attr]);
 
         if (efficiency.CalcEfficiency() > 0) {
             efficiency_queue_.push(efficiency);
@@ -231,6 +230,10 @@ void Sampler::InitializeEfficiencyQueueImpl() {
 void Sampler::InitializeEfficiencyQueue() {
     size_t const num_attributes = plis_->size();
 
+    clusters_.reserve(num_attributes);
+    for (model::PLI const* pli : *plis_) {
+        clusters_.push_back(pli->GetIndex());
+    }
     if (num_attributes >= 3) {
         SortClusters();
     }
@@ -265,7 +268,7 @@ ColumnCombinationList Sampler::GetAgreeSets(IdPairs const& comparison_suggestion
         Efficiency best_efficiency = efficiency_queue_.top();
         efficiency_queue_.pop();
 
-        RunWindow(best_efficiency, *(*plis_)[best_efficiency.GetAttr()]);
+        RunWindow(best_efficiency, clusters_[best_efficiency.GetAttr()]);
 
         if (best_efficiency.CalcEfficiency() > 0) {
             efficiency_queue_.push(best_efficiency);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -23,9 +24,14 @@ namespace algos::hy {
 class Sampler {
 private:
     class Efficiency;
+    using Clusters = std::deque<model::PLI::Cluster>;
+
     double efficiency_threshold_ = kEfficiencyThreshold;
 
     PLIsPtr plis_;
+    // Copies of the clusters of plis_, sorted for the windows. The PLIs may be shared by other
+    // algorithms through a relation session, so they are left intact.
+    std::vector<Clusters> clusters_;
     RowsPtr compressed_records_;
     std::priority_queue<Efficiency> efficiency_queue_;
     std::unique_ptr<AllColumnCombinations> agree_sets_;
@@ -44,10 +50,10 @@ private:
     void Match(boost::dynamic_bitset<>& attributes, size_t first_record_id,
                size_t second_record_id);
     template <typename F>
-    void RunWindowImpl(Efficiency& efficiency, model::PositionListIndex const& pli, F store_match);
+    void RunWindowImpl(Efficiency& efficiency, Clusters const& clusters, F store_match);
     std::vector<boost::dynamic_bitset<>> RunWindowRet(Efficiency& efficiency,
-                                                      model::PositionListIndex const& pli);
-    void RunWindow(Efficiency& efficiency, model::PositionListIndex const& pli);
+                                                      Clusters const& clusters);
+    void RunWindow(Efficiency& efficiency, Clusters const& clusters);
 
 public:
     Sampler(PLIsPtr plis, RowsPtr pli_records, config::ThreadNumType threads = 1);
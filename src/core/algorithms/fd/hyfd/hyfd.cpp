@@ -40,6 +40,7 @@ unsigned long long HyFD::ExecuteInternal() {
     IdPairs comparison_suggestions;
 
     while (true) {
+        CheckCancelled();
         auto non_fds = sampler.GetNonFDs(comparison_suggestions);
 
         inductor.UpdateFdTree(std::move(non_fds));
@@ -11,12 +11,16 @@ class Inductor {
 private:
     std::shared_ptr<fd_tree::FDTree> tree_;
 
-    void SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id);
-
 public:
     explicit Inductor(std::shared_ptr<fd_tree::FDTree> tree) noexcept : tree_(std::move(tree)) {}
 
     void UpdateFdTree(NonFDList&& non_fds);
+
+    /**
+     * Replaces every FD with the given RHS whose LHS is a subset of lhs_bits by its minimal
+     * specializations that are not subsets of lhs_bits.
+     */
+    void SpecializeTreeForNonFd(boost::dynamic_bitset<> const& lhs_bits, size_t rhs_id);
 };
 
 }  // namespace algos::hyfd
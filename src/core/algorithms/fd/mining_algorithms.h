@@ -3,6 +3,7 @@
 #include "algorithms/fd/aidfd/aid.h"
 #include "algorithms/fd/depminer/depminer.h"
 #include "algorithms/fd/dfd/dfd.h"
+#include "algorithms/fd/dynfd/dynfd.h"
 #include "algorithms/fd/fastfds/fastfds.h"
 #include "algorithms/fd/fd_mine/fd_mine.h"
 #include "algorithms/fd/fdep/fdep.h"
@@ -1,14 +1,21 @@
 #include "algorithms/fd/pfd_verifier/pfd_verifier.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
+#include <numeric>
+#include <stdexcept>
 
 #include "algorithms/algorithm.h"
 #include "config/equal_nulls/option.h"
 #include "config/error_measure/option.h"
 #include "config/indices/option.h"
+#include "config/indices/validate_index.h"
 #include "config/names.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/prefix_pli_cache.h"
+#include "model/table/relation_session.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -27,7 +34,7 @@ void PFDVerifier::MakeExecuteOptsAvailable() {
 }
 
 void PFDVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::GetSharedRelation(*input_table_, is_null_equal_null_);
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: pFD verifying is meaningless.");
     }
@@ -58,6 +65,46 @@ std::shared_ptr<model::PLI const> PFDVerifier::CalculatePLI(
     return pli;
 }
 
+std::vector<PFDStats> PFDVerifier::VerifyPFDs(
+        std::vector<std::pair<config::IndicesType, config::IndicesType>> pfds,
+        config::PfdErrorMeasureType error_measure, config::ThreadNumType threads) const {
+    if (relation_ == nullptr) {
+        throw std::logic_error("Data must be loaded before verifying pFDs.");
+    }
+    std::vector<config::IndicesType> combinations;
+    combinations.reserve(pfds.size() * 2);
+    for (auto& [lhs, rhs] : pfds) {
+        config::NormalizeAndValidateIndices(lhs, relation_->GetNumColumns());
+        config::NormalizeAndValidateIndices(rhs, relation_->GetNumColumns());
+        combinations.push_back(lhs);
+        combinations.push_back(rhs);
+    }
+    model::PrefixPLICache plis(*relation_, combinations);
+
+    std::vector<std::size_t> order(pfds.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&pfds](std::size_t i1, std::size_t i2) { return pfds[i1] < pfds[i2]; });
+
+    std::vector<PFDStats> stats(pfds.size());
+    auto verify = [&](std::size_t i) {
+        auto const& [lhs, rhs] = pfds[order[i]];
+        std::shared_ptr<model::PLI const> lhs_pli = plis.GetPLI(lhs);
+        std::shared_ptr<model::PLI const> rhs_pli = plis.GetPLI(rhs);
+        PFDStatsCalculator calculator(relation_, error_measure);
+        calculator.CalculateStatistics(lhs_pli.get(), lhs_pli->Intersect(rhs_pli.get()).get());
+        stats[order[i]] = {calculator.GetNumViolatingClusters(), calculator.GetNumViolatingRows(),
+                           calculator.GetError()};
+    };
+    if (threads > 1 && pfds.size() > 1) {
+        util::WorkerThreadPool pool(threads);
+        pool.ExecIndex(verify, pfds.size());
+    } else {
+        for (std::size_t i = 0; i < pfds.size(); ++i) verify(i);
+    }
+    return stats;
+}
+
 PFDVerifier::PFDVerifier() : Algorithm({}) {
     using namespace config::names;
     RegisterOptions();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "algorithms/algorithm.h"
@@ -11,9 +12,17 @@
 #include "config/error_measure/type.h"
 #include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 
 namespace algos {
 
+/* Statistics of one of the pFDs checked by PFDVerifier::VerifyPFDs */
+struct PFDStats {
+    size_t num_violating_clusters;
+    size_t num_violating_rows;
+    config::ErrorType error;
+};
+
 class PFDVerifier : public Algorithm {
 private:
     config::InputTable input_table_;
@@ -60,6 +69,14 @@ public:
         return stats_calculator_->GetError();
     }
 
+    /* Checks every (LHS indices, RHS indices) pair against the loaded table with the given
+     * error measure, reusing PLIs of column combinations the pFDs have in common. The state of
+     * the algorithm is not changed. Statistics are returned in the order of the input. */
+    std::vector<PFDStats> VerifyPFDs(
+            std::vector<std::pair<config::IndicesType, config::IndicesType>> pfds,
+            config::PfdErrorMeasureType error_measure = +PfdErrorMeasure::per_tuple,
+            config::ThreadNumType threads = 1) const;
+
     PFDVerifier();
 };
 
@@ -1,5 +1,10 @@
 #include "pli_based_fd_algorithm.h"
 
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
 #include "config/equal_nulls/option.h"
 #include "config/tabular_data/input_table/option.h"
 
@@ -31,6 +36,48 @@ void PliBasedFDAlgorithm::LoadDataInternal() {
     }
 }
 
+// An FD is written as a line of LHS column indices, followed by "->" and the RHS column index
+std::string PliBasedFDAlgorithm::SerializeResult() const {
+    std::ostringstream out;
+    for (FD const& fd : FdList()) {
+        for (model::ColumnIndex index : fd.GetLhsIndices()) {
+            out << index << ' ';
+        }
+        out << "-> " << fd.GetRhsIndex() << '\n';
+    }
+    return out.str();
+}
+
+void PliBasedFDAlgorithm::LoadResult(std::string const& data) {
+    std::shared_ptr<RelationalSchema const> const& schema = relation_->GetSharedPtrSchema();
+    std::size_t const num_columns = schema->GetNumColumns();
+    auto parse_index = [num_columns](std::string const& token) {
+        model::ColumnIndex index;
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), index);
+        if (error != std::errc{} || end != token.data() + token.size() || index >= num_columns) {
+            throw std::invalid_argument("Invalid column index \"" + token + '"');
+        }
+        return index;
+    };
+
+    std::istringstream in{data};
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream line_in{line};
+        boost::dynamic_bitset<> lhs(num_columns);
+        std::string token;
+        while (line_in >> token && token != "->") {
+            lhs.set(parse_index(token));
+        }
+        if (token != "->" || !(line_in >> token)) {
+            throw std::invalid_argument("Malformed FD \"" + line + '"');
+        }
+        model::ColumnIndex const rhs = parse_index(token);
+        fd_collection_.Register(schema->GetVertical(std::move(lhs)), *schema->GetColumn(rhs),
+                                schema);
+    }
+}
+
 std::vector<Column const*> PliBasedFDAlgorithm::GetKeys() const {
     assert(relation_ != nullptr);
 
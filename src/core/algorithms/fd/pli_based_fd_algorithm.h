@@ -1,11 +1,13 @@
 #pragma once
 
 #include <optional>
+#include <string>
 
 #include "config/equal_nulls/type.h"
 #include "config/tabular_data/input_table_type.h"
 #include "fd_algorithm.h"
 #include "model/table/column_layout_relation_data.h"
+#include "model/table/relation_session.h"
 
 namespace algos {
 
@@ -27,8 +29,7 @@ public:
 
         std::shared_ptr<ColumnLayoutRelationData> GetRelation() const {
             if (*relation_ == nullptr)
-                *relation_ =
-                        ColumnLayoutRelationData::CreateFrom(**input_table_, *is_null_equal_null_);
+                *relation_ = model::GetSharedRelation(**input_table_, *is_null_equal_null_);
             return *relation_;
         }
     };
@@ -45,6 +46,13 @@ protected:
 
     void LoadDataInternal() final;
 
+    bool CanCacheResult() const noexcept override {
+        return true;
+    }
+
+    std::string SerializeResult() const override;
+    void LoadResult(std::string const& data) override;
+
     ColumnLayoutRelationData const& GetRelation() const noexcept {
         // GetRelation should be called after the dataset has been parsed, i.e. after algorithm
         // execution
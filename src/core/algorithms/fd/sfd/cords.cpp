@@ -1,6 +1,7 @@
 #include "cords.h"
 
 #include <chrono>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -9,11 +10,14 @@
 #include "config/option.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
 #include "contingency_table.h"
 #include "frequency_handler.h"
 #include "model/table/column_index.h"
+#include "model/table/relation_session.h"
 #include "model/table/typed_column_data.h"
 #include "sample.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 Cords::Cords() : FDAlgorithm({kFirstPhaseName, kSecondPhaseName}) {
@@ -69,6 +73,8 @@ void Cords::RegisterOptions() {
                     .SetValueCheck(check_positive));
 
     RegisterOption(Option{&fixed_sample_, kFixedSample, kDFixedSample, false});
+    RegisterOption(Option{&frequency_sketch_, kFrequencySketch, kDFrequencySketch, false});
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void Cords::MakeExecuteOptsAvailableFDInternal() {
@@ -76,7 +82,7 @@ void Cords::MakeExecuteOptsAvailableFDInternal() {
     MakeOptionsAvailable({kOnlySFD, kMinCard, kMaxDiffValsProportion, kMinSFDStrengthMeasure,
                           kMinSkewThreshold, kMinStructuralZeroesAmount,
                           kMaxFalsePositiveProbability, kDelta, kMaxAmountOfCategories,
-                          kFixedSample});
+                          kFixedSample, kFrequencySketch, config::kThreadNumberOpt.GetName()});
 }
 
 void Cords::ResetStateFd() {
@@ -88,24 +94,34 @@ void Cords::ResetStateFd() {
 }
 
 void Cords::LoadDataInternal() {
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, is_null_equal_null_);
 }
 
-bool Cords::DetectSFD(Sample const &smp) {
+bool Cords::DetectSFD(Sample const &smp) const {
     return smp.GetConcatCardinality() <= max_diff_vals_proportion_ * smp.GetRowIndices().size() &&
            (smp.GetLhsCardinality() >=
             (1 - min_sfd_strength_measure_) * smp.GetConcatCardinality());
 }
 
-void Cords::SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                         std::vector<model::TypedColumnData> const &data, Sample &smp) {
+void Cords::SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k, Sample &smp) const {
     for (model::ColumnIndex col_ind : {col_i, col_k}) {
+        if (is_skewed_[col_ind]) {
+            smp.Filter(handler_, col_ind);
+        }
+    }
+}
+
+void Cords::Init(model::ColumnIndex columns, std::vector<model::TypedColumnData> const &data,
+                 util::WorkerThreadPool *pool) {
+    is_skewed_.assign(columns, false);
+    domains_.assign(columns, 0);
+    handler_.InitFrequencyHandler(data, columns, max_amount_of_categories_, frequency_sketch_,
+                                  pool);
+    for (model::ColumnIndex col_ind = 0; col_ind < columns; ++col_ind) {
         if (handler_.GetColumnFrequencySum(col_ind) >=
             (1 - min_skew_threshold_) * data[col_ind].GetNumRows()) {
             is_skewed_[col_ind] = true;
             domains_[col_ind] = handler_.ColumnFrequencyMapSize(col_ind);
-            smp.Filter(handler_, data, col_ind);
         } else {
             domains_[col_ind] =
                     std::min(handler_.GetColumnCardinality(col_ind), max_amount_of_categories_);
@@ -113,12 +129,6 @@ void Cords::SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k,
     }
 }
 
-void Cords::Init(model::ColumnIndex columns, std::vector<model::TypedColumnData> const &data) {
-    is_skewed_.resize(columns, false);
-    domains_.resize(columns, 0);
-    handler_.InitFrequencyHandler(data, columns, max_amount_of_categories_);
-}
-
 void Cords::RegisterCorrelation(model::ColumnIndex lhs_ind, model::ColumnIndex rhs_ind) {
     Column lhs_col(typed_relation_->GetSchema(),
                    typed_relation_->GetSchema()->GetColumn(lhs_ind)->GetName(), lhs_ind);
@@ -128,15 +138,34 @@ void Cords::RegisterCorrelation(model::ColumnIndex lhs_ind, model::ColumnIndex r
     correlations_collection_.Register(std::move(correlation_to_register));
 }
 
-bool Cords::CheckCorrelation(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                             std::vector<model::TypedColumnData> const &data, Sample &smp) {
-    SkewHandling(col_i, col_k, data, smp);
+bool Cords::CheckCorrelation(model::ColumnIndex col_i, model::ColumnIndex col_k, Sample &smp,
+                             ContingencyTable &table) const {
+    SkewHandling(col_i, col_k, smp);
 
-    ContingencyTable cont_table(col_i, col_k, domains_);
-    cont_table.FillTable(smp, data, handler_, is_skewed_, domains_);
+    table.Reset(col_i, col_k, domains_);
+    table.FillTable(smp, handler_, is_skewed_, domains_);
+
+    return table.TooMuchStructuralZeroes(domains_, min_structural_zeroes_proportion_) ||
+           table.ChiSquaredTest(smp, domains_, max_false_positive_probability_);
+}
+
+Cords::PairResult Cords::ProcessPair(model::ColumnIndex col_i, model::ColumnIndex col_k,
+                                     size_t row_count, PairBuffers &buffers) const {
+    unsigned long long sample_size = Sample::CalculateSampleSize(
+            handler_.GetColumnCardinality(col_i), handler_.GetColumnCardinality(col_k),
+            max_false_positive_probability_, delta_);
+
+    Sample smp(fixed_sample_, sample_size, row_count, col_i, col_k, handler_,
+               typed_relation_->GetSchema(), buffers.sample);
+
+    if (DetectSFD(smp)) {
+        return PairResult::kSoftFd;
+    }
 
-    return cont_table.TooMuchStructuralZeroes(domains_, min_structural_zeroes_proportion_) ||
-           cont_table.ChiSquaredTest(smp, domains_, max_false_positive_probability_);
+    if (!only_sfd_ && CheckCorrelation(col_i, col_k, smp, buffers.table)) {
+        return PairResult::kCorrelation;
+    }
+    return PairResult::kNone;
 }
 
 bool Cords::IsSoftOrTrivial(model::ColumnIndex col_ind, size_t row_count) {
@@ -161,7 +190,12 @@ unsigned long long Cords::ExecuteInternal() {
     size_t row_count = data.front().GetNumRows();
     model::ColumnIndex column_count = data.size();
 
-    Init(column_count, data);
+    std::unique_ptr<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool = std::make_unique<util::WorkerThreadPool>(threads_num_);
+    }
+
+    Init(column_count, data, pool.get());
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
@@ -181,35 +215,38 @@ unsigned long long Cords::ExecuteInternal() {
         return {ind1, ind2};
     };
 
+    std::vector<std::pair<model::ColumnIndex, model::ColumnIndex>> pairs;
     for (model::ColumnIndex ind1 = 0; ind1 < column_count - 1; ind1++) {
         if (is_soft_or_trivial[ind1]) continue;
 
         for (model::ColumnIndex ind2 = ind1 + 1; ind2 < column_count; ind2++) {
             if (is_soft_or_trivial[ind2]) continue;
 
-            auto [col_i, col_k] = sort_indices_by_cardinality(ind1, ind2);
-
-            unsigned long long sample_size = Sample::CalculateSampleSize(
-                    handler_.GetColumnCardinality(col_i), handler_.GetColumnCardinality(col_k),
-                    max_false_positive_probability_, delta_);
-
-            Sample smp(fixed_sample_, sample_size, row_count, col_i, col_k, data,
-                       typed_relation_->GetSchema());
-
-            bool sfd_detected = DetectSFD(smp);
-
-            if (sfd_detected) {
-                RegisterFd(smp.GetLhsVertical(), smp.GetRhsColumn(),
-                           typed_relation_->GetSharedPtrSchema());
-            }
+            pairs.push_back(sort_indices_by_cardinality(ind1, ind2));
+        }
+    }
 
-            if (sfd_detected || only_sfd_) {
-                continue;
-            }
+    std::vector<PairResult> results(pairs.size());
+    auto process_pair = [this, &pairs, &results, row_count](size_t i, PairBuffers &buffers) {
+        results[i] = ProcessPair(pairs[i].first, pairs[i].second, row_count, buffers);
+    };
+    if (pool != nullptr) {
+        pool->ExecIndexWithResource(process_pair, []() { return PairBuffers{}; }, pairs.size());
+    } else {
+        PairBuffers buffers;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            process_pair(i, buffers);
+        }
+    }
 
-            if (CheckCorrelation(col_i, col_k, data, smp)) {
-                RegisterCorrelation(col_i, col_k);
-            }
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        auto [col_i, col_k] = pairs[i];
+        if (results[i] == PairResult::kSoftFd) {
+            RegisterFd(Vertical(*typed_relation_->GetSchema()->GetColumn(col_i)),
+                       *typed_relation_->GetSchema()->GetColumn(col_k),
+                       typed_relation_->GetSharedPtrSchema());
+        } else if (results[i] == PairResult::kCorrelation) {
+            RegisterCorrelation(col_i, col_k);
         }
     }
 
@@ -8,6 +8,7 @@
 #include "algorithms/fd/fd_algorithm.h"
 #include "config/equal_nulls/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "contingency_table.h"
 #include "correlation.h"
 #include "frequency_handler.h"
@@ -16,17 +17,25 @@
 #include "model/table/column_layout_typed_relation_data.h"
 #include "sample.h"
 
+namespace util {
+class WorkerThreadPool;
+}  // namespace util
+
 namespace algos {
+/* Column pairs are independent and are evaluated in parallel if threads > 1. Skew of a column does
+ * not depend on the pair, so it is decided once per column beforehand. */
 class Cords : public FDAlgorithm {
 private:
     using TypedRelation = model::ColumnLayoutTypedRelationData;
     using CorrelationCollection = util::PrimitiveCollection<Correlation>;
     config::InputTable input_table_;
     config::EqNullsType is_null_equal_null_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    std::shared_ptr<TypedRelation> typed_relation_;
 
     bool only_sfd_;
     bool fixed_sample_ = false;
+    bool frequency_sketch_ = false;
+    config::ThreadNumType threads_num_ = 1;
 
     long double minimum_cardinality_;
     long double max_diff_vals_proportion_;
@@ -52,19 +61,30 @@ private:
 
     unsigned long long ExecuteInternal() override;
 
-    void Init(model::ColumnIndex columns, std::vector<model::TypedColumnData> const &data);
+    enum class PairResult : char { kNone, kSoftFd, kCorrelation };
+
+    /* Per-thread memory reused between column pairs */
+    struct PairBuffers {
+        Sample::Buffers sample;
+        ContingencyTable table;
+    };
 
-    bool DetectSFD(Sample const &smp);
+    void Init(model::ColumnIndex columns, std::vector<model::TypedColumnData> const &data,
+              util::WorkerThreadPool *pool);
+
+    bool DetectSFD(Sample const &smp) const;
 
     // bool DetectAndRegisterSFD(Sample const &smp);
 
-    void SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                      std::vector<model::TypedColumnData> const &data, Sample &smp);
+    void SkewHandling(model::ColumnIndex col_i, model::ColumnIndex col_k, Sample &smp) const;
 
     bool IsSoftOrTrivial(model::ColumnIndex col_ind, size_t row_count);
 
-    bool CheckCorrelation(model::ColumnIndex col_i, model::ColumnIndex col_k,
-                          std::vector<model::TypedColumnData> const &data, Sample &smp);
+    bool CheckCorrelation(model::ColumnIndex col_i, model::ColumnIndex col_k, Sample &smp,
+                          ContingencyTable &table) const;
+
+    PairResult ProcessPair(model::ColumnIndex col_i, model::ColumnIndex col_k, size_t row_count,
+                           PairBuffers &buffers) const;
 
     void RegisterCorrelation(model::ColumnIndex lhs_ind, model::ColumnIndex rhs_ind);
 
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace algos {
+
+/* Count-min sketch of value frequencies. Estimates never underestimate the frequency and exceed
+ * it by at most 2 * (total count) / kWidth with probability 1 - 2^(-kDepth). Values are given by
+ * their hashes. */
+class CountMinSketch {
+private:
+    static constexpr std::size_t kDepth = 4;
+    static constexpr std::size_t kWidthBits = 14;
+    static constexpr std::size_t kWidth = std::size_t{1} << kWidthBits;
+    static constexpr std::array<std::uint64_t, kDepth> kSeeds = {
+            0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL,
+            0xd6e8feb86659fd93ULL};
+
+    std::vector<std::size_t> counters_ = std::vector<std::size_t>(kDepth * kWidth, 0);
+
+    static std::size_t Cell(std::size_t row, std::uint64_t hash) {
+        std::uint64_t x = hash ^ kSeeds[row];
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return row * kWidth + (x >> (64 - kWidthBits));
+    }
+
+public:
+    // Adds one occurrence of the value and returns the new estimate of its frequency.
+    std::size_t Add(std::uint64_t hash) {
+        std::size_t estimate = static_cast<std::size_t>(-1);
+        for (std::size_t row = 0; row < kDepth; ++row) {
+            estimate = std::min(estimate, ++counters_[Cell(row, hash)]);
+        }
+        return estimate;
+    }
+};
+
+}  // namespace algos
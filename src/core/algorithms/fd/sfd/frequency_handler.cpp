@@ -1,49 +1,150 @@
 #include "frequency_handler.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "algorithms/ind/faida/inclusion_testing/hyperloglog.h"
+#include "count_min_sketch.h"
 #include "model/table/column_index.h"
 #include "model/table/tuple_index.h"
 #include "model/table/typed_column_data.h"
+#include "util/worker_thread_pool.h"
+
+namespace {
+
+// HyperLogLog uses the leading bits of a hash, which std::hash does not spread well enough.
+std::uint64_t Mix(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+constexpr std::uint8_t kHyperLogLogBits = 14;
+
+}  // namespace
 
 namespace algos {
 void FrequencyHandler::InitFrequencyHandler(std::vector<model::TypedColumnData> const &data,
                                             model::ColumnIndex columns,
-                                            size_t max_amount_of_categories) {
-    cardinality_.resize(columns, 0);
-    frequency_maps_.resize(columns);
-    freq_sums_.resize(columns, 0);
-    for (model::ColumnIndex col_ind = 0; col_ind < data.size(); col_ind++) {
-        std::unordered_map<std::string, size_t> value_frequency_counter;
-        auto const &col_data = data[col_ind];
-        for (model::TupleIndex row_ind = 0; row_ind < col_data.GetNumRows(); row_ind++) {
-            auto &freq = value_frequency_counter[col_data.GetDataAsString(row_ind)];
-            if (freq == 0) cardinality_[col_ind]++;
-            ++freq;
+                                            size_t max_amount_of_categories, bool sketch,
+                                            util::WorkerThreadPool *pool) {
+    data_ = &data;
+    sketch_ = sketch;
+    cardinality_.assign(columns, 0);
+    frequency_maps_.assign(columns, {});
+    freq_sums_.assign(columns, 0);
+    row_codes_.assign(sketch ? 0 : columns, {});
+    code_ordinals_.assign(sketch ? 0 : columns, {});
+    code_hashes_.assign(sketch ? 0 : columns, {});
+    hash_ordinals_.assign(sketch ? columns : 0, {});
+
+    auto process_column = [this, max_amount_of_categories](model::ColumnIndex col_ind) {
+        if (sketch_) {
+            SketchColumn(col_ind, max_amount_of_categories);
+        } else {
+            EncodeColumn(col_ind, max_amount_of_categories);
+        }
+    };
+    if (pool != nullptr) {
+        pool->ExecIndex(process_column, data.size());
+    } else {
+        for (model::ColumnIndex col_ind = 0; col_ind < data.size(); col_ind++) {
+            process_column(col_ind);
         }
-        std::vector<std::pair<std::string, size_t>> values_ordered_by_frequencies(
-                value_frequency_counter.begin(), value_frequency_counter.end());
-
-        auto cmp = [](std::pair<std::string, size_t> const &left,
-                      std::pair<std::string, size_t> const &right) {
-            return left.second > right.second;
-        };
-
-        std::sort(values_ordered_by_frequencies.begin(), values_ordered_by_frequencies.end(), cmp);
-
-        for (size_t ordinal_number = 0;
-             ordinal_number <
-             std::min(max_amount_of_categories, values_ordered_by_frequencies.size());
-             ordinal_number++) {
-            auto const &[value, freq] = values_ordered_by_frequencies[ordinal_number];
-            frequency_maps_[col_ind][value] = ordinal_number;
-            freq_sums_[col_ind] += freq;
+    }
+}
+
+void FrequencyHandler::EncodeColumn(model::ColumnIndex col_ind, size_t max_amount_of_categories) {
+    auto const &col_data = (*data_)[col_ind];
+    std::vector<ValueId> &codes = row_codes_[col_ind];
+    std::unordered_map<std::string, ValueId> dictionary;
+    std::vector<size_t> frequencies;
+    codes.reserve(col_data.GetNumRows());
+    for (model::TupleIndex row_ind = 0; row_ind < col_data.GetNumRows(); row_ind++) {
+        auto [it, inserted] =
+                dictionary.try_emplace(col_data.GetDataAsString(row_ind), frequencies.size());
+        if (inserted) frequencies.push_back(0);
+        ++frequencies[it->second];
+        codes.push_back(it->second);
+    }
+    cardinality_[col_ind] = dictionary.size();
+
+    std::vector<std::string const *> values(dictionary.size());
+    std::vector<std::pair<ValueId, size_t>> values_ordered_by_frequencies;
+    values_ordered_by_frequencies.reserve(dictionary.size());
+    for (auto const &[value, code] : dictionary) {
+        values[code] = &value;
+        values_ordered_by_frequencies.emplace_back(code, frequencies[code]);
+    }
+
+    auto cmp = [](std::pair<ValueId, size_t> const &left,
+                  std::pair<ValueId, size_t> const &right) { return left.second > right.second; };
+
+    std::sort(values_ordered_by_frequencies.begin(), values_ordered_by_frequencies.end(), cmp);
+
+    code_ordinals_[col_ind].assign(dictionary.size(), kNotFrequent);
+    for (size_t ordinal_number = 0;
+         ordinal_number < std::min(max_amount_of_categories, values_ordered_by_frequencies.size());
+         ordinal_number++) {
+        auto const &[code, freq] = values_ordered_by_frequencies[ordinal_number];
+        frequency_maps_[col_ind][*values[code]] = ordinal_number;
+        code_ordinals_[col_ind][code] = ordinal_number;
+        freq_sums_[col_ind] += freq;
+    }
+
+    code_hashes_[col_ind].reserve(dictionary.size());
+    for (std::string const *value : values) {
+        code_hashes_[col_ind].push_back(std::hash<std::string>{}(*value));
+    }
+}
+
+/* The most frequent values are tracked along with the sketch: a value replaces the least frequent
+ * tracked one as soon as its estimated frequency exceeds that one's. */
+void FrequencyHandler::SketchColumn(model::ColumnIndex col_ind, size_t max_amount_of_categories) {
+    auto const &col_data = (*data_)[col_ind];
+    CountMinSketch sketch;
+    hll::HyperLogLog distinct(kHyperLogLogBits);
+    std::unordered_map<size_t, std::pair<std::string, size_t>> tracked;
+    std::set<std::pair<size_t, size_t>> tracked_by_frequency;
+
+    for (model::TupleIndex row_ind = 0; row_ind < col_data.GetNumRows(); row_ind++) {
+        std::string value = col_data.GetDataAsString(row_ind);
+        size_t const hash = std::hash<std::string>{}(value);
+        distinct.add_hash(Mix(hash));
+        size_t const estimate = sketch.Add(hash);
+
+        if (auto it = tracked.find(hash); it != tracked.end()) {
+            tracked_by_frequency.erase({it->second.second, hash});
+            it->second.second = estimate;
+        } else if (tracked.size() < max_amount_of_categories) {
+            tracked.try_emplace(hash, std::move(value), estimate);
+        } else if (tracked_by_frequency.begin()->first < estimate) {
+            tracked.erase(tracked_by_frequency.begin()->second);
+            tracked_by_frequency.erase(tracked_by_frequency.begin());
+            tracked.try_emplace(hash, std::move(value), estimate);
+        } else {
+            continue;
         }
+        tracked_by_frequency.emplace(estimate, hash);
+    }
+
+    if (col_data.GetNumRows() != 0) {
+        cardinality_[col_ind] = std::max<size_t>(1, std::llround(distinct.estimate()));
+    }
+    size_t ordinal_number = 0;
+    for (auto it = tracked_by_frequency.rbegin(); it != tracked_by_frequency.rend(); ++it) {
+        auto const &[estimate, hash] = *it;
+        frequency_maps_[col_ind][tracked.at(hash).first] = ordinal_number;
+        hash_ordinals_[col_ind][hash] = ordinal_number++;
+        freq_sums_[col_ind] += estimate;
     }
+    freq_sums_[col_ind] = std::min(freq_sums_[col_ind], col_data.GetNumRows());
 }
 
 }  // namespace algos
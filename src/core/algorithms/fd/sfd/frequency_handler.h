@@ -1,22 +1,55 @@
 #pragma once
 
+#include <functional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "model/table/column_index.h"
+#include "model/table/tuple_index.h"
 #include "model/table/typed_column_data.h"
 
+namespace util {
+class WorkerThreadPool;
+}  // namespace util
+
 namespace algos {
 
+/* Frequencies of the values of every column. Values of rows are dictionary-encoded once, so that
+ * samples and contingency tables work with value codes instead of hashing strings.
+ * In sketch mode no codes are stored: frequencies of the most frequent values are estimated with
+ * a count-min sketch and cardinalities with HyperLogLog in a single pass over a column, values
+ * are identified by their hashes, which are calculated when a row is requested. Intended for
+ * columns with too many distinct values to keep a dictionary for. */
 class FrequencyHandler {
+public:
+    /* Code of a value in its column, hash of the value in sketch mode */
+    using ValueId = size_t;
+
 private:
+    static constexpr size_t kNotFrequent = static_cast<size_t>(-1);
+
+    std::vector<model::TypedColumnData> const *data_ = nullptr;
+    bool sketch_ = false;
+
     std::vector<size_t> cardinality_;
     std::vector<size_t> freq_sums_;
     std::vector<std::unordered_map<std::string, size_t>> frequency_maps_;
 
+    std::vector<std::vector<ValueId>> row_codes_;
+    /* Ordinal numbers among the most frequent values and hashes of values, by value code */
+    std::vector<std::vector<size_t>> code_ordinals_;
+    std::vector<std::vector<size_t>> code_hashes_;
+    /* Sketch mode: ordinal numbers of the most frequent values, by value hash */
+    std::vector<std::unordered_map<size_t, size_t>> hash_ordinals_;
+
+    void EncodeColumn(model::ColumnIndex col_ind, size_t max_amount_of_categories);
+    void SketchColumn(model::ColumnIndex col_ind, size_t max_amount_of_categories);
+
 public:
     void InitFrequencyHandler(std::vector<model::TypedColumnData> const &data,
-                              model::ColumnIndex columns, size_t max_amount_of_categories);
+                              model::ColumnIndex columns, size_t max_amount_of_categories,
+                              bool sketch = false, util::WorkerThreadPool *pool = nullptr);
 
     [[nodiscard]] size_t GetColumnFrequencySum(model::ColumnIndex col_ind) const {
         return freq_sums_[col_ind];
@@ -36,6 +69,29 @@ public:
         return frequency_maps_[col_ind].find(val) != frequency_maps_[col_ind].end();
     }
 
+    [[nodiscard]] ValueId GetValueId(model::ColumnIndex col_ind, model::TupleIndex row) const {
+        if (sketch_) {
+            return std::hash<std::string>{}((*data_)[col_ind].GetDataAsString(row));
+        }
+        return row_codes_[col_ind][row];
+    }
+
+    [[nodiscard]] bool IsFrequent(model::ColumnIndex col_ind, ValueId value) const {
+        return GetValueOrdinalNumber(col_ind, value) != kNotFrequent;
+    }
+
+    [[nodiscard]] size_t GetValueOrdinalNumber(model::ColumnIndex col_ind, ValueId value) const {
+        if (sketch_) {
+            auto it = hash_ordinals_[col_ind].find(value);
+            return it == hash_ordinals_[col_ind].end() ? kNotFrequent : it->second;
+        }
+        return code_ordinals_[col_ind][value];
+    }
+
+    [[nodiscard]] size_t GetValueHash(model::ColumnIndex col_ind, ValueId value) const {
+        return sketch_ ? value : code_hashes_[col_ind][value];
+    }
+
     [[nodiscard]] size_t Size() const {
         return frequency_maps_.size();
     }
@@ -48,6 +104,10 @@ public:
         cardinality_.clear();
         frequency_maps_.clear();
         freq_sums_.clear();
+        row_codes_.clear();
+        code_ordinals_.clear();
+        code_hashes_.clear();
+        hash_ordinals_.clear();
     }
 };
 }  // namespace algos
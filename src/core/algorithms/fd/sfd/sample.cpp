@@ -1,39 +1,51 @@
 #include "sample.h"
 
+#include <algorithm>
 #include <chrono>
 #include <random>
-#include <string>
-#include <unordered_set>
 #include <vector>
 
 #include "frequency_handler.h"
 #include "model/table/tuple_index.h"
 
+namespace {
+
+template <typename T>
+size_t CountDistinct(std::vector<T> &values) {
+    std::sort(values.begin(), values.end());
+    return std::unique(values.begin(), values.end()) - values.begin();
+}
+
+}  // namespace
+
 namespace algos {
 Sample::Sample(bool fixed_sample, unsigned long long sample_size, model::TupleIndex rows,
-               model::ColumnIndex lhs, model::ColumnIndex rhs,
-               std::vector<model::TypedColumnData> const &data, RelationalSchema const *rel_schema_)
+               model::ColumnIndex lhs, model::ColumnIndex rhs, FrequencyHandler const &handler,
+               RelationalSchema const *rel_schema_, Buffers &buffers)
     : lhs_col_(rel_schema_, rel_schema_->GetColumn(lhs)->GetName(), lhs),
       rhs_col_(rel_schema_, rel_schema_->GetColumn(rhs)->GetName(), rhs) {
     auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
     std::mt19937 gen(seed);
     std::uniform_int_distribution<model::TupleIndex> distribution(0, rows - 1);
 
-    std::unordered_set<std::string> map_lhs;
-    std::unordered_set<std::string> map_rhs;
-    std::unordered_set<std::string> map_cardinality;
+    buffers.lhs_values.clear();
+    buffers.rhs_values.clear();
+    buffers.pairs.clear();
+    row_indices_.reserve(sample_size);
 
     for (model::ColumnIndex i = 0; i < sample_size; i++) {
         model::TupleIndex row = (fixed_sample) ? i % rows : distribution(gen);
 
         row_indices_.push_back(row);
-        map_lhs.insert(data[lhs].GetDataAsString(row));
-        map_rhs.insert(data[rhs].GetDataAsString(row));
-        map_cardinality.insert(data[lhs].GetDataAsString(row) + data[rhs].GetDataAsString(row));
+        FrequencyHandler::ValueId lhs_value = handler.GetValueId(lhs, row);
+        FrequencyHandler::ValueId rhs_value = handler.GetValueId(rhs, row);
+        buffers.lhs_values.push_back(lhs_value);
+        buffers.rhs_values.push_back(rhs_value);
+        buffers.pairs.emplace_back(lhs_value, rhs_value);
     }
-    lhs_cardinality_ = map_lhs.size();
-    rhs_cardinality_ = map_rhs.size();
-    concat_cardinality_ = map_cardinality.size();
+    lhs_cardinality_ = CountDistinct(buffers.lhs_values);
+    rhs_cardinality_ = CountDistinct(buffers.rhs_values);
+    concat_cardinality_ = CountDistinct(buffers.pairs);
 }
 
 unsigned long long Sample::CalculateSampleSize(size_t lhs_cardinality, size_t rhs_cardinality,
@@ -48,10 +60,9 @@ unsigned long long Sample::CalculateSampleSize(size_t lhs_cardinality, size_t rh
     return static_cast<long long>((numerator / denominator) * (v2 / 1.69));
 }
 
-void Sample::Filter(FrequencyHandler const &handler,
-                    std::vector<model::TypedColumnData> const &data, model::ColumnIndex col_ind) {
-    std::erase_if(row_indices_, [&handler, &data, col_ind](model::TupleIndex row_id) {
-        return !handler.ContainsValAtColumn(data[col_ind].GetDataAsString(row_id), col_ind);
+void Sample::Filter(FrequencyHandler const &handler, model::ColumnIndex col_ind) {
+    std::erase_if(row_indices_, [&handler, col_ind](model::TupleIndex row_id) {
+        return !handler.IsFrequent(col_ind, handler.GetValueId(col_ind, row_id));
     });
 }
 }  // namespace algos
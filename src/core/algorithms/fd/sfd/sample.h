@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <numbers>
+#include <utility>
 #include <vector>
 
 #include "frequency_handler.h"
@@ -16,6 +17,14 @@
 namespace algos {
 
 class Sample {
+public:
+    /* Scratch memory reused between samples, must not be shared between threads */
+    struct Buffers {
+        std::vector<FrequencyHandler::ValueId> lhs_values;
+        std::vector<FrequencyHandler::ValueId> rhs_values;
+        std::vector<std::pair<FrequencyHandler::ValueId, FrequencyHandler::ValueId>> pairs;
+    };
+
 private:
     std::vector<model::TupleIndex> row_indices_;
     Column lhs_col_;
@@ -26,10 +35,10 @@ private:
 
 public:
     Sample(bool fixed_sample, unsigned long long sample_size, size_t rows, model::ColumnIndex lhs,
-           model::ColumnIndex rhs, std::vector<model::TypedColumnData> const &data,
-           RelationalSchema const *rel_schema_);
-    void Filter(FrequencyHandler const &handler, std::vector<model::TypedColumnData> const &data,
-                model::ColumnIndex col_ind);
+           model::ColumnIndex rhs, FrequencyHandler const &handler,
+           RelationalSchema const *rel_schema_, Buffers &buffers);
+    /* Leaves only rows with one of the most frequent values of the column */
+    void Filter(FrequencyHandler const &handler, model::ColumnIndex col_ind);
 
     /* Formulae (2) from "CORDS: Automatic Discovery of Correlations and Soft Functional
        Dependencies."*/
@@ -220,6 +220,7 @@ unsigned long long TaneCommon::ExecuteInternal() {
     unsigned int max_arity =
             max_lhs_ == std::numeric_limits<unsigned int>::max() ? max_lhs_ : max_lhs_ + 1;
     for (unsigned int arity = 2; arity <= max_arity; arity++) {
+        CheckCancelled();
         model::LatticeLevel::ClearLevelsBelow(levels, arity - 1);
         model::LatticeLevel::GenerateNextLevel(levels);
 
@@ -0,0 +1,130 @@
+#include "candidate_space.h"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+
+#include <boost/graph/iteration_macros.hpp>
+
+namespace algos {
+
+GraphLabels::GraphLabels(graph_t const& graph) {
+    vertex_labels_.reserve(boost::num_vertices(graph));
+    BGL_FORALL_VERTICES_T(v, graph, graph_t) {
+        auto [it, inserted] = ids_.try_emplace(graph[v].attributes.at("label"), ids_.size());
+        if (inserted) {
+            label_vertices_.emplace_back();
+        }
+        vertex_labels_.push_back(it->second);
+        label_vertices_[it->second].push_back(v);
+    }
+}
+
+CandidateSpace::CandidateSpace(graph_t const& graph, graph_t const& pattern, vertex_t center,
+                               GraphLabels const& labels)
+    : graph_(graph) {
+    BuildOrder(pattern, center);
+    BuildCandidates(pattern, labels);
+}
+
+void CandidateSpace::BuildOrder(graph_t const& pattern, vertex_t center) {
+    std::size_t const size = boost::num_vertices(pattern);
+    positions_.assign(size, kNoParent);
+    order_.reserve(size);
+    parents_.reserve(size);
+
+    auto bfs = [this, &pattern](vertex_t root) {
+        std::queue<vertex_t> queue;
+        positions_[root] = order_.size();
+        order_.push_back(root);
+        parents_.push_back(kNoParent);
+        queue.push(root);
+        while (!queue.empty()) {
+            vertex_t u = queue.front();
+            queue.pop();
+            BGL_FORALL_ADJ_T(u, w, pattern, graph_t) {
+                if (positions_[w] != kNoParent) continue;
+                positions_[w] = order_.size();
+                order_.push_back(w);
+                parents_.push_back(positions_[u]);
+                queue.push(w);
+            }
+        }
+    };
+    bfs(center);
+    // Patterns are expected to be connected, but do not lose the vertices if they are not.
+    BGL_FORALL_VERTICES_T(u, pattern, graph_t) {
+        if (positions_[u] == kNoParent) bfs(u);
+    }
+
+    edge_labels_.resize(size * size);
+    BGL_FORALL_EDGES_T(e, pattern, graph_t) {
+        std::size_t fst = positions_[boost::source(e, pattern)];
+        std::size_t snd = positions_[boost::target(e, pattern)];
+        edge_labels_[fst * size + snd] = pattern[e].label;
+        edge_labels_[snd * size + fst] = pattern[e].label;
+    }
+}
+
+void CandidateSpace::BuildCandidates(graph_t const& pattern, GraphLabels const& labels) {
+    offsets_.reserve(order_.size() + 1);
+    offsets_.push_back(0);
+    for (vertex_t u : order_) {
+        std::size_t const label = labels.GetId(pattern[u].attributes.at("label"));
+        std::map<std::size_t, std::size_t> required_labels;
+        bool satisfiable = label != GraphLabels::kUnknownLabel;
+        BGL_FORALL_ADJ_T(u, w, pattern, graph_t) {
+            std::size_t const adj_label = labels.GetId(pattern[w].attributes.at("label"));
+            satisfiable &= adj_label != GraphLabels::kUnknownLabel;
+            ++required_labels[adj_label];
+        }
+        if (satisfiable) {
+            std::size_t const degree = boost::degree(u, pattern);
+            std::map<std::size_t, std::size_t> label_degrees;
+            for (vertex_t v : labels.GetVertices(label)) {
+                if (boost::degree(v, graph_) < degree) continue;
+                label_degrees.clear();
+                BGL_FORALL_ADJ_T(v, w, graph_, graph_t) {
+                    std::size_t const adj_label = labels.GetLabel(w);
+                    if (required_labels.contains(adj_label)) ++label_degrees[adj_label];
+                }
+                bool const is_candidate = std::all_of(
+                        required_labels.begin(), required_labels.end(), [&](auto const& kv) {
+                            auto it = label_degrees.find(kv.first);
+                            return it != label_degrees.end() && it->second >= kv.second;
+                        });
+                if (is_candidate) candidates_.push_back(v);
+            }
+        }
+        offsets_.push_back(candidates_.size());
+    }
+}
+
+bool CandidateSpace::IsCandidate(std::size_t pos, vertex_t v) const {
+    std::span<vertex_t const> candidates = GetCandidates(pos);
+    return std::binary_search(candidates.begin(), candidates.end(), v);
+}
+
+bool CandidateSpace::IsConsistent(std::size_t pos, vertex_t v,
+                                  std::vector<vertex_t> const& images) const {
+    for (std::size_t prev = 0; prev != pos; ++prev) {
+        vertex_t const image = images[prev];
+        if (image == v) return false;
+        // Out-edge lists are scanned, so look for the edge from the vertex of lower degree.
+        auto [e, exists] = boost::out_degree(v, graph_) < boost::out_degree(image, graph_)
+                                   ? boost::edge(v, image, graph_)
+                                   : boost::edge(image, v, graph_);
+        std::optional<std::string> const& label = GetEdgeLabel(pos, prev);
+        if (!label ? exists : !exists || graph_[e].label != *label) return false;
+    }
+    return true;
+}
+
+bool CandidateSpace::HasEmptyCandidates() const {
+    for (std::size_t pos = 0; pos != order_.size(); ++pos) {
+        if (offsets_[pos] == offsets_[pos + 1]) return true;
+    }
+    return false;
+}
+
+}  // namespace algos
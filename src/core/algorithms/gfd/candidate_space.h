@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gfd.h"
+
+namespace algos {
+
+// Vertex labels of a data graph interned to integers, shared by all candidate spaces over it.
+class GraphLabels {
+private:
+    std::unordered_map<std::string, std::size_t> ids_;
+    std::vector<std::size_t> vertex_labels_;
+    std::vector<std::vector<vertex_t>> label_vertices_;
+
+public:
+    static constexpr std::size_t kUnknownLabel = std::numeric_limits<std::size_t>::max();
+
+    explicit GraphLabels(graph_t const& graph);
+
+    std::size_t GetId(std::string const& label) const {
+        auto it = ids_.find(label);
+        return it == ids_.end() ? kUnknownLabel : it->second;
+    }
+
+    std::size_t GetLabel(vertex_t v) const {
+        return vertex_labels_[v];
+    }
+
+    // Vertices with the given label in ascending order.
+    std::vector<vertex_t> const& GetVertices(std::size_t label) const {
+        return label_vertices_[label];
+    }
+};
+
+/* Flat (CPI/CECI-like) candidate-space index of a GFD pattern over a data graph.
+ * Pattern vertices are matched in BFS order starting at the pattern center, every vertex except
+ * the center is reached through the edge to its parent in the BFS tree. Candidates of every
+ * pattern vertex are the data vertices with the same label that have at least as many neighbours
+ * of each label as the pattern vertex has; they are stored in one sorted array split by offsets.
+ */
+class CandidateSpace {
+public:
+    static constexpr std::size_t kNoParent = std::numeric_limits<std::size_t>::max();
+
+private:
+    graph_t const& graph_;
+    // Pattern vertices in matching order, order_[0] is the center.
+    std::vector<vertex_t> order_;
+    // Pattern vertex -> its position in order_.
+    std::vector<std::size_t> positions_;
+    // Position of the BFS parent of order_[i].
+    std::vector<std::size_t> parents_;
+    // Label of the pattern edge between order_[i] and order_[j] stored at i * size + j,
+    // empty if the vertices are not adjacent.
+    std::vector<std::optional<std::string>> edge_labels_;
+    // Candidates of order_[i] are candidates_[offsets_[i]..offsets_[i + 1]).
+    std::vector<std::size_t> offsets_;
+    std::vector<vertex_t> candidates_;
+
+    void BuildOrder(graph_t const& pattern, vertex_t center);
+    void BuildCandidates(graph_t const& pattern, GraphLabels const& labels);
+
+public:
+    CandidateSpace(graph_t const& graph, graph_t const& pattern, vertex_t center,
+                   GraphLabels const& labels);
+
+    std::size_t Size() const noexcept {
+        return order_.size();
+    }
+
+    std::size_t GetPosition(vertex_t pattern_vertex) const {
+        return positions_[pattern_vertex];
+    }
+
+    std::size_t GetParent(std::size_t pos) const {
+        return parents_[pos];
+    }
+
+    std::optional<std::string> const& GetEdgeLabel(std::size_t fst_pos, std::size_t snd_pos) const {
+        return edge_labels_[fst_pos * order_.size() + snd_pos];
+    }
+
+    std::span<vertex_t const> GetCandidates(std::size_t pos) const {
+        return {candidates_.data() + offsets_[pos], candidates_.data() + offsets_[pos + 1]};
+    }
+
+    bool IsCandidate(std::size_t pos, vertex_t v) const;
+
+    // Checks that the edges between v and the images of order_[0..pos) are exactly the edges
+    // of the pattern, as induced subgraph isomorphism requires.
+    bool IsConsistent(std::size_t pos, vertex_t v, std::vector<vertex_t> const& images) const;
+
+    // No embedding exists if some pattern vertex has no candidates.
+    bool HasEmptyCandidates() const;
+};
+
+}  // namespace algos
@@ -10,7 +10,6 @@
 #include <boost/graph/vf2_sub_graph_iso.hpp>
 #include <easylogging++.h>
 
-#include "balancer.h"
 #include "config/equal_nulls/option.h"
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
@@ -34,9 +33,8 @@ void GfdHandler::RegisterOptions() {
 }
 
 void GfdHandler::LoadDataInternal() {
-    std::ifstream f(graph_path_);
-    graph_ = parser::graph_parser::ReadGraph(f);
-    f.close();
+    graph_ = parser::graph_parser::ReadGraph(graph_path_, threads_num_);
+    std::ifstream f;
     for (auto const& path : gfd_paths_) {
         auto gfd_path = path;
         f.open(gfd_path);
@@ -3,6 +3,7 @@
 
 #include "algorithms/algorithm.h"
 #include "config/names_and_descriptions.h"
+#include "config/thread_number/type.h"
 #include "gfd.h"
 #include "parser/graph_parser/graph_parser.h"
 
@@ -12,6 +13,8 @@ class GfdHandler : public Algorithm {
 protected:
     std::filesystem::path graph_path_;
     std::vector<std::filesystem::path> gfd_paths_;
+    // Also used to parse edge list graphs in parallel.
+    config::ThreadNumType threads_num_ = 1;
 
     graph_t graph_;
     std::vector<Gfd> gfds_;
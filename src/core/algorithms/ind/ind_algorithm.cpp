@@ -1,5 +1,11 @@
 #include "ind_algorithm.h"
 
+#include <array>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
 #include "config/names_and_descriptions.h"
 #include "config/tabular_data/input_tables/option.h"
 
@@ -23,4 +29,71 @@ void INDAlgorithm::LoadDataInternal() {
     LoadINDAlgorithmDataInternal();
 }
 
+// An IND is written as "lhs_table lhs_columns... -> rhs_table rhs_columns... : error"
+std::string INDAlgorithm::SerializeResult() const {
+    std::ostringstream out;
+    auto write_columns = [&out](model::ColumnCombination const& cc) {
+        out << cc.GetTableIndex() << ' ';
+        for (model::ColumnIndex index : cc.GetColumnIndices()) {
+            out << index << ' ';
+        }
+    };
+    for (IND const& ind : INDList()) {
+        write_columns(ind.GetLhs());
+        out << "-> ";
+        write_columns(ind.GetRhs());
+        std::array<char, 32> error;
+        auto [end, ec] = std::to_chars(error.data(), error.data() + error.size(), ind.GetError());
+        out << ": " << std::string_view(error.data(), end - error.data()) << '\n';
+    }
+    return out.str();
+}
+
+void INDAlgorithm::LoadResult(std::string const& data) {
+    auto parse_index = [](std::string const& token, std::size_t bound) {
+        std::size_t index;
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), index);
+        if (error != std::errc{} || end != token.data() + token.size() || index >= bound) {
+            throw std::invalid_argument("Invalid table or column index \"" + token + '"');
+        }
+        return index;
+    };
+    // Reads the table and column indices up to the delimiter
+    auto read_columns = [this, &parse_index](std::istringstream& line_in,
+                                             std::string_view delimiter) {
+        std::string token;
+        if (!(line_in >> token) || token == delimiter) {
+            throw std::invalid_argument("Missing table index");
+        }
+        auto const table = static_cast<model::TableIndex>(parse_index(token, schemas_->size()));
+        std::size_t const num_columns = (*schemas_)[table].GetNumColumns();
+        std::vector<model::ColumnIndex> columns;
+        while (line_in >> token && token != delimiter) {
+            columns.push_back(static_cast<model::ColumnIndex>(parse_index(token, num_columns)));
+        }
+        if (token != delimiter || columns.empty()) {
+            throw std::invalid_argument("Malformed column combination");
+        }
+        return std::make_shared<model::ColumnCombination>(table, std::move(columns));
+    };
+
+    std::istringstream in{data};
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream line_in{line};
+        auto lhs = read_columns(line_in, "->");
+        auto rhs = read_columns(line_in, ":");
+        std::string token;
+        config::ErrorType error;
+        if (!(line_in >> token) || lhs->GetArity() != rhs->GetArity()) {
+            throw std::invalid_argument("Malformed IND \"" + line + '"');
+        }
+        auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), error);
+        if (ec != std::errc{} || end != token.data() + token.size()) {
+            throw std::invalid_argument("Invalid IND error \"" + token + '"');
+        }
+        ind_collection_.Register(std::move(lhs), std::move(rhs), schemas_, error);
+    }
+}
+
 }  // namespace algos
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -39,6 +40,13 @@ protected:
 
     explicit INDAlgorithm(std::vector<std::string_view> phase_names);
 
+    bool CanCacheResult() const noexcept override {
+        return true;
+    }
+
+    std::string SerializeResult() const override;
+    void LoadResult(std::string const& data) override;
+
     virtual void RegisterIND(std::shared_ptr<model::ColumnCombination> lhs,
                              std::shared_ptr<model::ColumnCombination> rhs,
                              config::ErrorType error = 0.0) {
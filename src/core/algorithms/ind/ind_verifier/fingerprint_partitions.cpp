@@ -0,0 +1,109 @@
+#include "fingerprint_partitions.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace algos::ind_verifier {
+
+namespace {
+
+/* Finalizer of SplitMix64 */
+std::uint64_t Mix(std::uint64_t x) noexcept {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+}  // namespace
+
+/* The halves are computed with two unrelated hash functions: std::hash of every value and
+ * FNV-1a over the bytes of all values, each value followed by its length. */
+Fingerprint Fingerprint::Of(std::vector<std::string> const& tuple) {
+    constexpr std::uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+    constexpr std::uint64_t kFnvPrime = 0x100000001b3ULL;
+
+    std::uint64_t high = kFnvOffsetBasis;
+    std::uint64_t low = tuple.size();
+    for (std::string const& value : tuple) {
+        for (unsigned char c : value) {
+            high = (high ^ c) * kFnvPrime;
+        }
+        high = (high ^ value.size()) * kFnvPrime;
+        low = Mix(low + std::hash<std::string_view>{}(value));
+    }
+    return {Mix(high), low};
+}
+
+FingerprintPartitions::FingerprintPartitions(std::filesystem::path spill_dir,
+                                             std::size_t mem_limit)
+    : spill_dir_(std::move(spill_dir)),
+      buffer_capacity_(std::max(mem_limit / sizeof(Fingerprint), std::size_t{1})),
+      buffers_(kPartitionsCount) {}
+
+FingerprintPartitions::~FingerprintPartitions() {
+    if (spilled_) {
+        std::error_code ec;
+        std::filesystem::remove_all(spill_dir_, ec);
+    }
+}
+
+std::filesystem::path FingerprintPartitions::GetSpillFile(std::size_t partition) const {
+    return spill_dir_ / std::to_string(partition);
+}
+
+void FingerprintPartitions::Spill() {
+    std::filesystem::create_directories(spill_dir_);
+    spilled_ = true;
+    for (std::size_t partition = 0; partition != kPartitionsCount; ++partition) {
+        std::vector<Fingerprint>& buffer = buffers_[partition];
+        if (buffer.empty()) continue;
+        std::ofstream file{GetSpillFile(partition), std::ios::binary | std::ios::app};
+        file.write(reinterpret_cast<char const*>(buffer.data()),
+                   buffer.size() * sizeof(Fingerprint));
+        if (!file) {
+            throw std::runtime_error("Cannot write fingerprints to " +
+                                     GetSpillFile(partition).string());
+        }
+        buffer.clear();
+        buffer.shrink_to_fit();
+    }
+    buffered_ = 0;
+}
+
+void FingerprintPartitions::Add(Fingerprint const& fingerprint) {
+    buffers_[GetPartition(fingerprint)].push_back(fingerprint);
+    if (++buffered_ == buffer_capacity_) {
+        Spill();
+    }
+}
+
+std::vector<Fingerprint> FingerprintPartitions::TakePartition(std::size_t partition) {
+    std::vector<Fingerprint> fingerprints = std::move(buffers_[partition]);
+    buffers_[partition] = {};
+    std::filesystem::path const file_path = GetSpillFile(partition);
+    if (!spilled_ || !std::filesystem::exists(file_path)) {
+        return fingerprints;
+    }
+
+    std::size_t const buffered_count = fingerprints.size();
+    std::size_t const spilled_count = std::filesystem::file_size(file_path) / sizeof(Fingerprint);
+    fingerprints.resize(buffered_count + spilled_count);
+    std::ifstream file{file_path, std::ios::binary};
+    file.read(reinterpret_cast<char*>(fingerprints.data() + buffered_count),
+              spilled_count * sizeof(Fingerprint));
+    if (!file) {
+        throw std::runtime_error("Cannot read fingerprints from " + file_path.string());
+    }
+    file.close();
+    std::filesystem::remove(file_path);
+    return fingerprints;
+}
+
+}  // namespace algos::ind_verifier
@@ -0,0 +1,83 @@
+/** \file
+ * \brief Tuple fingerprints partitioned by hash
+ *
+ * Partitions of 128-bit tuple fingerprints which are spilled to disk when they do not fit into
+ * the memory limit.
+ */
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace algos::ind_verifier {
+
+///
+/// \brief 128-bit hash of a tuple of values.
+///
+/// Equal tuples have equal fingerprints. Different tuples of a table with n rows get the same
+/// fingerprint with a probability of about n^2 / 2^128.
+///
+struct Fingerprint {
+    std::uint64_t high;
+    std::uint64_t low;
+
+    static Fingerprint Of(std::vector<std::string> const& tuple);
+
+    auto operator<=>(Fingerprint const&) const = default;
+};
+
+struct FingerprintHash {
+    std::size_t operator()(Fingerprint const& fingerprint) const noexcept {
+        return fingerprint.low;
+    }
+};
+
+///
+/// \brief Fingerprints distributed among a fixed number of partitions by their hash.
+///
+/// Fingerprints are buffered in memory. When the buffers exceed the memory limit, every buffer
+/// is appended to the file of its partition, so there are at most `kPartitionsCount` files.
+/// Different partitions may be taken from different threads at the same time.
+///
+class FingerprintPartitions {
+public:
+    static constexpr std::size_t kPartitionsCount = 64;
+
+private:
+    std::filesystem::path spill_dir_;
+    std::size_t buffer_capacity_;
+    std::size_t buffered_ = 0;
+    bool spilled_ = false;
+    std::vector<std::vector<Fingerprint>> buffers_;
+
+    std::filesystem::path GetSpillFile(std::size_t partition) const;
+    void Spill();
+
+public:
+    /// \param spill_dir  directory for the partition files, it is created on the first spill and
+    ///                   removed by the destructor
+    /// \param mem_limit  memory for the buffers, in bytes
+    FingerprintPartitions(std::filesystem::path spill_dir, std::size_t mem_limit);
+    FingerprintPartitions(FingerprintPartitions const&) = delete;
+    FingerprintPartitions& operator=(FingerprintPartitions const&) = delete;
+    ~FingerprintPartitions();
+
+    static std::size_t GetPartition(Fingerprint const& fingerprint) noexcept {
+        return fingerprint.high % kPartitionsCount;
+    }
+
+    void Add(Fingerprint const& fingerprint);
+
+    /// Move all fingerprints of the partition out, in no particular order.
+    std::vector<Fingerprint> TakePartition(std::size_t partition);
+
+    bool IsSpilled() const noexcept {
+        return spilled_;
+    }
+};
+
+}  // namespace algos::ind_verifier
@@ -5,14 +5,18 @@
  */
 #include "ind_verifier.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <random>
 #include <set>
 #include <sstream>
-#include <unordered_set>
-
-#include <boost/functional/hash.hpp>
+#include <unordered_map>
 
 #include "config/indices/option.h"
+#include "config/mem_limit/option.h"
 #include "config/tabular_data/input_tables/option.h"
+#include "config/thread_number/option.h"
+#include "fingerprint_partitions.h"
 #include "indices/option.h"
 #include "model/table/dataset_stream_projection.h"
 #include "model/table/table_index.h"
@@ -20,6 +24,7 @@
 #include "table/tuple_index.h"
 #include "tabular_data/input_table_type.h"
 #include "timed_invoke.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -59,10 +64,13 @@ void INDVerifier::RegisterOptions() {
                             "Invalid input: LHS and RHS indices must have the same size"};
                 }
             }));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(config::kMemLimitMbOpt(&mem_limit_mb_));
 }
 
 void INDVerifier::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kLhsIndicesOpt.GetName(), config::kRhsIndicesOpt.GetName()});
+    MakeOptionsAvailable({config::kLhsIndicesOpt.GetName(), config::kRhsIndicesOpt.GetName(),
+                          config::kThreadNumberOpt.GetName(), config::kMemLimitMbOpt.GetName()});
 }
 
 void INDVerifier::ResetState() {
@@ -79,18 +87,32 @@ void INDVerifier::LoadDataInternal() {
     /* Do nothing, we don't prepocess any data before executing. */
 }
 
+namespace {
+
+/* Unique directories for partitions of one verification. */
+std::filesystem::path MakeSpillDirPath(std::string_view side) {
+    static thread_local std::mt19937_64 random{std::random_device{}()};
+    std::stringstream ss;
+    ss << "desbordante_ind_verifier_" << std::hex << random() << "_" << side;
+    return std::filesystem::temp_directory_path() / ss.str();
+}
+
+}  // namespace
+
 void INDVerifier::VerifyIND() {
+    using ind_verifier::Fingerprint, ind_verifier::FingerprintPartitions;
     /* Ensure, that all rows have model::IDatasetStream::GetNumberOfColumns() values. */
     using FixedStream = model::DatasetStreamFixed<model::IDatasetStream*>;
     /* Perform a projection of the fixed dataset stream. */
     using StreamProjection = model::DatasetStreamProjection<FixedStream>;
-    using Row = StreamProjection::Row;
 
     config::InputTable const& lhs_table = input_tables_.front();
     config::InputTable const& rhs_table = input_tables_.back();
 
+    /* Tables are read several times, and LHS and RHS may be the same table. */
     auto const create_stream = [](config::InputTable const& table,
                                   config::IndicesType const& indices) {
+        table->Reset();
         StreamProjection stream{table.get(), indices};
         if (!stream.HasNextRow()) {
             std::stringstream ss;
@@ -101,39 +123,83 @@ void INDVerifier::VerifyIND() {
         return stream;
     };
 
-    std::unordered_set<Row, boost::hash<Row>> rhs_rows;
-    StreamProjection rhs_stream = create_stream(rhs_table, ind_.rhs);
-    while (rhs_stream.HasNextRow()) {
-        rhs_rows.insert(rhs_stream.GetNextRow());
-    }
+    /* The memory limit is split between the sides. */
+    std::size_t const side_mem_limit = (std::size_t{mem_limit_mb_} << 20) / 2;
+    FingerprintPartitions rhs_partitions{MakeSpillDirPath("rhs"), side_mem_limit};
+    FingerprintPartitions lhs_partitions{MakeSpillDirPath("lhs"), side_mem_limit};
+    auto const fingerprint_table = [&](config::InputTable const& table,
+                                       config::IndicesType const& indices,
+                                       FingerprintPartitions& partitions) {
+        StreamProjection stream = create_stream(table, indices);
+        while (stream.HasNextRow()) {
+            partitions.Add(Fingerprint::Of(stream.GetNextRow()));
+        }
+    };
+    fingerprint_table(rhs_table, ind_.rhs, rhs_partitions);
+    CheckCancelled();
+    fingerprint_table(lhs_table, ind_.lhs, lhs_partitions);
+    CheckCancelled();
+
+    struct PartitionResult {
+        model::TupleIndex lhs_cardinality = 0;
+        model::TupleIndex violating_rows = 0;
+        std::vector<Fingerprint> violating_fingerprints;
+    };
 
-    if (lhs_table == rhs_table) {
-        /* We would iterate through the same table, so we should reset this table */
-        lhs_table->Reset();
+    std::vector<PartitionResult> results(FingerprintPartitions::kPartitionsCount);
+    auto const verify_partition = [&](std::size_t partition) {
+        std::vector<Fingerprint> rhs = rhs_partitions.TakePartition(partition);
+        std::sort(rhs.begin(), rhs.end());
+        rhs.erase(std::unique(rhs.begin(), rhs.end()), rhs.end());
+        std::vector<Fingerprint> lhs = lhs_partitions.TakePartition(partition);
+        std::sort(lhs.begin(), lhs.end());
+
+        PartitionResult& result = results[partition];
+        for (auto it = lhs.begin(); it != lhs.end();) {
+            auto const next = std::upper_bound(it, lhs.end(), *it);
+            ++result.lhs_cardinality;
+            if (!std::binary_search(rhs.begin(), rhs.end(), *it)) {
+                result.violating_rows += next - it;
+                result.violating_fingerprints.push_back(*it);
+            }
+            it = next;
+        }
+    };
+    if (threads_num_ > 1) {
+        util::WorkerThreadPool pool{threads_num_};
+        pool.ExecIndex(verify_partition, results.size());
+    } else {
+        for (std::size_t partition = 0; partition != results.size(); ++partition) {
+            verify_partition(partition);
+        }
     }
 
-    std::unordered_map<Row, Cluster, boost::hash<Row>> lhs_violating_row_to_cluster_map;
-    model::TupleIndex current_row_id = 0;
-
-    std::unordered_set<Row, boost::hash<Row>> lhs_rows;
-    StreamProjection lhs_stream = create_stream(lhs_table, ind_.lhs);
-    while (lhs_stream.HasNextRow()) {
-        Row row = lhs_stream.GetNextRow();
-        lhs_rows.insert(row);
-
-        if (!rhs_rows.contains(row)) {
-            lhs_violating_row_to_cluster_map[row].push_back(current_row_id);
-            ++violating_rows_;
+    model::TupleIndex lhs_cardinality = 0;
+    std::unordered_map<Fingerprint, Cluster, ind_verifier::FingerprintHash> violating_clusters;
+    for (PartitionResult const& result : results) {
+        lhs_cardinality += result.lhs_cardinality;
+        violating_rows_ += result.violating_rows;
+        for (Fingerprint const& fingerprint : result.violating_fingerprints) {
+            violating_clusters.emplace(fingerprint, Cluster{});
+        }
+    }
+    results.clear();
+
+    if (!violating_clusters.empty()) {
+        CheckCancelled();
+        StreamProjection lhs_stream = create_stream(lhs_table, ind_.lhs);
+        for (model::TupleIndex row_id = 0; lhs_stream.HasNextRow(); ++row_id) {
+            auto it = violating_clusters.find(Fingerprint::Of(lhs_stream.GetNextRow()));
+            if (it != violating_clusters.end()) {
+                it->second.push_back(row_id);
+            }
         }
-
-        ++current_row_id;
     }
 
-    for (auto& [row, cluster] : lhs_violating_row_to_cluster_map) {
+    for (auto& [fingerprint, cluster] : violating_clusters) {
         violating_clusters_.push_back(std::move(cluster));
     }
 
-    model::TupleIndex lhs_cardinality = lhs_rows.size();
     error_ = static_cast<Error>(GetViolatingClustersCount()) / lhs_cardinality;
 }
 
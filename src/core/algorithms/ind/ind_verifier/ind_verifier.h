@@ -7,6 +7,8 @@
 
 #include "algorithms/algorithm.h"
 #include "config/indices/type.h"
+#include "config/mem_limit/type.h"
+#include "config/thread_number/type.h"
 #include "error/type.h"
 #include "table/tuple_index.h"
 #include "tabular_data/input_tables_type.h"
@@ -16,6 +18,11 @@ namespace algos {
 ///
 /// \brief Algorithm for verifying AIND.
 ///
+/// Both tables are streamed, and projected tuples are stored as 128-bit fingerprints, which are
+/// spilled to temporary files if they exceed the memory limit. Partitions of the fingerprints are
+/// verified in parallel. Rows of the violating clusters are collected by a second pass over the
+/// left-hand side table, which only looks for the violating fingerprints.
+///
 /// \todo Add special handling of empty values and nulls.
 ///
 class INDVerifier final : public Algorithm {
@@ -32,6 +39,8 @@ private:
     /* configuration stage fields */
     config::InputTables input_tables_;
     RawIND ind_;
+    config::ThreadNumType threads_num_;
+    config::MemLimitMBType mem_limit_mb_;
 
     /* execution stage fields */
     std::vector<Cluster> violating_clusters_;
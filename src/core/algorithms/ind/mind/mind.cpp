@@ -6,19 +6,24 @@
 #include "mind.h"
 
 #include <algorithm>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
+#include <boost/functional/hash.hpp>
+
 #include "algorithms/create_algorithm.h"
 #include "config/error/option.h"
 #include "config/names_and_descriptions.h"
+#include "config/thread_number/option.h"
 #include "error/type.h"
 #include "ind/ind_algorithm.h"
 #include "max_arity/option.h"
-#include "model/table/dataset_stream_projection.h"
 #include "table/column_combination.h"
 #include "table/dataset_stream_fixed.h"
 #include "tabular_data/input_table_type.h"
 #include "util/timed_invoke.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -27,6 +32,9 @@ Mind::Mind() : INDAlgorithm({}) {
 
     RegisterOption(config::kErrorOpt(&max_ind_error_));
     RegisterOption(config::kMaxArityOpt(&max_arity_));
+    /* The value is passed to the unary IND algorithm as well. */
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void Mind::MakeLoadOptsAvailable() {
@@ -55,7 +63,31 @@ std::type_index Mind::GetExternalTypeIndex(std::string_view option_name) const {
 };
 
 void Mind::LoadINDAlgorithmDataInternal() {
-    timings_.load = util::TimedInvoke(&Algorithm::LoadData, auind_algo_);
+    timings_.load = util::TimedInvoke(&Algorithm::LoadData, auind_algo_) +
+                    util::TimedInvoke(&Mind::EncodeTables, this);
+}
+
+/*
+ * Read every table into columns of value identifiers.
+ * Rows with an incorrect count of values are skipped.
+ */
+void Mind::EncodeTables() {
+    std::unordered_map<std::string, ValueId> value_ids;
+    encoded_tables_.clear();
+    encoded_tables_.reserve(input_tables_.size());
+    for (config::InputTable const& table : input_tables_) {
+        table->Reset();
+        model::DatasetStreamFixed<> stream{table};
+        EncodedTable& encoded_table =
+                encoded_tables_.emplace_back(stream.GetNumberOfColumns());
+        while (stream.HasNextRow()) {
+            std::vector<std::string> row = stream.GetNextRow();
+            for (std::size_t i = 0; i != row.size(); ++i) {
+                auto const [it, _] = value_ids.try_emplace(std::move(row[i]), value_ids.size());
+                encoded_table[i].push_back(it->second);
+            }
+        }
+    }
 }
 
 void Mind::AddSpecificNeededOptions(std::unordered_set<std::string_view>& previous_options) const {
@@ -140,70 +172,141 @@ std::optional<RawIND> GetCandidateIfValid(model::IND const& p, model::IND const&
 }
 
 /*
- * Firstly, skip rows with incorrect count of values.
- * Secondly, project stream on the provided column indices.
+ * Tuples of a column combination, one after another, in the order of the rows.
+ * A tuple is referred to by the pointer to its first value.
  */
-using DatasetStreamFixedProjection = model::DatasetStreamProjection<model::DatasetStreamFixed<>>;
+template <typename ValueId>
+std::vector<ValueId> Project(std::vector<std::vector<ValueId>> const& table,
+                             model::ColumnCombination const& cc) {
+    std::vector<model::ColumnIndex> const& indices = cc.GetColumnIndices();
+    std::size_t const arity = indices.size();
+    std::size_t const rows = table.empty() ? 0 : table.front().size();
+    std::vector<ValueId> tuples(rows * arity);
+    for (std::size_t i = 0; i != arity; ++i) {
+        std::vector<ValueId> const& column = table[indices[i]];
+        for (std::size_t row = 0; row != rows; ++row) {
+            tuples[row * arity + i] = column[row];
+        }
+    }
+    return tuples;
+}
 
-using Row = DatasetStreamFixedProjection::Row;
-using HashSet = std::unordered_set<Row, boost::hash<Row>>;
+template <typename ValueId>
+class TupleHash {
+    std::size_t arity_;
 
-HashSet CreateHashSet(DatasetStreamFixedProjection&& stream) {
-    HashSet hash_container;
+public:
+    explicit TupleHash(std::size_t arity) : arity_(arity) {}
 
-    while (stream.HasNextRow()) {
-        hash_container.insert(stream.GetNextRow());
+    std::size_t operator()(ValueId const* tuple) const {
+        return boost::hash_range(tuple, tuple + arity_);
     }
+};
 
-    return hash_container;
-}
+template <typename ValueId>
+class TupleEqual {
+    std::size_t arity_;
 
-}  // namespace
-}  // namespace mind
+public:
+    explicit TupleEqual(std::size_t arity) : arity_(arity) {}
 
-std::optional<config::ErrorType> Mind::TestCandidate(RawIND const& raw_ind) {
-    using namespace mind;
+    bool operator()(ValueId const* lhs, ValueId const* rhs) const {
+        return std::equal(lhs, lhs + arity_, rhs);
+    }
+};
 
-    auto const create_projected_stream = [&](model::ColumnCombination const& cc) {
-        config::InputTable const& table = input_tables_[cc.GetTableIndex()];
-        table->Reset();
-        return DatasetStreamFixedProjection{table, cc.GetColumnIndices()};
-    };
+template <typename ValueId>
+using TupleSet = std::unordered_set<ValueId const*, TupleHash<ValueId>, TupleEqual<ValueId>>;
 
-    HashSet const rhs_hash_set{CreateHashSet(create_projected_stream(raw_ind.rhs))};
+/* The tuples must outlive the set. */
+template <typename ValueId>
+TupleSet<ValueId> CreateTupleSet(std::vector<ValueId> const& tuples, std::size_t arity) {
+    TupleSet<ValueId> set(0, TupleHash<ValueId>{arity}, TupleEqual<ValueId>{arity});
+    for (std::size_t i = 0; i < tuples.size(); i += arity) {
+        set.insert(tuples.data() + i);
+    }
+    return set;
+}
 
-    if (max_ind_error_ == 0) {
-        DatasetStreamFixedProjection lhs_stream = create_projected_stream(raw_ind.lhs);
-        while (lhs_stream.HasNextRow()) {
-            if (!rhs_hash_set.contains(lhs_stream.GetNextRow())) {
+template <typename ValueId>
+std::optional<config::ErrorType> TestCandidate(TupleSet<ValueId> const& rhs_tuple_set,
+                                               std::vector<ValueId> const& lhs_tuples,
+                                               std::size_t arity, config::ErrorType max_error) {
+    if (max_error == 0) {
+        for (std::size_t i = 0; i < lhs_tuples.size(); i += arity) {
+            if (!rhs_tuple_set.contains(lhs_tuples.data() + i)) {
                 return std::nullopt;
             }
         }
         return config::ErrorType{0.0};
     }
 
-    HashSet const lhs_hash_set{CreateHashSet(create_projected_stream(raw_ind.lhs))};
-    auto const lhs_cardinality = static_cast<model::TupleIndex>(lhs_hash_set.size());
-    model::TupleIndex const disqualify_row_limit = std::floor(lhs_cardinality * max_ind_error_) + 1;
+    TupleSet<ValueId> const lhs_tuple_set = CreateTupleSet(lhs_tuples, arity);
+    auto const lhs_cardinality = static_cast<model::TupleIndex>(lhs_tuple_set.size());
+    model::TupleIndex const disqualify_row_limit = std::floor(lhs_cardinality * max_error) + 1;
     model::TupleIndex disqualify_row_count = 0;
-    for (Row const& row : lhs_hash_set) {
-        if (!rhs_hash_set.contains(row)) {
+    for (ValueId const* tuple : lhs_tuple_set) {
+        if (!rhs_tuple_set.contains(tuple)) {
             ++disqualify_row_count;
             if (disqualify_row_count == disqualify_row_limit) {
                 assert(static_cast<config::ErrorType>(disqualify_row_count) / lhs_cardinality >
-                       max_ind_error_);
+                       max_error);
                 return std::nullopt;
             }
         }
     }
 
     auto const error = static_cast<config::ErrorType>(disqualify_row_count) / lhs_cardinality;
-    if (error <= max_ind_error_)
+    if (error <= max_error)
         return error;
     else
         return std::nullopt;
 }
 
+}  // namespace
+}  // namespace mind
+
+std::vector<std::optional<config::ErrorType>> Mind::TestCandidates(
+        std::vector<RawIND> const& candidates) const {
+    auto const hash_cc = [](model::ColumnCombination const& cc) { return cc.GetHash(); };
+    std::unordered_map<model::ColumnCombination, std::vector<std::size_t>, decltype(hash_cc)>
+            candidates_by_rhs(0, hash_cc);
+    for (std::size_t i = 0; i != candidates.size(); ++i) {
+        candidates_by_rhs[candidates[i].rhs].push_back(i);
+    }
+    std::vector<std::vector<std::size_t> const*> groups;
+    groups.reserve(candidates_by_rhs.size());
+    for (auto const& [rhs, group] : candidates_by_rhs) {
+        groups.push_back(&group);
+    }
+
+    std::vector<std::optional<config::ErrorType>> results(candidates.size());
+    auto const test_group = [&](std::size_t group_index) {
+        std::vector<std::size_t> const& group = *groups[group_index];
+        model::ColumnCombination const& rhs = candidates[group.front()].rhs;
+        std::size_t const arity = rhs.GetArity();
+        std::vector<ValueId> const rhs_tuples =
+                mind::Project(encoded_tables_[rhs.GetTableIndex()], rhs);
+        mind::TupleSet<ValueId> const rhs_tuple_set = mind::CreateTupleSet(rhs_tuples, arity);
+        for (std::size_t candidate_index : group) {
+            model::ColumnCombination const& lhs = candidates[candidate_index].lhs;
+            results[candidate_index] = mind::TestCandidate(
+                    rhs_tuple_set, mind::Project(encoded_tables_[lhs.GetTableIndex()], lhs), arity,
+                    max_ind_error_);
+        }
+    };
+
+    if (threads_num_ > 1 && groups.size() > 1) {
+        util::WorkerThreadPool pool{std::min<std::size_t>(threads_num_, groups.size())};
+        pool.ExecIndex(test_group, groups.size());
+    } else {
+        for (std::size_t i = 0; i != groups.size(); ++i) {
+            test_group(i);
+        }
+    }
+    return results;
+}
+
 /*
  * Mine unary INDs.
  *
@@ -252,12 +355,14 @@ void Mind::MineNaryINDs() {
             });
         }
 
+        CheckCancelled();
         prev_it = std::prev(INDList().end()); /*< last element of the previous lattice level */
         prev_raw_inds.clear();
-        for (RawIND const& candidate : candidates) {
-            if (auto error_opt = TestCandidate(candidate)) {
-                RegisterIND(candidate.lhs, candidate.rhs, error_opt.value());
-                prev_raw_inds.insert(candidate);
+        std::vector<std::optional<config::ErrorType>> const errors = TestCandidates(candidates);
+        for (std::size_t i = 0; i != candidates.size(); ++i) {
+            if (errors[i]) {
+                RegisterIND(candidates[i].lhs, candidates[i].rhs, errors[i].value());
+                prev_raw_inds.insert(candidates[i]);
             }
         }
         candidates.clear();
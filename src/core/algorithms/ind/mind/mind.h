@@ -5,12 +5,15 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "algorithms/ind/ind_algorithm.h"
 #include "config/error/type.h"
 #include "config/max_arity/type.h"
+#include "config/thread_number/type.h"
 #include "raw_ind.h"
 
 namespace algos {
@@ -29,10 +32,18 @@ public:
 
 private:
     using RawIND = mind::RawIND;
+    /// value identifier, equal values of all tables have the same identifier
+    using ValueId = std::uint32_t;
+    /// table columns with values replaced by their identifiers
+    using EncodedTable = std::vector<std::vector<ValueId>>;
 
     /* configuration stage fields */
     config::ErrorType max_ind_error_ = 0;
     config::MaxArityType max_arity_;
+    config::ThreadNumType threads_num_ = 1;
+
+    /* load stage fields */
+    std::vector<EncodedTable> encoded_tables_; /*< tables are read only once, while loading */
 
     /* execution stage fields */
     std::unique_ptr<INDAlgorithm> auind_algo_; /*< algorithm for mining unary approximate INDs*/
@@ -46,14 +57,17 @@ private:
     std::type_index GetExternalTypeIndex(std::string_view option_name) const override;
 
     void LoadINDAlgorithmDataInternal() override;
+    void EncodeTables();
 
     ///
-    /// Test a given IND candidate to determine if it should be registered.
+    /// Test IND candidates to determine which of them should be registered.
+    /// Candidates with the same right-hand side are tested against one set of its tuples.
     ///
-    /// \return `std::nullopt` if the candidate should not be registered,
-    ///         otherwise return the error threshold at which AIND holds.
+    /// \return for every candidate, `std::nullopt` if it should not be registered,
+    ///         otherwise the error threshold at which AIND holds.
     ///
-    std::optional<config::ErrorType> TestCandidate(RawIND const& raw_ind);
+    std::vector<std::optional<config::ErrorType>> TestCandidates(
+            std::vector<RawIND> const& candidates) const;
 
     void MineUnaryINDs();
     void MineNaryINDs();
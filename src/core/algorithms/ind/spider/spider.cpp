@@ -61,15 +61,17 @@ std::vector<Attribute> InitAttributes(std::vector<model::ColumnDomain> const& do
     return attrs;
 }
 
-template <typename Attribute>
+template <typename Attribute, typename CheckCancelled>
 std::vector<Attribute> GetProcessedAttributes(std::vector<model::ColumnDomain> const& domains,
-                                              config::EqNullsType is_null_equal_null) {
+                                              config::EqNullsType is_null_equal_null,
+                                              CheckCancelled check_cancelled) {
     using AttributeRW = std::reference_wrapper<Attribute>;
     std::vector attrs = InitAttributes<Attribute>(domains);
     std::priority_queue<AttributeRW, std::vector<AttributeRW>, std::greater<Attribute>> attr_pq(
             attrs.begin(), attrs.end());
     boost::dynamic_bitset<> ids_bitset(attrs.size());
     while (!attr_pq.empty()) {
+        check_cancelled();
         AttributeRW attr_rw = attr_pq.top();
         std::string const& value = attr_rw.get().GetCurrentValue();
         do {
@@ -103,7 +105,8 @@ std::vector<Attribute> GetProcessedAttributes(std::vector<model::ColumnDomain> c
 
 void Spider::MineINDs() {
     using spider::INDAttribute;
-    std::vector const attrs = GetProcessedAttributes<INDAttribute>(domains_, is_null_equal_null_);
+    std::vector const attrs = GetProcessedAttributes<INDAttribute>(
+            domains_, is_null_equal_null_, [this]() { CheckCancelled(); });
     for (auto const& dep : attrs) {
         for (AttributeIndex ref_id : dep.GetRefIds()) {
             RegisterIND(dep.ToCC(), attrs[ref_id].ToCC());
@@ -113,7 +116,8 @@ void Spider::MineINDs() {
 
 void Spider::MineAINDs() {
     using spider::AINDAttribute;
-    std::vector const attrs = GetProcessedAttributes<AINDAttribute>(domains_, is_null_equal_null_);
+    std::vector const attrs = GetProcessedAttributes<AINDAttribute>(
+            domains_, is_null_equal_null_, [this]() { CheckCancelled(); });
     for (auto const& dep : attrs) {
         for (AttributeIndex ref_id : dep.GetRefIds(max_ind_error_)) {
             RegisterIND(dep.ToCC(), attrs[ref_id].ToCC(), dep.GetError(ref_id));
@@ -15,6 +15,7 @@ struct IndexedPointsCalculationResult;
 template <typename T>
 struct PointsCalculationResult;
 struct Highlight;
+class HighlightCalculator;
 
 using ClusterIndex = model::PLI::Cluster::value_type;
 
@@ -27,8 +28,11 @@ template <typename T>
 using CompareFunction = std::function<bool(std::vector<T> const& points)>;
 template <typename T>
 using HighlightFunction = std::function<void(std::vector<T> const& points,
-                                             std::vector<Highlight>&& cluster_highlights)>;
-using ClusterFunction = std::function<bool(model::PLI::Cluster const& cluster)>;
+                                             std::vector<Highlight>&& cluster_highlights,
+                                             HighlightCalculator& highlight_calculator)>;
+// Highlights of a cluster that violates the MFD are added to highlight_calculator.
+using ClusterFunction = std::function<bool(model::PLI::Cluster const& cluster,
+                                           HighlightCalculator& highlight_calculator)>;
 template <typename T>
 using IndexedPointsFunction =
         std::function<IndexedPointsCalculationResult<T>(model::PLI::Cluster const& cluster)>;
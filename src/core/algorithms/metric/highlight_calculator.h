@@ -1,5 +1,9 @@
 #pragma once
 
+#include <iterator>
+#include <memory>
+#include <vector>
+
 #include "algorithms/metric/highlight.h"
 #include "algorithms/metric/points.h"
 #include "config/indices/type.h"
@@ -39,6 +43,13 @@ public:
             std::vector<IndexedPoint<std::vector<long double>>> const& indexed_points,
             std::vector<Highlight>&& cluster_highlights);
 
+    // Appends the highlights of other, which must be calculated for the same columns.
+    void MergeHighlights(HighlightCalculator&& other) {
+        highlights_.insert(highlights_.end(), std::make_move_iterator(other.highlights_.begin()),
+                           std::make_move_iterator(other.highlights_.end()));
+        other.highlights_.clear();
+    }
+
     void SortHighlightsByDistanceAscending();
     void SortHighlightsByDistanceDescending();
     void SortHighlightsByFurthestIndexAscending();
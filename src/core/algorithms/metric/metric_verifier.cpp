@@ -1,8 +1,10 @@
 #include "algorithms/metric/metric_verifier.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -16,6 +18,72 @@
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "model/table/relation_session.h"
+#include "util/worker_thread_pool.h"
+
+namespace {
+
+// Consecutive clusters are verified as one task until they have this many rows in total.
+constexpr std::size_t kMinBatchRows = 256;
+constexpr std::size_t kBatchesPerThread = 8;
+
+// Coordinates of the points stored dimension by dimension, so that the distance loops below run
+// over contiguous arrays.
+template <typename Point, typename GetCoordinates>
+std::vector<long double> TransposeCoordinates(std::vector<Point> const& points,
+                                              GetCoordinates get_coordinates) {
+    std::size_t const points_num = points.size();
+    std::size_t const dimensions = get_coordinates(points[0]).size();
+    std::vector<long double> coords(points_num * dimensions);
+    for (std::size_t i = 0; i < points_num; ++i) {
+        std::vector<long double> const& point = get_coordinates(points[i]);
+        for (std::size_t d = 0; d < dimensions; ++d) {
+            coords[d * points_num + i] = point[d];
+        }
+    }
+    return coords;
+}
+
+// Maximum squared Euclidean distance between the point `from` and the points [first, points_num).
+// The sums are rounded to double after every dimension exactly as in util::EuclideanDistance, and
+// the square root is monotonic, so the root of the result is the largest distance it would give.
+double MaxSquaredDistance(std::vector<long double> const& coords, std::size_t points_num,
+                          std::size_t from, std::size_t first, std::vector<double>& squared_dists) {
+    squared_dists.assign(points_num - first, 0.0);
+    double* dists = squared_dists.data();
+    for (long double const* dim_coords = coords.data();
+         dim_coords != coords.data() + coords.size(); dim_coords += points_num) {
+        long double const origin = dim_coords[from];
+        long double const* other = dim_coords + first;
+        for (std::size_t j = 0; j < points_num - first; ++j) {
+            long double const diff = other[j] - origin;
+            dists[j] += diff * diff;
+        }
+    }
+    double max_dist = 0;
+    for (double dist : squared_dists) {
+        max_dist = dist > max_dist ? dist : max_dist;
+    }
+    return max_dist;
+}
+
+// Distance between the minimum and the maximum value, computed the same way as INumericType::Dist.
+template <typename T>
+double GetSpread(std::vector<algos::metric::IndexedOneDimensionalPoint> const& points) {
+    std::vector<T> values(points.size());
+    std::transform(points.begin(), points.end(), values.begin(),
+                   [](auto const& p) { return model::Type::GetValue<T>(p.point); });
+    T min_value = values[0];
+    T max_value = values[0];
+    for (T value : values) {
+        min_value = value < min_value ? value : min_value;
+        max_value = value > max_value ? value : max_value;
+    }
+    return static_cast<double>(max_value - min_value);
+}
+
+}  // namespace
 
 namespace algos::metric {
 
@@ -107,6 +175,7 @@ void MetricVerifier::RegisterOptions() {
 
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
     RegisterOption(config::kLhsIndicesOpt(&lhs_indices_, get_schema_columns));
     RegisterOption(Option{&algo_, kMetricAlgorithm, kDMetricAlgorithm}.SetValueCheck(algo_check));
     RegisterOption(Option{&dist_from_null_is_infinity_, kDistFromNullIsInfinity,
@@ -122,18 +191,17 @@ void MetricVerifier::RegisterOptions() {
 
 void MetricVerifier::MakeExecuteOptsAvailable() {
     using namespace config::names;
-    MakeOptionsAvailable(
-            {kDistFromNullIsInfinity, kParameter, kMetric, config::kLhsIndicesOpt.GetName()});
+    MakeOptionsAvailable({kDistFromNullIsInfinity, kParameter, kMetric,
+                          config::kLhsIndicesOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void MetricVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::GetSharedRelation(*input_table_, is_null_equal_null_);
     input_table_->Reset();
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: metric FD verifying is meaningless.");
     }
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, is_null_equal_null_);
 }
 
 void MetricVerifier::ResetState() {
@@ -229,16 +297,72 @@ void MetricVerifier::VerifyMetricFD() {
         pli = pli->Intersect(relation_->GetColumnData(lhs_indices_[i]).GetPositionListIndex());
     }
 
-    metric_fd_holds_ = true;
-    auto cluster_func = GetClusterFunction();
-    for (auto const& cluster : pli->GetIndex()) {
-        if (!cluster_func(cluster)) {
-            metric_fd_holds_ = false;
-            if (algo_ == +MetricAlgo::approx) {
-                break;
+    metric_fd_holds_ = VerifyClusters(pli->GetIndex(), GetClusterFunction());
+}
+
+std::vector<std::size_t> MetricVerifier::GetBatchBounds(
+        std::deque<model::PLI::Cluster> const& clusters) const {
+    std::size_t rows_num = 0;
+    for (auto const& cluster : clusters) {
+        rows_num += cluster.size();
+    }
+    std::size_t const batch_rows =
+            std::max(kMinBatchRows, rows_num / (threads_num_ * kBatchesPerThread));
+    std::vector<std::size_t> bounds = {0};
+    std::size_t rows_in_batch = 0;
+    for (std::size_t i = 0; i < clusters.size(); ++i) {
+        rows_in_batch += clusters[i].size();
+        if (rows_in_batch >= batch_rows || i + 1 == clusters.size()) {
+            bounds.push_back(i + 1);
+            rows_in_batch = 0;
+        }
+    }
+    return bounds;
+}
+
+/* Clusters are independent, so they are verified in parallel, in batches of consecutive clusters
+ * to keep small clusters from paying the per-task overhead. Every batch collects highlights into
+ * its own calculator, the calculators are merged in batch order afterwards, so the highlights
+ * don't depend on the number of threads.
+ */
+bool MetricVerifier::VerifyClusters(std::deque<model::PLI::Cluster> const& clusters,
+                                    ClusterFunction const& cluster_func) {
+    bool const stop_on_failure = algo_ == +MetricAlgo::approx;
+    std::vector<std::size_t> const bounds = GetBatchBounds(clusters);
+    std::size_t const batches_num = bounds.size() - 1;
+    if (threads_num_ == 1 || batches_num < 2) {
+        bool holds = true;
+        for (auto const& cluster : clusters) {
+            if (!cluster_func(cluster, *highlight_calculator_)) {
+                holds = false;
+                if (stop_on_failure) {
+                    break;
+                }
             }
         }
+        return holds;
     }
+
+    std::vector<HighlightCalculator> batch_highlights(
+            batches_num, HighlightCalculator{typed_relation_, rhs_indices_});
+    std::atomic<bool> holds = true;
+    util::WorkerThreadPool pool{std::min<std::size_t>(threads_num_, batches_num)};
+    pool.ExecIndex(
+            [&](model::Index batch) {
+                for (std::size_t i = bounds[batch]; i != bounds[batch + 1]; ++i) {
+                    if (stop_on_failure && !holds.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    if (!cluster_func(clusters[i], batch_highlights[batch])) {
+                        holds.store(false, std::memory_order_relaxed);
+                    }
+                }
+            },
+            batches_num);
+    for (HighlightCalculator& highlights : batch_highlights) {
+        highlight_calculator_->MergeHighlights(std::move(highlights));
+    }
+    return holds;
 }
 
 ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
@@ -251,8 +375,9 @@ ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
                     return points_calculator_->CalculateIndexedPoints(cluster);
                 },
                 [this](auto const& points) { return CompareNumericValues(points); },
-                [this](auto const& points, std::vector<Highlight>&& cluster_highlights) {
-                    return highlight_calculator_->CalculateOneDimensionalHighlights(
+                [](auto const& points, std::vector<Highlight>&& cluster_highlights,
+                   HighlightCalculator& highlight_calculator) {
+                    return highlight_calculator.CalculateOneDimensionalHighlights(
                             points, std::move(cluster_highlights));
                 });
     }
@@ -270,9 +395,9 @@ ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
                     [this, dist_func](auto const& points) {
                         return this->BruteVerifyCluster(points, dist_func);
                     },
-                    [this, dist_func](auto const& points,
-                                      std::vector<Highlight>&& cluster_highlights) {
-                        return highlight_calculator_->CalculateHighlightsForStrings(
+                    [dist_func](auto const& points, std::vector<Highlight>&& cluster_highlights,
+                                HighlightCalculator& highlight_calculator) {
+                        return highlight_calculator.CalculateHighlightsForStrings(
                                 points, std::move(cluster_highlights), dist_func);
                     });
         };
@@ -291,15 +416,17 @@ ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
                 [&type](std::byte const* l, std::byte const* r) { return type.Dist(l, r); });
     }
 
-    return [this, &type, verify_func](model::PLI::Cluster const& cluster) {
+    return [this, &type, verify_func](model::PLI::Cluster const& cluster,
+                                      HighlightCalculator& highlight_calculator) {
         std::unordered_map<std::string, util::QGramVector> q_gram_map;
-        return verify_func(GetCosineDistFunction(type, q_gram_map))(cluster);
+        return verify_func(GetCosineDistFunction(type, q_gram_map))(cluster, highlight_calculator);
     };
 }
 
 ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
     if (algo_ == +MetricAlgo::calipers) {
-        return [this](model::PLI::Cluster const& cluster) {
+        return [this](model::PLI::Cluster const& cluster,
+                      HighlightCalculator& highlight_calculator) {
             auto result = points_calculator_->CalculateMultidimensionalPointsForCalipers(cluster);
             if (!CheckMFDFailIfHasNulls(result.has_nulls) &&
                 CalipersCompareNumericValues(result.points)) {
@@ -308,7 +435,7 @@ ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
 
             auto result_indexed =
                     points_calculator_->CalculateMultidimensionalIndexedPoints(cluster);
-            highlight_calculator_->CalculateMultidimensionalHighlights(
+            highlight_calculator.CalculateMultidimensionalHighlights(
                     result_indexed.points, std::move(result_indexed.cluster_highlights));
             return false;
         };
@@ -318,20 +445,17 @@ ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
                 [this](auto const& cluster) {
                     return points_calculator_->CalculateMultidimensionalIndexedPoints(cluster);
                 },
-                [this](auto const& points) {
-                    return BruteVerifyCluster<std::vector<long double>>(points,
-                                                                        util::EuclideanDistance);
-                },
-                [this](auto const& points, std::vector<Highlight>&& cluster_highlights) {
-                    return highlight_calculator_->CalculateMultidimensionalHighlights(
+                [this](auto const& points) { return BruteVerifyEuclidean(points); },
+                [](auto const& points, std::vector<Highlight>&& cluster_highlights,
+                   HighlightCalculator& highlight_calculator) {
+                    return highlight_calculator.CalculateMultidimensionalHighlights(
                             points, std::move(cluster_highlights));
                 });
     }
-    auto points_func = [this](auto const& cluster) {
-        return points_calculator_->CalculateMultidimensionalPointsForApprox(cluster);
+    return [this](model::PLI::Cluster const& cluster, HighlightCalculator&) {
+        auto result = points_calculator_->CalculateMultidimensionalPointsForApprox(cluster);
+        return !CheckMFDFailIfHasNulls(result.has_nulls) && ApproxVerifyEuclidean(result.points);
     };
-    return CalculateApproxClusterFunction<std::vector<long double>>(points_func,
-                                                                    util::EuclideanDistance);
 }
 
 ClusterFunction MetricVerifier::GetClusterFunction() {
@@ -362,12 +486,13 @@ template <typename T>
 ClusterFunction MetricVerifier::CalculateClusterFunction(
         IndexedPointsFunction<T> points_func, CompareFunction<T> compare_func,
         HighlightFunction<T> highlight_func) const {
-    return [this, points_func, compare_func, highlight_func](model::PLI::Cluster const& cluster) {
+    return [this, points_func, compare_func, highlight_func](
+                   model::PLI::Cluster const& cluster, HighlightCalculator& highlight_calculator) {
         auto result = points_func(cluster);
         if (!CheckMFDFailIfHasNulls(result.has_nulls) && compare_func(result.points)) {
             return true;
         }
-        highlight_func(result.points, std::move(result.cluster_highlights));
+        highlight_func(result.points, std::move(result.cluster_highlights), highlight_calculator);
         return false;
     };
 }
@@ -375,7 +500,8 @@ ClusterFunction MetricVerifier::CalculateClusterFunction(
 template <typename T>
 ClusterFunction MetricVerifier::CalculateApproxClusterFunction(
         PointsFunction<T> points_func, DistanceFunction<T> dist_func) const {
-    return [points_func, dist_func, this](model::PLI::Cluster const& cluster) {
+    return [points_func, dist_func, this](model::PLI::Cluster const& cluster,
+                                          HighlightCalculator&) {
         auto result = points_func(cluster);
         return !CheckMFDFailIfHasNulls(result.has_nulls) &&
                ApproxVerifyCluster(result.points, dist_func);
@@ -388,21 +514,10 @@ bool MetricVerifier::CompareNumericValues(
         return true;
     }
     model::TypedColumnData const& col = typed_relation_->GetColumnData(rhs_indices_[0]);
-    auto const& type = static_cast<model::INumericType const&>(col.GetType());
-
-    std::byte const* max_value = points[0].point;
-    std::byte const* min_value = points[0].point;
-    for (size_t i = 1; i < points.size(); ++i) {
-        if (type.Compare(points[i].point, max_value) == model::CompareResult::kGreater) {
-            max_value = points[i].point;
-        } else if (type.Compare(points[i].point, min_value) == model::CompareResult::kLess) {
-            min_value = points[i].point;
-        }
-        if (type.Dist(max_value, min_value) > parameter_) {
-            return false;
-        }
+    if (col.GetTypeId() == +model::TypeId::kInt) {
+        return GetSpread<model::Int>(points) <= parameter_;
     }
-    return true;
+    return GetSpread<model::Double>(points) <= parameter_;
 }
 
 template <typename T>
@@ -430,6 +545,36 @@ bool MetricVerifier::BruteVerifyCluster(std::vector<IndexedPoint<T>> const& poin
     return true;
 }
 
+bool MetricVerifier::BruteVerifyEuclidean(std::vector<IndexedVector> const& points) const {
+    if (points.size() < 2) {
+        return true;
+    }
+    std::vector<long double> const coords =
+            TransposeCoordinates(points, [](IndexedVector const& p) -> auto const& {
+                return p.point;
+            });
+    std::vector<double> squared_dists;
+    for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+        if (std::sqrt(MaxSquaredDistance(coords, points.size(), i, i + 1, squared_dists)) >
+            parameter_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MetricVerifier::ApproxVerifyEuclidean(
+        std::vector<std::vector<long double>> const& points) const {
+    if (points.size() < 2) {
+        return true;
+    }
+    std::vector<long double> const coords = TransposeCoordinates(
+            points, [](std::vector<long double> const& p) -> auto const& { return p; });
+    std::vector<double> squared_dists;
+    return std::sqrt(MaxSquaredDistance(coords, points.size(), 0, 1, squared_dists)) * 2 <=
+           parameter_;
+}
+
 bool MetricVerifier::CalipersCompareNumericValues(std::vector<util::Point>& points) const {
     auto pairs = util::GetAntipodalPairs(util::CalculateConvexHull(points));
     return std::all_of(pairs.cbegin(), pairs.cend(), [this](auto const& pair) {
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <deque>
 #include <filesystem>
 #include <functional>
 #include <memory>
@@ -18,6 +19,7 @@
 #include "config/equal_nulls/type.h"
 #include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_relation_data.h"
 #include "model/table/column_layout_typed_relation_data.h"
 #include "util/convex_hull.h"
@@ -37,11 +39,13 @@ private:
     unsigned int q_;
     bool dist_from_null_is_infinity_;
     config::EqNullsType is_null_equal_null_;
+    config::ThreadNumType threads_num_ = 1;
 
     bool metric_fd_holds_ = false;
 
     std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
-    std::shared_ptr<ColumnLayoutRelationData> relation_;  // temporarily parsing twice
+    // Unless the table is attached to a session, it is parsed twice
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
     std::unique_ptr<PointsCalculator> points_calculator_;
     std::unique_ptr<HighlightCalculator> highlight_calculator_;
 
@@ -63,6 +67,9 @@ private:
     bool BruteVerifyCluster(std::vector<IndexedPoint<T>> const& points,
                             DistanceFunction<T> const& dist_func) const;
 
+    bool BruteVerifyEuclidean(std::vector<IndexedVector> const& points) const;
+    bool ApproxVerifyEuclidean(std::vector<std::vector<long double>> const& points) const;
+
     bool CalipersCompareNumericValues(std::vector<util::Point>& points) const;
 
     template <typename T>
@@ -75,6 +82,9 @@ private:
     ClusterFunction GetClusterFunctionForSeveralDimensions();
     ClusterFunction GetClusterFunctionForOneDimension();
     ClusterFunction GetClusterFunction();
+    std::vector<std::size_t> GetBatchBounds(std::deque<model::PLI::Cluster> const& clusters) const;
+    bool VerifyClusters(std::deque<model::PLI::Cluster> const& clusters,
+                        ClusterFunction const& cluster_func);
     void VerifyMetricFD();
     std::string GetStringValue(config::IndicesType const& index_vec, ClusterIndex row_index) const;
     void VisualizeHighlights() const;
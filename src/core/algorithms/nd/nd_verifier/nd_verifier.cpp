@@ -2,9 +2,11 @@
 
 #include <chrono>
 #include <cstddef>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <easylogging++.h>
@@ -19,9 +21,13 @@
 #include "config/option.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
+#include "model/table/column_layout_relation_data.h"
 #include "model/table/column_layout_typed_relation_data.h"
+#include "model/table/relation_session.h"
 #include "model/table/typed_column_data.h"
 #include "model/types/builtin.h"
+#include "model/types/mixed_type.h"
 #include "model/types/type.h"
 #include "util/timed_invoke.h"
 
@@ -42,20 +48,71 @@ void NDVerifier::RegisterOptions() {
     RegisterOption(config::kLhsIndicesOpt(&lhs_indices_, get_schema_cols));
     RegisterOption(config::kRhsIndicesOpt(&rhs_indices_, get_schema_cols));
     RegisterOption(Option<model::WeightType>(&weight_, kWeight, kDNDWeight, 1));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void NDVerifier::LoadDataInternal() {
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, is_null_equal_null_);
     input_table_->Reset();
     if (typed_relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: ND verifying is meaningless.");
     }
+    CreateColumnPLIs();
+}
+
+void NDVerifier::CreateColumnPLIs() {
+    using model::TypedColumnData;
+    constexpr int kMixedEmptyValueId = ColumnLayoutRelationData::kNullValueId - 1;
+
+    column_plis_.clear();
+    for (TypedColumnData const& col_data : typed_relation_->GetColumnData()) {
+        model::Type const& type = col_data.GetType();
+        // Equality has to agree with Type::Hash. DoubleType::Compare treats values within an
+        // epsilon as equal, while their hashes differ, so doubles are compared exactly. Values of
+        // the other types are equal exactly when util::ValueCombination considers them equal.
+        auto const equal = [&type, is_mixed = col_data.IsMixed()](std::byte const* a,
+                                                                   std::byte const* b) {
+            model::TypeId type_id = type.GetTypeId();
+            if (is_mixed) {
+                type_id = model::MixedType::RetrieveTypeId(a);
+                if (type_id != model::MixedType::RetrieveTypeId(b)) return false;
+            }
+            if (type_id == +model::TypeId::kDouble) {
+                if (is_mixed) {
+                    a = model::MixedType::RetrieveValue(a);
+                    b = model::MixedType::RetrieveValue(b);
+                }
+                return model::Type::GetValue<model::Double>(a) ==
+                       model::Type::GetValue<model::Double>(b);
+            }
+            return type.Compare(a, b) == model::CompareResult::kEqual;
+        };
+        std::unordered_map<std::byte const*, int, model::Type::Hasher, decltype(equal)> value_ids(
+                0, type.GetHasher(), equal);
+
+        // Empty values of mixed columns cannot be hashed. They are equal to each other, but not
+        // to nulls, and are unique when null is not equal to null, like nulls.
+        int const empty_value_id =
+                is_null_equal_null_ ? kMixedEmptyValueId : ColumnLayoutRelationData::kNullValueId;
+        std::vector<int> column;
+        column.reserve(col_data.GetNumRows());
+        for (std::byte const* value : col_data.GetData()) {
+            if (value == nullptr) {
+                column.push_back(ColumnLayoutRelationData::kNullValueId);
+            } else if (col_data.IsMixed() &&
+                       model::MixedType::RetrieveTypeId(value) == +model::TypeId::kEmpty) {
+                column.push_back(empty_value_id);
+            } else {
+                column.push_back(value_ids.try_emplace(value, value_ids.size()).first->second);
+            }
+        }
+        column_plis_.push_back(model::PositionListIndex::CreateFor(column, is_null_equal_null_));
+    }
 }
 
 void NDVerifier::MakeExecuteOptsAvailable() {
     MakeOptionsAvailable({config::kLhsIndicesOpt.GetName(), config::kRhsIndicesOpt.GetName(),
-                          config::names::kWeight});
+                          config::names::kWeight, config::kThreadNumberOpt.GetName()});
 }
 
 unsigned long long NDVerifier::ExecuteInternal() {
@@ -85,63 +142,47 @@ void NDVerifier::ResetState() {
     stats_calculator_ = util::StatsCalculator{};
 }
 
-void NDVerifier::AddVCToValues(
-        std::shared_ptr<std::vector<util::ValueCombination>> values,
-        std::shared_ptr<std::vector<size_t>> row,
-        std::vector<std::pair<model::TypeId, std::byte const*>> const& typed_data,
-        bool is_null) const {
-    util::ValueCombination vc{typed_data};
-
-    size_t index{values->size()};
-    if (is_null && !is_null_equal_null_) {
-        // If not null_eq_null, every value with null will be unique
-        values->push_back(vc);
-    } else {
-        for (size_t i{0}; i < values->size(); ++i) {
-            if ((*values)[i] == vc) {
-                index = i;
-                break;
-            }
-        }
-
-        if (index == values->size()) {  // wasn`t in values
-            values->push_back(vc);
-        }
+std::shared_ptr<std::vector<size_t>> NDVerifier::EncodeCombination(
+        config::IndicesType const& col_idxs, std::vector<util::ValueCombination>& values) const {
+    model::PositionListIndex const* pli = column_plis_[col_idxs.front()].get();
+    std::unique_ptr<model::PositionListIndex> intersection;
+    for (auto col_idx_pt{std::next(col_idxs.begin())}; col_idx_pt != col_idxs.end();
+         ++col_idx_pt) {
+        intersection = pli->Intersect(column_plis_[*col_idx_pt].get());
+        pli = intersection.get();
     }
-    row->push_back(index);
-}
-
-NDVerifier::CombinedValuesType NDVerifier::CombineValues(
-        config::IndicesType const& col_idxs) const {
-    auto values = std::make_shared<std::vector<util::ValueCombination>>();
-    auto row = std::make_shared<std::vector<size_t>>();
-
-    for (size_t row_idx{0}; row_idx < typed_relation_->GetNumRows(); ++row_idx) {
-        std::vector<std::pair<model::TypeId, std::byte const*>> typed_data;
-        bool was_null = false;
-        for (auto col_idx_pt{col_idxs.begin()}; col_idx_pt != col_idxs.end(); ++col_idx_pt) {
-            model::TypedColumnData const& col_data = typed_relation_->GetColumnData(*col_idx_pt);
-            std::vector<std::byte const*> const& byte_data = col_data.GetData();
-            auto type_id = col_data.GetTypeId();
-
-            std::byte const* bytes_ptr = byte_data[row_idx];
-            if (bytes_ptr == nullptr) {
-                LOG(INFO) << "WARNING: Cell (" << *col_idx_pt << ", " << row_idx << ") is empty";
-                was_null = true;
+    std::shared_ptr<std::vector<int> const> probing_table = pli->CalculateAndGetProbingTable();
+
+    constexpr size_t kNoCode = std::numeric_limits<size_t>::max();
+    std::vector<size_t> cluster_codes(pli->GetIndex().size() + 1, kNoCode);
+    auto encoded = std::make_shared<std::vector<size_t>>();
+    encoded->reserve(probing_table->size());
+    for (size_t row_idx{0}; row_idx < probing_table->size(); ++row_idx) {
+        int const cluster_id = (*probing_table)[row_idx];
+        // Rows of stripped clusters have unique values, nulls included unless null equals null
+        bool const is_unique = cluster_id == model::PositionListIndex::kSingletonValueId;
+        size_t code = is_unique ? kNoCode : cluster_codes[cluster_id];
+        if (code == kNoCode) {
+            std::vector<std::pair<model::TypeId, std::byte const*>> typed_data;
+            for (auto col_idx : col_idxs) {
+                model::TypedColumnData const& col_data = typed_relation_->GetColumnData(col_idx);
+                typed_data.emplace_back(col_data.GetTypeId(), col_data.GetValue(row_idx));
             }
-
-            typed_data.emplace_back(std::move(type_id), bytes_ptr);
+            code = values.size();
+            values.emplace_back(std::move(typed_data));
+            if (!is_unique) cluster_codes[cluster_id] = code;
         }
-
-        AddVCToValues(values, row, typed_data, was_null);
+        encoded->push_back(code);
     }
-    return std::make_pair(std::move(values), std::move(row));
+    return encoded;
 }
 
 void NDVerifier::VerifyND() {
     auto local_start_time = std::chrono::system_clock::now();
-    auto [lhs_values, combined_lhs] = CombineValues(lhs_indices_);
-    auto [rhs_values, combined_rhs] = CombineValues(rhs_indices_);
+    auto lhs_values = std::make_shared<std::vector<util::ValueCombination>>();
+    auto rhs_values = std::make_shared<std::vector<util::ValueCombination>>();
+    auto combined_lhs = EncodeCombination(lhs_indices_, *lhs_values);
+    auto combined_rhs = EncodeCombination(rhs_indices_, *rhs_values);
 
     LOG(DEBUG) << "Values combination took "
                << std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -149,28 +190,9 @@ void NDVerifier::VerifyND() {
                                          .count())
                << "ms";
 
-    local_start_time = std::chrono::system_clock::now();
-    std::unordered_map<size_t, std::unordered_set<size_t>> value_deps{};
-
-    for (size_t i{0}; i < combined_lhs->size(); ++i) {
-        auto lhs_code = (*combined_lhs)[i];
-        auto rhs_code = (*combined_rhs)[i];
-
-        if (value_deps.find(lhs_code) == value_deps.end()) {
-            value_deps.emplace(lhs_code, std::unordered_set<size_t>({rhs_code}));
-        } else {
-            value_deps[lhs_code].insert(rhs_code);
-        }
-    }
-    LOG(DEBUG) << "Value deps calculation took "
-               << std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                         std::chrono::system_clock::now() - local_start_time)
-                                         .count())
-               << "ms";
-
-    stats_calculator_ = util::StatsCalculator(std::move(value_deps), std::move(lhs_values),
-                                              std::move(rhs_values), std::move(combined_lhs),
-                                              std::move(combined_rhs));
+    stats_calculator_ =
+            util::StatsCalculator(std::move(lhs_values), std::move(rhs_values),
+                                  std::move(combined_lhs), std::move(combined_rhs), threads_num_);
 }
 
 [[nodiscard]] std::vector<util::Highlight> const& NDVerifier::GetHighlights() const {
@@ -13,7 +13,9 @@
 #include "config/equal_nulls/type.h"
 #include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_typed_relation_data.h"
+#include "model/table/position_list_index.h"
 #include "model/types/builtin.h"
 
 namespace algos::nd_verifier {
@@ -21,16 +23,15 @@ namespace algos::nd_verifier {
 /// @brief Algorithm for verifying if ND holds with given weight
 class NDVerifier : public Algorithm {
 private:
-    using CombinedValuesType = std::pair<std::shared_ptr<std::vector<util::ValueCombination>>,
-                                         std::shared_ptr<std::vector<size_t>>>;
-
     config::InputTable input_table_;
     config::IndicesType lhs_indices_;
     config::IndicesType rhs_indices_;
     model::WeightType weight_;
     config::EqNullsType is_null_equal_null_;
+    config::ThreadNumType threads_num_;
 
     std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::vector<std::unique_ptr<model::PositionListIndex>> column_plis_;
 
     util::StatsCalculator stats_calculator_;
 
@@ -38,17 +39,18 @@ private:
     void ResetState() override;
     void VerifyND();
 
-    CombinedValuesType CombineValues(config::IndicesType const& col_idxs) const;
+    void CreateColumnPLIs();
+
+    /// @brief Encode every row by the value of the column combination in it.
+    /// Codes are assigned in the order of the first occurrences of the values.
+    /// @param values  filled with the value of every code
+    std::shared_ptr<std::vector<size_t>> EncodeCombination(
+            config::IndicesType const& col_idxs, std::vector<util::ValueCombination>& values) const;
 
     void CalculateStats() {
         stats_calculator_.CalculateStats();
     }
 
-    void AddVCToValues(std::shared_ptr<std::vector<util::ValueCombination>> values,
-                       std::shared_ptr<std::vector<size_t>> row,
-                       std::vector<std::pair<model::TypeId, std::byte const*>> const& typed_data,
-                       bool is_null) const;
-
 protected:
     void LoadDataInternal() override;
     void MakeExecuteOptsAvailable() override;
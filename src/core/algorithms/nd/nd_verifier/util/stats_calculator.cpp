@@ -1,5 +1,6 @@
 #include "algorithms/nd/nd_verifier/util/stats_calculator.h"
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -9,6 +10,7 @@
 
 #include "algorithms/nd/nd.h"
 #include "algorithms/nd/nd_verifier/util/value_combination.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos::nd_verifier::util {
 
@@ -29,23 +31,69 @@ namespace algos::nd_verifier::util {
     return result;
 }
 
-void StatsCalculator::CalculateStats() {
-    lhs_frequencies_ =
-            CalculateFrequencies(lhs_values_->size(), encoded_lhs_->begin(), encoded_lhs_->end());
-    rhs_frequencies_ =
-            CalculateFrequencies(rhs_values_->size(), encoded_rhs_->begin(), encoded_rhs_->end());
+std::shared_ptr<std::vector<size_t>> StatsCalculator::CalculateFrequencies(
+        size_t codes_number, std::vector<size_t> const& encoded) {
+    auto result = std::make_shared<std::vector<size_t>>(codes_number, 0);
+    for (size_t code : encoded) {
+        ++(*result)[code];
+    }
 
-    model::WeightType max_weight{0};
-    model::WeightType min_weight{UINT_MAX};
-    for (size_t code{0}; code < lhs_values_->size(); ++code) {
-        size_t weight = value_deps_[code].size();
+    return result;
+}
+
+std::vector<size_t> StatsCalculator::CalculateWeights() const {
+    size_t const lhs_codes_number = lhs_values_->size();
+    if (lhs_codes_number == 0) return {};
+
+    // Rhs codes grouped by lhs codes, the group of a lhs code starts at group_begins[code]
+    std::vector<size_t> group_begins(lhs_codes_number + 1, 0);
+    for (size_t code{0}; code < lhs_codes_number; ++code) {
+        group_begins[code + 1] = group_begins[code] + (*lhs_frequencies_)[code];
+    }
+    std::vector<size_t> grouped_rhs(encoded_rhs_->size());
+    std::vector<size_t> group_ends(group_begins.begin(), std::prev(group_begins.end()));
+    for (size_t i{0}; i < encoded_lhs_->size(); ++i) {
+        grouped_rhs[group_ends[(*encoded_lhs_)[i]]++] = (*encoded_rhs_)[i];
+    }
 
-        if (weight == 0) {
-            // This value is associated with no rhs values, but is somehow present in value_deps
-            LOG(INFO) << "WARNING: Lhs value '" << (*lhs_values_)[code]
-                      << "''s weight is 0, but it's present in value_deps";
+    std::vector<size_t> weights(lhs_codes_number);
+    auto const calculate_weight = [&](size_t code) {
+        auto const begin = grouped_rhs.begin() + group_begins[code];
+        auto const end = grouped_rhs.begin() + group_begins[code + 1];
+        std::sort(begin, end);
+        weights[code] = std::distance(begin, std::unique(begin, end));
+    };
+
+    if (threads_num_ > 1) {
+        // Lhs codes are split into chunks, so that threads don't contend for every code
+        size_t const chunks_number = std::min<size_t>(threads_num_ * 16, lhs_codes_number);
+        size_t const chunk_size = (lhs_codes_number + chunks_number - 1) / chunks_number;
+        ::util::WorkerThreadPool pool{threads_num_};
+        pool.ExecIndex(
+                [&](size_t chunk) {
+                    size_t const end = std::min(lhs_codes_number, (chunk + 1) * chunk_size);
+                    for (size_t code{chunk * chunk_size}; code < end; ++code) {
+                        calculate_weight(code);
+                    }
+                },
+                chunks_number);
+    } else {
+        for (size_t code{0}; code < lhs_codes_number; ++code) {
+            calculate_weight(code);
         }
+    }
+
+    return weights;
+}
+
+void StatsCalculator::CalculateStats() {
+    lhs_frequencies_ = CalculateFrequencies(lhs_values_->size(), *encoded_lhs_);
+    rhs_frequencies_ = CalculateFrequencies(rhs_values_->size(), *encoded_rhs_);
 
+    std::vector<size_t> const weights = CalculateWeights();
+    model::WeightType max_weight{0};
+    model::WeightType min_weight{UINT_MAX};
+    for (size_t weight : weights) {
         if (weight > max_weight) {
             max_weight = weight;
         }
@@ -54,16 +102,23 @@ void StatsCalculator::CalculateStats() {
         }
     }
 
-    std::vector<size_t> highlights_lhs_codes;
-    for (size_t code{0}; code < lhs_values_->size(); ++code) {
-        if (value_deps_[code].size() == max_weight) {
-            highlights_lhs_codes.push_back(code);
+    // Rhs codes of highlights are collected in the order of the rows
+    std::vector<size_t> highlight_indices(weights.size(), weights.size());
+    std::vector<std::pair<size_t, std::unordered_set<size_t>>> highlights_rhs;
+    for (size_t code{0}; code < weights.size(); ++code) {
+        if (weights[code] == max_weight) {
+            highlight_indices[code] = highlights_rhs.size();
+            highlights_rhs.emplace_back(code, std::unordered_set<size_t>{});
+        }
+    }
+    for (size_t i{0}; i < encoded_lhs_->size(); ++i) {
+        size_t const highlight_index = highlight_indices[(*encoded_lhs_)[i]];
+        if (highlight_index != weights.size()) {
+            highlights_rhs[highlight_index].second.insert((*encoded_rhs_)[i]);
         }
     }
 
-    for (size_t highlight_lhs_code : highlights_lhs_codes) {
-        std::unordered_set<size_t>& rhs_set = value_deps_[highlight_lhs_code];
-
+    for (auto& [highlight_lhs_code, rhs_set] : highlights_rhs) {
         highlights_.emplace_back(lhs_values_, rhs_values_, encoded_lhs_, encoded_rhs_,
                                  lhs_frequencies_, rhs_frequencies_, highlight_lhs_code,
                                  std::move(rhs_set));
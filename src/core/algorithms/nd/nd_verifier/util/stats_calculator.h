@@ -9,12 +9,13 @@
 #include "algorithms/nd/nd.h"
 #include "algorithms/nd/nd_verifier/util/highlight.h"
 #include "algorithms/nd/nd_verifier/util/value_combination.h"
+#include "config/thread_number/type.h"
 
 namespace algos::nd_verifier::util {
 
 class StatsCalculator {
 private:
-    std::unordered_map<size_t, std::unordered_set<size_t>> value_deps_;
+    config::ThreadNumType threads_num_{1};
 
     // Shared data:
     std::shared_ptr<std::vector<ValueCombination>> lhs_values_;
@@ -29,28 +30,23 @@ private:
     model::WeightType global_min_weight_{UINT_MAX};
     model::WeightType real_weight_{0};
 
-    template <typename It>
-    std::shared_ptr<std::vector<size_t>> CalculateFrequencies(size_t codes_number, It begin,
-                                                              It end) {
-        auto result = std::make_shared<std::vector<size_t>>();
-        for (size_t code{0}; code < codes_number; ++code) {
-            result->push_back(std::count(begin, end, code));
-        }
+    static std::shared_ptr<std::vector<size_t>> CalculateFrequencies(
+            size_t codes_number, std::vector<size_t> const& encoded);
 
-        return result;
-    }
+    /// @brief Number of distinct rhs values of every lhs value
+    [[nodiscard]] std::vector<size_t> CalculateWeights() const;
 
     [[nodiscard]] std::unordered_map<std::string, size_t> GetFrequencies(
             std::shared_ptr<std::vector<ValueCombination>> values,
             std::shared_ptr<std::vector<size_t>> frequencies) const;
 
 public:
-    StatsCalculator(std::unordered_map<size_t, std::unordered_set<size_t>>&& value_deps,
-                    std::shared_ptr<std::vector<ValueCombination>> lhs_codes,
+    StatsCalculator(std::shared_ptr<std::vector<ValueCombination>> lhs_codes,
                     std::shared_ptr<std::vector<ValueCombination>> rhs_codes,
                     std::shared_ptr<std::vector<size_t>> encoded_lhs,
-                    std::shared_ptr<std::vector<size_t>> encoded_rhs)
-        : value_deps_(std::move(value_deps)),
+                    std::shared_ptr<std::vector<size_t>> encoded_rhs,
+                    config::ThreadNumType threads_num = 1)
+        : threads_num_(threads_num),
           lhs_values_(std::move(lhs_codes)),
           rhs_values_(std::move(rhs_codes)),
           encoded_lhs_(std::move(encoded_lhs)),
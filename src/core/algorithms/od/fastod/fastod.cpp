@@ -1,11 +1,17 @@
 #include "fastod.h"
 
+#include <atomic>
+#include <charconv>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
 
 #include <boost/unordered/unordered_map.hpp>
 #include <easylogging++.h>
 
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
 #include "config/time_limit/option.h"
 #include "util/timed_invoke.h"
 
@@ -23,8 +29,8 @@ void Fastod::CCPut(AttributeSet const& key, AttributeSet attribute_set) {
     cc_[key] = std::move(attribute_set);
 }
 
-fastod::AttributeSet const& Fastod::CCGet(AttributeSet const& key) {
-    return cc_[key];
+fastod::AttributeSet const& Fastod::CCGet(AttributeSet const& key) const {
+    return cc_.at(key);
 }
 
 void Fastod::PrepareOptions() {
@@ -35,6 +41,7 @@ void Fastod::PrepareOptions() {
 void Fastod::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
 
 void Fastod::MakeLoadOptionsAvailable() {
@@ -42,7 +49,8 @@ void Fastod::MakeLoadOptionsAvailable() {
 }
 
 void Fastod::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName()});
+    MakeOptionsAvailable(
+            {config::kTimeLimitSecondsOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void Fastod::LoadDataInternal() {
@@ -66,7 +74,12 @@ void Fastod::ResetState() {
 }
 
 unsigned long long Fastod::ExecuteInternal() {
+    if (threads_num_ > 1) {
+        pool_ = std::make_unique<util::WorkerThreadPool>(threads_num_);
+    }
+
     size_t const elapsed_milliseconds = util::TimedInvoke(&Fastod::Discover, this);
+    pool_.reset();
 
     for (auto const& od : result_asc_) {
         LOG(DEBUG) << od.ToString();
@@ -83,6 +96,69 @@ unsigned long long Fastod::ExecuteInternal() {
     return elapsed_milliseconds;
 }
 
+// An OD is written as "kind context_columns... -> columns...", where the kind is asc, desc or
+// simple, and the columns are the pair of an order compatible dependency or the right attribute
+std::string Fastod::SerializeResult() const {
+    std::ostringstream out;
+    auto write_context = [&out](std::string_view kind, AttributeSet const& context) {
+        out << kind;
+        context.Iterate([&out](model::ColumnIndex attr) { out << ' ' << attr; });
+        out << " ->";
+    };
+    for (AscCanonicalOD const& od : result_asc_) {
+        write_context("asc", od.GetContext());
+        out << ' ' << od.GetAttributePair().left << ' ' << od.GetAttributePair().right << '\n';
+    }
+    for (DescCanonicalOD const& od : result_desc_) {
+        write_context("desc", od.GetContext());
+        out << ' ' << od.GetAttributePair().left << ' ' << od.GetAttributePair().right << '\n';
+    }
+    for (SimpleCanonicalOD const& od : result_simple_) {
+        write_context("simple", od.GetContext());
+        out << ' ' << od.GetRight() << '\n';
+    }
+    return out.str();
+}
+
+void Fastod::LoadResult(std::string const& data) {
+    model::ColumnIndex const num_columns = data_->GetColumnCount();
+    auto parse_index = [num_columns](std::string const& token) {
+        model::ColumnIndex index;
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), index);
+        if (error != std::errc{} || end != token.data() + token.size() || index >= num_columns) {
+            throw std::invalid_argument("Invalid column index \"" + token + '"');
+        }
+        return index;
+    };
+
+    std::istringstream in{data};
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream line_in{line};
+        std::string kind;
+        line_in >> kind;
+        AttributeSet context(num_columns);
+        std::string token;
+        while (line_in >> token && token != "->") {
+            context.Set(parse_index(token));
+        }
+        std::vector<model::ColumnIndex> columns;
+        while (line_in >> token) {
+            columns.push_back(parse_index(token));
+        }
+        if (kind == "asc" && columns.size() == 2) {
+            result_asc_.emplace_back(context, columns[0], columns[1]);
+        } else if (kind == "desc" && columns.size() == 2) {
+            result_desc_.emplace_back(context, columns[0], columns[1]);
+        } else if (kind == "simple" && columns.size() == 1) {
+            result_simple_.emplace_back(context, columns[0]);
+        } else {
+            throw std::invalid_argument("Malformed OD \"" + line + '"');
+        }
+    }
+    is_complete_ = true;
+}
+
 void Fastod::PrintStatistics() const {
     const size_t ocd_count = result_asc_.size() + result_desc_.size();
     const size_t fd_count = result_simple_.size();
@@ -152,38 +228,72 @@ void Fastod::ComputeODs() {
         AddCandidates<true>(context, del_attrs);
     }
 
-    size_t delete_index = 0;
+    std::vector<AttributeSet const*> contexts;
+    contexts.reserve(context_in_current_level_.size());
 
     for (AttributeSet const& context : context_in_current_level_) {
-        auto const& del_attrs = deleted_attrs[delete_index++];
+        contexts.push_back(&context);
+        // Validation must not insert into the maps, so that contexts can be validated in parallel
+        CSGet<true>(context);
+        CSGet<false>(context);
+    }
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
+    std::vector<ContextODs> context_ods(contexts.size());
+    std::vector<char> validated(contexts.size(), false);
+    std::atomic<bool> time_is_up = false;
+
+    auto validate = [&](size_t i) {
+        if (time_is_up.load(std::memory_order_relaxed) || IsTimeUp()) {
+            time_is_up.store(true, std::memory_order_relaxed);
             return;
         }
 
-        AttributeSet const& cc = CCGet(context);
-        AttributeSet context_intersect_cc_context = fastod::Intersect(context, cc);
+        ValidateContext(*contexts[i], deleted_attrs[i], context_ods[i]);
+        validated[i] = true;
+    };
 
-        context_intersect_cc_context.Iterate(
-                [this, &context, &del_attrs, &cc](model::ColumnIndex attr) {
-                    SimpleCanonicalOD od(del_attrs[attr], attr);
+    if (pool_ != nullptr) {
+        pool_->ExecIndex(validate, contexts.size());
+    } else {
+        for (size_t i = 0; i < contexts.size() && !time_is_up; ++i) {
+            validate(i);
+        }
+    }
 
-                    if (od.IsValid(data_, partition_cache_)) {
-                        AddToResult(std::move(od));
-                        CCPut(context, fastod::DeleteAttribute(cc, attr));
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        if (validated[i]) {
+            AddToResult(std::move(context_ods[i]));
+        }
+    }
 
-                        const AttributeSet diff = fastod::Difference(schema_, context);
+    if (time_is_up) {
+        is_complete_ = false;
+    }
+}
 
-                        if (diff.Any()) {
-                            CCPut(context, cc & (~diff));
-                        }
-                    }
-                });
+void Fastod::ValidateContext(AttributeSet const& context,
+                             std::vector<AttributeSet> const& del_attrs, ContextODs& ods) {
+    AttributeSet& cc = cc_.at(context);
+    AttributeSet context_intersect_cc_context = fastod::Intersect(context, cc);
 
-        CalculateODs<false>(context, del_attrs);
-        CalculateODs<true>(context, del_attrs);
-    }
+    context_intersect_cc_context.Iterate([this, &context, &del_attrs, &cc,
+                                          &ods](model::ColumnIndex attr) {
+        SimpleCanonicalOD od(del_attrs[attr], attr);
+
+        if (od.IsValid(data_, partition_cache_)) {
+            ods.simple.emplace_back(std::move(od));
+            cc = fastod::DeleteAttribute(cc, attr);
+
+            const AttributeSet diff = fastod::Difference(schema_, context);
+
+            if (diff.Any()) {
+                cc = cc & (~diff);
+            }
+        }
+    });
+
+    CalculateODs<false>(del_attrs, cs_desc_.at(context), ods);
+    CalculateODs<true>(del_attrs, cs_asc_.at(context), ods);
 }
 
 void Fastod::PruneLevels() {
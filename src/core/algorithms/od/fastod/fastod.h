@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -13,7 +15,9 @@
 #include "algorithms/od/fastod/storage/partition_cache.h"
 #include "algorithms/od/fastod/util/timer.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "config/time_limit/type.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -28,7 +32,15 @@ private:
     using DataFrame = fastod::DataFrame;
     using Timer = fastod::Timer;
 
+    // ODs found in one context of a level.
+    struct ContextODs {
+        std::vector<AscCanonicalOD> asc;
+        std::vector<DescCanonicalOD> desc;
+        std::vector<SimpleCanonicalOD> simple;
+    };
+
     config::TimeLimitSecondsType time_limit_seconds_ = 0u;
+    config::ThreadNumType threads_num_ = 1;
     bool is_complete_ = true;
     size_t level_ = 1;
 
@@ -43,6 +55,8 @@ private:
 
     Timer timer_;
     PartitionCache partition_cache_;
+    // Only exists during execution with more than one thread.
+    std::unique_ptr<util::WorkerThreadPool> pool_;
 
     AttributeSet schema_;
     std::shared_ptr<DataFrame> data_;
@@ -53,6 +67,14 @@ private:
     void ResetState() override;
     unsigned long long ExecuteInternal() final;
 
+    // Results of a run stopped by the time limit are not kept
+    bool CanCacheResult() const noexcept override {
+        return time_limit_seconds_ == 0;
+    }
+
+    std::string SerializeResult() const override;
+    void LoadResult(std::string const& data) override;
+
     void PrepareOptions();
     void RegisterOptions();
     void MakeLoadOptionsAvailable();
@@ -61,12 +83,14 @@ private:
 
     void Initialize();
     void ComputeODs();
+    void ValidateContext(AttributeSet const& context, std::vector<AttributeSet> const& del_attrs,
+                         ContextODs& ods);
     void PruneLevels();
     void CalculateNextLevel();
     void Discover();
 
     void CCPut(AttributeSet const& key, AttributeSet attribute_set);
-    AttributeSet const& CCGet(AttributeSet const& key);
+    AttributeSet const& CCGet(AttributeSet const& key) const;
 
     template <bool Ascending>
     void CSPut(AttributeSet const& key, AttributePair const& value) {
@@ -95,17 +119,10 @@ private:
         }
     }
 
-    template <bool Ascending>
-    void AddToResult(fastod::CanonicalOD<Ascending>&& od) {
-        if constexpr (Ascending) {
-            result_asc_.emplace_back(std::move(od));
-        } else {
-            result_desc_.emplace_back(std::move(od));
-        }
-    }
-
-    void AddToResult(SimpleCanonicalOD&& od) {
-        result_simple_.emplace_back(std::move(od));
+    void AddToResult(ContextODs&& ods) {
+        std::move(ods.asc.begin(), ods.asc.end(), std::back_inserter(result_asc_));
+        std::move(ods.desc.begin(), ods.desc.end(), std::back_inserter(result_desc_));
+        std::move(ods.simple.begin(), ods.simple.end(), std::back_inserter(result_simple_));
     }
 
     template <bool Ascending>
@@ -148,10 +165,11 @@ private:
         }
     }
 
+    // Only touches the candidates of the context, so contexts of a level can be processed in
+    // parallel.
     template <bool Ascending>
-    void CalculateODs(AttributeSet const& context, std::vector<AttributeSet> const& deleted_attrs) {
-        auto& cs_for_con = CSGet<Ascending>(context);
-
+    void CalculateODs(std::vector<AttributeSet> const& deleted_attrs,
+                      std::unordered_set<AttributePair>& cs_for_con, ContextODs& ods) {
         for (auto it = cs_for_con.begin(); it != cs_for_con.end();) {
             model::ColumnIndex a = it->left;
             model::ColumnIndex b = it->right;
@@ -162,7 +180,11 @@ private:
                                                   b);
 
                 if (od.IsValid(data_, partition_cache_)) {
-                    AddToResult(std::move(od));
+                    if constexpr (Ascending) {
+                        ods.asc.emplace_back(std::move(od));
+                    } else {
+                        ods.desc.emplace_back(std::move(od));
+                    }
                     cs_for_con.erase(it++);
                 } else {
                     ++it;
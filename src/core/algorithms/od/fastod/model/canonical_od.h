@@ -21,6 +21,14 @@ public:
     bool IsValid(std::shared_ptr<DataFrame> data, PartitionCache& cache) const;
     std::string ToString() const;
 
+    AttributeSet const& GetContext() const noexcept {
+        return context_;
+    }
+
+    AttributePair const& GetAttributePair() const noexcept {
+        return ap_;
+    }
+
     friend bool operator==(CanonicalOD<true> const& x, CanonicalOD<true> const& y);
     friend bool operator!=(CanonicalOD<true> const& x, CanonicalOD<true> const& y);
     friend bool operator<(CanonicalOD<true> const& x, CanonicalOD<true> const& y);
@@ -46,6 +54,14 @@ public:
     bool IsValid(std::shared_ptr<DataFrame> data, PartitionCache& cache) const;
     std::string ToString() const;
 
+    AttributeSet const& GetContext() const noexcept {
+        return context_;
+    }
+
+    model::ColumnIndex GetRight() const noexcept {
+        return right_;
+    }
+
     friend bool operator==(SimpleCanonicalOD const& x, SimpleCanonicalOD const& y);
     friend bool operator!=(SimpleCanonicalOD const& x, SimpleCanonicalOD const& y);
     friend bool operator<(SimpleCanonicalOD const& x, SimpleCanonicalOD const& y);
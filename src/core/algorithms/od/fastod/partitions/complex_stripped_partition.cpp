@@ -86,13 +86,40 @@ void ComplexStrippedPartition::ToStrippedPartition() {
         sp_begins_->push_back(sp_begin);
     }
 
-    rb_begins_->clear();
-    rb_indexes_->clear();
+    rb_begins_.reset();
+    rb_indexes_.reset();
 
     is_stripped_partition_ = true;
     should_be_converted_to_sp_ = false;
 }
 
+size_t ComplexStrippedPartition::GetMemoryUsage() const {
+    auto vector_memory = [](auto const& vector_ptr) -> size_t {
+        return vector_ptr ? vector_ptr->capacity() * sizeof(vector_ptr->front()) : 0;
+    };
+
+    return sizeof(*this) + vector_memory(sp_indexes_) + vector_memory(sp_begins_) +
+           vector_memory(rb_indexes_) + vector_memory(rb_begins_);
+}
+
+size_t ComplexStrippedPartition::GetGroupCount() const {
+    return is_stripped_partition_ ? sp_begins_->size() - 1 : rb_begins_->size() - 1;
+}
+
+size_t ComplexStrippedPartition::GetTupleCount() const {
+    if (is_stripped_partition_) {
+        return sp_indexes_->size();
+    }
+
+    size_t tuple_count = 0;
+
+    for (DataFrame::Range const& range : *rb_indexes_) {
+        tuple_count += RangeSize(range);
+    }
+
+    return tuple_count;
+}
+
 std::string ComplexStrippedPartition::CommonToString() const {
     std::stringstream result;
     std::string indexes_string;
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "algorithms/od/fastod/storage/data_frame.h"
@@ -20,6 +23,14 @@ private:
 
     static constexpr inline double kSmallRangesRatioToConvert = 0.5;
     static constexpr inline size_t kMinMeaningfulRangeSize = static_cast<size_t>(40);
+    static constexpr inline size_t kTupleFractionToScanByValue = static_cast<size_t>(8);
+    static constexpr inline size_t kNoGroup = std::numeric_limits<size_t>::max();
+
+    struct GroupState {
+        int left_value = std::numeric_limits<int>::min();
+        int left_value_max = std::numeric_limits<int>::min();
+        int preceding_max = std::numeric_limits<int>::min();
+    };
 
     std::string CommonToString() const;
     void CommonProduct(model::ColumnIndex attribute);
@@ -29,34 +40,78 @@ private:
     void RangeBasedProduct(model::ColumnIndex attribute);
     bool RangeBasedSplit(model::ColumnIndex right) const;
 
-    std::vector<DataFrame::ValueIndices> IntersectWithAttribute(model::ColumnIndex attribute,
-                                                                size_t group_start,
-                                                                size_t group_end);
+    size_t GetGroupCount() const;
+    size_t GetTupleCount() const;
 
-    ComplexStrippedPartition(std::shared_ptr<DataFrame> data,
-                             std::shared_ptr<std::vector<size_t>> indexes,
-                             std::shared_ptr<std::vector<size_t>> begins);
+    template <typename F>
+    void ForEachTuple(F f) const {
+        if (is_stripped_partition_) {
+            for (size_t group = 0; group + 1 < sp_begins_->size(); ++group) {
+                for (size_t i = (*sp_begins_)[group]; i < (*sp_begins_)[group + 1]; ++i) {
+                    f(group, (*sp_indexes_)[i]);
+                }
+            }
+        } else {
+            for (size_t group = 0; group + 1 < rb_begins_->size(); ++group) {
+                for (size_t i = (*rb_begins_)[group]; i < (*rb_begins_)[group + 1]; ++i) {
+                    DataFrame::Range const& range = (*rb_indexes_)[i];
 
-    ComplexStrippedPartition(std::shared_ptr<DataFrame> data,
-                             std::shared_ptr<std::vector<DataFrame::Range>> indexes,
-                             std::shared_ptr<std::vector<size_t>> begins);
+                    for (size_t j = range.first; j <= range.second; ++j) {
+                        f(group, j);
+                    }
+                }
+            }
+        }
+    }
 
-public:
-    ComplexStrippedPartition();
-    ComplexStrippedPartition(ComplexStrippedPartition const& origin) = default;
+    /* A swap is a pair of tuples of one group where the left value of the first one precedes the
+     * left value of the second one while the right value follows it. Tuples of the table are
+     * scanned in the order of left values, and for every group the maximum right value among the
+     * tuples with preceding left values is kept.
+     */
+    template <bool Ascending>
+    bool SwapByValueOrder(model::ColumnIndex left, model::ColumnIndex right) const {
+        std::vector<size_t> group_of_tuple(data_->GetTupleCount(), kNoGroup);
+        ForEachTuple([&group_of_tuple](size_t group, size_t tuple) {
+            group_of_tuple[tuple] = group;
+        });
 
-    ComplexStrippedPartition& operator=(ComplexStrippedPartition const& other);
+        std::vector<GroupState> states(GetGroupCount());
+        std::vector<int> const& tuples = data_->GetTuplesByValue(left);
 
-    std::string ToString() const;
-    void Product(model::ColumnIndex attribute);
-    bool Split(model::ColumnIndex right) const;
+        auto has_swap = [&](int tuple) {
+            const size_t group = group_of_tuple[tuple];
 
-    bool ShouldBeConvertedToStrippedPartition() const;
-    void ToStrippedPartition();
+            if (group == kNoGroup) {
+                return false;
+            }
+
+            GroupState& state = states[group];
+            int const left_value = data_->GetValue(tuple, left);
+            int const right_value = data_->GetValue(tuple, right);
+
+            if (left_value != state.left_value) {
+                state.preceding_max = std::max(state.preceding_max, state.left_value_max);
+                state.left_value = left_value;
+                state.left_value_max = right_value;
+            } else {
+                state.left_value_max = std::max(state.left_value_max, right_value);
+            }
+
+            return state.preceding_max > right_value;
+        };
+
+        if constexpr (Ascending) {
+            return std::any_of(tuples.begin(), tuples.end(), has_swap);
+        } else {
+            return std::any_of(tuples.rbegin(), tuples.rend(), has_swap);
+        }
+    }
 
     template <bool Ascending>
-    bool Swap(model::ColumnIndex left, model::ColumnIndex right) const {
+    bool SwapBySorting(model::ColumnIndex left, model::ColumnIndex right) const {
         const size_t group_count = is_stripped_partition_ ? sp_begins_->size() : rb_begins_->size();
+        std::vector<std::pair<int, int>> values;
 
         for (size_t begin_pointer = 0; begin_pointer < group_count - 1; begin_pointer++) {
             const size_t group_begin = is_stripped_partition_ ? (*sp_begins_)[begin_pointer]
@@ -65,11 +120,9 @@ public:
             const size_t group_end = is_stripped_partition_ ? (*sp_begins_)[begin_pointer + 1]
                                                             : (*rb_begins_)[begin_pointer + 1];
 
-            std::vector<std::pair<int, int>> values;
+            values.clear();
 
             if (is_stripped_partition_) {
-                values.reserve(group_end - group_begin);
-
                 for (size_t i = group_begin; i < group_end; ++i) {
                     const size_t index = (*sp_indexes_)[i];
 
@@ -118,6 +171,43 @@ public:
         return false;
     }
 
+    std::vector<DataFrame::ValueIndices> IntersectWithAttribute(model::ColumnIndex attribute,
+                                                                size_t group_start,
+                                                                size_t group_end);
+
+    ComplexStrippedPartition(std::shared_ptr<DataFrame> data,
+                             std::shared_ptr<std::vector<size_t>> indexes,
+                             std::shared_ptr<std::vector<size_t>> begins);
+
+    ComplexStrippedPartition(std::shared_ptr<DataFrame> data,
+                             std::shared_ptr<std::vector<DataFrame::Range>> indexes,
+                             std::shared_ptr<std::vector<size_t>> begins);
+
+public:
+    ComplexStrippedPartition();
+    ComplexStrippedPartition(ComplexStrippedPartition const& origin) = default;
+
+    ComplexStrippedPartition& operator=(ComplexStrippedPartition const& other);
+
+    std::string ToString() const;
+    void Product(model::ColumnIndex attribute);
+    bool Split(model::ColumnIndex right) const;
+
+    bool ShouldBeConvertedToStrippedPartition() const;
+    void ToStrippedPartition();
+
+    // Memory owned by the index vectors, which may be shared with copies of the partition.
+    size_t GetMemoryUsage() const;
+
+    template <bool Ascending>
+    bool Swap(model::ColumnIndex left, model::ColumnIndex right) const {
+        // A pass in the order of left values visits every tuple of the table, sorting visits only
+        // tuples of the partition but costs a logarithmic factor.
+        return GetTupleCount() * kTupleFractionToScanByValue >= data_->GetTupleCount()
+                       ? SwapByValueOrder<Ascending>(left, right)
+                       : SwapBySorting<Ascending>(left, right);
+    }
+
     template <bool RangeBasedMode>
     static ComplexStrippedPartition Create(std::shared_ptr<DataFrame> data) {
         if constexpr (RangeBasedMode) {
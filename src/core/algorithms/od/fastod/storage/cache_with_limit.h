@@ -1,24 +1,60 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
-#include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace algos::fastod {
 
+// Cache limited by the total memory of its values. When the limit is exceeded, values that were
+// used least often are evicted.
 template <typename K, typename V>
 class CacheWithLimit {
 private:
-    std::unordered_map<K, V> entries_;
-    std::queue<K> keys_in_order_;
-    const size_t max_size_;
+    struct Entry {
+        V value;
+        size_t memory;
+        size_t uses;
+    };
+
+    std::unordered_map<K, Entry> entries_;
+    const size_t max_memory_;
+    size_t memory_ = 0;
+
+    // Evicts values used no more often than the median. Use counts of the remaining values are
+    // halved, so that values that were only popular long ago do not stay forever.
+    void EvictRarelyUsed(const K& keep) {
+        while (memory_ > max_memory_ && entries_.size() > 1) {
+            std::vector<size_t> uses;
+            uses.reserve(entries_.size());
+
+            for (auto const& [key, entry] : entries_) {
+                uses.push_back(entry.uses);
+            }
+
+            auto median = uses.begin() + uses.size() / 2;
+            std::nth_element(uses.begin(), median, uses.end());
+            const size_t median_uses = *median;
+
+            for (auto it = entries_.begin(); it != entries_.end();) {
+                if (it->second.uses <= median_uses && !(it->first == keep)) {
+                    memory_ -= it->second.memory;
+                    it = entries_.erase(it);
+                } else {
+                    it->second.uses /= 2;
+                    ++it;
+                }
+            }
+        }
+    }
 
 public:
-    explicit CacheWithLimit(size_t max_size) : max_size_(max_size){};
+    explicit CacheWithLimit(size_t max_memory) : max_memory_(max_memory){};
 
     void Clear() {
         entries_.clear();
-        keys_in_order_ = {};
+        memory_ = 0;
     }
 
     bool Contains(const K& key) const noexcept {
@@ -26,18 +62,31 @@ public:
     }
 
     const V& Get(const K& key) const {
-        return entries_.at(key);
+        return entries_.at(key).value;
     }
 
-    void Set(const K& key, const V& value) {
-        if (!entries_.try_emplace(key, value).second) return;
+    // Counts a use of the value. Returns nullptr if there is no value for the key.
+    const V* Use(const K& key) {
+        auto it = entries_.find(key);
 
-        if (keys_in_order_.size() >= max_size_) {
-            entries_.erase(keys_in_order_.front());
-            keys_in_order_.pop();
+        if (it == entries_.end()) {
+            return nullptr;
         }
 
-        keys_in_order_.push(key);
+        it->second.uses++;
+        return &it->second.value;
+    }
+
+    void Set(const K& key, const V& value, size_t memory) {
+        if (memory > max_memory_ || !entries_.try_emplace(key, Entry{value, memory, 1}).second) {
+            return;
+        }
+
+        memory_ += memory;
+
+        if (memory_ > max_memory_) {
+            EvictRarelyUsed(key);
+        }
     }
 };
 
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <stdexcept>
+#include <utility>
 
 #include "algorithms/od/fastod/util/type_util.h"
 #include "csv_parser/csv_parser.h"
@@ -18,6 +19,7 @@ DataFrame::DataFrame(std::vector<model::TypedColumnData> const& columns_data) {
     data_.reserve(cols_num);
     data_ranges_.reserve(cols_num);
     range_item_placement_.reserve(cols_num);
+    tuples_by_value_.reserve(cols_num);
 
     std::transform(columns_data.cbegin(), columns_data.cend(), std::back_inserter(data_),
                    ConvertColumnDataToIntegers);
@@ -25,6 +27,9 @@ DataFrame::DataFrame(std::vector<model::TypedColumnData> const& columns_data) {
     std::transform(data_.cbegin(), data_.cend(), std::back_inserter(data_ranges_),
                    ExtractRangesFromColumn);
 
+    std::transform(data_.cbegin(), data_.cend(), std::back_inserter(tuples_by_value_),
+                   SortTuplesByValue);
+
     for (size_t column = 0; column < cols_num; ++column) {
         const size_t tuple_count = data_[column].size();
 
@@ -59,6 +64,10 @@ size_t DataFrame::GetRangeIndexByItem(size_t item, model::ColumnIndex attribute)
     return range_item_placement_[attribute][item];
 }
 
+std::vector<int> const& DataFrame::GetTuplesByValue(model::ColumnIndex attribute) const {
+    return tuples_by_value_[attribute];
+}
+
 model::ColumnIndex DataFrame::GetColumnCount() const {
     return data_.size();
 }
@@ -192,6 +201,33 @@ std::vector<DataFrame::ValueIndices> DataFrame::ExtractRangesFromColumn(
     return ranges;
 }
 
+std::vector<int> DataFrame::SortTuplesByValue(std::vector<int> const& column) {
+    // Values are dense ranks starting from zero, so counting sort is enough.
+    std::vector<int> value_begins;
+
+    for (int value : column) {
+        if (static_cast<size_t>(value) >= value_begins.size()) {
+            value_begins.resize(value + 1);
+        }
+
+        value_begins[value]++;
+    }
+
+    int begin = 0;
+
+    for (int& count : value_begins) {
+        begin += std::exchange(count, begin);
+    }
+
+    std::vector<int> tuples(column.size());
+
+    for (size_t i = 0; i < column.size(); ++i) {
+        tuples[value_begins[column[i]]++] = static_cast<int>(i);
+    }
+
+    return tuples;
+}
+
 std::optional<size_t> DataFrame::FindRangeIndexByItem(
         size_t item, std::vector<DataFrame::ValueIndices> const& ranges) {
     auto iter = std::find_if(ranges.cbegin(), ranges.cend(), [item](auto const& p) {
@@ -21,6 +21,8 @@ private:
     std::vector<std::vector<int>> data_;
     std::vector<std::vector<DataFrame::ValueIndices>> data_ranges_;
     std::vector<std::vector<size_t>> range_item_placement_;
+    // Tuple indices of every column in the ascending order of the values.
+    std::vector<std::vector<int>> tuples_by_value_;
 
     AttributeSet attrs_with_ranges_;
 
@@ -34,6 +36,8 @@ private:
     static std::vector<DataFrame::ValueIndices> ExtractRangesFromColumn(
             std::vector<int> const& column);
 
+    static std::vector<int> SortTuplesByValue(std::vector<int> const& column);
+
     static std::optional<size_t> FindRangeIndexByItem(
             size_t item, std::vector<DataFrame::ValueIndices> const& ranges);
 
@@ -51,6 +55,7 @@ public:
     int GetValue(int tuple_index, model::ColumnIndex attribute_index) const;
     std::vector<std::vector<DataFrame::ValueIndices>> const& GetDataRanges() const;
     size_t GetRangeIndexByItem(size_t item, model::ColumnIndex attribute) const;
+    std::vector<int> const& GetTuplesByValue(model::ColumnIndex attribute) const;
 
     model::ColumnIndex GetColumnCount() const;
     size_t GetTupleCount() const;
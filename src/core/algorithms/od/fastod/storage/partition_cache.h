@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <optional>
 
 #include "algorithms/od/fastod/model/attribute_set.h"
 #include "algorithms/od/fastod/partitions/complex_stripped_partition.h"
@@ -8,11 +10,16 @@
 
 namespace algos::fastod {
 
+// Thread-safe. Partitions are computed outside of the lock, copies of a partition share its
+// index vectors, so returning them by value is cheap.
 class PartitionCache {
 private:
-    CacheWithLimit<AttributeSet, ComplexStrippedPartition> cache_{static_cast<size_t>(1e8)};
+    static constexpr size_t kMaxMemory = static_cast<size_t>(1) << 30;
 
-    void CallProductWithAttribute(ComplexStrippedPartition& partition, size_t attribute) {
+    CacheWithLimit<AttributeSet, ComplexStrippedPartition> cache_{kMaxMemory};
+    std::mutex mutex_;
+
+    static void CallProductWithAttribute(ComplexStrippedPartition& partition, size_t attribute) {
         partition.Product(attribute);
 
         if (partition.ShouldBeConvertedToStrippedPartition()) {
@@ -20,49 +27,67 @@ private:
         }
     }
 
-    bool CallProductWithAttributesInCache(ComplexStrippedPartition& result,
-                                          AttributeSet const& attribute_set) {
-        bool is_product_called = false;
+    // Looks for a cached partition of the attribute set without one attribute.
+    std::optional<model::ColumnIndex> FindCachedSubset(ComplexStrippedPartition& subset_partition,
+                                                       AttributeSet const& attribute_set) {
+        std::optional<model::ColumnIndex> missing_attr;
+
+        attribute_set.Iterate([this, &attribute_set, &subset_partition,
+                               &missing_attr](model::ColumnIndex attr) {
+            if (missing_attr.has_value()) {
+                return;
+            }
+
+            AttributeSet one_less = DeleteAttribute(attribute_set, attr);
 
-        attribute_set.Iterate(
-                [this, &attribute_set, &result, &is_product_called](model::ColumnIndex attr) {
-                    AttributeSet one_less = DeleteAttribute(attribute_set, attr);
+            if (!one_less.Any()) {
+                return;
+            }
 
-                    if (one_less.Any() && cache_.Contains(one_less)) {
-                        result = cache_.Get(one_less);
-                        CallProductWithAttribute(result, attr);
-                        is_product_called = true;
-                    }
-                });
+            if (ComplexStrippedPartition const* cached = cache_.Use(one_less)) {
+                subset_partition = *cached;
+                missing_attr = attr;
+            }
+        });
 
-        return is_product_called;
+        return missing_attr;
     }
 
 public:
     void Clear() {
+        std::lock_guard lock(mutex_);
         cache_.Clear();
     }
 
     ComplexStrippedPartition GetStrippedPartition(AttributeSet const& attribute_set,
                                                   std::shared_ptr<DataFrame> data) {
-        if (cache_.Contains(attribute_set)) {
-            return cache_.Get(attribute_set);
-        }
-
         ComplexStrippedPartition result_partition;
-        bool is_product_called = CallProductWithAttributesInCache(result_partition, attribute_set);
+        std::optional<model::ColumnIndex> missing_attr;
+
+        {
+            std::lock_guard lock(mutex_);
+
+            if (ComplexStrippedPartition const* cached = cache_.Use(attribute_set)) {
+                return *cached;
+            }
+
+            missing_attr = FindCachedSubset(result_partition, attribute_set);
+        }
 
-        if (!is_product_called) {
+        if (missing_attr.has_value()) {
+            CallProductWithAttribute(result_partition, *missing_attr);
+        } else {
             result_partition = data->IsAttributesMostlyRangeBased(attribute_set)
                                        ? ComplexStrippedPartition::Create<true>(data)
                                        : ComplexStrippedPartition::Create<false>(data);
 
-            attribute_set.Iterate([this, &result_partition](model::ColumnIndex attr) {
+            attribute_set.Iterate([&result_partition](model::ColumnIndex attr) {
                 CallProductWithAttribute(result_partition, attr);
             });
         }
 
-        cache_.Set(attribute_set, result_partition);
+        std::lock_guard lock(mutex_);
+        cache_.Set(attribute_set, result_partition, result_partition.GetMemoryUsage());
         return result_partition;
     }
 };
@@ -1,67 +1,55 @@
 #include "dependency_checker.h"
 
 #include <algorithm>
-#include <unordered_set>
+#include <vector>
 
 #include "model/table/tuple_index.h"
 
 namespace algos::order {
 
-namespace {
-bool SubsetSetDifference(SortedPartition::EquivalenceClass const& a,
-                         SortedPartition::EquivalenceClass& b) {
-    auto const not_found = b.end();
-    for (model::TupleIndex element : a) {
-        auto it = b.find(element);
-        if (it == not_found) {
-            return false;
-        }
-        b.erase(it);
-    }
-    return true;
-}
-}  // namespace
+/* Rows s and t are swapped if s is before t in l but after t in r. If there are no swaps, classes
+ * of r are ascending along l, and the candidate is invalidated by a merge if a class of r contains
+ * rows of several classes of l. Such a class then has the maximum index among the classes of r for
+ * all the preceding classes of l and the minimum one for the next class, so comparing adjacent
+ * classes of l is enough.
+ */
+ValidityType CheckForSwap(SortedPartition const& l, SortedPartition const& r,
+                          SortedPartition::Buffers& buffers) {
+    using PartitionIndex = SortedPartition::PartitionIndex;
+    std::vector<PartitionIndex>& r_class_of_row = buffers.class_of_row;
+    r.GetClassIndices(r_class_of_row);
 
-ValidityType CheckForSwap(SortedPartition const& l, SortedPartition const& r) {
     ValidityType res = ValidityType::valid;
-    size_t l_i = 0, r_i = 0;
-    bool next_l = true, next_r = true;
-    SortedPartition::EquivalenceClass l_eq_class;
-    SortedPartition::EquivalenceClass r_eq_class;
-    SortedPartition::EquivalenceClasses const& l_classes = l.GetEqClasses();
-    SortedPartition::EquivalenceClasses const& r_classes = r.GetEqClasses();
-    while (l_i < l_classes.size() && r_i < r_classes.size()) {
-        if (next_l) {
-            l_eq_class = l_classes[l_i];
-        }
-        if (next_r) {
-            r_eq_class = r_classes[r_i];
+    bool first_class = true;
+    PartitionIndex prev_max = 0;
+    for (std::size_t i = 0; i < l.Size(); ++i) {
+        bool empty = true;
+        PartitionIndex min = 0, max = 0;
+        for (model::TupleIndex tuple_index : l.GetEqClass(i)) {
+            PartitionIndex const r_class = r_class_of_row[tuple_index];
+            if (!SortedPartition::IsInPartition(r_class)) continue;
+            min = empty ? r_class : std::min(min, r_class);
+            max = empty ? r_class : std::max(max, r_class);
+            empty = false;
         }
-        if (l_eq_class.size() < r_eq_class.size()) {
-            if (!SubsetSetDifference(l_eq_class, r_eq_class)) {
+        if (empty) continue;
+        if (!first_class) {
+            if (prev_max > min) {
                 return ValidityType::swap;
-            } else {
-                res = ValidityType::merge;
-                ++l_i;
-                next_l = true;
-                next_r = false;
             }
-        } else {
-            if (!SubsetSetDifference(r_eq_class, l_eq_class)) {
-                return ValidityType::swap;
-            } else {
-                ++r_i;
-                next_r = true;
-                if (l_eq_class.empty()) {
-                    ++l_i;
-                    next_l = true;
-                } else {
-                    next_l = false;
-                }
+            if (prev_max == min) {
+                res = ValidityType::merge;
             }
         }
+        first_class = false;
+        prev_max = max;
     }
     return res;
 }
 
+ValidityType CheckForSwap(SortedPartition const& l, SortedPartition const& r) {
+    SortedPartition::Buffers buffers;
+    return CheckForSwap(l, r, buffers);
+}
+
 }  // namespace algos::order
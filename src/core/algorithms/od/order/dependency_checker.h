@@ -8,6 +8,8 @@ namespace algos::order {
 
 BETTER_ENUM(ValidityType, char, valid = 0, merge, swap);
 
+ValidityType CheckForSwap(SortedPartition const& l, SortedPartition const& r,
+                          SortedPartition::Buffers& buffers);
 ValidityType CheckForSwap(SortedPartition const& l, SortedPartition const& r);
 
 }  // namespace algos::order
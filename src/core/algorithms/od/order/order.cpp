@@ -1,16 +1,22 @@
 #include "order.h"
 
 #include <algorithm>
+#include <charconv>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
 #include <utility>
 
 #include <easylogging++.h>
 
 #include "config/names_and_descriptions.h"
 #include "config/tabular_data/input_table/option.h"
+#include "config/thread_number/option.h"
 #include "dependency_checker.h"
 #include "list_lattice.h"
+#include "model/table/relation_session.h"
 #include "model/table/tuple_index.h"
 #include "model/types/types.h"
 #include "order_utility.h"
@@ -28,13 +34,26 @@ void Order::RegisterOptions() {
     using config::Option;
 
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+}
+
+void Order::MakeExecuteOptsAvailable() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void Order::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, false);
+    typed_relation_ = model::GetSharedTypedRelation(*input_table_, false);
 }
 
-void Order::ResetState() {}
+void Order::ResetState() {
+    sorted_partitions_.clear();
+    single_attributes_.clear();
+    previous_candidate_sets_.clear();
+    candidate_sets_.clear();
+    valid_.clear();
+    merge_invalidated_.clear();
+    lattice_.reset();
+}
 
 void Order::PruneSingleEqClassPartitions() {
     for (auto& [attr, partition] : sorted_partitions_) {
@@ -75,33 +94,64 @@ void Order::CreateSingleColumnSortedPartitions() {
             return type->Compare(l.data, r.data) == model::CompareResult::kEqual;
         };
         std::sort(indexed_byte_data.begin(), indexed_byte_data.end(), less);
-        SortedPartition::EquivalenceClasses equivalence_classes;
-        equivalence_classes.reserve(typed_relation_->GetNumRows());
-        equivalence_classes.push_back({indexed_byte_data.front().index});
-        for (size_t k = 1; k < indexed_byte_data.size(); ++k) {
-            if (equal(indexed_byte_data[k - 1], indexed_byte_data[k])) {
-                equivalence_classes.back().insert(indexed_byte_data[k].index);
-            } else {
-                equivalence_classes.push_back({indexed_byte_data[k].index});
+        std::vector<model::TupleIndex> rows;
+        rows.reserve(indexed_byte_data.size());
+        std::vector<std::size_t> begins = {0};
+        for (size_t k = 0; k < indexed_byte_data.size(); ++k) {
+            if (k != 0 && !equal(indexed_byte_data[k - 1], indexed_byte_data[k])) {
+                begins.push_back(k);
             }
+            rows.push_back(indexed_byte_data[k].index);
         }
-        equivalence_classes.shrink_to_fit();
-        sorted_partitions_.emplace(
-                AttributeList{i},
-                SortedPartition(std::move(equivalence_classes), typed_relation_->GetNumRows()));
+        if (!rows.empty()) {
+            begins.push_back(rows.size());
+        }
+        begins.shrink_to_fit();
+        sorted_partitions_.emplace(AttributeList{i},
+                                   SortedPartition(std::move(rows), std::move(begins),
+                                                   typed_relation_->GetNumRows()));
     }
     PruneSingleEqClassPartitions();
 }
 
-void Order::CreateSortedPartitionsFromSingletons(AttributeList const& attr_list) {
-    if (sorted_partitions_.find(attr_list) != sorted_partitions_.end()) {
+template <typename Work>
+void Order::ForEachIndex(std::size_t size, Work work) {
+    if (pool_ == nullptr || size < 2) {
+        SortedPartition::Buffers buffers;
+        for (std::size_t i = 0; i < size; ++i) {
+            work(i, buffers);
+        }
         return;
     }
+    pool_->ExecIndexWithResource(work, []() { return SortedPartition::Buffers{}; }, size);
+}
+
+SortedPartition Order::CreateSortedPartitionFromSingletons(
+        AttributeList const& attr_list, SortedPartition::Buffers& buffers) const {
     SortedPartition res = sorted_partitions_.at({attr_list[0]});
     for (size_t i = 1; i < attr_list.size(); ++i) {
-        res.Intersect(sorted_partitions_.at({attr_list[i]}));
+        res.Intersect(sorted_partitions_.at({attr_list[i]}), buffers);
+    }
+    return res;
+}
+
+void Order::CreateSortedPartitionsFromSingletons(
+        std::vector<AttributeList const*> const& attr_lists) {
+    std::vector<AttributeList const*> missing;
+    std::unordered_set<AttributeList, ListHash> seen;
+    for (AttributeList const* attr_list : attr_lists) {
+        if (sorted_partitions_.find(*attr_list) == sorted_partitions_.end() &&
+            seen.insert(*attr_list).second) {
+            missing.push_back(attr_list);
+        }
+    }
+    std::vector<SortedPartition> partitions(missing.size());
+    ForEachIndex(missing.size(), [&](std::size_t i, SortedPartition::Buffers& buffers) {
+        partitions[i] = CreateSortedPartitionFromSingletons(*missing[i], buffers);
+    });
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        sorted_partitions_.emplace(*missing[i], std::move(partitions[i]));
     }
-    sorted_partitions_.emplace(attr_list, res);
 }
 
 bool Order::HasValidPrefix(AttributeList const& lhs, AttributeList const& rhs) const {
@@ -115,26 +165,49 @@ bool Order::HasValidPrefix(AttributeList const& lhs, AttributeList const& rhs) c
     return prefix_valid;
 }
 
-ValidityType Order::CheckCandidateValidity(AttributeList const& lhs, AttributeList const& rhs) {
-    bool is_merge_immediately = false;
+bool Order::IsMergeInvalidated(AttributeList const& lhs, AttributeList const& rhs) const {
     for (AttributeList const& lhs_prefix : GetPrefixes(lhs)) {
         if (InUnorderedMap(merge_invalidated_, lhs_prefix, rhs)) {
-            is_merge_immediately = true;
-            break;
+            return true;
         }
     }
-    ValidityType candidate_validity = +ValidityType::merge;
-    if (!is_merge_immediately) {
-        CreateSortedPartitionsFromSingletons(lhs);
-        if (sorted_partitions_[lhs].Size() == 1) {
-            candidate_validity = +ValidityType::valid;
-            candidate_sets_[lhs].erase(rhs);
+    return false;
+}
+
+/* Validity of a candidate depends only on the ODs of the previous levels, so the candidates of a
+ * level are checked independently: the sorted partitions they need are created in parallel first,
+ * then the candidates are checked in parallel.
+ */
+std::vector<ValidityType> Order::CheckCandidatesValidity(CandidatePairs const& candidates) {
+    std::vector<ValidityType> validities(candidates.size(), +ValidityType::merge);
+    std::vector<std::size_t> to_check;
+    std::vector<AttributeList const*> attr_lists;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (!IsMergeInvalidated(candidates[i].first, candidates[i].second)) {
+            to_check.push_back(i);
+            attr_lists.push_back(&candidates[i].first);
+        }
+    }
+    CreateSortedPartitionsFromSingletons(attr_lists);
+
+    std::vector<std::size_t> to_swap_check;
+    attr_lists.clear();
+    for (std::size_t i : to_check) {
+        if (sorted_partitions_.at(candidates[i].first).Size() == 1) {
+            validities[i] = +ValidityType::valid;
         } else {
-            CreateSortedPartitionsFromSingletons(rhs);
-            candidate_validity = CheckForSwap(sorted_partitions_[lhs], sorted_partitions_[rhs]);
+            to_swap_check.push_back(i);
+            attr_lists.push_back(&candidates[i].second);
         }
     }
-    return candidate_validity;
+    CreateSortedPartitionsFromSingletons(attr_lists);
+
+    ForEachIndex(to_swap_check.size(), [&](std::size_t j, SortedPartition::Buffers& buffers) {
+        auto const& [lhs, rhs] = candidates[to_swap_check[j]];
+        validities[to_swap_check[j]] =
+                CheckForSwap(sorted_partitions_.at(lhs), sorted_partitions_.at(rhs), buffers);
+    });
+    return validities;
 }
 
 void Order::ComputeDependencies(ListLattice::LatticeLevel const& lattice_level) {
@@ -142,43 +215,44 @@ void Order::ComputeDependencies(ListLattice::LatticeLevel const& lattice_level)
         return;
     }
     UpdateCandidateSets();
+    CandidatePairs candidates;
     for (Node const& node : lattice_level) {
-        CandidatePairs candidate_pairs = lattice_->ObtainCandidates(node);
-        for (auto const& [lhs, rhs] : candidate_pairs) {
+        for (auto& [lhs, rhs] : lattice_->ObtainCandidates(node)) {
             if (!InUnorderedMap(candidate_sets_, lhs, rhs)) {
                 continue;
             }
             if (HasValidPrefix(lhs, rhs)) {
                 continue;
             }
-            ValidityType candidate_validity = CheckCandidateValidity(lhs, rhs);
-            if (candidate_validity == +ValidityType::valid) {
-                bool non_minimal_by_merge = false;
-                for (AttributeList const& merge_lhs : GetPrefixes(lhs)) {
-                    if (InUnorderedMap(merge_invalidated_, merge_lhs, rhs)) {
-                        non_minimal_by_merge = true;
-                        break;
-                    }
-                }
-                if (non_minimal_by_merge) {
-                    continue;
-                }
-                if (valid_.find(lhs) == valid_.end()) {
-                    valid_[lhs] = {};
-                }
-                valid_[lhs].insert(rhs);
-                bool lhs_unique = typed_relation_->GetNumRows() == sorted_partitions_[lhs].Size();
-                if (lhs_unique) {
-                    candidate_sets_[lhs].erase(rhs);
-                }
-            } else if (candidate_validity == +ValidityType::swap) {
+            candidates.emplace_back(std::move(lhs), std::move(rhs));
+        }
+    }
+    std::vector<ValidityType> validities = CheckCandidatesValidity(candidates);
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        auto const& [lhs, rhs] = candidates[i];
+        ValidityType candidate_validity = validities[i];
+        if (candidate_validity == +ValidityType::valid) {
+            bool lhs_unique = typed_relation_->GetNumRows() == sorted_partitions_[lhs].Size();
+            if (sorted_partitions_[lhs].Size() == 1) {
                 candidate_sets_[lhs].erase(rhs);
-            } else if (candidate_validity == +ValidityType::merge) {
-                if (merge_invalidated_.find(lhs) == merge_invalidated_.end()) {
-                    merge_invalidated_[lhs] = {};
-                }
-                merge_invalidated_[lhs].insert(rhs);
             }
+            if (IsMergeInvalidated(lhs, rhs)) {
+                continue;
+            }
+            if (valid_.find(lhs) == valid_.end()) {
+                valid_[lhs] = {};
+            }
+            valid_[lhs].insert(rhs);
+            if (lhs_unique) {
+                candidate_sets_[lhs].erase(rhs);
+            }
+        } else if (candidate_validity == +ValidityType::swap) {
+            candidate_sets_[lhs].erase(rhs);
+        } else if (candidate_validity == +ValidityType::merge) {
+            if (merge_invalidated_.find(lhs) == merge_invalidated_.end()) {
+                merge_invalidated_[lhs] = {};
+            }
+            merge_invalidated_[lhs].insert(rhs);
         }
     }
     MergePrune();
@@ -359,6 +433,9 @@ void Order::PrintValidOD() {
 
 unsigned long long Order::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
+    if (threads_num_ > 1) {
+        pool_ = std::make_unique<util::WorkerThreadPool>(threads_num_);
+    }
     CreateSingleColumnSortedPartitions();
     lattice_ = std::make_unique<ListLattice>(candidate_sets_, single_attributes_);
     while (!lattice_->IsEmpty()) {
@@ -366,6 +443,7 @@ unsigned long long Order::ExecuteInternal() {
         lattice_->Prune(candidate_sets_);
         lattice_->GenerateNextLevel(candidate_sets_);
     }
+    pool_.reset();
     PrintValidOD();
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -373,4 +451,53 @@ unsigned long long Order::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
+// An OD is written as "lhs_columns... -> rhs_columns..."
+std::string Order::SerializeResult() const {
+    std::ostringstream out;
+    for (auto const& [lhs, rhses] : valid_) {
+        for (AttributeList const& rhs : rhses) {
+            for (model::ColumnIndex index : lhs) {
+                out << index << ' ';
+            }
+            out << "->";
+            for (model::ColumnIndex index : rhs) {
+                out << ' ' << index;
+            }
+            out << '\n';
+        }
+    }
+    return out.str();
+}
+
+void Order::LoadResult(std::string const& data) {
+    std::size_t const num_columns = typed_relation_->GetNumColumns();
+    auto parse_index = [num_columns](std::string const& token) {
+        model::ColumnIndex index;
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), index);
+        if (error != std::errc{} || end != token.data() + token.size() || index >= num_columns) {
+            throw std::invalid_argument("Invalid column index \"" + token + '"');
+        }
+        return index;
+    };
+
+    std::istringstream in{data};
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream line_in{line};
+        AttributeList lhs;
+        AttributeList rhs;
+        std::string token;
+        while (line_in >> token && token != "->") {
+            lhs.push_back(parse_index(token));
+        }
+        while (line_in >> token) {
+            rhs.push_back(parse_index(token));
+        }
+        if (lhs.empty() || rhs.empty()) {
+            throw std::invalid_argument("Malformed OD \"" + line + '"');
+        }
+        valid_[std::move(lhs)].insert(std::move(rhs));
+    }
+}
+
 }  // namespace algos::order
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "algorithms/algorithm.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "dependency_checker.h"
 #include "list_lattice.h"
 #include "model/table/column_layout_typed_relation_data.h"
 #include "order_utility.h"
 #include "sorted_partitions.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos::order {
 
@@ -20,7 +23,10 @@ public:
     using TypedRelation = model::ColumnLayoutTypedRelationData;
 
     config::InputTable input_table_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    config::ThreadNumType threads_num_ = 1;
+    // Only exists during execution with more than one thread.
+    std::unique_ptr<util::WorkerThreadPool> pool_;
+    std::shared_ptr<TypedRelation> typed_relation_;
     SortedPartitions sorted_partitions_;
     std::vector<AttributeList> single_attributes_;
     CandidateSets previous_candidate_sets_;
@@ -30,13 +36,19 @@ public:
     std::unique_ptr<ListLattice> lattice_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailable() override;
     void LoadDataInternal() override;
     void ResetState() override;
     void PruneSingleEqClassPartitions();
     void CreateSingleColumnSortedPartitions();
-    void CreateSortedPartitionsFromSingletons(AttributeList const& attr_list);
+    template <typename Work>
+    void ForEachIndex(std::size_t size, Work work);
+    SortedPartition CreateSortedPartitionFromSingletons(AttributeList const& attr_list,
+                                                        SortedPartition::Buffers& buffers) const;
+    void CreateSortedPartitionsFromSingletons(std::vector<AttributeList const*> const& attr_lists);
     bool HasValidPrefix(AttributeList const& lhs, AttributeList const& rhs) const;
-    ValidityType CheckCandidateValidity(AttributeList const& lhs, AttributeList const& rhs);
+    bool IsMergeInvalidated(AttributeList const& lhs, AttributeList const& rhs) const;
+    std::vector<ValidityType> CheckCandidatesValidity(CandidatePairs const& candidates);
     void ComputeDependencies(ListLattice::LatticeLevel const& lattice_level);
     std::vector<AttributeList> Extend(AttributeList const& lhs, AttributeList const& rhs) const;
     bool IsMinimal(AttributeList const& a) const;
@@ -46,6 +58,13 @@ public:
     void PrintValidOD();
     unsigned long long ExecuteInternal() final;
 
+    bool CanCacheResult() const noexcept override {
+        return true;
+    }
+
+    std::string SerializeResult() const override;
+    void LoadResult(std::string const& data) override;
+
 public:
     OrderDependencies const& GetValidODs() const {
         return valid_;
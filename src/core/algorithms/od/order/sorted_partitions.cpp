@@ -1,70 +1,90 @@
 #include "sorted_partitions.h"
 
-#include <unordered_map>
+#include <algorithm>
 #include <vector>
 
 #include "model/table/tuple_index.h"
 
 namespace algos::order {
 
-void SortedPartition::BuildHashTable() {
-    hash_partition_.reserve(num_rows_);
-    for (PartitionIndex i = 0; i < sorted_partition_.size(); ++i) {
-        if (sorted_partition_[i].size() == 1) {
-            continue;
-        }
-        for (model::TupleIndex tuple_index : sorted_partition_[i]) {
-            hash_partition_.emplace(tuple_index, i);
-        }
+SortedPartition::SortedPartition(std::vector<model::TupleIndex>&& rows,
+                                 std::vector<std::size_t>&& begins, unsigned long num_rows)
+    : rows_(std::move(rows)), begins_(std::move(begins)), num_rows_(num_rows) {
+    for (std::size_t i = 0; i < Size(); ++i) {
+        std::sort(rows_.begin() + begins_[i], rows_.begin() + begins_[i + 1]);
     }
 }
 
-SortedPartition::HashProduct SortedPartition::BuildHashProduct(SortedPartition const& other) {
-    HashProduct hash_product;
-    hash_product.reserve(hash_partition_.size());
-    for (EquivalenceClass const& eq_class : other.sorted_partition_) {
-        if (other.sorted_partition_.size() <= 1) {
-            break;
+void SortedPartition::GetClassIndices(std::vector<PartitionIndex>& class_of_row) const {
+    class_of_row.assign(num_rows_, kNoClass);
+    for (PartitionIndex i = 0; i < Size(); ++i) {
+        for (model::TupleIndex tuple_index : GetEqClass(i)) {
+            class_of_row[tuple_index] = i;
         }
-        std::unordered_set<PartitionIndex> visited_positions;
-        for (model::TupleIndex tuple_index : eq_class) {
-            auto it = hash_partition_.find(tuple_index);
-            if (it == hash_partition_.end()) {
-                continue;
-            }
-            PartitionIndex position = it->second;
-            visited_positions.insert(position);
-            auto pos_it = hash_product.find(position);
-            if (pos_it == hash_product.end()) {
-                pos_it = hash_product.emplace(position, EquivalenceClasses{{}}).first;
-            }
-            pos_it->second.back().insert(tuple_index);
+    }
+}
+
+/* Counting sort of the rows of non-singleton classes by their classes in other: rows are visited in
+ * the order of the classes of other and put to the next free position of their class here. Then a
+ * class is split where the class in other changes. Rows of other are ascending inside a class, so
+ * rows of the resulting classes are ascending too.
+ */
+void SortedPartition::Intersect(SortedPartition const& other, Buffers& buffers) {
+    std::vector<PartitionIndex>& class_of_row = buffers.class_of_row;
+    std::vector<PartitionIndex>& fill_positions = buffers.fill_positions;
+    std::vector<PartitionIndex>& refined_classes = buffers.refined_classes;
+
+    class_of_row.assign(num_rows_, kNoClass);
+    for (PartitionIndex i = 0; i < Size(); ++i) {
+        if (begins_[i + 1] - begins_[i] == 1) continue;
+        for (model::TupleIndex tuple_index : GetEqClass(i)) {
+            class_of_row[tuple_index] = i;
         }
-        for (PartitionIndex position : visited_positions) {
-            hash_product[position].push_back({});
+    }
+    fill_positions.assign(begins_.begin(), begins_.end() - 1);
+    refined_classes.resize(rows_.size());
+
+    std::vector<model::TupleIndex> rows(rows_.size());
+    for (PartitionIndex j = 0; j < other.Size(); ++j) {
+        for (model::TupleIndex tuple_index : other.GetEqClass(j)) {
+            PartitionIndex const class_index = class_of_row[tuple_index];
+            if (class_index == kNoClass) continue;
+            std::size_t const position = fill_positions[class_index]++;
+            rows[position] = tuple_index;
+            refined_classes[position] = j;
         }
     }
-    return hash_product;
-}
 
-void SortedPartition::Intersect(SortedPartition const& other) {
-    BuildHashTable();
-    HashProduct hash_product = BuildHashProduct(other);
-    SortedPartition res(num_rows_);
-    res.sorted_partition_.reserve(num_rows_);
-    for (std::size_t i = 0; i < sorted_partition_.size(); ++i) {
-        if (EquivalenceClass const& eq_class = sorted_partition_[i]; eq_class.size() == 1) {
-            res.sorted_partition_.push_back(eq_class);
-        } else {
-            for (EquivalenceClass& eq_class : hash_product[i]) {
-                if (!eq_class.empty()) {
-                    res.sorted_partition_.push_back(std::move(eq_class));
-                }
+    std::vector<std::size_t> begins;
+    begins.reserve(rows_.size() + 1);
+    begins.push_back(0);
+    std::size_t out = 0;
+    for (PartitionIndex i = 0; i < Size(); ++i) {
+        std::size_t const begin = begins_[i];
+        std::size_t end = fill_positions[i];
+        if (begins_[i + 1] - begin == 1) {
+            // Singleton classes cannot be split, they are kept as they are.
+            rows[begin] = rows_[begin];
+            end = begin + 1;
+        }
+        if (begin == end) continue;
+        for (std::size_t position = begin; position < end; ++position) {
+            if (position != begin && refined_classes[position] != refined_classes[position - 1]) {
+                begins.push_back(out);
             }
+            rows[out++] = rows[position];
         }
+        begins.push_back(out);
     }
-    res.sorted_partition_.shrink_to_fit();
-    *this = std::move(res);
+    rows.resize(out);
+    begins.shrink_to_fit();
+    rows_ = std::move(rows);
+    begins_ = std::move(begins);
+}
+
+void SortedPartition::Intersect(SortedPartition const& other) {
+    Buffers buffers;
+    Intersect(other, buffers);
 }
 
 }  // namespace algos::order
@@ -1,41 +1,64 @@
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <cstddef>
+#include <span>
 #include <vector>
 
 #include "model/table/tuple_index.h"
 
 namespace algos::order {
 
+/* Equivalence classes of rows in the order of their values. Rows of all classes are stored in one
+ * array, rows of the i-th class are rows_[begins_[i]..begins_[i + 1]) in ascending order.
+ */
 class SortedPartition {
 public:
-    using EquivalenceClass = std::unordered_set<model::TupleIndex>;
-    using EquivalenceClasses = std::vector<EquivalenceClass>;
+    using EquivalenceClass = std::span<model::TupleIndex const>;
     using PartitionIndex = unsigned long;
-    using HashProduct = std::unordered_map<PartitionIndex, EquivalenceClasses>;
+
+    // Scratch memory reused between intersections, so that they don't allocate per call.
+    // Must not be shared between threads.
+    struct Buffers {
+        std::vector<PartitionIndex> class_of_row;
+        std::vector<PartitionIndex> fill_positions;
+        std::vector<PartitionIndex> refined_classes;
+    };
 
 private:
-    EquivalenceClasses sorted_partition_;
-    std::unordered_map<model::TupleIndex, PartitionIndex> hash_partition_;
-    unsigned long num_rows_ = 0;
+    static constexpr PartitionIndex kNoClass = static_cast<PartitionIndex>(-1);
 
-    void BuildHashTable();
-    HashProduct BuildHashProduct(SortedPartition const& other);
+    std::vector<model::TupleIndex> rows_;
+    std::vector<std::size_t> begins_ = {0};
+    unsigned long num_rows_ = 0;
 
 public:
     SortedPartition() = default;
     explicit SortedPartition(unsigned long num_rows) noexcept : num_rows_(num_rows){};
-    SortedPartition(EquivalenceClasses&& eq_classes, unsigned long num_rows)
-        : sorted_partition_(std::move(eq_classes)), num_rows_(num_rows){};
+    // Rows of every class are sorted here, they may come in any order.
+    SortedPartition(std::vector<model::TupleIndex>&& rows, std::vector<std::size_t>&& begins,
+                    unsigned long num_rows);
+
+    // Splits every class into the classes of other, keeping the order of other inside a class.
+    void Intersect(SortedPartition const& other, Buffers& buffers);
     void Intersect(SortedPartition const& other);
 
-    EquivalenceClasses const& GetEqClasses() const {
-        return sorted_partition_;
+    EquivalenceClass GetEqClass(std::size_t index) const {
+        return {rows_.data() + begins_[index], rows_.data() + begins_[index + 1]};
     }
 
+    // Index of the class of every row, kNoClass for rows not in the partition.
+    void GetClassIndices(std::vector<PartitionIndex>& class_of_row) const;
+
     std::size_t Size() const {
-        return sorted_partition_.size();
+        return begins_.size() - 1;
+    }
+
+    unsigned long GetNumRows() const {
+        return num_rows_;
+    }
+
+    static bool IsInPartition(PartitionIndex class_index) {
+        return class_index != kNoClass;
     }
 };
 
@@ -0,0 +1,225 @@
+#include "algorithms/result_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <typeindex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "config/error_measure/type.h"
+#include "config/indices/type.h"
+#include "config/names.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/tabular_data/input_tables_type.h"
+#include "model/table/relation_session.h"
+
+namespace {
+
+// Cache entries of other versions are never read, increase it when a format of results changes
+constexpr unsigned kFormatVersion = 1;
+
+class Fnv1aHash {
+private:
+    static constexpr std::uint64_t kOffsetBasis = 14695981039346656037ULL;
+    static constexpr std::uint64_t kPrime = 1099511628211ULL;
+
+    std::uint64_t hash_ = kOffsetBasis;
+
+public:
+    void Add(std::string const& string) {
+        // The size goes first, so that different sequences of strings cannot have the same bytes
+        std::uint64_t size = string.size();
+        for (unsigned i = 0; i != sizeof(size); ++i) {
+            AddByte(static_cast<unsigned char>(size >> (8 * i)));
+        }
+        for (char c : string) {
+            AddByte(static_cast<unsigned char>(c));
+        }
+    }
+
+    void AddByte(unsigned char byte) noexcept {
+        hash_ = (hash_ ^ byte) * kPrime;
+    }
+
+    std::string ToHex() const {
+        std::ostringstream out;
+        out << std::hex;
+        out.width(16);
+        out.fill('0');
+        out << hash_;
+        return out.str();
+    }
+};
+
+using ToStringFunction = std::function<std::string(boost::any const&)>;
+
+template <typename T>
+std::pair<std::type_index, ToStringFunction> normal_to_string_pair{
+        std::type_index(typeid(T)), [](boost::any const& value) {
+            std::ostringstream out;
+            out.precision(17);
+            out << boost::any_cast<T>(value);
+            return out.str();
+        }};
+
+template <typename T>
+std::pair<std::type_index, ToStringFunction> enum_to_string_pair{
+        std::type_index(typeid(T)),
+        [](boost::any const& value) { return boost::any_cast<T>(value)._to_string(); }};
+
+std::unordered_map<std::type_index, ToStringFunction> const kToStringFunctions{
+        normal_to_string_pair<bool>,
+        normal_to_string_pair<int>,
+        normal_to_string_pair<unsigned int>,
+        normal_to_string_pair<unsigned short>,
+        normal_to_string_pair<long>,
+        normal_to_string_pair<unsigned long>,
+        normal_to_string_pair<double>,
+        normal_to_string_pair<long double>,
+        normal_to_string_pair<std::string>,
+        enum_to_string_pair<config::PfdErrorMeasureType>,
+        enum_to_string_pair<config::AfdErrorMeasureType>,
+        {std::type_index(typeid(config::IndicesType)), [](boost::any const& value) {
+             std::string result;
+             for (config::IndexType index : boost::any_cast<config::IndicesType>(value)) {
+                 result += std::to_string(index) + ',';
+             }
+             return result;
+         }}};
+
+// Options that change how the results are obtained but not the results themselves
+std::unordered_set<std::string_view> const kIgnoredOptions{config::names::kThreads,
+                                                           config::names::kMemLimitMB};
+
+// A session reads its table once for all the algorithms attached to it
+std::string GetTableFingerprint(model::IDatasetStream& table) {
+    if (auto* session_table = dynamic_cast<model::SessionTable*>(&table)) {
+        return session_table->GetSession().GetFingerprint(&algos::ResultCache::GetFingerprint);
+    }
+    return algos::ResultCache::GetFingerprint(table);
+}
+
+std::string ReadFile(std::filesystem::path const& path) {
+    std::ifstream in{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+namespace algos {
+
+ResultCache::ResultCache(std::filesystem::path directory) : directory_(std::move(directory)) {
+    std::filesystem::create_directories(directory_);
+}
+
+std::filesystem::path ResultCache::GetEntryPath(std::string const& key) const {
+    Fnv1aHash hash;
+    hash.Add(key);
+    return directory_ / (hash.ToHex() + ".result");
+}
+
+std::optional<std::string> ResultCache::Find(std::string const& key) const {
+    std::filesystem::path const path = GetEntryPath(key);
+    if (!std::filesystem::exists(path)) return std::nullopt;
+
+    // An entry starts with its key, which is compared to tell apart the keys of the same hash
+    std::string entry = ReadFile(path);
+    std::string const header = std::to_string(key.size()) + '\n' + key;
+    if (entry.compare(0, header.size(), header) != 0) return std::nullopt;
+    return entry.substr(header.size());
+}
+
+void ResultCache::Store(std::string const& key, std::string const& data) const {
+    std::filesystem::path const path = GetEntryPath(key);
+    std::filesystem::path temp_path = path;
+    temp_path += '.' + std::to_string(std::random_device{}());
+    {
+        std::ofstream out{temp_path, std::ios::binary};
+        out << key.size() << '\n' << key << data;
+        if (!out) {
+            throw std::runtime_error("Failed to write a result cache entry to " +
+                                     temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path);
+}
+
+void ResultCache::Clear() const {
+    for (std::filesystem::directory_entry const& entry :
+         std::filesystem::directory_iterator(directory_)) {
+        if (entry.path().extension() == ".result") {
+            std::filesystem::remove(entry.path());
+        }
+    }
+}
+
+std::string ResultCache::GetFingerprint(model::IDatasetStream& stream) {
+    Fnv1aHash hash;
+    std::size_t const num_columns = stream.GetNumberOfColumns();
+    for (std::size_t i = 0; i != num_columns; ++i) {
+        hash.Add(stream.GetColumnName(i));
+    }
+    std::size_t num_rows = 0;
+    while (stream.HasNextRow()) {
+        for (std::string const& value : stream.GetNextRow()) {
+            hash.Add(value);
+        }
+        hash.AddByte('\n');
+        ++num_rows;
+    }
+    stream.Reset();
+    return std::to_string(num_columns) + 'x' + std::to_string(num_rows) + ':' + hash.ToHex();
+}
+
+std::optional<std::string> ResultCache::GetTablesFingerprint(config::OptValue const& opt_value) {
+    if (opt_value.type == typeid(config::InputTable)) {
+        auto const& table = boost::any_cast<config::InputTable const&>(opt_value.value);
+        return table == nullptr ? std::string{} : GetTableFingerprint(*table);
+    }
+    if (opt_value.type == typeid(config::InputTables)) {
+        std::string fingerprint;
+        for (config::InputTable const& table :
+             boost::any_cast<config::InputTables const&>(opt_value.value)) {
+            fingerprint += GetTableFingerprint(*table) + ';';
+        }
+        return fingerprint;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> ResultCache::MakeKey(
+        std::string const& algorithm_name,
+        std::unordered_map<std::string_view, config::OptValue> const& opt_values,
+        std::unordered_map<std::string_view, std::string> const& table_fingerprints) {
+    std::vector<std::string> options;
+    for (auto const& [name, opt_value] : opt_values) {
+        if (kIgnoredOptions.contains(name)) continue;
+        std::string value;
+        if (auto it = table_fingerprints.find(name); it != table_fingerprints.end()) {
+            value = it->second;
+        } else if (std::optional<std::string> fingerprint = GetTablesFingerprint(opt_value)) {
+            value = std::move(*fingerprint);
+        } else {
+            auto to_string_it = kToStringFunctions.find(opt_value.type);
+            if (to_string_it == kToStringFunctions.end()) return std::nullopt;
+            value = to_string_it->second(opt_value.value);
+        }
+        options.push_back(std::string{name} + '=' + value);
+    }
+    std::sort(options.begin(), options.end());
+
+    std::string key = std::to_string(kFormatVersion) + '\n' + algorithm_name + '\n';
+    for (std::string const& option : options) {
+        key += option + '\n';
+    }
+    return key;
+}
+
+}  // namespace algos
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "config/ioption.h"
+#include "model/table/idataset_stream.h"
+
+namespace algos {
+
+/**
+ * Results of algorithm executions kept on the local disk.
+ *
+ * An entry is stored under a key that describes the execution: the algorithm, the fingerprints
+ * of its tables and the values of its other options. An algorithm that has a result cache set
+ * looks its key up before mining and, if the entry is found, loads the results from it instead.
+ * Every entry is a separate file, which is written to a temporary file first and then renamed,
+ * so several processes may share the directory.
+ */
+class ResultCache {
+private:
+    std::filesystem::path directory_;
+
+    std::filesystem::path GetEntryPath(std::string const& key) const;
+
+public:
+    /* Creates the directory if it does not exist */
+    explicit ResultCache(std::filesystem::path directory);
+
+    std::optional<std::string> Find(std::string const& key) const;
+    void Store(std::string const& key, std::string const& data) const;
+    /* Removes all entries */
+    void Clear() const;
+
+    std::filesystem::path const& GetDirectory() const noexcept {
+        return directory_;
+    }
+
+    /* Reads the whole stream and resets it. Streams with the same column names and rows have
+     * the same fingerprint */
+    static std::string GetFingerprint(model::IDatasetStream& stream);
+
+    /* Returns the fingerprint of the tables if the option holds a table or a list of them. The
+     * fingerprint of a table attached to a session is taken once per session */
+    static std::optional<std::string> GetTablesFingerprint(config::OptValue const& opt_value);
+
+    /* Returns nothing if there is an option whose type cannot be a part of a key. Tables are
+     * represented by the fingerprints, which are taken from table_fingerprints by option name if
+     * they are there, and calculated otherwise. Options that do not affect the results, like the
+     * number of threads, are left out */
+    static std::optional<std::string> MakeKey(
+            std::string const& algorithm_name,
+            std::unordered_map<std::string_view, config::OptValue> const& opt_values,
+            std::unordered_map<std::string_view, std::string> const& table_fingerprints);
+};
+
+}  // namespace algos
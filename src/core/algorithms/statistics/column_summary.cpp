@@ -0,0 +1,505 @@
+#include "algorithms/statistics/column_summary.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "model/types/mixed_type.h"
+
+namespace algos {
+
+namespace {
+
+constexpr char kSummaryMagic[] = "CSUM";
+constexpr std::uint8_t kSummaryVersion = 1;
+
+/* Finalizer of SplitMix64, spreads the bits of FNV-1a hashes over the HyperLogLog registers */
+std::uint64_t Mix(std::uint64_t x) noexcept {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/* Hashes do not depend on the platform, so that serialized summaries can be merged anywhere */
+std::uint64_t HashBytes(std::uint8_t tag, std::string const& bytes) noexcept {
+    constexpr std::uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+    constexpr std::uint64_t kFnvPrime = 0x100000001b3ULL;
+
+    std::uint64_t hash = (kFnvOffsetBasis ^ tag) * kFnvPrime;
+    for (unsigned char c : bytes) {
+        hash = (hash ^ c) * kFnvPrime;
+    }
+    return Mix(hash);
+}
+
+/* An int and a double with the same value are the same value */
+std::uint64_t HashNumber(double number) noexcept {
+    if (number == 0) number = 0;  // -0.0
+    return Mix(std::bit_cast<std::uint64_t>(number) ^ 0x9e3779b97f4a7c15ULL);
+}
+
+template <typename T>
+void WriteValue(std::ostream& out, T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template <typename T>
+T ReadValue(std::istream& in) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::invalid_argument("Invalid column summary: unexpected end of data");
+    }
+    return value;
+}
+
+void WriteString(std::ostream& out, std::string const& string) {
+    WriteValue<std::uint64_t>(out, string.size());
+    out.write(string.data(), string.size());
+}
+
+std::string ReadString(std::istream& in) {
+    std::string string(ReadValue<std::uint64_t>(in), '\0');
+    if (!in.read(string.data(), string.size())) {
+        throw std::invalid_argument("Invalid column summary: unexpected end of data");
+    }
+    return string;
+}
+
+template <typename T>
+void WriteOptional(std::ostream& out, std::optional<T> const& value) {
+    WriteValue<std::uint8_t>(out, value.has_value());
+    if (!value.has_value()) return;
+    if constexpr (std::is_same_v<T, std::string>) {
+        WriteString(out, *value);
+    } else {
+        WriteValue(out, *value);
+    }
+}
+
+template <typename T>
+std::optional<T> ReadOptional(std::istream& in) {
+    if (ReadValue<std::uint8_t>(in) == 0) return std::nullopt;
+    if constexpr (std::is_same_v<T, std::string>) {
+        return ReadString(in);
+    } else {
+        return ReadValue<T>(in);
+    }
+}
+
+}  // namespace
+
+void DistinctSketch::AddToRegisters(std::uint64_t hash) {
+    std::size_t const index = hash >> (64 - kPrecision);
+    std::uint64_t const rest = hash << kPrecision;
+    auto const rank = static_cast<std::uint8_t>(
+            rest == 0 ? 64 - kPrecision + 1 : std::countl_zero(rest) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+}
+
+void DistinctSketch::SwitchToRegisters() {
+    registers_.assign(std::size_t{1} << kPrecision, 0);
+    for (std::uint64_t hash : hashes_) {
+        AddToRegisters(hash);
+    }
+    hashes_ = {};
+}
+
+void DistinctSketch::Add(std::uint64_t hash) {
+    if (!IsExact()) {
+        AddToRegisters(hash);
+        return;
+    }
+    hashes_.insert(hash);
+    if (hashes_.size() > kExactLimit) {
+        SwitchToRegisters();
+    }
+}
+
+void DistinctSketch::Merge(DistinctSketch const& other) {
+    if (other.IsExact()) {
+        for (std::uint64_t hash : other.hashes_) {
+            Add(hash);
+        }
+        return;
+    }
+    if (IsExact()) {
+        SwitchToRegisters();
+    }
+    for (std::size_t i = 0; i != registers_.size(); ++i) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+std::size_t DistinctSketch::Estimate() const {
+    if (IsExact()) {
+        return hashes_.size();
+    }
+
+    double const m = registers_.size();
+    double inverse_sum = 0;
+    std::size_t zero_registers = 0;
+    for (std::uint8_t rank : registers_) {
+        inverse_sum += std::ldexp(1.0, -rank);
+        if (rank == 0) ++zero_registers;
+    }
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / inverse_sum;
+    if (estimate <= 2.5 * m && zero_registers != 0) {
+        // Linear counting is more precise for small cardinalities
+        estimate = m * std::log(m / zero_registers);
+    }
+    return std::llround(estimate);
+}
+
+void DistinctSketch::Write(std::ostream& out) const {
+    WriteValue<std::uint8_t>(out, IsExact());
+    if (IsExact()) {
+        std::vector<std::uint64_t> hashes(hashes_.begin(), hashes_.end());
+        std::sort(hashes.begin(), hashes.end());
+        WriteValue<std::uint64_t>(out, hashes.size());
+        for (std::uint64_t hash : hashes) {
+            WriteValue(out, hash);
+        }
+    } else {
+        out.write(reinterpret_cast<char const*>(registers_.data()), registers_.size());
+    }
+}
+
+DistinctSketch DistinctSketch::Read(std::istream& in) {
+    DistinctSketch sketch;
+    if (ReadValue<std::uint8_t>(in) != 0) {
+        std::uint64_t const size = ReadValue<std::uint64_t>(in);
+        if (size > kExactLimit) {
+            throw std::invalid_argument("Invalid column summary: too many distinct hashes");
+        }
+        for (std::uint64_t i = 0; i != size; ++i) {
+            sketch.hashes_.insert(ReadValue<std::uint64_t>(in));
+        }
+    } else {
+        sketch.registers_.resize(std::size_t{1} << kPrecision);
+        if (!in.read(reinterpret_cast<char*>(sketch.registers_.data()),
+                     sketch.registers_.size())) {
+            throw std::invalid_argument("Invalid column summary: unexpected end of data");
+        }
+    }
+    return sketch;
+}
+
+void QuantileSketch::Compact(std::size_t level) {
+    if (level + 1 == levels_.size()) {
+        levels_.emplace_back();
+    }
+    std::vector<double>& numbers = levels_[level];
+    std::sort(numbers.begin(), numbers.end());
+    // An odd number stays on its level to keep the total weight
+    std::size_t const paired = numbers.size() - numbers.size() % 2;
+    for (std::size_t i = compaction_offset_; i < paired; i += 2) {
+        levels_[level + 1].push_back(numbers[i]);
+    }
+    compaction_offset_ = !compaction_offset_;
+    numbers.erase(numbers.begin(), numbers.begin() + paired);
+}
+
+void QuantileSketch::CompactFullLevels() {
+    for (std::size_t level = 0; level != levels_.size(); ++level) {
+        if (levels_[level].size() >= kCapacity) {
+            Compact(level);
+        }
+    }
+}
+
+void QuantileSketch::Add(double number) {
+    if (levels_.empty()) {
+        levels_.emplace_back();
+    }
+    levels_.front().push_back(number);
+    ++count_;
+    if (levels_.front().size() >= kCapacity) {
+        CompactFullLevels();
+    }
+}
+
+void QuantileSketch::Merge(QuantileSketch const& other) {
+    if (levels_.size() < other.levels_.size()) {
+        levels_.resize(other.levels_.size());
+    }
+    for (std::size_t level = 0; level != other.levels_.size(); ++level) {
+        levels_[level].insert(levels_[level].end(), other.levels_[level].begin(),
+                              other.levels_[level].end());
+    }
+    count_ += other.count_;
+    CompactFullLevels();
+}
+
+std::optional<double> QuantileSketch::GetQuantile(double part) const {
+    if (count_ == 0) return std::nullopt;
+
+    std::vector<std::pair<double, std::size_t>> weighted;
+    for (std::size_t level = 0; level != levels_.size(); ++level) {
+        for (double number : levels_[level]) {
+            weighted.emplace_back(number, std::size_t{1} << level);
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    auto const rank = static_cast<std::size_t>(count_ * part);
+    std::size_t weight_before = 0;
+    for (auto const& [number, weight] : weighted) {
+        weight_before += weight;
+        if (weight_before > rank) return number;
+    }
+    return weighted.back().first;
+}
+
+void QuantileSketch::Write(std::ostream& out) const {
+    WriteValue<std::uint64_t>(out, count_);
+    WriteValue<std::uint8_t>(out, compaction_offset_);
+    WriteValue<std::uint64_t>(out, levels_.size());
+    for (std::vector<double> const& numbers : levels_) {
+        WriteValue<std::uint64_t>(out, numbers.size());
+        for (double number : numbers) {
+            WriteValue(out, number);
+        }
+    }
+}
+
+QuantileSketch QuantileSketch::Read(std::istream& in) {
+    QuantileSketch sketch;
+    sketch.count_ = ReadValue<std::uint64_t>(in);
+    sketch.compaction_offset_ = ReadValue<std::uint8_t>(in) != 0;
+    std::uint64_t const num_levels = ReadValue<std::uint64_t>(in);
+    if (num_levels > 64) {
+        throw std::invalid_argument("Invalid column summary: too many quantile sketch levels");
+    }
+    sketch.levels_.resize(num_levels);
+    for (std::vector<double>& numbers : sketch.levels_) {
+        std::uint64_t const size = ReadValue<std::uint64_t>(in);
+        if (size >= kCapacity) {
+            throw std::invalid_argument("Invalid column summary: quantile sketch level overflow");
+        }
+        for (std::uint64_t i = 0; i != size; ++i) {
+            numbers.push_back(ReadValue<double>(in));
+        }
+    }
+    return sketch;
+}
+
+ColumnSummary ColumnSummary::Of(model::TypedColumnData const& column) {
+    ColumnSummary summary;
+    summary.num_rows_ = column.GetNumRows();
+    summary.num_nulls_ = column.GetNumNulls();
+    summary.num_empties_ = column.GetNumEmpties();
+
+    bool const is_mixed = column.GetTypeId() == +model::TypeId::kMixed;
+    for (std::size_t row = 0; row != column.GetNumRows(); ++row) {
+        if (column.IsNullOrEmpty(row)) continue;
+
+        model::TypeId const type_id = column.GetValueTypeId(row);
+        ++summary.type_counts_[type_id._to_index()];
+        std::byte const* value = column.GetValue(row);
+        std::byte const* raw_value = is_mixed ? model::MixedType::RetrieveValue(value) : value;
+        switch (type_id) {
+            case model::TypeId::kInt:
+                summary.AddNumber(model::Type::GetValue<model::Int>(raw_value));
+                break;
+            case model::TypeId::kDouble:
+                summary.AddNumber(model::Type::GetValue<model::Double>(raw_value));
+                break;
+            case model::TypeId::kString:
+                summary.AddString(model::Type::GetValue<model::String>(raw_value));
+                break;
+            default:
+                summary.distinct_.Add(
+                        HashBytes(type_id._to_integral(), column.GetType().ValueToString(value)));
+        }
+    }
+    return summary;
+}
+
+void ColumnSummary::AddNumber(double number) {
+    MergeMoments(1, number, 0, 0, 0);
+    sum_ += number;
+    sum_of_squares_ += number * number;
+    if (number == 0) ++num_zeros_;
+    if (number < 0) ++num_negatives_;
+    min_number_ = std::min(min_number_.value_or(number), number);
+    max_number_ = std::max(max_number_.value_or(number), number);
+    distinct_.Add(HashNumber(number));
+    quantiles_.Add(number);
+}
+
+void ColumnSummary::AddString(std::string const& string) {
+    if (!min_string_.has_value() || string < *min_string_) min_string_ = string;
+    if (!max_string_.has_value() || string > *max_string_) max_string_ = string;
+    distinct_.Add(HashBytes(model::TypeId::kString, string));
+}
+
+void ColumnSummary::MergeMoments(std::size_t count, double mean, double m2, double m3,
+                                 double m4) {
+    if (count == 0) return;
+    if (num_numbers_ == 0) {
+        num_numbers_ = count;
+        mean_ = mean;
+        m2_ = m2;
+        m3_ = m3;
+        m4_ = m4;
+        return;
+    }
+
+    double const na = num_numbers_;
+    double const nb = count;
+    double const n = na + nb;
+    double const delta = mean - mean_;
+    double const delta_n = delta / n;
+    double const delta_n2 = delta_n * delta_n;
+
+    m4_ += m4 + delta * delta_n * delta_n2 * na * nb * (na * na - na * nb + nb * nb) +
+           6 * delta_n2 * (na * na * m2 + nb * nb * m2_) + 4 * delta_n * (na * m3 - nb * m3_);
+    m3_ += m3 + delta * delta_n2 * na * nb * (na - nb) + 3 * delta_n * (na * m2 - nb * m2_);
+    m2_ += m2 + delta * delta_n * na * nb;
+    mean_ += nb * delta_n;
+    num_numbers_ += count;
+}
+
+void ColumnSummary::Merge(ColumnSummary const& other) {
+    num_rows_ += other.num_rows_;
+    num_nulls_ += other.num_nulls_;
+    num_empties_ += other.num_empties_;
+    for (std::size_t i = 0; i != type_counts_.size(); ++i) {
+        type_counts_[i] += other.type_counts_[i];
+    }
+
+    MergeMoments(other.num_numbers_, other.mean_, other.m2_, other.m3_, other.m4_);
+    sum_ += other.sum_;
+    sum_of_squares_ += other.sum_of_squares_;
+    num_zeros_ += other.num_zeros_;
+    num_negatives_ += other.num_negatives_;
+    auto merge_bound = [](auto& bound, auto const& other_bound, auto select) {
+        if (!other_bound.has_value()) return;
+        bound = bound.has_value() ? select(*bound, *other_bound) : *other_bound;
+    };
+    auto min = [](auto const& a, auto const& b) { return std::min(a, b); };
+    auto max = [](auto const& a, auto const& b) { return std::max(a, b); };
+    merge_bound(min_number_, other.min_number_, min);
+    merge_bound(max_number_, other.max_number_, max);
+    merge_bound(min_string_, other.min_string_, min);
+    merge_bound(max_string_, other.max_string_, max);
+
+    distinct_.Merge(other.distinct_);
+    quantiles_.Merge(other.quantiles_);
+}
+
+std::optional<double> ColumnSummary::GetSum() const {
+    if (num_numbers_ == 0) return std::nullopt;
+    return sum_;
+}
+
+std::optional<double> ColumnSummary::GetSumOfSquares() const {
+    if (num_numbers_ == 0) return std::nullopt;
+    return sum_of_squares_;
+}
+
+std::optional<double> ColumnSummary::GetAvg() const {
+    if (num_numbers_ == 0) return std::nullopt;
+    return mean_;
+}
+
+std::optional<double> ColumnSummary::GetCorrectedSTD() const {
+    if (num_numbers_ < 2) return std::nullopt;
+    return std::sqrt(m2_ / (num_numbers_ - 1));
+}
+
+std::optional<double> ColumnSummary::GetSkewness() const {
+    std::optional<double> const std = GetCorrectedSTD();
+    if (!std.has_value()) return std::nullopt;
+    return m3_ / num_numbers_ / std::pow(*std, 3);
+}
+
+std::optional<double> ColumnSummary::GetKurtosis() const {
+    std::optional<double> const std = GetCorrectedSTD();
+    if (!std.has_value()) return std::nullopt;
+    return m4_ / num_numbers_ / std::pow(*std, 4) - 3;
+}
+
+std::string ColumnSummary::Serialize() const {
+    std::ostringstream out;
+    out.write(kSummaryMagic, sizeof(kSummaryMagic) - 1);
+    WriteValue(out, kSummaryVersion);
+
+    WriteValue<std::uint64_t>(out, num_rows_);
+    WriteValue<std::uint64_t>(out, num_nulls_);
+    WriteValue<std::uint64_t>(out, num_empties_);
+    WriteValue<std::uint64_t>(out, type_counts_.size());
+    for (std::size_t count : type_counts_) {
+        WriteValue<std::uint64_t>(out, count);
+    }
+
+    WriteValue<std::uint64_t>(out, num_numbers_);
+    for (double value : {mean_, m2_, m3_, m4_, sum_, sum_of_squares_}) {
+        WriteValue(out, value);
+    }
+    WriteValue<std::uint64_t>(out, num_zeros_);
+    WriteValue<std::uint64_t>(out, num_negatives_);
+    WriteOptional(out, min_number_);
+    WriteOptional(out, max_number_);
+    WriteOptional(out, min_string_);
+    WriteOptional(out, max_string_);
+
+    distinct_.Write(out);
+    quantiles_.Write(out);
+    return std::move(out).str();
+}
+
+ColumnSummary ColumnSummary::Deserialize(std::string const& data) {
+    std::istringstream in(data);
+    std::string magic(sizeof(kSummaryMagic) - 1, '\0');
+    in.read(magic.data(), magic.size());
+    if (!in || magic != kSummaryMagic) {
+        throw std::invalid_argument("Invalid column summary: unknown format");
+    }
+    if (ReadValue<std::uint8_t>(in) != kSummaryVersion) {
+        throw std::invalid_argument("Invalid column summary: unsupported version");
+    }
+
+    ColumnSummary summary;
+    summary.num_rows_ = ReadValue<std::uint64_t>(in);
+    summary.num_nulls_ = ReadValue<std::uint64_t>(in);
+    summary.num_empties_ = ReadValue<std::uint64_t>(in);
+    if (ReadValue<std::uint64_t>(in) != summary.type_counts_.size()) {
+        throw std::invalid_argument("Invalid column summary: unexpected number of types");
+    }
+    for (std::size_t& count : summary.type_counts_) {
+        count = ReadValue<std::uint64_t>(in);
+    }
+
+    summary.num_numbers_ = ReadValue<std::uint64_t>(in);
+    for (double* value : {&summary.mean_, &summary.m2_, &summary.m3_, &summary.m4_,
+                          &summary.sum_, &summary.sum_of_squares_}) {
+        *value = ReadValue<double>(in);
+    }
+    summary.num_zeros_ = ReadValue<std::uint64_t>(in);
+    summary.num_negatives_ = ReadValue<std::uint64_t>(in);
+    summary.min_number_ = ReadOptional<double>(in);
+    summary.max_number_ = ReadOptional<double>(in);
+    summary.min_string_ = ReadOptional<std::string>(in);
+    summary.max_string_ = ReadOptional<std::string>(in);
+
+    summary.distinct_ = DistinctSketch::Read(in);
+    summary.quantiles_ = QuantileSketch::Read(in);
+    if (in.peek() != std::istream::traits_type::eof()) {
+        throw std::invalid_argument("Invalid column summary: unexpected data at the end");
+    }
+    return summary;
+}
+
+}  // namespace algos
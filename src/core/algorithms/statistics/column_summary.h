@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "model/table/typed_column_data.h"
+#include "model/types/builtin.h"
+
+namespace algos {
+
+/* Counts distinct values by their 64-bit hashes. The hashes are kept while there are at most
+ * kExactLimit of them, after that they are replaced by the registers of a HyperLogLog sketch,
+ * whose relative error is about 1.6%. */
+class DistinctSketch {
+public:
+    static constexpr std::size_t kExactLimit = 4096;
+    static constexpr unsigned kPrecision = 12;
+
+private:
+    std::unordered_set<std::uint64_t> hashes_;
+    /* Empty while the hashes are kept */
+    std::vector<std::uint8_t> registers_;
+
+    void AddToRegisters(std::uint64_t hash);
+    void SwitchToRegisters();
+
+public:
+    void Add(std::uint64_t hash);
+    void Merge(DistinctSketch const& other);
+    std::size_t Estimate() const;
+
+    bool IsExact() const noexcept {
+        return registers_.empty();
+    }
+
+    void Write(std::ostream& out) const;
+    static DistinctSketch Read(std::istream& in);
+};
+
+/* Approximates quantiles of numbers. A number on level h stands for 2^h numbers. When a level
+ * reaches kCapacity numbers, it is sorted and every other number moves to the next level, as in
+ * the compactors of the KLL sketch. The quantiles are exact until the first compaction. */
+class QuantileSketch {
+public:
+    static constexpr std::size_t kCapacity = 256;
+
+private:
+    std::vector<std::vector<double>> levels_;
+    std::size_t count_ = 0;
+    /* Alternates the numbers kept by compactions, so that they are not biased to one side */
+    bool compaction_offset_ = false;
+
+    void Compact(std::size_t level);
+    void CompactFullLevels();
+
+public:
+    void Add(double number);
+    void Merge(QuantileSketch const& other);
+    /* Same as the element with index count * part of the sorted numbers */
+    std::optional<double> GetQuantile(double part) const;
+
+    std::size_t GetCount() const noexcept {
+        return count_;
+    }
+
+    void Write(std::ostream& out) const;
+    static QuantileSketch Read(std::istream& in);
+};
+
+/**
+ * Mergeable summary of a column.
+ *
+ * A summary is taken from a parsed batch of rows. Summaries of batches of the same column, for
+ * example of appended partitions or of shards of a table processed in parallel, can be merged
+ * without the rows, and kept between runs in the serialized form.
+ *
+ * The type of a column is deduced for each batch separately, so values are counted by the type
+ * they got in their batch. Numeric statistics are calculated over the int and double values and
+ * string statistics over the string values, whatever the type of the column is.
+ */
+class ColumnSummary {
+private:
+    std::size_t num_rows_ = 0;
+    std::size_t num_nulls_ = 0;
+    std::size_t num_empties_ = 0;
+    std::vector<std::size_t> type_counts_ = std::vector<std::size_t>(model::TypeId::_size());
+
+    std::size_t num_numbers_ = 0;
+    /* Mean and sums of powers of deviations from it, merged by the formulas of Pébay */
+    double mean_ = 0;
+    double m2_ = 0;
+    double m3_ = 0;
+    double m4_ = 0;
+    double sum_ = 0;
+    double sum_of_squares_ = 0;
+    std::size_t num_zeros_ = 0;
+    std::size_t num_negatives_ = 0;
+    std::optional<double> min_number_;
+    std::optional<double> max_number_;
+    std::optional<std::string> min_string_;
+    std::optional<std::string> max_string_;
+
+    DistinctSketch distinct_;
+    QuantileSketch quantiles_;
+
+    void AddNumber(double number);
+    void AddString(std::string const& string);
+    void MergeMoments(std::size_t count, double mean, double m2, double m3, double m4);
+
+public:
+    static ColumnSummary Of(model::TypedColumnData const& column);
+
+    /* Both summaries must describe the same column */
+    void Merge(ColumnSummary const& other);
+
+    std::string Serialize() const;
+    /* Throws std::invalid_argument if the data is not a serialized summary */
+    static ColumnSummary Deserialize(std::string const& data);
+
+    std::size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    std::size_t GetNumNulls() const noexcept {
+        return num_nulls_;
+    }
+
+    std::size_t GetNumEmpties() const noexcept {
+        return num_empties_;
+    }
+
+    // Returns number of non-NULL and nonempty values.
+    std::size_t GetCount() const noexcept {
+        return num_rows_ - num_nulls_ - num_empties_;
+    }
+
+    // Returns number of values that were parsed as the given type.
+    std::size_t GetTypeCount(model::TypeId type_id) const noexcept {
+        return type_counts_[type_id._to_index()];
+    }
+
+    // Returns number of int and double values.
+    std::size_t GetNumNumbers() const noexcept {
+        return num_numbers_;
+    }
+
+    std::size_t GetNumZeros() const noexcept {
+        return num_zeros_;
+    }
+
+    std::size_t GetNumNegatives() const noexcept {
+        return num_negatives_;
+    }
+
+    std::optional<double> GetSum() const;
+    std::optional<double> GetSumOfSquares() const;
+    std::optional<double> GetAvg() const;
+    // Returns corrected standard deviation, as DataStats does.
+    std::optional<double> GetCorrectedSTD() const;
+    std::optional<double> GetSkewness() const;
+    std::optional<double> GetKurtosis() const;
+
+    std::optional<double> GetMinNumber() const noexcept {
+        return min_number_;
+    }
+
+    std::optional<double> GetMaxNumber() const noexcept {
+        return max_number_;
+    }
+
+    std::optional<std::string> const& GetMinString() const noexcept {
+        return min_string_;
+    }
+
+    std::optional<std::string> const& GetMaxString() const noexcept {
+        return max_string_;
+    }
+
+    // Returns number of distinct values, exact while IsDistinctExact() is true.
+    std::size_t GetDistinct() const {
+        return distinct_.Estimate();
+    }
+
+    bool IsDistinctExact() const noexcept {
+        return distinct_.IsExact();
+    }
+
+    // Returns quantile of the numbers, exact for up to QuantileSketch::kCapacity numbers.
+    std::optional<double> GetQuantile(double part) const {
+        return quantiles_.GetQuantile(part);
+    }
+};
+
+}  // namespace algos
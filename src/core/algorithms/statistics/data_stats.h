@@ -3,6 +3,7 @@
 #include <set>
 
 #include "algorithms/fd/fd_algorithm.h"
+#include "algorithms/statistics/column_summary.h"
 #include "algorithms/statistics/statistic.h"
 #include "config/equal_nulls/type.h"
 #include "config/tabular_data/input_table_type.h"
@@ -15,7 +16,7 @@ class DataStats : public Algorithm {
     config::EqNullsType is_null_equal_null_;
     config::ThreadNumType threads_num_;
 
-    std::vector<model::TypedColumnData> col_data_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
     std::vector<ColumnStats> all_stats_;
 
     size_t MixedDistinct(size_t index) const;
@@ -167,6 +168,11 @@ public:
     // Returns the amount of entirely lowercase words in a string column.
     Statistic GetNumberOfEntirelyLowercaseWords(size_t index) const;
 
+    // Returns a summary of the column that can be merged with summaries of other batches of rows.
+    ColumnSummary GetSummary(size_t index) const;
+    // Returns summaries of all columns.
+    std::vector<ColumnSummary> GetSummaries() const;
+
     ColumnStats const& GetAllStats(size_t index) const;
     std::vector<ColumnStats> const& GetAllStats() const;
     std::string ToString() const;
@@ -11,13 +11,14 @@
 #include "algorithms/ucc/hpivalid/config.h"
 #include "algorithms/ucc/hpivalid/result_collector.h"
 #include "algorithms/ucc/hpivalid/tree_search.h"
+#include "model/table/relation_session.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
 
 namespace algos {
 
 void HPIValid::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::GetSharedRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -24,6 +24,14 @@ private:
 
     void ResetUCCAlgorithmState() override {}
 
+    bool CanCacheResult() const noexcept override {
+        return true;
+    }
+
+    std::shared_ptr<RelationalSchema const> GetSchema() const override {
+        return relation_->GetSharedPtrSchema();
+    }
+
 public:
     HPIValid() : UCCAlgorithm({}) {}
 };
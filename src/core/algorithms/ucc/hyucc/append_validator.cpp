@@ -0,0 +1,135 @@
+#include "append_validator.h"
+
+#include <iterator>
+#include <optional>
+#include <set>
+#include <utility>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <easylogging++.h>
+
+namespace algos::hyucc {
+
+AppendValidator::AppendValidator(UCCTree* tree, std::vector<hy::ClusterId> og_mapping,
+                                 bool is_null_equal_null, model::IDatasetStream& table)
+    : tree_(tree),
+      og_mapping_(std::move(og_mapping)),
+      is_null_equal_null_(is_null_equal_null),
+      columns_(og_mapping_.size()) {
+    std::vector<model::DynPLI::ClusterValue> no_rows;
+    for (std::size_t column = 0; column != columns_.size(); ++column) {
+        plis_.push_back(model::DynPLI::CreateFor(no_rows));
+    }
+    ReadRows(table);
+}
+
+int AppendValidator::EncodeValue(std::string const& value) {
+    if (value.empty()) {
+        return is_null_equal_null_ ? kNullValueId : next_value_id_++;
+    }
+    auto [it, is_value_new] = value_dictionary_.try_emplace(value, next_value_id_);
+    if (is_value_new) {
+        next_value_id_++;
+    }
+    return it->second;
+}
+
+std::size_t AppendValidator::ReadRows(model::IDatasetStream& rows) {
+    std::size_t const num_columns = columns_.size();
+    std::size_t const first_row = GetNumRows();
+    while (rows.HasNextRow()) {
+        std::vector<std::string> const row = rows.GetNextRow();
+        if (row.size() != num_columns) {
+            LOG(WARNING) << "Unexpected number of columns for a row, skipping (expected "
+                         << num_columns << ", got " << row.size() << ")";
+            continue;
+        }
+        for (std::size_t column = 0; column != num_columns; ++column) {
+            columns_[column].push_back(EncodeValue(row[og_mapping_[column]]));
+        }
+    }
+
+    for (std::size_t column = 0; column != num_columns; ++column) {
+        std::vector<std::pair<std::optional<std::size_t>, model::DynPLI::ClusterValue>> inserts;
+        inserts.reserve(GetNumRows() - first_row);
+        for (std::size_t row = first_row; row != GetNumRows(); ++row) {
+            inserts.emplace_back(std::nullopt, model::DynPLI::ClusterValue{columns_[column][row]});
+        }
+        plis_[column]->UpdateWith(inserts, {});
+    }
+    return first_row;
+}
+
+boost::dynamic_bitset<> AppendValidator::GetAgreeSet(std::size_t row1, std::size_t row2) const {
+    boost::dynamic_bitset<> agree_set(columns_.size());
+    for (std::size_t column = 0; column != columns_.size(); ++column) {
+        if (columns_[column][row1] == columns_[column][row2]) {
+            agree_set.set(column);
+        }
+    }
+    return agree_set;
+}
+
+std::vector<boost::dynamic_bitset<>> AppendValidator::FindViolations(
+        model::RawUCC const& ucc, std::size_t first_new_row) const {
+    std::set<boost::dynamic_bitset<>> agree_sets;
+    for (std::size_t row = first_new_row; row != GetNumRows(); ++row) {
+        model::DynPLI::Cluster const* rarest = nullptr;
+        for (std::size_t column = ucc.find_first(); column != model::RawUCC::npos;
+             column = ucc.find_next(column)) {
+            model::DynPLI::Cluster const& cluster =
+                    plis_[column]->GetClusters().at({columns_[column][row]});
+            if (rarest == nullptr || cluster.size() < rarest->size()) {
+                rarest = &cluster;
+            }
+        }
+        // Rows are only appended, so every cluster is sorted. A pair of new rows is compared once,
+        // when the later of them is processed
+        for (int other : *rarest) {
+            if (static_cast<std::size_t>(other) >= row) break;
+            boost::dynamic_bitset<> agree_set = GetAgreeSet(row, other);
+            if (ucc.is_subset_of(agree_set)) {
+                agree_sets.insert(std::move(agree_set));
+            }
+        }
+    }
+    return {agree_sets.begin(), agree_sets.end()};
+}
+
+NonUCCList AppendValidator::AppendRows(model::IDatasetStream& rows,
+                                       config::ThreadNumType threads_num) {
+    std::size_t const first_new_row = ReadRows(rows);
+    NonUCCList non_uccs(columns_.size());
+    if (first_new_row == GetNumRows()) {
+        return non_uccs;
+    }
+
+    std::vector<model::RawUCC> const uccs = tree_->FillUCCs();
+    std::vector<std::vector<boost::dynamic_bitset<>>> violations(uccs.size());
+    if (threads_num > 1) {
+        boost::asio::thread_pool pool(threads_num);
+        for (std::size_t i = 0; i != uccs.size(); ++i) {
+            boost::asio::post(pool, [this, &uccs, &violations, first_new_row, i]() {
+                violations[i] = FindViolations(uccs[i], first_new_row);
+            });
+        }
+        pool.join();
+    } else {
+        for (std::size_t i = 0; i != uccs.size(); ++i) {
+            violations[i] = FindViolations(uccs[i], first_new_row);
+        }
+    }
+
+    std::set<boost::dynamic_bitset<>> unique_non_uccs;
+    for (std::vector<boost::dynamic_bitset<>>& ucc_violations : violations) {
+        unique_non_uccs.insert(std::make_move_iterator(ucc_violations.begin()),
+                               std::make_move_iterator(ucc_violations.end()));
+    }
+    for (boost::dynamic_bitset<> non_ucc : unique_non_uccs) {
+        non_uccs.Add(std::move(non_ucc));
+    }
+    return non_uccs;
+}
+
+}  // namespace algos::hyucc
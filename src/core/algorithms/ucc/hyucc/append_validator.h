@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "algorithms/ucc/hyucc/model/non_ucc_list.h"
+#include "algorithms/ucc/hyucc/model/ucc_tree.h"
+#include "algorithms/ucc/raw_ucc.h"
+#include "config/thread_number/type.h"
+#include "fd/hycommon/types.h"
+#include "model/table/dynamic_position_list_index.h"
+#include "model/table/idataset_stream.h"
+
+namespace algos::hyucc {
+
+/**
+ * Finds the UCCs of the tree that are violated by rows appended to the table.
+ *
+ * Keeps every row of the table encoded and a DynPLI of every column, in the column order of the
+ * tree. Appended rows cannot make a non-UCC unique again, so only the pairs of rows with at least
+ * one new row have to be compared. For every UCC, a new row is compared with the rows that share
+ * its value in the column of the UCC where this value is the rarest. The agree sets of the pairs
+ * that are equal on the UCC are all the non-UCCs the tree has to be specialized by.
+ */
+class AppendValidator {
+private:
+    UCCTree* tree_;
+    /* Original index of every column of the tree */
+    std::vector<hy::ClusterId> og_mapping_;
+    bool is_null_equal_null_;
+
+    std::unordered_map<std::string, int> value_dictionary_;
+    int next_value_id_ = 1;
+    static constexpr int kNullValueId = -1;
+
+    std::vector<std::vector<int>> columns_;
+    std::vector<std::unique_ptr<model::DynPLI>> plis_;
+
+    std::size_t GetNumRows() const noexcept {
+        return columns_.front().size();
+    }
+
+    int EncodeValue(std::string const& value);
+    /* Returns the index of the first read row */
+    std::size_t ReadRows(model::IDatasetStream& rows);
+
+    boost::dynamic_bitset<> GetAgreeSet(std::size_t row1, std::size_t row2) const;
+    std::vector<boost::dynamic_bitset<>> FindViolations(model::RawUCC const& ucc,
+                                                        std::size_t first_new_row) const;
+
+public:
+    /* Indexes the rows of the whole table, which must be the table the tree was mined on */
+    AppendValidator(UCCTree* tree, std::vector<hy::ClusterId> og_mapping, bool is_null_equal_null,
+                    model::IDatasetStream& table);
+
+    /* Adds the rows to the table and returns the non-UCCs they produce */
+    NonUCCList AppendRows(model::IDatasetStream& rows, config::ThreadNumType threads_num);
+};
+
+}  // namespace algos::hyucc
@@ -4,40 +4,91 @@
 
 #include <easylogging++.h>
 
+#include "config/exceptions.h"
 #include "fd/hycommon/types.h"
 #include "inductor.h"
+#include "model/table/relation_session.h"
 #include "preprocessor.h"
 #include "sampler.h"
 #include "validator.h"
 
 namespace algos {
 
+void HyUCC::RegisterOptions() {
+    auto check_inserts = [this](config::InputTable const& insert_batch) {
+        if (insert_batch == nullptr || !insert_batch->HasNextRow()) {
+            return;
+        }
+        if (insert_batch->GetNumberOfColumns() != input_table_->GetNumberOfColumns()) {
+            throw config::ConfigurationError(
+                    "Schema mismatch: insert statements must have the same number of columns as "
+                    "the input table");
+        }
+        for (std::size_t i = 0; i < input_table_->GetNumberOfColumns(); ++i) {
+            if (insert_batch->GetColumnName(i) != input_table_->GetColumnName(i)) {
+                throw config::ConfigurationError(
+                        "Schema mismatch: insert statements' column names must match the input "
+                        "table");
+            }
+        }
+    };
+
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    RegisterOption(
+            config::kInsertStatementsOpt(&insert_statements_table_).SetValueCheck(check_inserts));
+}
+
 void HyUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::GetSharedRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
     }
+    ucc_tree_.reset();
+    append_validator_.reset();
 }
 
 unsigned long long HyUCC::ExecuteInternal() {
+    auto const start_time = std::chrono::system_clock::now();
+
+    if (ucc_tree_ == nullptr) {
+        MineUCCs();
+    }
+    if (insert_statements_table_ != nullptr && insert_statements_table_->HasNextRow()) {
+        AppendRows();
+    }
+
+    RegisterUCCs(ucc_tree_->FillUCCs(), og_mapping_);
+
+    LOG(DEBUG) << "Mined UCCs:";
+    for (model::UCC const& ucc : UCCList()) {
+        LOG(DEBUG) << ucc.ToString();
+    }
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+void HyUCC::MineUCCs() {
     using namespace hy;
     using namespace hyucc;
-    auto const start_time = std::chrono::system_clock::now();
 
     auto [plis, pli_records, og_mapping] = Preprocess(relation_.get());
+    og_mapping_ = std::move(og_mapping);
     auto const plis_shared = std::make_shared<PLIs>(std::move(plis));
     auto const pli_records_shared = std::make_shared<Rows>(std::move(pli_records));
 
     hyucc::Sampler sampler(plis_shared, pli_records_shared, threads_num_);
 
-    auto ucc_tree = std::make_unique<UCCTree>(relation_->GetNumColumns());
-    Inductor inductor(ucc_tree.get());
-    Validator validator(ucc_tree.get(), plis_shared, pli_records_shared, threads_num_);
+    ucc_tree_ = std::make_unique<UCCTree>(relation_->GetNumColumns());
+    Inductor inductor(ucc_tree_.get());
+    Validator validator(ucc_tree_.get(), plis_shared, pli_records_shared, threads_num_);
 
     IdPairs comparison_suggestions;
 
     while (true) {
+        CheckCancelled();
         LOG(DEBUG) << "Sampling...";
         NonUCCList non_uccs = sampler.GetNonUCCs(comparison_suggestions);
 
@@ -51,18 +102,25 @@ unsigned long long HyUCC::ExecuteInternal() {
             break;
         }
     }
+}
 
-    auto uccs = ucc_tree->FillUCCs();
-    RegisterUCCs(std::move(uccs), og_mapping);
-
-    LOG(DEBUG) << "Mined UCCs:";
-    for (model::UCC const& ucc : UCCList()) {
-        LOG(DEBUG) << ucc.ToString();
+/* New rows may only violate UCCs, and every violating pair contains a new row. Specializing the
+ * tree by the agree sets of all such pairs leaves exactly the minimal UCCs of the extended table,
+ * so no validation against the whole table is needed. */
+void HyUCC::AppendRows() {
+    if (append_validator_ == nullptr) {
+        LOG(DEBUG) << "Indexing the table...";
+        input_table_->Reset();
+        append_validator_ = std::make_unique<hyucc::AppendValidator>(
+                ucc_tree_.get(), og_mapping_, is_null_equal_null_, *input_table_);
     }
 
-    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now() - start_time);
-    return elapsed_milliseconds.count();
+    LOG(DEBUG) << "Checking appended rows...";
+    hyucc::NonUCCList non_uccs = append_validator_->AppendRows(*insert_statements_table_,
+                                                               threads_num_);
+    CheckCancelled();
+    LOG(DEBUG) << "Inducing...";
+    hyucc::Inductor(ucc_tree_.get()).UpdateUCCTree(std::move(non_uccs));
 }
 
 void HyUCC::RegisterUCCs(std::vector<boost::dynamic_bitset<>>&& uccs,
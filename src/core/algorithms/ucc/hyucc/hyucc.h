@@ -2,6 +2,10 @@
 
 #include <memory>
 
+#include "algorithms/ucc/hyucc/append_validator.h"
+#include "algorithms/ucc/hyucc/model/ucc_tree.h"
+#include "config/tabular_data/crud_operations/insert/option.h"
+#include "config/tabular_data/input_table_type.h"
 #include "config/thread_number/option.h"
 #include "config/thread_number/type.h"
 #include "fd/hycommon/types.h"
@@ -11,26 +15,40 @@
 
 namespace algos {
 
+/* The first execution mines the UCCs of the table. The tree of the UCCs is kept, so the next
+ * executions only append the rows of the insert statements to the table and specialize the UCCs
+ * these rows violate instead of mining from scratch. */
 class HyUCC : public UCCAlgorithm {
 private:
-    std::unique_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
     config::ThreadNumType threads_num_ = 1;
+    config::InputTable insert_statements_table_ = nullptr;
 
+    /* UCCs of the table in the order of columns given by og_mapping_ */
+    std::unique_ptr<hyucc::UCCTree> ucc_tree_;
+    std::vector<hy::ClusterId> og_mapping_;
+    /* Index of the rows, built when rows are appended for the first time */
+    std::unique_ptr<hyucc::AppendValidator> append_validator_;
+
+    void RegisterOptions();
     void LoadDataInternal() override;
     unsigned long long ExecuteInternal() override;
 
     void ResetUCCAlgorithmState() override {}
 
+    void MineUCCs();
+    void AppendRows();
     void RegisterUCCs(std::vector<boost::dynamic_bitset<>>&& uccs,
                       std::vector<hy::ClusterId> const& og_mapping);
 
     void MakeExecuteOptsAvailable() final {
-        MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+        MakeOptionsAvailable(
+                {config::kThreadNumberOpt.GetName(), config::kInsertStatementsOpt.GetName()});
     }
 
 public:
     HyUCC() : UCCAlgorithm({}) {
-        RegisterOption(config::kThreadNumberOpt(&threads_num_));
+        RegisterOptions();
     }
 };
 
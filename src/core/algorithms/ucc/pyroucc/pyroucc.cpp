@@ -11,6 +11,7 @@
 #include "config/max_lhs/option.h"
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
+#include "model/table/relation_session.h"
 
 namespace algos {
 
@@ -37,7 +38,7 @@ void PyroUCC::MakeExecuteOptsAvailable() {
 }
 
 void PyroUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::GetSharedRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
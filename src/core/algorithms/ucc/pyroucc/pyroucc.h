@@ -12,7 +12,7 @@ namespace algos {
 
 class PyroUCC : public DependencyConsumer, public UCCAlgorithm {
 private:
-    std::unique_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData> relation_;
 
     std::unique_ptr<SearchSpace> search_space_;
 
@@ -29,6 +29,14 @@ private:
     unsigned long long ExecuteInternal() final;
     void LoadDataInternal() final;
 
+    bool CanCacheResult() const noexcept override {
+        return true;
+    }
+
+    std::shared_ptr<RelationalSchema const> GetSchema() const override {
+        return relation_->GetSharedPtrSchema();
+    }
+
 public:
     PyroUCC();
 };
@@ -1,5 +1,10 @@
 #include "ucc_algorithm.h"
 
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
 #include "config/equal_nulls/option.h"
 #include "config/tabular_data/input_table/option.h"
 
@@ -16,4 +21,43 @@ void UCCAlgorithm::RegisterOptions() {
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
 }
 
+std::string UCCAlgorithm::SerializeResult() const {
+    std::ostringstream out;
+    for (model::UCC const& ucc : UCCList()) {
+        boost::dynamic_bitset<> const& indices = ucc.GetColumnIndicesRef();
+        for (std::size_t index = indices.find_first(); index != boost::dynamic_bitset<>::npos;
+             index = indices.find_next(index)) {
+            out << index << ' ';
+        }
+        out << '\n';
+    }
+    return out.str();
+}
+
+void UCCAlgorithm::LoadResult(std::string const& data) {
+    std::shared_ptr<RelationalSchema const> schema = GetSchema();
+    if (schema == nullptr) {
+        throw std::logic_error("The algorithm does not support caching of results.");
+    }
+    std::size_t const num_columns = schema->GetNumColumns();
+
+    std::istringstream in{data};
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream line_in{line};
+        boost::dynamic_bitset<> indices(num_columns);
+        std::string token;
+        while (line_in >> token) {
+            std::size_t index;
+            auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), index);
+            if (error != std::errc{} || end != token.data() + token.size() ||
+                index >= num_columns) {
+                throw std::invalid_argument("Invalid column index \"" + token + '"');
+            }
+            indices.set(index);
+        }
+        ucc_collection_.Register(schema, std::move(indices));
+    }
+}
+
 }  // namespace algos
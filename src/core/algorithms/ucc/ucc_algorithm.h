@@ -1,12 +1,15 @@
 #pragma once
 
 #include <list>
+#include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
 #include "algorithms/algorithm.h"
 #include "config/equal_nulls/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "model/table/relational_schema.h"
 #include "ucc.h"
 #include "util/primitive_collection.h"
 
@@ -36,6 +39,15 @@ protected:
     // If your algorithm has no progress bar implemented, pass an empty vector.
     constexpr static std::string_view kDefaultPhaseName = "UCC mining";
 
+    // UCCs are cached as lines of column indices. An algorithm that supports caching overrides
+    // CanCacheResult and GetSchema, which returns the schema of the loaded table.
+    std::string SerializeResult() const override;
+    void LoadResult(std::string const& data) override;
+
+    virtual std::shared_ptr<RelationalSchema const> GetSchema() const {
+        return nullptr;
+    }
+
     explicit UCCAlgorithm(std::vector<std::string_view> phase_names);
 
 public:
@@ -1,17 +1,69 @@
 #include "ucc_verifier.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <numeric>
 #include <stdexcept>
+#include <unordered_set>
 
 #include "config/equal_nulls/option.h"
 #include "config/indices/option.h"
+#include "config/indices/validate_index.h"
 #include "config/names_and_descriptions.h"
 #include "config/option_using.h"
 #include "config/tabular_data/input_table/option.h"
+#include "model/table/prefix_pli_cache.h"
+#include "model/table/relation_session.h"
+#include "util/py_tuple_hash.h"
+#include "util/worker_thread_pool.h"
 
 namespace algos {
 
+namespace {
+
+using ProbingTables = std::vector<std::vector<int> const*>;
+
+struct RowCodesHash {
+    ProbingTables const* tables;
+
+    std::size_t operator()(int row) const noexcept {
+        util::PyTupleHash hash(tables->size());
+        for (std::vector<int> const* table : *tables) {
+            hash.AddValue((*table)[row]);
+        }
+        return hash.GetResult();
+    }
+};
+
+struct RowCodesEqual {
+    ProbingTables const* tables;
+
+    bool operator()(int row1, int row2) const noexcept {
+        return std::all_of(tables->begin(), tables->end(), [row1, row2](auto const* table) {
+            return (*table)[row1] == (*table)[row2];
+        });
+    }
+};
+
+using RowSet = std::unordered_set<int, RowCodesHash, RowCodesEqual>;
+
+/* Whether some two rows of the cluster have the same values in the columns of the tables. Rows
+ * holding a value that occurs once in one of these columns are not even hashed. */
+bool HasEqualRows(model::PLI::Cluster const& cluster, ProbingTables const& tables,
+                  RowSet& rows) {
+    rows.clear();
+    for (int row : cluster) {
+        bool const unique_value = std::any_of(tables.begin(), tables.end(), [row](auto const* t) {
+            return (*t)[row] == model::PLI::kSingletonValueId;
+        });
+        if (!unique_value && !rows.insert(row).second) return true;
+    }
+    return false;
+}
+
+}  // namespace
+
 UCCVerifier::UCCVerifier() : Algorithm({}) {
     RegisterOptions();
     MakeOptionsAvailable({config::kTableOpt.GetName(), config::kEqualNullsOpt.GetName()});
@@ -38,7 +90,7 @@ void UCCVerifier::MakeExecuteOptsAvailable() {
 }
 
 void UCCVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    relation_ = model::GetSharedRelation(*input_table_, is_null_equal_null_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC verifying is meaningless.");
@@ -68,4 +120,79 @@ void UCCVerifier::VerifyUCC() {
     stats_calculator_->CalculateStatistics(pli->GetIndex());
 }
 
+bool UCCVerifier::IsUnique(config::IndicesType indices, config::ThreadNumType threads) const {
+    if (relation_ == nullptr) {
+        throw std::logic_error("Data must be loaded before verifying UCCs.");
+    }
+    config::NormalizeAndValidateIndices(indices, relation_->GetNumColumns());
+
+    auto get_pli = [this](config::IndexType index) {
+        return relation_->GetColumnData(index).GetPositionListIndex();
+    };
+    // Only rows in the clusters of every column can be duplicates, so the column with the fewest
+    // such rows is probed and the others are looked up.
+    config::IndexType const probed = *std::min_element(
+            indices.begin(), indices.end(), [&get_pli](auto index1, auto index2) {
+                return get_pli(index1)->GetSize() < get_pli(index2)->GetSize();
+            });
+    std::deque<model::PLI::Cluster> const& clusters = get_pli(probed)->GetIndex();
+    ProbingTables tables;
+    for (config::IndexType index : indices) {
+        if (index != probed) tables.push_back(&relation_->GetColumnData(index).GetProbingTable());
+    }
+    auto make_row_set = [&tables]() {
+        return RowSet(0, RowCodesHash{&tables}, RowCodesEqual{&tables});
+    };
+
+    if (threads <= 1 || clusters.size() < 2) {
+        RowSet rows = make_row_set();
+        return std::none_of(clusters.begin(), clusters.end(), [&](auto const& cluster) {
+            return HasEqualRows(cluster, tables, rows);
+        });
+    }
+    std::atomic<bool> duplicate_found = false;
+    util::WorkerThreadPool pool(threads);
+    pool.ExecIndexWithResource(
+            [&](model::Index i, RowSet& rows) {
+                if (duplicate_found.load(std::memory_order::relaxed)) return;
+                if (HasEqualRows(clusters[i], tables, rows)) {
+                    duplicate_found.store(true, std::memory_order::relaxed);
+                }
+            },
+            make_row_set, clusters.size());
+    return !duplicate_found;
+}
+
+std::vector<UCCStats> UCCVerifier::VerifyUCCs(std::vector<config::IndicesType> uccs,
+                                              config::ThreadNumType threads) const {
+    if (relation_ == nullptr) {
+        throw std::logic_error("Data must be loaded before verifying UCCs.");
+    }
+    for (config::IndicesType& ucc : uccs) {
+        config::NormalizeAndValidateIndices(ucc, relation_->GetNumColumns());
+    }
+    model::PrefixPLICache plis(*relation_, uccs);
+
+    std::vector<std::size_t> order(uccs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&uccs](std::size_t i1, std::size_t i2) { return uccs[i1] < uccs[i2]; });
+
+    std::vector<UCCStats> stats(uccs.size());
+    auto verify = [&](std::size_t i) {
+        std::shared_ptr<model::PLI const> pli = plis.GetPLI(uccs[order[i]]);
+        UCCStatsCalculator calculator(relation_->GetNumRows());
+        calculator.CalculateStatistics(pli->GetIndex());
+        stats[order[i]] = {calculator.UCCHolds(), calculator.GetNumClustersViolatingUCC(),
+                           calculator.GetNumRowsViolatingUCC(), calculator.GetAUCCError()};
+    };
+    if (threads > 1 && uccs.size() > 1) {
+        util::WorkerThreadPool pool(threads);
+        pool.ExecIndex(verify, uccs.size());
+    } else {
+        for (std::size_t i = 0; i < uccs.size(); ++i) verify(i);
+    }
+    return stats;
+}
+
 }  // namespace algos
@@ -7,10 +7,19 @@
 #include "config/equal_nulls/type.h"
 #include "config/indices/type.h"
 #include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
 #include "model/table/column_layout_relation_data.h"
 
 namespace algos {
 
+/* Statistics of one of the UCCs checked by UCCVerifier::VerifyUCCs */
+struct UCCStats {
+    bool holds;
+    size_t num_clusters_violating_ucc;
+    size_t num_rows_violating_ucc;
+    double error;
+};
+
 /* Algorithm used to verify that a set of columns is UCC and retrieving useful information in
  * case it is not */
 class UCCVerifier : public Algorithm {
@@ -72,6 +81,18 @@ public:
         return stats_calculator_->GetAUCCError();
     }
 
+    /* Checks whether the columns form a UCC in the loaded table and nothing else. Instead of
+     * intersecting the PLIs of all the columns, the rows of the clusters of the smallest PLI are
+     * compared on the probing tables of the other columns, stopping at the first pair of equal
+     * rows. Does not change the state of the algorithm. */
+    bool IsUnique(config::IndicesType indices, config::ThreadNumType threads = 1) const;
+
+    /* Verifies UCCs given as sets of column indices against the loaded table without changing
+     * the state of the algorithm. PLIs of column combinations shared by the UCCs are computed
+     * once. Returns the statistics of each UCC in the order of the input. */
+    std::vector<UCCStats> VerifyUCCs(std::vector<config::IndicesType> uccs,
+                                     config::ThreadNumType threads = 1) const;
+
     UCCVerifier();
 };
 
@@ -106,7 +106,9 @@ constexpr auto kDIgnoreNullCols =
 constexpr auto kDIgnoreConstantCols =
         "Ignore INDs which contain columns filled with only one value. May "
         "increase performance but impacts the result. [true|false]";
-constexpr auto kDGraphData = "Path to dot-file with graph";
+constexpr auto kDGraphData =
+        "Path to the graph: a dot-file, a binary graph snapshot or a directory with vertices.csv "
+        "and edges.csv";
 constexpr auto kDGfdData = "Path to file with GFD";
 constexpr auto kDMemLimitMB = "memory limit im MBs";
 constexpr auto kDDifferenceTable = "CSV table containing difference limits for each column";
@@ -150,6 +152,10 @@ constexpr auto kDMaxAmountOfCategories =
 constexpr auto kDFixedSample =
         "Indicates that instead of random generated sample CORDS uses sample consisting of n first "
         "rows of the given table. Intended for tests only.";
+constexpr auto kDFrequencySketch =
+        "Estimate value frequencies with a count-min sketch and column cardinalities with "
+        "HyperLogLog instead of dictionary-encoding the columns. Uses little memory for columns "
+        "with very many distinct values, but the results may differ from exact ones.";
 constexpr auto kDLeftTable = "first table processed by the algorithm";
 constexpr auto kDRightTable = "second table processed by the algorithm";
 constexpr auto kDPruneNonDisjoint =
@@ -1,6 +1,7 @@
 #include "config/indices/validate_index.h"
 
 #include "config/exceptions.h"
+#include "config/indices/option.h"
 
 namespace config {
 
@@ -11,4 +12,12 @@ void ValidateIndex(IndexType value, size_t cols_count) {
     }
 }
 
+void NormalizeAndValidateIndices(IndicesType& indices, size_t cols_count) {
+    if (indices.empty()) {
+        throw ConfigurationError("Indices cannot be empty");
+    }
+    IndicesOption::NormalizeIndices(indices);
+    ValidateIndex(indices.back(), cols_count);
+}
+
 }  // namespace config
@@ -6,4 +6,7 @@
 
 namespace config {
 void ValidateIndex(IndexType value, size_t cols_count);
+// Checks indices given outside of an option the way indices options do, sorting and
+// deduplicating them.
+void NormalizeAndValidateIndices(IndicesType& indices, size_t cols_count);
 }  // namespace config
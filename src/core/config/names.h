@@ -73,6 +73,7 @@ constexpr auto kMaxFalsePositiveProbability = "max_false_positive_probability";
 constexpr auto kDelta = "delta";
 constexpr auto kMaxAmountOfCategories = "max_amount_of_categories";
 constexpr auto kFixedSample = "fixed_sample";
+constexpr auto kFrequencySketch = "frequency_sketch";
 constexpr auto kLeftTable = "left_table";
 constexpr auto kRightTable = "right_table";
 constexpr auto kPruneNonDisjoint = "prune_nondisjoint";
@@ -2,13 +2,20 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_set>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
 
 #define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
 #include <boost/thread.hpp>
@@ -17,6 +24,84 @@
 
 #include "identifier_set.h"
 #include "parallel_for.h"
+#include "util/worker_thread_pool.h"
+
+namespace {
+
+// Agree set of a tuple pair packed into 64-bit words: bit i is set iff the tuples agree on the
+// i-th column.
+using AgreeMask = std::vector<std::uint64_t>;
+using AgreeMaskSet = boost::unordered_flat_set<AgreeMask>;
+
+#if defined(__AVX2__)
+constexpr std::size_t kLanes = 8;
+#else
+constexpr std::size_t kLanes = 4;
+#endif
+static_assert(64 % kLanes == 0);
+
+// Clusters larger than this are split into one work item per first tuple of a pair.
+constexpr std::size_t kMaxUnsplitClusterSize = 64;
+
+/* Dictionary-encoded tuples stored row by row. Every row is padded to a multiple of kLanes
+ * values. Singleton values and padding are replaced with a value unique to the row, so two rows
+ * agree on a column iff their values in it are equal.
+ */
+class CompressedRows {
+private:
+    std::size_t stride_;
+    std::vector<int> values_;
+
+public:
+    CompressedRows(ColumnLayoutRelationData const& relation, std::vector<int> const& tuples)
+        : stride_((relation.GetNumColumns() + kLanes - 1) / kLanes * kLanes),
+          values_(tuples.size() * stride_) {
+        std::vector<ColumnData> const& columns = relation.GetColumnData();
+        for (std::size_t row = 0; row < tuples.size(); ++row) {
+            int const unique_value = -static_cast<int>(row) - 1;
+            int* values = values_.data() + row * stride_;
+            std::fill(values, values + stride_, unique_value);
+            for (std::size_t column = 0; column < columns.size(); ++column) {
+                int const value = columns[column].GetProbingTableValue(tuples[row]);
+                if (value != model::PLI::kSingletonValueId) values[column] = value;
+            }
+        }
+    }
+
+    int const* GetRow(std::size_t row) const noexcept {
+        return values_.data() + row * stride_;
+    }
+
+    std::size_t GetStride() const noexcept {
+        return stride_;
+    }
+};
+
+// Sets the bits of the columns the rows agree on, the mask must be zeroed beforehand.
+void CompareRows(int const* row1, int const* row2, std::size_t stride, std::uint64_t* mask) {
+    for (std::size_t i = 0; i < stride; i += kLanes) {
+#if defined(__AVX2__)
+        __m256i const eq =
+                _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(row1 + i)),
+                                   _mm256_loadu_si256(reinterpret_cast<__m256i const*>(row2 + i)));
+        std::uint64_t const bits =
+                static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+#elif defined(__SSE2__)
+        __m128i const eq =
+                _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(row1 + i)),
+                                _mm_loadu_si128(reinterpret_cast<__m128i const*>(row2 + i)));
+        std::uint64_t const bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+#else
+        std::uint64_t bits = 0;
+        for (std::size_t j = 0; j < kLanes; ++j) {
+            bits |= std::uint64_t{row1[i + j] == row2[i + j]} << j;
+        }
+#endif
+        mask[i / 64] |= bits << (i % 64);
+    }
+}
+
+}  // namespace
 
 namespace model {
 
@@ -48,6 +133,11 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAgreeSets() const {
             agree_sets = GenAsUsingGetAgreeSets();
             break;
         }
+        case AgreeSetsGenMethod::kUsingCompressedRows: {
+            method_str = "`kUsingCompressedRows`";
+            agree_sets = GenAsUsingCompressedRows();
+            break;
+        }
     }
 
     // metanome kostil, doesn't work properly in general
@@ -227,6 +317,89 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingMcAndGetAgreeSets() c
     return agree_sets;
 }
 
+AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingCompressedRows() const {
+    SetOfVectors const max_representation = GenPliMaxRepresentation();
+
+    // Rows of the compressed table in order of the first appearance of the tuples
+    std::vector<int> tuple_rows(relation_->GetNumRows(), -1);
+    std::vector<int> tuples;
+    for (auto const& cluster : max_representation) {
+        for (int tuple : cluster) {
+            if (tuple_rows[tuple] == -1) {
+                tuple_rows[tuple] = static_cast<int>(tuples.size());
+                tuples.push_back(tuple);
+            }
+        }
+    }
+    CompressedRows const rows(*relation_, tuples);
+
+    // Pairs of tuples from cluster whose first tuple is at position [first, last)
+    struct PairsRange {
+        std::vector<int> const* cluster;
+        std::size_t first;
+        std::size_t last;
+    };
+    std::vector<PairsRange> ranges;
+    double pairs_num = 0;
+    for (auto const& cluster : max_representation) {
+        if (cluster.size() < 2) continue;
+        pairs_num += cluster.size() * (cluster.size() - 1) / 2.0;
+        if (cluster.size() <= kMaxUnsplitClusterSize) {
+            ranges.push_back({&cluster, 0, cluster.size() - 1});
+            continue;
+        }
+        for (std::size_t first = 0; first + 1 < cluster.size(); ++first) {
+            ranges.push_back({&cluster, first, first + 1});
+        }
+    }
+
+    std::size_t const words_num = (relation_->GetNumColumns() + 63) / 64;
+    auto process_range = [&](PairsRange const& range, AgreeMaskSet& masks) {
+        std::vector<int> const& cluster = *range.cluster;
+        AgreeMask mask(words_num);
+        std::size_t range_pairs = 0;
+        for (std::size_t p = range.first; p != range.last; ++p) {
+            int const* row1 = rows.GetRow(tuple_rows[cluster[p]]);
+            for (std::size_t q = p + 1; q != cluster.size(); ++q) {
+                std::fill(mask.begin(), mask.end(), 0);
+                CompareRows(row1, rows.GetRow(tuple_rows[cluster[q]]), rows.GetStride(),
+                            mask.data());
+                masks.insert(mask);
+            }
+            range_pairs += cluster.size() - p - 1;
+        }
+        AddProgress(algos::FDAlgorithm::kTotalProgressPercent * range_pairs / pairs_num);
+    };
+
+    AgreeMaskSet masks;
+    if (config_.threads_num > 1 && ranges.size() > 1) {
+        std::mutex masks_mutex;
+        util::WorkerThreadPool pool(std::min<std::size_t>(config_.threads_num, ranges.size()));
+        pool.ExecIndexWithResource(
+                [&](model::Index i, AgreeMaskSet& thread_masks) {
+                    process_range(ranges[i], thread_masks);
+                },
+                []() { return AgreeMaskSet{}; }, ranges.size(),
+                [&](AgreeMaskSet&& thread_masks) {
+                    std::scoped_lock lock(masks_mutex);
+                    masks.insert(thread_masks.begin(), thread_masks.end());
+                });
+    } else {
+        for (PairsRange const& range : ranges) {
+            process_range(range, masks);
+        }
+    }
+
+    SetOfAgreeSets agree_sets;
+    agree_sets.reserve(masks.size());
+    for (AgreeMask const& mask : masks) {
+        boost::dynamic_bitset<> columns(mask.begin(), mask.end());
+        columns.resize(relation_->GetNumColumns());
+        agree_sets.insert(relation_->GetSchema()->GetVertical(columns));
+    }
+    return agree_sets;
+}
+
 AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingGetAgreeSets() const {
     SetOfAgreeSets agree_sets;
     vector<ColumnData> const& columns_data = relation_->GetColumnData();
@@ -64,6 +64,20 @@ enum class AgreeSetsGenMethod {
                                *  Metanome. For more information about maximal representation
                                *  check out http://www.vldb.org/pvldb/vol8/p1082-papenbrock.pdf
                                */
+    kUsingCompressedRows,     /*< Processes the same tuple pairs as `kUsingMCAndGetAgreeSet`,
+                               *  but without materializing tuples and agree sets per pair:
+                               *  1. Generates maximal representation.
+                               *  2. Copies dictionary-encoded values of the tuples from maximal
+                               *     representation into one row-major array. Singleton values
+                               *     are replaced with tuple-unique ones, so that equal values
+                               *     always mean agreement.
+                               *  3. Compares rows of every pair of tuples from a cluster with
+                               *     SIMD compare-and-movemask into a packed bitmask.
+                               *  4. Deduplicates bitmasks in per-thread flat hash sets and
+                               *     converts distinct ones to agree sets.
+                               *  Pairs are processed in parallel with config_.threads_num
+                               *  threads, large clusters are split by their first tuple.
+                               */
 };
 
 /* Max representation generation method */
@@ -162,6 +176,7 @@ private:
     SetOfAgreeSets GenAsUsingMapOfIdSets() const;
     SetOfAgreeSets GenAsUsingGetAgreeSets() const;
     SetOfAgreeSets GenAsUsingMcAndGetAgreeSets() const;
+    SetOfAgreeSets GenAsUsingCompressedRows() const;
 
     /* Implementations of generation MC algorithms */
     SetOfVectors GenMcUsingHandleEqvClass() const;
@@ -0,0 +1,59 @@
+#include "model/table/prefix_pli_cache.h"
+
+#include <iterator>
+
+namespace model {
+
+PrefixPLICache::PrefixPLICache(ColumnLayoutRelationData const& relation,
+                               std::vector<Combination> const& combinations)
+    : relation_(relation) {
+    for (Combination const& combination : combinations) {
+        for (std::size_t length = 2; length <= combination.size(); ++length) {
+            ++shared_prefixes_[Combination(combination.begin(), combination.begin() + length)]
+                      .uses_left;
+        }
+    }
+    std::erase_if(shared_prefixes_, [](auto const& item) { return item.second.uses_left < 2; });
+}
+
+std::shared_ptr<PLI const> PrefixPLICache::UseSharedPrefix(
+        Combination const& prefix, std::shared_ptr<PLI const> const& prev_pli, ColumnIndex column) {
+    PLI const* column_pli = relation_.GetColumnData(column).GetPositionListIndex();
+    {
+        std::lock_guard lock(mutex_);
+        auto it = shared_prefixes_.find(prefix);
+        if (it == shared_prefixes_.end()) {
+            return prev_pli->Intersect(column_pli);
+        }
+        if (it->second.pli != nullptr) {
+            std::shared_ptr<PLI const> pli = it->second.pli;
+            if (--it->second.uses_left == 0) shared_prefixes_.erase(it);
+            return pli;
+        }
+    }
+
+    std::shared_ptr<PLI const> pli = prev_pli->Intersect(column_pli);
+    std::lock_guard lock(mutex_);
+    // The entry cannot have been erased: this use has not been counted yet.
+    auto it = shared_prefixes_.find(prefix);
+    if (it->second.pli == nullptr) {
+        it->second.pli = pli;
+    } else {
+        // Another thread has computed it at the same time
+        pli = it->second.pli;
+    }
+    if (--it->second.uses_left == 0) shared_prefixes_.erase(it);
+    return pli;
+}
+
+std::shared_ptr<PLI const> PrefixPLICache::GetPLI(Combination const& combination) {
+    std::shared_ptr<PLI const> pli = relation_.GetColumnData(combination[0]).GetPliOwnership();
+    Combination prefix{combination[0]};
+    for (auto it = std::next(combination.begin()); it != combination.end(); ++it) {
+        prefix.push_back(*it);
+        pli = UseSharedPrefix(prefix, pli, *it);
+    }
+    return pli;
+}
+
+}  // namespace model
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "model/table/column_index.h"
+#include "model/table/column_layout_relation_data.h"
+#include "model/table/position_list_index.h"
+
+namespace model {
+
+/* PLIs of column combinations for verifying many dependencies over one relation.
+ * The PLI of a combination is built column by column, and the intermediate PLIs of prefixes
+ * shared by several requested combinations are computed once. A shared prefix PLI is dropped as
+ * soon as the last combination that uses it has been requested, so requesting combinations in
+ * lexicographic order keeps at most one chain of prefixes in memory. Thread-safe. */
+class PrefixPLICache {
+private:
+    using Combination = std::vector<ColumnIndex>;
+
+    struct Entry {
+        std::size_t uses_left = 0;
+        std::shared_ptr<PLI const> pli;
+    };
+
+    ColumnLayoutRelationData const& relation_;
+    std::map<Combination, Entry> shared_prefixes_;
+    std::mutex mutex_;
+
+    std::shared_ptr<PLI const> UseSharedPrefix(Combination const& prefix,
+                                               std::shared_ptr<PLI const> const& prev_pli,
+                                               ColumnIndex column);
+
+public:
+    /* Every combination must be requested with GetPLI exactly as many times as it occurs in
+     * combinations */
+    PrefixPLICache(ColumnLayoutRelationData const& relation,
+                   std::vector<Combination> const& combinations);
+
+    std::shared_ptr<PLI const> GetPLI(Combination const& combination);
+};
+
+}  // namespace model
@@ -0,0 +1,68 @@
+#include "relation_session.h"
+
+namespace model {
+
+std::shared_ptr<IDatasetStream> RelationSession::Attach() {
+    std::scoped_lock lock(mutex_);
+    table_->Reset();
+    return std::make_shared<SessionTable>(shared_from_this());
+}
+
+std::shared_ptr<ColumnLayoutRelationData> RelationSession::GetRelation(bool is_null_equal_null) {
+    std::scoped_lock lock(mutex_);
+    std::shared_ptr<ColumnLayoutRelationData>& relation = relations_[is_null_equal_null];
+    if (relation == nullptr) {
+        table_->Reset();
+        relation = ColumnLayoutRelationData::CreateFrom(*table_, is_null_equal_null);
+        table_->Reset();
+    }
+    return relation;
+}
+
+std::shared_ptr<ColumnLayoutTypedRelationData> RelationSession::GetTypedRelation(
+        bool is_null_equal_null) {
+    std::scoped_lock lock(mutex_);
+    std::shared_ptr<ColumnLayoutTypedRelationData>& relation =
+            typed_relations_[is_null_equal_null];
+    if (relation == nullptr) {
+        table_->Reset();
+        relation = ColumnLayoutTypedRelationData::CreateFrom(*table_, is_null_equal_null);
+        table_->Reset();
+    }
+    return relation;
+}
+
+std::string RelationSession::GetFingerprint(
+        std::function<std::string(IDatasetStream&)> const& calculate) {
+    std::scoped_lock lock(mutex_);
+    if (!fingerprint_.has_value()) {
+        table_->Reset();
+        fingerprint_ = calculate(*table_);
+        table_->Reset();
+    }
+    return *fingerprint_;
+}
+
+void RelationSession::Release() {
+    std::scoped_lock lock(mutex_);
+    relations_ = {};
+    typed_relations_ = {};
+}
+
+std::shared_ptr<ColumnLayoutRelationData> GetSharedRelation(IDatasetStream& table,
+                                                            bool is_null_equal_null) {
+    if (auto* session_table = dynamic_cast<SessionTable*>(&table)) {
+        return session_table->GetSession().GetRelation(is_null_equal_null);
+    }
+    return ColumnLayoutRelationData::CreateFrom(table, is_null_equal_null);
+}
+
+std::shared_ptr<ColumnLayoutTypedRelationData> GetSharedTypedRelation(IDatasetStream& table,
+                                                                      bool is_null_equal_null) {
+    if (auto* session_table = dynamic_cast<SessionTable*>(&table)) {
+        return session_table->GetSession().GetTypedRelation(is_null_equal_null);
+    }
+    return ColumnLayoutTypedRelationData::CreateFrom(table, is_null_equal_null);
+}
+
+}  // namespace model
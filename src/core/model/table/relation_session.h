@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "column_layout_relation_data.h"
+#include "column_layout_typed_relation_data.h"
+#include "idataset_stream.h"
+
+namespace model {
+
+/**
+ * A table parsed once for all the algorithms that profile it.
+ *
+ * The session owns the table and builds its encoded (ColumnLayoutRelationData) and typed
+ * (ColumnLayoutTypedRelationData) forms on the first request for each of them, separately for
+ * both ways of comparing NULLs. The forms are shared by the algorithms and kept until the session
+ * and every algorithm that got them are destroyed. Algorithms are given the table returned by
+ * Attach. Those that support sessions take the forms from it with GetSharedRelation and
+ * GetSharedTypedRelation, others just read its rows.
+ *
+ * The forms are built under a lock, but the rows of the table are read through a single cursor,
+ * so algorithms attached to the same session must load their data one at a time.
+ */
+class RelationSession : public std::enable_shared_from_this<RelationSession> {
+private:
+    std::shared_ptr<IDatasetStream> table_;
+    std::mutex mutex_;
+    // Indexed by is_null_equal_null
+    std::array<std::shared_ptr<ColumnLayoutRelationData>, 2> relations_;
+    std::array<std::shared_ptr<ColumnLayoutTypedRelationData>, 2> typed_relations_;
+    std::optional<std::string> fingerprint_;
+
+    explicit RelationSession(std::shared_ptr<IDatasetStream> table) : table_(std::move(table)) {}
+
+public:
+    static std::shared_ptr<RelationSession> Create(std::shared_ptr<IDatasetStream> table) {
+        return std::shared_ptr<RelationSession>(new RelationSession(std::move(table)));
+    }
+
+    /* Returns a table to give to an algorithm. It reads the rows from the beginning and keeps
+     * the session alive */
+    std::shared_ptr<IDatasetStream> Attach();
+
+    /* Rows of the table, used by attached tables */
+    IDatasetStream& GetRows() noexcept {
+        return *table_;
+    }
+
+    std::shared_ptr<ColumnLayoutRelationData> GetRelation(bool is_null_equal_null);
+    std::shared_ptr<ColumnLayoutTypedRelationData> GetTypedRelation(bool is_null_equal_null);
+
+    /* Returns calculate(table) from the first call, so the rows are read for it only once. Used
+     * for the fingerprints of the result cache */
+    std::string GetFingerprint(std::function<std::string(IDatasetStream&)> const& calculate);
+
+    /* Drops the forms, they are built again on the next request */
+    void Release();
+};
+
+/* A table attached to a session */
+class SessionTable final : public IDatasetStream {
+private:
+    std::shared_ptr<RelationSession> session_;
+    IDatasetStream& rows_;
+
+public:
+    explicit SessionTable(std::shared_ptr<RelationSession> session)
+        : session_(std::move(session)), rows_(session_->GetRows()) {}
+
+    RelationSession& GetSession() const noexcept {
+        return *session_;
+    }
+
+    Row GetNextRow() final {
+        return rows_.GetNextRow();
+    }
+
+    bool HasNextRow() const final {
+        return rows_.HasNextRow();
+    }
+
+    size_t GetNumberOfColumns() const final {
+        return rows_.GetNumberOfColumns();
+    }
+
+    std::string GetColumnName(size_t index) const final {
+        return rows_.GetColumnName(index);
+    }
+
+    std::string GetRelationName() const final {
+        return rows_.GetRelationName();
+    }
+
+    void Reset() final {
+        rows_.Reset();
+    }
+};
+
+/* Takes the relation from the session if the table is attached to one, parses the table
+ * otherwise */
+std::shared_ptr<ColumnLayoutRelationData> GetSharedRelation(IDatasetStream& table,
+                                                            bool is_null_equal_null);
+std::shared_ptr<ColumnLayoutTypedRelationData> GetSharedTypedRelation(IDatasetStream& table,
+                                                                      bool is_null_equal_null);
+
+}  // namespace model
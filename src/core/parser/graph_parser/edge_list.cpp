@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "graph_parser.h"
+#include "util/parallel_for.h"
+
+namespace parser::graph_parser {
+
+namespace {
+
+// Lines of a mapped CSV file. Views stay valid while the file is mapped.
+class MappedCsv {
+private:
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    std::string_view data_;
+    std::vector<std::string_view> header_;
+    char separator_;
+
+public:
+    // Part of the file consisting of whole lines.
+    struct Chunk {
+        std::string_view text;
+        std::vector<std::string_view> fields;
+        std::size_t rows_num = 0;
+        // Exceptions cannot leave worker threads, parse errors are reported through here.
+        std::string error;
+    };
+
+    MappedCsv(std::filesystem::path const& path, char separator) : separator_(separator) {
+        if (!std::filesystem::exists(path)) {
+            throw std::runtime_error("Error: couldn't find file " + path.string());
+        }
+        if (std::filesystem::file_size(path) != 0) {
+            file_ = {path.c_str(), boost::interprocess::read_only};
+            region_ = {file_, boost::interprocess::read_only};
+            data_ = {static_cast<char const*>(region_.get_address()), region_.get_size()};
+        }
+        std::size_t header_end = std::min(data_.find('\n'), data_.size());
+        header_ = SplitLine(data_.substr(0, header_end));
+        data_.remove_prefix(std::min(header_end + 1, data_.size()));
+    }
+
+    std::vector<std::string_view> SplitLine(std::string_view line) const {
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        std::vector<std::string_view> fields;
+        std::size_t pos;
+        while ((pos = line.find(separator_)) != std::string_view::npos) {
+            fields.push_back(line.substr(0, pos));
+            line.remove_prefix(pos + 1);
+        }
+        fields.push_back(line);
+        return fields;
+    }
+
+    std::vector<std::string_view> const& GetHeader() const noexcept {
+        return header_;
+    }
+
+    // Splits the body into about chunks_num chunks, every one ending at a line end.
+    std::vector<Chunk> MakeChunks(std::size_t chunks_num) const {
+        std::vector<Chunk> chunks;
+        std::size_t const approx_size = data_.size() / chunks_num + 1;
+        std::size_t begin = 0;
+        while (begin < data_.size()) {
+            std::size_t end = data_.find('\n', std::min(begin + approx_size, data_.size()) - 1);
+            end = end == std::string_view::npos ? data_.size() : end + 1;
+            chunks.emplace_back().text = data_.substr(begin, end - begin);
+            begin = end;
+        }
+        return chunks;
+    }
+
+    // Fills chunk.fields with exactly columns_num fields per non-empty line, padding short
+    // lines with empty fields.
+    void ParseChunk(Chunk& chunk, std::size_t columns_num) const {
+        std::string_view text = chunk.text;
+        while (!text.empty()) {
+            std::size_t line_end = std::min(text.find('\n'), text.size());
+            std::string_view line = text.substr(0, line_end);
+            text.remove_prefix(std::min(line_end + 1, text.size()));
+            if (line.empty() || line == "\r") continue;
+            std::vector<std::string_view> fields = SplitLine(line);
+            if (fields.size() > columns_num) {
+                throw std::runtime_error("Error: row \"" + std::string{line} + "\" has " +
+                                         std::to_string(fields.size()) + " fields, expected " +
+                                         std::to_string(columns_num));
+            }
+            fields.resize(columns_num);
+            chunk.fields.insert(chunk.fields.end(), fields.begin(), fields.end());
+            ++chunk.rows_num;
+        }
+    }
+};
+
+int ParseId(std::string_view field) {
+    int id;
+    auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), id);
+    if (ec != std::errc{} || ptr != field.data() + field.size()) {
+        throw std::runtime_error("Error: \"" + std::string{field} + "\" is not a vertex id");
+    }
+    return id;
+}
+
+std::vector<MappedCsv::Chunk> ParseChunks(MappedCsv const& csv, std::size_t columns_num,
+                                          unsigned threads_num) {
+    // A few chunks per thread, so that the threads finish at about the same time.
+    std::vector<MappedCsv::Chunk> chunks = csv.MakeChunks(threads_num * 4);
+    auto parse = [&csv, columns_num](MappedCsv::Chunk& chunk) {
+        try {
+            csv.ParseChunk(chunk, columns_num);
+        } catch (std::exception const& e) {
+            chunk.error = e.what();
+        }
+    };
+    util::ParallelForeach(chunks.begin(), chunks.end(), threads_num, parse);
+    for (MappedCsv::Chunk const& chunk : chunks) {
+        if (!chunk.error.empty()) throw std::runtime_error(chunk.error);
+    }
+    return chunks;
+}
+
+}  // namespace
+
+graph_t ReadEdgeListGraph(std::filesystem::path const& vertices_path,
+                          std::filesystem::path const& edges_path, unsigned threads_num,
+                          char separator) {
+    MappedCsv vertices_csv(vertices_path, separator);
+    std::vector<std::string_view> const& header = vertices_csv.GetHeader();
+    if (std::find(std::next(header.begin()), header.end(), "label") == header.end()) {
+        throw std::runtime_error("Error: no \"label\" column in " + vertices_path.string());
+    }
+    std::size_t const columns_num = header.size();
+    std::vector<MappedCsv::Chunk> vertex_chunks =
+            ParseChunks(vertices_csv, columns_num, threads_num);
+
+    std::size_t vertices_num = 0;
+    for (MappedCsv::Chunk const& chunk : vertex_chunks) {
+        vertices_num += chunk.rows_num;
+    }
+    graph_t result(vertices_num);
+    std::vector<std::string> const attribute_names(std::next(header.begin()), header.end());
+    std::unordered_map<int, vertex_t> vertex_by_id;
+    vertex_by_id.reserve(vertices_num);
+    vertex_t v = 0;
+    for (MappedCsv::Chunk const& chunk : vertex_chunks) {
+        for (auto row = chunk.fields.begin(); row != chunk.fields.end(); row += columns_num, ++v) {
+            int const id = ParseId(row[0]);
+            if (!vertex_by_id.emplace(id, v).second) {
+                throw std::runtime_error("Error: duplicate vertex id " + std::to_string(id));
+            }
+            result[v].node_id = id;
+            auto& attributes = result[v].attributes;
+            for (std::size_t i = 1; i < columns_num; ++i) {
+                if (!row[i].empty()) attributes.emplace(attribute_names[i - 1], row[i]);
+            }
+        }
+    }
+
+    MappedCsv edges_csv(edges_path, separator);
+    std::size_t const edge_columns_num = edges_csv.GetHeader().size();
+    if (edge_columns_num < 2 || edge_columns_num > 3) {
+        throw std::runtime_error("Error: expected source, target and optional label columns in " +
+                                 edges_path.string());
+    }
+    std::vector<MappedCsv::Chunk> edge_chunks =
+            ParseChunks(edges_csv, edge_columns_num, threads_num);
+    // Resolve endpoints in parallel too, only insertion into the graph is sequential.
+    std::vector<std::vector<std::pair<vertex_t, vertex_t>>> endpoints(edge_chunks.size());
+    std::vector<std::size_t> chunk_indices(edge_chunks.size());
+    std::iota(chunk_indices.begin(), chunk_indices.end(), 0);
+    auto get_vertex = [&vertex_by_id](std::string_view field) {
+        auto it = vertex_by_id.find(ParseId(field));
+        if (it == vertex_by_id.end()) {
+            throw std::runtime_error("Error: edge refers to unknown vertex " + std::string{field});
+        }
+        return it->second;
+    };
+    util::ParallelForeach(chunk_indices.begin(), chunk_indices.end(), threads_num,
+                          [&](std::size_t i) {
+                              MappedCsv::Chunk& chunk = edge_chunks[i];
+                              endpoints[i].reserve(chunk.rows_num);
+                              try {
+                                  for (std::size_t j = 0; j < chunk.fields.size();
+                                       j += edge_columns_num) {
+                                      endpoints[i].emplace_back(get_vertex(chunk.fields[j]),
+                                                                get_vertex(chunk.fields[j + 1]));
+                                  }
+                              } catch (std::exception const& e) {
+                                  chunk.error = e.what();
+                              }
+                          });
+    for (std::size_t i = 0; i < edge_chunks.size(); ++i) {
+        if (!edge_chunks[i].error.empty()) throw std::runtime_error(edge_chunks[i].error);
+        std::vector<std::string_view> const& fields = edge_chunks[i].fields;
+        for (std::size_t j = 0; j < endpoints[i].size(); ++j) {
+            auto [source, target] = endpoints[i][j];
+            std::string label;
+            if (edge_columns_num == 3) label = fields[j * edge_columns_num + 2];
+            boost::add_edge(source, target, {std::move(label)}, result);
+        }
+    }
+    return result;
+}
+
+}  // namespace parser::graph_parser
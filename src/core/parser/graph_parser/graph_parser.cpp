@@ -120,7 +120,13 @@ graph_t ReadGraph(std::istream& stream) {
     return result;
 };
 
-graph_t ReadGraph(std::filesystem::path const& path) {
+graph_t ReadGraph(std::filesystem::path const& path, unsigned threads_num) {
+    if (std::filesystem::is_directory(path)) {
+        return ReadEdgeListGraph(path / "vertices.csv", path / "edges.csv", threads_num);
+    }
+    if (IsGraphSnapshot(path)) {
+        return ReadGraphSnapshot(path);
+    }
     std::ifstream f(path);
     graph_t result = ReadGraph(f);
     f.close();
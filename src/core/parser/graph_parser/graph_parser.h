@@ -12,7 +12,31 @@ namespace parser {
 namespace graph_parser {
 
 graph_t ReadGraph(std::istream& stream);
-graph_t ReadGraph(std::filesystem::path const& path);
+/* Reads a graph in any of the supported formats:
+ * - a directory is read as an edge list (vertices.csv and edges.csv, see ReadEdgeListGraph);
+ * - a file starting with the snapshot signature is read as a snapshot (see ReadGraphSnapshot);
+ * - any other file is read as DOT.
+ * threads_num is only used by the edge list reader.
+ */
+graph_t ReadGraph(std::filesystem::path const& path, unsigned threads_num = 1);
+
+/* Reads a graph stored as two CSV files with a header row and no quoting.
+ * Vertex file: the first column is the integer vertex id, the rest are attributes named by the
+ * header, a "label" column is required; empty cells mean the attribute is absent.
+ * Edge file: source id, target id and, optionally, edge label.
+ * Both files are memory-mapped and parsed in parallel chunks of lines.
+ */
+graph_t ReadEdgeListGraph(std::filesystem::path const& vertices_path,
+                          std::filesystem::path const& edges_path, unsigned threads_num = 1,
+                          char separator = ',');
+
+/* Binary snapshot of a graph: all strings are stored once in a string table, vertices and edges
+ * refer to them by index. The file is memory-mapped on reading, so loading it needs no parsing.
+ * Numbers are stored in the native byte order, snapshots are not portable between architectures.
+ */
+void WriteGraphSnapshot(std::filesystem::path const& path, graph_t const& graph);
+graph_t ReadGraphSnapshot(std::filesystem::path const& path);
+bool IsGraphSnapshot(std::filesystem::path const& path);
 
 void WriteGraph(std::ostream& stream, graph_t& result);
 void WriteGraph(std::filesystem::path const& path, graph_t& result);
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/graph/iteration_macros.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "graph_parser.h"
+
+namespace parser::graph_parser {
+
+namespace {
+
+constexpr char kSignature[8] = {'D', 'E', 'S', 'B', 'G', 'R', 'P', 'H'};
+constexpr std::uint64_t kVersion = 1;
+
+/* The header is followed by arrays of 64-bit unsigned integers and then by the characters of all
+ * strings:
+ * string_offsets[strings_num + 1], vertex_ids[vertices_num], attribute_offsets[vertices_num + 1],
+ * attributes[attributes_num * 2] (name and value string indices),
+ * edges[edges_num * 3] (source, target and label string index), chars[chars_size].
+ */
+struct SnapshotHeader {
+    char signature[8];
+    std::uint64_t version;
+    std::uint64_t vertices_num;
+    std::uint64_t edges_num;
+    std::uint64_t attributes_num;
+    std::uint64_t strings_num;
+    std::uint64_t chars_size;
+
+    std::uint64_t NumbersSize() const {
+        return (strings_num + 1) + vertices_num + (vertices_num + 1) + attributes_num * 2 +
+               edges_num * 3;
+    }
+};
+
+class StringTable {
+private:
+    std::unordered_map<std::string, std::uint64_t> ids_;
+    std::vector<std::uint64_t> offsets_ = {0};
+    std::string chars_;
+
+public:
+    std::uint64_t GetId(std::string const& str) {
+        auto [it, inserted] = ids_.try_emplace(str, ids_.size());
+        if (inserted) {
+            chars_ += str;
+            offsets_.push_back(chars_.size());
+        }
+        return it->second;
+    }
+
+    std::vector<std::uint64_t> const& GetOffsets() const noexcept {
+        return offsets_;
+    }
+
+    std::string const& GetChars() const noexcept {
+        return chars_;
+    }
+};
+
+template <typename T>
+void WriteArray(std::ofstream& out, std::vector<T> const& data) {
+    out.write(reinterpret_cast<char const*>(data.data()),
+              static_cast<std::streamsize>(data.size() * sizeof(T)));
+}
+
+}  // namespace
+
+void WriteGraphSnapshot(std::filesystem::path const& path, graph_t const& graph) {
+    StringTable strings;
+    std::vector<std::uint64_t> vertex_ids;
+    std::vector<std::uint64_t> attribute_offsets = {0};
+    std::vector<std::uint64_t> attributes;
+    std::vector<std::uint64_t> edge_records;
+    vertex_ids.reserve(boost::num_vertices(graph));
+    BGL_FORALL_VERTICES_T(v, graph, graph_t) {
+        vertex_ids.push_back(static_cast<std::uint64_t>(graph[v].node_id));
+        for (auto const& [name, value] : graph[v].attributes) {
+            attributes.push_back(strings.GetId(name));
+            attributes.push_back(strings.GetId(value));
+        }
+        attribute_offsets.push_back(attributes.size() / 2);
+    }
+    edge_records.reserve(boost::num_edges(graph) * 3);
+    BGL_FORALL_EDGES_T(e, graph, graph_t) {
+        edge_records.push_back(boost::source(e, graph));
+        edge_records.push_back(boost::target(e, graph));
+        edge_records.push_back(strings.GetId(graph[e].label));
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.signature, kSignature, sizeof(kSignature));
+    header.version = kVersion;
+    header.vertices_num = vertex_ids.size();
+    header.edges_num = edge_records.size() / 3;
+    header.attributes_num = attributes.size() / 2;
+    header.strings_num = strings.GetOffsets().size() - 1;
+    header.chars_size = strings.GetChars().size();
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Error: couldn't open file " + path.string());
+    }
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    WriteArray(out, strings.GetOffsets());
+    WriteArray(out, vertex_ids);
+    WriteArray(out, attribute_offsets);
+    WriteArray(out, attributes);
+    WriteArray(out, edge_records);
+    out.write(strings.GetChars().data(), static_cast<std::streamsize>(header.chars_size));
+}
+
+bool IsGraphSnapshot(std::filesystem::path const& path) {
+    std::ifstream in(path, std::ios::binary);
+    char signature[sizeof(kSignature)];
+    return in.read(signature, sizeof(signature)) &&
+           std::equal(std::begin(signature), std::end(signature), std::begin(kSignature));
+}
+
+graph_t ReadGraphSnapshot(std::filesystem::path const& path) {
+    if (!IsGraphSnapshot(path)) {
+        throw std::runtime_error("Error: " + path.string() + " is not a graph snapshot");
+    }
+    boost::interprocess::file_mapping file(path.c_str(), boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+    auto const* data = static_cast<char const*>(region.get_address());
+
+    auto corrupted = [&path]() {
+        return std::runtime_error("Error: graph snapshot " + path.string() + " is corrupted");
+    };
+    std::size_t const size = region.get_size();
+    if (size < sizeof(SnapshotHeader)) throw corrupted();
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != kVersion) {
+        throw std::runtime_error("Error: unsupported graph snapshot version " +
+                                 std::to_string(header.version));
+    }
+    // Bounding every count by the file size first keeps the size computation from overflowing.
+    std::uint64_t const max_count = size / sizeof(std::uint64_t);
+    for (std::uint64_t count : {header.vertices_num, header.edges_num, header.attributes_num,
+                                header.strings_num}) {
+        if (count >= max_count) throw corrupted();
+    }
+    if (size != sizeof(header) + header.NumbersSize() * sizeof(std::uint64_t) + header.chars_size) {
+        throw corrupted();
+    }
+
+    // The mapping is page-aligned and the header size is a multiple of 8.
+    auto const* string_offsets = reinterpret_cast<std::uint64_t const*>(data + sizeof(header));
+    std::uint64_t const* vertex_ids = string_offsets + header.strings_num + 1;
+    std::uint64_t const* attribute_offsets = vertex_ids + header.vertices_num;
+    std::uint64_t const* attributes = attribute_offsets + header.vertices_num + 1;
+    std::uint64_t const* edge_records = attributes + header.attributes_num * 2;
+    char const* chars = reinterpret_cast<char const*>(edge_records + header.edges_num * 3);
+
+    // Offsets must go from 0 to the end of their arrays without decreasing, indices must refer
+    // to existing strings and vertices.
+    auto check_offsets = [&](std::uint64_t const* offsets, std::uint64_t num, std::uint64_t end) {
+        if (offsets[0] != 0 || offsets[num] != end ||
+            !std::is_sorted(offsets, offsets + num + 1)) {
+            throw corrupted();
+        }
+    };
+    check_offsets(string_offsets, header.strings_num, header.chars_size);
+    check_offsets(attribute_offsets, header.vertices_num, header.attributes_num);
+    auto check_index = [&](std::uint64_t index, std::uint64_t num) {
+        if (index >= num) throw corrupted();
+    };
+    for (std::uint64_t i = 0; i < header.attributes_num * 2; ++i) {
+        check_index(attributes[i], header.strings_num);
+    }
+    for (std::uint64_t i = 0; i < header.edges_num * 3; i += 3) {
+        check_index(edge_records[i], header.vertices_num);
+        check_index(edge_records[i + 1], header.vertices_num);
+        check_index(edge_records[i + 2], header.strings_num);
+    }
+
+    auto get_string = [&](std::uint64_t id) {
+        return std::string_view{chars + string_offsets[id],
+                                string_offsets[id + 1] - string_offsets[id]};
+    };
+
+    graph_t result(header.vertices_num);
+    for (std::uint64_t v = 0; v < header.vertices_num; ++v) {
+        result[v].node_id = static_cast<int>(vertex_ids[v]);
+        auto& vertex_attributes = result[v].attributes;
+        for (std::uint64_t i = attribute_offsets[v]; i < attribute_offsets[v + 1]; ++i) {
+            vertex_attributes.emplace_hint(vertex_attributes.end(), get_string(attributes[2 * i]),
+                                           get_string(attributes[2 * i + 1]));
+        }
+    }
+    for (std::uint64_t const* record = edge_records;
+         record != edge_records + header.edges_num * 3; record += 3) {
+        boost::add_edge(record[0], record[1], {std::string{get_string(record[2])}}, result);
+    }
+    return result;
+}
+
+}  // namespace parser::graph_parser
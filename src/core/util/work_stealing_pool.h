@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <easylogging++.h>
+
+namespace util {
+
+/* Runs dynamically spawned tasks on a fixed number of workers.
+ * Every worker owns a deque of tasks: it takes tasks from the back of its own deque and, once the
+ * deque is empty, steals from the front of the other workers' deques. Tasks may spawn subtasks
+ * with Push, so a few huge units of work (e.g. search subtrees rooted at hub vertices) get split
+ * and spread among all workers instead of being stuck on the worker they were assigned to.
+ */
+template <typename Task>
+class WorkStealingPool {
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<Queue> queues_;
+    // Number of pushed tasks that are not processed yet.
+    std::atomic<std::size_t> unfinished_ = 0;
+    // Number of tasks lying in the deques, i.e. not taken by a worker yet.
+    std::atomic<std::size_t> queued_ = 0;
+    std::atomic<bool> stopped_ = false;
+    // Workers that found no task to take sleep on idle_cv_ until one is pushed or the run ends.
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+    std::mutex exception_mutex_;
+    std::exception_ptr exception_;
+
+    std::optional<Task> Pop(std::size_t worker) {
+        Queue& queue = queues_[worker];
+        std::scoped_lock lock{queue.mutex};
+        if (queue.tasks.empty()) return std::nullopt;
+        Task task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    std::optional<Task> Steal(std::size_t thief) {
+        std::size_t const workers_num = queues_.size();
+        for (std::size_t i = 1; i < workers_num; ++i) {
+            Queue& queue = queues_[(thief + i) % workers_num];
+            std::scoped_lock lock{queue.mutex};
+            if (queue.tasks.empty()) continue;
+            Task task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+        return std::nullopt;
+    }
+
+    bool CanSleep() const noexcept {
+        return queued_.load() == 0 && unfinished_.load() != 0 && !stopped_.load();
+    }
+
+    // Wakes up the sleeping workers after the state CanSleep depends on has changed. Taking the
+    // mutex orders the change before the check of a worker that is about to sleep.
+    void WakeUp(bool all) {
+        { std::scoped_lock lock{idle_mutex_}; }
+        if (all) {
+            idle_cv_.notify_all();
+        } else {
+            idle_cv_.notify_one();
+        }
+    }
+
+    template <typename Func>
+    void Work(std::size_t worker, Func& func) {
+        while (!stopped_.load(std::memory_order_relaxed)) {
+            std::optional<Task> task = Pop(worker);
+            if (!task) task = Steal(worker);
+            if (!task) {
+                std::unique_lock lock{idle_mutex_};
+                idle_cv_.wait(lock, [this]() { return !CanSleep(); });
+                if (unfinished_.load(std::memory_order_acquire) == 0) return;
+                continue;
+            }
+            try {
+                func(worker, std::move(*task));
+            } catch (...) {
+                std::scoped_lock lock{exception_mutex_};
+                if (!exception_) exception_ = std::current_exception();
+                stopped_.store(true, std::memory_order_relaxed);
+                WakeUp(true);
+            }
+            if (unfinished_.fetch_sub(1, std::memory_order_acq_rel) == 1) WakeUp(true);
+        }
+    }
+
+public:
+    explicit WorkStealingPool(std::size_t workers_num) : queues_(workers_num) {
+        assert(workers_num != 0);
+    }
+
+    std::size_t WorkersNum() const noexcept {
+        return queues_.size();
+    }
+
+    // Thread-safe. Tasks pushed by a worker should go to its own deque.
+    void Push(std::size_t worker, Task task) {
+        unfinished_.fetch_add(1, std::memory_order_relaxed);
+        {
+            Queue& queue = queues_[worker];
+            std::scoped_lock lock{queue.mutex};
+            queue.tasks.push_back(std::move(task));
+            queued_.fetch_add(1, std::memory_order_relaxed);
+        }
+        WakeUp(false);
+    }
+
+    /* Calls func(worker_index, task) for every pushed task, including the ones pushed by func
+     * itself, and returns when there are no tasks left. The calling thread is worker 0.
+     * If func throws, the remaining tasks are dropped and the first exception is rethrown.
+     */
+    template <typename Func>
+    void Run(Func func) {
+        std::vector<std::thread> threads;
+        threads.reserve(queues_.size() - 1);
+        for (std::size_t worker = 1; worker < queues_.size(); ++worker) {
+            try {
+                threads.emplace_back([this, worker, &func]() { Work(worker, func); });
+            } catch (std::system_error const& e) {
+                /* Could not create a new thread, the rest of the workers will steal its tasks */
+                LOG(WARNING) << "Created " << threads.size() << " threads in WorkStealingPool. "
+                             << "Could not create new thread: " << e.what();
+                break;
+            }
+        }
+        Work(0, func);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        if (exception_) {
+            std::exception_ptr exception = std::exchange(exception_, nullptr);
+            for (Queue& queue : queues_) {
+                queue.tasks.clear();
+            }
+            unfinished_ = 0;
+            queued_ = 0;
+            stopped_ = false;
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+}  // namespace util
@@ -1,15 +1,24 @@
 #include "bind_main_classes.h"
 
+#include <memory>
+#include <optional>
+#include <string>
 #include <typeindex>
 #include <typeinfo>
+#include <utility>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include "algorithms/algo_factory.h"
 #include "algorithms/algorithm.h"
+#include "algorithms/md/hymd/hymd.h"
+#include "algorithms/result_cache.h"
 #include "config/exceptions.h"
 #include "config/names.h"
+#include "config/tabular_data/input_table_type.h"
+#include "model/table/relation_session.h"
+#include "py_util/async_execution.h"
 #include "py_util/get_py_type.h"
 #include "py_util/opt_to_py.h"
 #include "py_util/py_to_any.h"
@@ -30,6 +39,23 @@ void ConfigureAlgo(Algorithm& algorithm, py::kwargs const& kwargs) {
                                : boost::any{};
             });
 }
+
+// HyMD creates Python objects and calls Python functions given as custom column matches while it
+// runs, other algorithms only touch Python objects through DataFrame readers, which take the GIL
+// themselves.
+bool NeedsGil(Algorithm const& algorithm) {
+    return dynamic_cast<algos::hymd::HyMD const*>(&algorithm) != nullptr;
+}
+
+template <typename Func>
+void RunReleasingGil(Algorithm const& algorithm, Func func) {
+    if (NeedsGil(algorithm)) {
+        func();
+        return;
+    }
+    py::gil_scoped_release release;
+    func();
+}
 }  // namespace
 
 namespace python_bindings {
@@ -41,6 +67,54 @@ void BindMainClasses(py::module_& main_module) {
 
     py::register_exception<config::ConfigurationError>(main_module, "ConfigurationError",
                                                        PyExc_ValueError);
+    py::register_exception<algos::ExecutionCancelled>(main_module, "ExecutionCancelled",
+                                                      PyExc_RuntimeError);
+
+    py::class_<AsyncExecution>(main_module, "AsyncExecution",
+                               "Handle of an execution started with execute_async. Awaitable.")
+            .def("done", &AsyncExecution::Done, "Check whether the execution has finished.")
+            .def("wait", &AsyncExecution::Wait, "timeout"_a = py::none(),
+                 "Wait for the execution to finish for at most timeout seconds. Returns whether "
+                 "it has finished.")
+            .def("result", &AsyncExecution::Result,
+                 "Wait for the execution to finish and raise the exception it failed with, if "
+                 "any.")
+            .def("cancel", &AsyncExecution::Cancel,
+                 "Ask the execution to stop. result() will raise ExecutionCancelled if it stops "
+                 "early.")
+            .def("get_progress", &AsyncExecution::GetProgress,
+                 "Get the current phase index and the progress of that phase in percent.")
+            .def("__await__", [](py::object execution) {
+                py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+                return loop.attr("run_in_executor")(py::none(), execution.attr("result"))
+                        .attr("__await__")();
+            });
+
+    py::class_<algos::ResultCache, std::shared_ptr<algos::ResultCache>>(
+            main_module, "ResultCache",
+            "Results of algorithm executions kept in a directory. Attach it to algorithms with "
+            "set_result_cache.")
+            .def(py::init([](std::string const& directory) {
+                     return std::make_shared<algos::ResultCache>(directory);
+                 }),
+                 "directory"_a)
+            .def_property_readonly(
+                    "directory",
+                    [](algos::ResultCache const& cache) { return cache.GetDirectory().string(); })
+            .def("clear", &algos::ResultCache::Clear, "Remove all kept results.");
+
+    py::class_<model::RelationSession, std::shared_ptr<model::RelationSession>>(
+            main_module, "RelationSession",
+            "A table parsed once for all the algorithms it is passed to as the table option. "
+            "Algorithms load their data one at a time.")
+            .def(py::init([](py::handle table) {
+                     return model::RelationSession::Create(
+                             boost::any_cast<config::InputTable>(python_bindings::PyToAny(
+                                     config::names::kTable, typeid(config::InputTable), table)));
+                 }),
+                 "table"_a)
+            .def("release", &model::RelationSession::Release,
+                 "Free the parsed forms of the table, they are parsed again when needed.");
 
 #define CERTAIN_SCRIPTS_ONLY                                                       \
     "\nThis option is only expected to be used by Python scripts in which it is\n" \
@@ -51,7 +125,7 @@ void BindMainClasses(py::module_& main_module) {
                     "load_data",
                     [](Algorithm& algo, py::kwargs const& kwargs) {
                         ConfigureAlgo(algo, kwargs);
-                        algo.LoadData();
+                        RunReleasingGil(algo, [&algo]() { algo.LoadData(); });
                     },
                     "Load data for execution")
             .def("get_possible_options", &Algorithm::GetPossibleOptions,
@@ -106,9 +180,32 @@ void BindMainClasses(py::module_& main_module) {
                     "execute",
                     [](Algorithm& algo, py::kwargs const& kwargs) {
                         ConfigureAlgo(algo, kwargs);
-                        algo.Execute();
+                        RunReleasingGil(algo, [&algo]() { algo.Execute(); });
+                    },
+                    "Process data.")
+            .def(
+                    "execute_async",
+                    [](py::object algo_obj, py::kwargs const& kwargs) {
+                        auto& algo = algo_obj.cast<Algorithm&>();
+                        ConfigureAlgo(algo, kwargs);
+                        return std::make_unique<AsyncExecution>(std::move(algo_obj),
+                                                                NeedsGil(algo));
                     },
-                    "Process data.");
+                    "Process data on a separate thread. Returns an AsyncExecution handle. The "
+                    "algorithm must not be used until the execution is done.")
+            .def("get_progress", &Algorithm::GetProgress,
+                 "Get the current phase index and the progress of that phase in percent. May be "
+                 "called while the algorithm is executed.")
+            .def("get_phase_names", &Algorithm::GetPhaseNames, "Get names of the phases.")
+            .def("set_result_cache", &Algorithm::SetResultCache, "cache"_a,
+                 "Keep results in the cache and reuse them when the algorithm is executed with "
+                 "the same options on the same data. Must be called before load_data. Pass None "
+                 "to stop using the cache. Only some algorithms support caching, others ignore "
+                 "it.")
+            .def("get_result_cache", &Algorithm::GetResultCache)
+            .def("cancel", &Algorithm::Cancel,
+                 "Stop the running (or next) load_data or execute call, which will raise "
+                 "ExecutionCancelled. May be called from any thread.");
 #undef CERTAIN_SCRIPTS_ONLY
 }
 }  // namespace python_bindings
@@ -23,12 +23,19 @@ void BindFdVerification(pybind11::module_& main_module) {
             .def_property_readonly("num_distinct_rhs_values", &Highlight::GetNumDistinctRhsValues)
             .def_property_readonly("most_frequent_rhs_value_proportion",
                                    &Highlight::GetMostFrequentRhsValueProportion);
+    py::class_<FDStats>(fd_verification_module, "FDStats")
+            .def_readonly("holds", &FDStats::holds)
+            .def_readonly("num_error_clusters", &FDStats::num_error_clusters)
+            .def_readonly("num_error_rows", &FDStats::num_error_rows)
+            .def_readonly("error", &FDStats::error);
     BindPrimitiveNoBase<FDVerifier>(fd_verification_module, "FDVerifier")
             .def("fd_holds", &FDVerifier::FDHolds)
             .def("get_error", &FDVerifier::GetError)
             .def("get_num_error_clusters", &FDVerifier::GetNumErrorClusters)
             .def("get_num_error_rows", &FDVerifier::GetNumErrorRows)
-            .def("get_highlights", &FDVerifier::GetHighlights);
+            .def("get_highlights", &FDVerifier::GetHighlights)
+            .def("verify_fds", &FDVerifier::VerifyFDs, py::arg("fds"), py::arg("threads") = 1,
+                 py::call_guard<py::gil_scoped_release>());
 
     main_module.attr("afd_verification") = fd_verification_module;
 }
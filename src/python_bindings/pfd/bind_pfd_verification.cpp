@@ -1,10 +1,17 @@
 #include "bind_pfd_verification.h"
 
+#include <utility>
+#include <vector>
+
+#include <boost/any.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include "algorithms/fd/pfd_verifier/pfd_verifier.h"
+#include "config/error_measure/type.h"
+#include "config/names.h"
 #include "py_util/bind_primitive.h"
+#include "py_util/py_to_any.h"
 
 namespace {
 namespace py = pybind11;
@@ -15,11 +22,28 @@ void BindPfdVerification(py::module_& main_module) {
     using namespace algos;
     auto pfd_verification_module = main_module.def_submodule("pfd_verification");
 
+    py::class_<PFDStats>(pfd_verification_module, "PFDStats")
+            .def_readonly("num_violating_clusters", &PFDStats::num_violating_clusters)
+            .def_readonly("num_violating_rows", &PFDStats::num_violating_rows)
+            .def_readonly("error", &PFDStats::error);
     BindPrimitiveNoBase<PFDVerifier>(pfd_verification_module, "PFDVerifier")
             .def("get_num_violating_clusters", &PFDVerifier::GetNumViolatingClusters)
             .def("get_num_violating_rows", &PFDVerifier::GetNumViolatingRows)
             .def("get_violating_clusters", &PFDVerifier::GetViolatingClusters)
-            .def("get_error", &PFDVerifier::GetError);
+            .def("get_error", &PFDVerifier::GetError)
+            .def(
+                    "verify_pfds",
+                    [](PFDVerifier const& verifier,
+                       std::vector<std::pair<config::IndicesType, config::IndicesType>> pfds,
+                       py::handle error_measure, config::ThreadNumType threads) {
+                        auto measure = boost::any_cast<config::PfdErrorMeasureType>(
+                                PyToAny(config::names::kPfdErrorMeasure,
+                                        typeid(config::PfdErrorMeasureType), error_measure));
+                        py::gil_scoped_release release;
+                        return verifier.VerifyPFDs(std::move(pfds), measure, threads);
+                    },
+                    py::arg("pfds"), py::arg("error_measure") = "per_tuple",
+                    py::arg("threads") = 1);
     main_module.attr("pfd_verification") = pfd_verification_module;
 }
 }  // namespace python_bindings
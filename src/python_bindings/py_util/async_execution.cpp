@@ -0,0 +1,87 @@
+#include "async_execution.h"
+
+#include <chrono>
+
+namespace python_bindings {
+
+namespace py = pybind11;
+
+AsyncExecution::AsyncExecution(py::object algorithm_obj, bool hold_gil)
+    : algorithm_obj_(std::move(algorithm_obj)),
+      algorithm_(algorithm_obj_.cast<algos::Algorithm&>()) {
+    thread_ = std::thread([&algorithm = algorithm_, state = state_, hold_gil]() {
+        std::exception_ptr error;
+        try {
+            if (hold_gil) {
+                py::gil_scoped_acquire acquire;
+                algorithm.Execute();
+            } else {
+                algorithm.Execute();
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard lock(state->mutex);
+            // Cancel may have been called after Execute had returned, then the request is still
+            // set and would make the next call on the algorithm throw.
+            algorithm.ClearCancelRequest();
+            state->error = std::move(error);
+            state->done = true;
+        }
+        state->done_var.notify_all();
+    });
+}
+
+AsyncExecution::~AsyncExecution() {
+    Cancel();
+    py::gil_scoped_release release;
+    thread_.join();
+}
+
+void AsyncExecution::Cancel() noexcept {
+    std::lock_guard lock(state_->mutex);
+    if (!state_->done) algorithm_.Cancel();
+}
+
+bool AsyncExecution::Done() const {
+    std::lock_guard lock(state_->mutex);
+    return state_->done;
+}
+
+bool AsyncExecution::Wait(std::optional<double> timeout_seconds) {
+    using Clock = std::chrono::steady_clock;
+    // Python signal handlers, e.g. the one raising KeyboardInterrupt, only run in the main thread
+    // with the GIL held, so the wait is split into short intervals.
+    constexpr std::chrono::milliseconds kSignalCheckInterval{100};
+    std::optional<Clock::time_point> deadline;
+    if (timeout_seconds.has_value()) {
+        deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                          std::chrono::duration<double>(*timeout_seconds));
+    }
+    while (true) {
+        {
+            py::gil_scoped_release release;
+            std::unique_lock lock(state_->mutex);
+            Clock::time_point wake_up = Clock::now() + kSignalCheckInterval;
+            if (deadline.has_value() && *deadline < wake_up) wake_up = *deadline;
+            if (state_->done_var.wait_until(lock, wake_up, [this]() { return state_->done; })) {
+                return true;
+            }
+        }
+        if (PyErr_CheckSignals() != 0) throw py::error_already_set();
+        if (deadline.has_value() && Clock::now() >= *deadline) return false;
+    }
+}
+
+void AsyncExecution::Result() {
+    Wait(std::nullopt);
+    std::exception_ptr error;
+    {
+        std::lock_guard lock(state_->mutex);
+        error = state_->error;
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace python_bindings
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include <pybind11/pybind11.h>
+
+#include "algorithms/algorithm.h"
+
+namespace python_bindings {
+
+// Runs Algorithm::Execute on a separate thread, so that Python code can wait for it, poll its
+// progress or cancel it. Until the execution is done, the algorithm must not be used otherwise.
+// Destroying the handle cancels the execution if it is still running and waits for it to stop.
+class AsyncExecution {
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done_var;
+        bool done = false;
+        std::exception_ptr error;
+    };
+
+    // Keeps the algorithm alive while it is being executed.
+    pybind11::object algorithm_obj_;
+    algos::Algorithm& algorithm_;
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+    std::thread thread_;
+
+public:
+    // If hold_gil is true, the execution holds the GIL, which is needed by algorithms that call
+    // Python code.
+    AsyncExecution(pybind11::object algorithm_obj, bool hold_gil);
+    AsyncExecution(AsyncExecution const&) = delete;
+    AsyncExecution& operator=(AsyncExecution const&) = delete;
+    ~AsyncExecution();
+
+    [[nodiscard]] bool Done() const;
+    // Returns whether the execution is done. Can be interrupted with a signal.
+    bool Wait(std::optional<double> timeout_seconds);
+    // Waits for the execution and rethrows the exception it ended with, if any.
+    void Result();
+
+    // Does nothing if the execution is done.
+    void Cancel() noexcept;
+
+    [[nodiscard]] std::pair<uint8_t, double> GetProgress() const noexcept {
+        return algorithm_.GetProgress();
+    }
+};
+
+}  // namespace python_bindings
@@ -1,6 +1,15 @@
 #include "dataframe_reader.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -15,7 +24,11 @@ namespace python_bindings {
 
 namespace py = pybind11;
 
-static std::vector<std::string> GetColumnNames(py::handle dataframe) {
+namespace {
+
+using Cells = std::vector<std::string>;
+
+std::vector<std::string> GetColumnNames(py::handle dataframe) {
     std::vector<std::string> names;
     py::list name_lst = dataframe.attr("columns").attr("to_list")();
     for (py::handle element : name_lst) {
@@ -24,48 +37,401 @@ static std::vector<std::string> GetColumnNames(py::handle dataframe) {
     return names;
 }
 
-DataframeReaderBase::DataframeReaderBase(py::handle dataframe, std::string name)
-    : dataframe_(py::reinterpret_borrow<py::object>(dataframe)),
-      df_iter_(dataframe_.attr("itertuples")(false, py::none{})),
-      name_(std::move(name)),
-      column_names_(GetColumnNames(dataframe_)) {}
+py::buffer_info RequestBuffer(py::handle object) {
+    return py::reinterpret_borrow<py::buffer>(object).request();
+}
+
+// Same as Python's float repr: the shortest string that converts back to the same value, in
+// positional notation if the decimal exponent is in [-4, 16) and in scientific notation otherwise.
+std::string FormatDouble(double value) {
+    if (std::isnan(value)) return "nan";
+    if (std::isinf(value)) return value > 0 ? "inf" : "-inf";
+
+    char buf[32];
+    char const* end = std::to_chars(buf, std::end(buf), value, std::chars_format::scientific).ptr;
+    std::string_view repr(buf, end - buf);
+    std::string result;
+    if (repr.front() == '-') {
+        result += '-';
+        repr.remove_prefix(1);
+    }
+    std::size_t const exponent_pos = repr.find('e');
+    std::string digits(1, repr.front());
+    if (exponent_pos > 1) digits.append(repr.substr(2, exponent_pos - 2));
+    int const exponent = std::atoi(std::string(repr.substr(exponent_pos + 1)).c_str());
+
+    if (exponent < -4 || exponent >= 16) {
+        result += digits.front();
+        if (digits.size() > 1) {
+            result += '.';
+            result.append(digits, 1);
+        }
+        std::string exponent_digits = std::to_string(std::abs(exponent));
+        if (exponent_digits.size() < 2) exponent_digits.insert(0, 1, '0');
+        result += exponent < 0 ? "e-" : "e+";
+        result += exponent_digits;
+    } else if (exponent < 0) {
+        result += "0.";
+        result.append(-exponent - 1, '0');
+        result += digits;
+    } else if (digits.size() <= static_cast<std::size_t>(exponent) + 1) {
+        result += digits;
+        result.append(exponent + 1 - digits.size(), '0');
+        result += ".0";
+    } else {
+        result.append(digits, 0, exponent + 1);
+        result += '.';
+        result.append(digits, exponent + 1);
+    }
+    return result;
+}
 
-void DataframeReaderBase::Reset() {
-    df_iter_ = dataframe_.attr("itertuples")(false, py::none{});
+std::int64_t FloorDiv(std::int64_t value, std::int64_t divisor) {
+    std::int64_t quotient = value / divisor;
+    if (value % divisor < 0) --quotient;
+    return quotient;
 }
 
-std::string DataframeReaderBase::GetRelationName() const {
-    return name_;
+// Same as str of pandas.Timestamp: "YYYY-MM-DD HH:MM:SS" followed by microseconds or, if there
+// are any, nanoseconds.
+std::string FormatTimestamp(std::int64_t nanoseconds) {
+    constexpr std::int64_t kNanosecondsInSecond = 1'000'000'000;
+    constexpr std::int64_t kSecondsInDay = 86'400;
+    std::int64_t const seconds = FloorDiv(nanoseconds, kNanosecondsInSecond);
+    std::int64_t const fraction = nanoseconds - seconds * kNanosecondsInSecond;
+    std::int64_t days = FloorDiv(seconds, kSecondsInDay);
+    std::int64_t const day_seconds = seconds - days * kSecondsInDay;
+
+    // Proleptic Gregorian date of a day number, counting from 0000-03-01 in 400-year eras.
+    days += 719'468;
+    std::int64_t const era = FloorDiv(days, 146'097);
+    std::int64_t const day_of_era = days - era * 146'097;
+    std::int64_t const year_of_era =
+            (day_of_era - day_of_era / 1460 + day_of_era / 36'524 - day_of_era / 146'096) / 365;
+    std::int64_t const day_of_year =
+            day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    std::int64_t const shifted_month = (5 * day_of_year + 2) / 153;
+    std::int64_t const day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+    std::int64_t const month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+    std::int64_t const year = year_of_era + era * 400 + (month <= 2);
+
+    char buf[64];
+    int length = std::snprintf(buf, sizeof(buf), "%04lld-%02lld-%02lld %02lld:%02lld:%02lld",
+                               static_cast<long long>(year), static_cast<long long>(month),
+                               static_cast<long long>(day),
+                               static_cast<long long>(day_seconds / 3600),
+                               static_cast<long long>(day_seconds / 60 % 60),
+                               static_cast<long long>(day_seconds % 60));
+    if (fraction % 1000 != 0) {
+        length += std::snprintf(buf + length, sizeof(buf) - length, ".%09lld",
+                                static_cast<long long>(fraction));
+    } else if (fraction != 0) {
+        length += std::snprintf(buf + length, sizeof(buf) - length, ".%06lld",
+                                static_cast<long long>(fraction / 1000));
+    }
+    return {buf, static_cast<std::size_t>(length)};
 }
 
-std::string DataframeReaderBase::GetColumnName(size_t index) const {
-    return column_names_.at(index);
+bool IsNull(py::buffer_info const& nulls, std::size_t index) {
+    return static_cast<char const*>(nulls.ptr)[index * nulls.strides[0]] != 0;
 }
 
-size_t DataframeReaderBase::GetNumberOfColumns() const {
-    return column_names_.size();
+template <typename T, typename Format>
+void FormatValues(py::buffer_info const& values, py::buffer_info const& nulls, Cells& cells,
+                  Format format) {
+    char const* const data = static_cast<char const*>(values.ptr);
+    py::gil_scoped_release release;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        if (IsNull(nulls, i)) {
+            cells[i] = model::Null::kValue;
+            continue;
+        }
+        T value;
+        std::memcpy(&value, data + i * values.strides[0], sizeof(T));
+        cells[i] = format(value);
+    }
 }
 
-bool DataframeReaderBase::HasNextRow() const {
-    return df_iter_ != py::iterator::sentinel();
+template <typename T>
+void FormatIntegers(py::buffer_info const& values, py::buffer_info const& nulls, Cells& cells) {
+    FormatValues<T>(values, nulls, cells, [](T value) { return std::to_string(value); });
 }
 
-std::vector<std::string> StringDataframeReader::GetNextRow() {
-    return py::cast<std::vector<std::string>>(*df_iter_++);
+bool IsArrowDtype(py::handle dtype) {
+    py::module const pandas = py::module::import("pandas");
+    return py::hasattr(pandas, "ArrowDtype") && py::isinstance(dtype, pandas.attr("ArrowDtype"));
+}
+
+// Reads a column of a numeric or boolean dtype, nullable extension dtypes included: their null
+// values are replaced with zeros of the column's type, which are never looked at.
+bool ReadNumbers(py::handle series, py::buffer_info const& nulls, Cells& cells) {
+    py::object dtype = series.attr("dtype");
+    py::object array;
+    // Masked dtypes (Int64, Float32, boolean, ...) yield NumPy scalars when iterated over, the
+    // others yield Python objects. They are only formatted differently for float32 values.
+    bool numpy_scalars = false;
+    if (py::hasattr(dtype, "numpy_dtype")) {
+        py::object numpy_dtype = dtype.attr("numpy_dtype");
+        array = series.attr("to_numpy")(py::arg("dtype") = numpy_dtype,
+                                        py::arg("na_value") = numpy_dtype.attr("type")(0));
+        numpy_scalars = !IsArrowDtype(dtype);
+    } else {
+        array = series.attr("to_numpy")();
+    }
+    py::buffer_info values = RequestBuffer(array);
+    if (values.ndim != 1 || static_cast<std::size_t>(values.size) != cells.size()) return false;
+
+    char const kind = py::str(array.attr("dtype").attr("kind")).cast<std::string>().front();
+    switch (kind) {
+        case 'b':
+            FormatValues<bool>(values, nulls, cells,
+                               [](bool value) { return value ? "True" : "False"; });
+            return true;
+        case 'f':
+            if (values.itemsize == sizeof(double)) {
+                FormatValues<double>(values, nulls, cells, FormatDouble);
+                return true;
+            } else if (values.itemsize == sizeof(float) && !numpy_scalars) {
+                FormatValues<float>(values, nulls, cells, FormatDouble);
+                return true;
+            }
+            return false;
+        case 'i':
+            switch (values.itemsize) {
+                case 1:
+                    FormatIntegers<std::int8_t>(values, nulls, cells);
+                    return true;
+                case 2:
+                    FormatIntegers<std::int16_t>(values, nulls, cells);
+                    return true;
+                case 4:
+                    FormatIntegers<std::int32_t>(values, nulls, cells);
+                    return true;
+                case 8:
+                    FormatIntegers<std::int64_t>(values, nulls, cells);
+                    return true;
+            }
+            return false;
+        case 'u':
+            switch (values.itemsize) {
+                case 1:
+                    FormatIntegers<std::uint8_t>(values, nulls, cells);
+                    return true;
+                case 2:
+                    FormatIntegers<std::uint16_t>(values, nulls, cells);
+                    return true;
+                case 4:
+                    FormatIntegers<std::uint32_t>(values, nulls, cells);
+                    return true;
+                case 8:
+                    FormatIntegers<std::uint64_t>(values, nulls, cells);
+                    return true;
+            }
+            return false;
+    }
+    return false;
+}
+
+bool ReadTimestamps(py::handle series, py::buffer_info const& nulls, Cells& cells) {
+    py::object array = series.attr("to_numpy")().attr("view")("int64");
+    py::buffer_info values = RequestBuffer(array);
+    if (values.ndim != 1 || static_cast<std::size_t>(values.size) != cells.size()) return false;
+    FormatValues<std::int64_t>(values, nulls, cells, FormatTimestamp);
+    return true;
+}
+
+// StringDtype with a pyarrow storage or ArrowDtype of an Arrow string type. Every ArrowDtype has
+// the "pyarrow" storage, so that alone does not tell string columns from the others.
+bool IsArrowString(py::handle dtype) {
+    py::module const pandas = py::module::import("pandas");
+    if (py::isinstance(dtype, pandas.attr("StringDtype"))) {
+        return dtype.attr("storage").cast<std::string>().rfind("pyarrow", 0) == 0;
+    }
+    if (IsArrowDtype(dtype)) {
+        py::module const types = py::module::import("pyarrow.types");
+        py::object const type = dtype.attr("pyarrow_dtype");
+        return types.attr("is_string")(type).cast<bool>() ||
+               types.attr("is_large_string")(type).cast<bool>();
+    }
+    return false;
+}
+
+// An Arrow string array: validity bitmap, offsets of the values and their UTF-8 data.
+struct ArrowStringChunk {
+    std::size_t offset;
+    std::size_t length;
+    bool large_offsets;
+    py::buffer_info offsets;
+    char const* data;
+};
+
+template <typename Offset>
+std::string_view GetArrowString(ArrowStringChunk const& chunk, std::size_t index) {
+    Offset bounds[2];
+    std::memcpy(bounds, static_cast<char const*>(chunk.offsets.ptr) + index * sizeof(Offset),
+                sizeof(bounds));
+    return {chunk.data + bounds[0], static_cast<std::size_t>(bounds[1] - bounds[0])};
+}
+
+bool ReadArrowStrings(py::handle series, py::buffer_info const& nulls, Cells& cells) {
+    py::module const types = py::module::import("pyarrow.types");
+    py::object arrow_array = series.attr("array").attr("__arrow_array__")();
+    py::list arrays;
+    if (py::hasattr(arrow_array, "chunks")) {
+        arrays = arrow_array.attr("chunks").cast<py::list>();
+    } else {
+        arrays.append(arrow_array);
+    }
+
+    std::vector<ArrowStringChunk> chunks;
+    std::vector<py::buffer_info> data_buffers;
+    std::size_t total_length = 0;
+    for (py::handle array : arrays) {
+        py::object const type = array.attr("type");
+        bool const large_offsets = types.attr("is_large_string")(type).cast<bool>();
+        if (!large_offsets && !types.attr("is_string")(type).cast<bool>()) return false;
+        py::list buffers = array.attr("buffers")();
+        ArrowStringChunk& chunk = chunks.emplace_back();
+        chunk.offset = array.attr("offset").cast<std::size_t>();
+        chunk.length = py::len(array);
+        chunk.large_offsets = large_offsets;
+        chunk.offsets = RequestBuffer(buffers[1]);
+        chunk.data = nullptr;
+        if (!buffers[2].is_none()) {
+            chunk.data = static_cast<char const*>(
+                    data_buffers.emplace_back(RequestBuffer(buffers[2])).ptr);
+        }
+        total_length += chunk.length;
+    }
+    if (total_length != cells.size()) return false;
+
+    py::gil_scoped_release release;
+    std::size_t cell_index = 0;
+    for (ArrowStringChunk const& chunk : chunks) {
+        for (std::size_t i = chunk.offset; i < chunk.offset + chunk.length; ++i, ++cell_index) {
+            if (IsNull(nulls, cell_index)) {
+                cells[cell_index] = model::Null::kValue;
+            } else if (chunk.large_offsets) {
+                cells[cell_index] = GetArrowString<std::int64_t>(chunk, i);
+            } else {
+                cells[cell_index] = GetArrowString<std::int32_t>(chunk, i);
+            }
+        }
+    }
+    return true;
 }
 
-std::vector<std::string> ArbitraryDataframeReader::GetNextRow() {
-    std::vector<std::string> strings{};
-    auto tuple_row = py::reinterpret_borrow<py::object>(*df_iter_);
-    ++df_iter_;
-    for (py::handle el : tuple_row) {
+// Columns of any other dtype are converted to a list of the objects iterating over them yields
+// (`tolist` would turn NumPy scalars into Python objects, which `str` may format differently).
+// Strings are copied from their UTF-8 representation, other objects are converted with `str`.
+void ReadObjects(py::handle series, py::buffer_info const& nulls, Cells& cells) {
+    py::list objects(py::reinterpret_borrow<py::object>(series));
+    for (std::size_t i = 0; i < cells.size(); ++i) {
         // When reading from .csv files, pandas treats some values as nulls,
         // and empty values are among those values, which may cause some
         // confusion here, since in Desbordante only the literal "NULL" string
         // is interpreted as the null value.
-        strings.emplace_back(is_null_(el) ? model::Null::kValue : py::str(el));
+        if (IsNull(nulls, i)) {
+            cells[i] = model::Null::kValue;
+            continue;
+        }
+        PyObject* object = PyList_GET_ITEM(objects.ptr(), i);
+        if (PyUnicode_CheckExact(object)) {
+            Py_ssize_t size;
+            char const* utf8 = PyUnicode_AsUTF8AndSize(object, &size);
+            if (utf8 == nullptr) throw py::error_already_set();
+            cells[i].assign(utf8, size);
+        } else {
+            cells[i] = py::str(py::handle(object)).cast<std::string>();
+        }
+    }
+}
+
+void ReadColumn(py::handle series, Cells& cells) {
+    py::object null_array = series.attr("isna")().attr("to_numpy")(py::arg("dtype") = "bool");
+    py::buffer_info nulls = RequestBuffer(null_array);
+
+    py::object dtype = series.attr("dtype");
+    char const kind = py::str(dtype.attr("kind")).cast<std::string>().front();
+    bool read;
+    if (IsArrowString(dtype)) {
+        read = ReadArrowStrings(series, nulls, cells);
+    } else if (kind == 'b' || kind == 'i' || kind == 'u' || kind == 'f') {
+        read = ReadNumbers(series, nulls, cells);
+    } else if (py::str(dtype).cast<std::string>() == "datetime64[ns]") {
+        read = ReadTimestamps(series, nulls, cells);
+    } else {
+        read = false;
+    }
+    if (!read) ReadObjects(series, nulls, cells);
+}
+
+}  // namespace
+
+DataframeReader::DataframeReader(py::handle dataframe, std::string name)
+    : dataframe_(py::reinterpret_borrow<py::object>(dataframe)),
+      name_(std::move(name)),
+      column_names_(GetColumnNames(dataframe_)),
+      rows_number_(py::len(dataframe_)) {
+    for (py::handle item : dataframe_.attr("items")()) {
+        series_.push_back(item.cast<py::tuple>()[1]);
     }
-    return strings;
+    columns_.resize(series_.size());
+}
+
+DataframeReader::~DataframeReader() {
+    py::gil_scoped_acquire acquire;
+    series_.clear();
+    dataframe_ = py::object();
+}
+
+void DataframeReader::ReadBlock(std::size_t begin) {
+    // Algorithms load data with the GIL released.
+    py::gil_scoped_acquire acquire;
+    block_begin_ = begin;
+    block_size_ = std::min(kBlockRows, rows_number_ - begin);
+    py::slice const rows(static_cast<py::ssize_t>(begin),
+                         static_cast<py::ssize_t>(begin + block_size_), 1);
+    for (std::size_t i = 0; i < series_.size(); ++i) {
+        py::object const block = series_[i].attr("iloc")[rows];
+        columns_[i].assign(block_size_, std::string());
+        ReadColumn(block, columns_[i]);
+    }
+}
+
+std::vector<std::string> DataframeReader::GetNextRow() {
+    if (next_row_ == block_begin_ + block_size_) ReadBlock(next_row_);
+    std::size_t const index = next_row_ - block_begin_;
+    std::vector<std::string> row;
+    row.reserve(columns_.size());
+    for (Cells& column : columns_) {
+        row.push_back(std::move(column[index]));
+    }
+    ++next_row_;
+    return row;
+}
+
+void DataframeReader::Reset() {
+    // The cells of the current block may have been moved out already.
+    next_row_ = 0;
+    block_begin_ = 0;
+    block_size_ = 0;
+}
+
+std::string DataframeReader::GetRelationName() const {
+    return name_;
+}
+
+std::string DataframeReader::GetColumnName(size_t index) const {
+    return column_names_.at(index);
+}
+
+size_t DataframeReader::GetNumberOfColumns() const {
+    return column_names_.size();
+}
+
+bool DataframeReader::HasNextRow() const {
+    return next_row_ < rows_number_;
 }
 
 }  // namespace python_bindings
@@ -1,21 +1,52 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 #include <pybind11/pybind11.h>
 
 #include "model/table/idataset_stream.h"
 
 namespace python_bindings {
 
-class DataframeReaderBase : public model::IDatasetStream {
-protected:
+// Reads a pandas DataFrame column by column instead of iterating over its rows from Python.
+// Columns of numeric, boolean and datetime64[ns] dtypes are read from their NumPy buffers and
+// Arrow-backed string columns from their Arrow buffers, the values are formatted in C++ with the
+// GIL released. Which values are null is found out with one `isna` call per column, because pandas
+// uses several Python objects as its null value. Cells of object columns are only converted
+// through Python if they are not str objects.
+// Values are formatted the same way `str` formats the values pandas yields for them when iterating
+// over the DataFrame, null values are replaced with Desbordante's null value.
+// The DataFrame is read in blocks of kBlockRows rows, so only one block of the table is kept as
+// strings at a time.
+class DataframeReader final : public model::IDatasetStream {
+public:
+    static constexpr std::size_t kBlockRows = 1 << 14;
+
+private:
     pybind11::object dataframe_;
-    pybind11::iterator df_iter_;
     std::string name_;
     std::vector<std::string> column_names_;
+    std::size_t rows_number_;
+    // Columns of the DataFrame as Series, blocks are read from their slices.
+    std::vector<pybind11::object> series_;
+    // Cells of the rows [block_begin_, block_begin_ + block_size_), GetNextRow moves them out.
+    std::vector<std::vector<std::string>> columns_;
+    std::size_t block_begin_ = 0;
+    std::size_t block_size_ = 0;
+    std::size_t next_row_ = 0;
+
+    void ReadBlock(std::size_t begin);
 
 public:
-    explicit DataframeReaderBase(pybind11::handle dataframe, std::string name = "Pandas dataframe");
+    explicit DataframeReader(pybind11::handle dataframe, std::string name = "Pandas dataframe");
+    DataframeReader(DataframeReader const&) = delete;
+    DataframeReader& operator=(DataframeReader const&) = delete;
+    // Takes the GIL: readers may be destroyed by algorithms running without it.
+    ~DataframeReader() override;
 
+    [[nodiscard]] std::vector<std::string> GetNextRow() final;
     void Reset() final;
     [[nodiscard]] std::string GetRelationName() const final;
     [[nodiscard]] std::string GetColumnName(size_t index) const final;
@@ -23,38 +54,4 @@ public:
     [[nodiscard]] bool HasNextRow() const final;
 };
 
-// If a DataFrame only consists of Python strings, then there is no need to get
-// string representations of every value, and we can get away with the normal
-// pybind11's conversions, which speeds up the reading process.
-class StringDataframeReader final : public DataframeReaderBase {
-public:
-    using DataframeReaderBase::DataframeReaderBase;
-
-    std::vector<std::string> GetNextRow() final;
-};
-
-// If a dataframe consists of arbitrary Python objects, we have to first check
-// for nullity and switch it out for Desbordante's null value if it is null.
-// Pandas uses several Python objects for its null value representation, so the
-// most robust way to check for a DataFrame's value nullity is to use the
-// `pandas.isna` function.
-// If the value is not null, then we have to convert it to std::string, which
-// involves converting it to a Python str first.
-class ArbitraryDataframeReader final : public DataframeReaderBase {
-private:
-    // Used in GetNextRow to check arbitrary dataframe values for nullity.
-    // Statically storing this may cause problems with garbage collection, but
-    // importing a module on every call may cause performance problems, and
-    // storing it as a field is a compromise, which is used here.
-    std::function<bool(pybind11::handle)> is_null_ =
-            [check_null = pybind11::module_::import("pandas").attr("isna")](pybind11::handle obj) {
-                return check_null(obj).cast<bool>();
-            };
-
-public:
-    using DataframeReaderBase::DataframeReaderBase;
-
-    [[nodiscard]] std::vector<std::string> GetNextRow() final;
-};
-
 }  // namespace python_bindings
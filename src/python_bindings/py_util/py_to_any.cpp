@@ -17,6 +17,7 @@
 #include "config/exceptions.h"
 #include "config/tabular_data/input_table_type.h"
 #include "config/tabular_data/input_tables_type.h"
+#include "model/table/relation_session.h"
 #include "parser/csv_parser/csv_parser.h"
 #include "py_util/create_dataframe_reader.h"
 #include "util/enum_to_available_values.h"
@@ -49,6 +50,9 @@ config::InputTable CreateCsvParser(std::string_view option_name, py::tuple const
 }
 
 config::InputTable PythonObjToInputTable(std::string_view option_name, py::handle obj) {
+    if (py::isinstance<model::RelationSession>(obj)) {
+        return py::cast<std::shared_ptr<model::RelationSession>>(obj)->Attach();
+    }
     if (py::isinstance<py::tuple>(obj)) {
         return CreateCsvParser(option_name, py::cast<py::tuple>(obj));
     }
@@ -3,6 +3,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "algorithms/statistics/column_summary.h"
 #include "algorithms/statistics/data_stats.h"
 #include "py_util/bind_primitive.h"
 
@@ -62,6 +63,40 @@ void BindStatistics(pybind11::module_& main_module) {
 
     auto statistics_module = main_module.def_submodule("statistics");
 
+    py::class_<ColumnSummary>(statistics_module, "ColumnSummary")
+            .def(py::init<>())
+            .def("merge", &ColumnSummary::Merge,
+                 "Adds the values summarized by another summary of the same column.",
+                 py::arg("other"))
+            .def("serialize",
+                 [](ColumnSummary const& summary) { return py::bytes(summary.Serialize()); })
+            .def_static(
+                    "deserialize",
+                    [](py::bytes const& data) { return ColumnSummary::Deserialize(data); },
+                    py::arg("data"))
+            .def_property_readonly("num_rows", &ColumnSummary::GetNumRows)
+            .def_property_readonly("num_nulls", &ColumnSummary::GetNumNulls)
+            .def_property_readonly("num_empties", &ColumnSummary::GetNumEmpties)
+            .def_property_readonly("count", &ColumnSummary::GetCount)
+            .def_property_readonly("num_numbers", &ColumnSummary::GetNumNumbers)
+            .def_property_readonly("num_zeros", &ColumnSummary::GetNumZeros)
+            .def_property_readonly("num_negatives", &ColumnSummary::GetNumNegatives)
+            .def_property_readonly("sum", &ColumnSummary::GetSum)
+            .def_property_readonly("sum_of_squares", &ColumnSummary::GetSumOfSquares)
+            .def_property_readonly("average", &ColumnSummary::GetAvg)
+            .def_property_readonly("corrected_std", &ColumnSummary::GetCorrectedSTD)
+            .def_property_readonly("skewness", &ColumnSummary::GetSkewness)
+            .def_property_readonly("kurtosis", &ColumnSummary::GetKurtosis)
+            .def_property_readonly("min_number", &ColumnSummary::GetMinNumber)
+            .def_property_readonly("max_number", &ColumnSummary::GetMaxNumber)
+            .def_property_readonly("min_string", &ColumnSummary::GetMinString)
+            .def_property_readonly("max_string", &ColumnSummary::GetMaxString)
+            .def_property_readonly("number_of_distinct", &ColumnSummary::GetDistinct)
+            .def_property_readonly("is_distinct_exact", &ColumnSummary::IsDistinctExact)
+            .def("get_quantile", &ColumnSummary::GetQuantile,
+                 "Returns quantile of the numbers in the column, approximate for large columns.",
+                 py::arg("part"));
+
     BindPrimitiveNoBase<DataStats>(statistics_module, "DataStats")
             .def("get_all_statistics_as_string", &DataStats::ToString)
             .def("get_number_of_values", &DataStats::NumberOfValues,
@@ -166,6 +201,10 @@ void BindStatistics(pybind11::module_& main_module) {
                  "Returns the amount of entirely lowercase words in a column.", py::arg("index"))
             .def("get_number_of_entirely_uppercase_words",
                  &DataStats::GetNumberOfEntirelyUppercaseWords,
-                 "Returns the amount of entirely uppercase words in a column.", py::arg("index"));
+                 "Returns the amount of entirely uppercase words in a column.", py::arg("index"))
+            .def("get_summary", &DataStats::GetSummary,
+                 "Returns mergeable summary of the column.", py::arg("index"))
+            .def("get_summaries", &DataStats::GetSummaries,
+                 "Returns mergeable summaries of all columns.");
 }
 }  // namespace python_bindings
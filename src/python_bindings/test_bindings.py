@@ -1,9 +1,17 @@
+import os
+import tempfile
 import unittest
 from collections import namedtuple
 from itertools import chain
 
 import desbordante as desb
 
+try:
+    import pandas
+    import pyarrow
+except ImportError:
+    pandas = pyarrow = None
+
 OptionContainer = namedtuple("OptionContainer", ['path', 'load_options', 'execute_options'])
 FailureCaseContainer = namedtuple("FailureCaseContainer", ['path', 'options'])
 
@@ -191,8 +199,171 @@ class TestPythonBindings(unittest.TestCase):
             with self.subTest(msg=f"metric_verifier_load: {load}"):
                 with self.assertRaises(desb.ConfigurationError):
                     check_metric_verifier_failure(load.path, load.options)
+
+    def test_async_execution(self):
+        algo = desb.fd.algorithms.HyFD()
+        algo.load_data(table=("WDC_satellites.csv", ",", True))
+        algo.execute()
+        fds = set(map(str, algo.get_fds()))
+
+        execution = algo.execute_async()
+        execution.result()
+        self.assertTrue(execution.done())
+        self.assertEqual(fds, set(map(str, algo.get_fds())))
+
+        algo.cancel()
+        execution = algo.execute_async()
+        with self.assertRaises(desb.ExecutionCancelled):
+            execution.result()
+
+    def test_dropped_async_execution(self):
+        algo = desb.fd.algorithms.HyFD()
+        algo.load_data(table=("WDC_satellites.csv", ",", True))
+        execution = algo.execute_async()
+        execution.result()
+        execution.cancel()
+        del execution
+
+        execution = algo.execute_async()
+        execution.wait()
+        del execution
+        # Neither dropping a finished handle nor cancelling it may cancel the next execution.
+        algo.execute()
+        self.assertTrue(algo.get_fds())
+
+    def test_batch_fd_verification(self):
+        fds = [([0], [1]), ([1, 0], [2]), ([2], [0, 1])]
+        algo = desb.fd_verification.algorithms.FDVerifier()
+        algo.load_data(table=("WDC_satellites.csv", ",", True))
+        stats = algo.verify_fds(fds, threads=2)
+        self.assertEqual(len(stats), len(fds))
+        for (lhs, rhs), fd_stats in zip(fds, stats):
+            algo.execute(lhs_indices=lhs, rhs_indices=rhs)
+            self.assertEqual(fd_stats.holds, algo.fd_holds())
+            self.assertEqual(fd_stats.num_error_rows, algo.get_num_error_rows())
+            self.assertAlmostEqual(fd_stats.error, algo.get_error())
+
+    def test_batch_ucc_verification(self):
+        uccs = [[0], [1, 0], [0, 1, 2], [3, 2]]
+        algo = desb.ucc_verification.algorithms.UccVerifier()
+        algo.load_data(table=("WDC_satellites.csv", ",", True))
+        stats = algo.verify_uccs(uccs, threads=2)
+        self.assertEqual(len(stats), len(uccs))
+        for ucc, ucc_stats in zip(uccs, stats):
+            algo.execute(ucc_indices=ucc)
+            self.assertEqual(ucc_stats.holds, algo.ucc_holds())
+            self.assertEqual(algo.is_unique(ucc, threads=2), algo.ucc_holds())
+            self.assertEqual(ucc_stats.num_rows_violating_ucc, algo.get_num_rows_violating_ucc())
+            self.assertAlmostEqual(ucc_stats.error, algo.get_error())
                 
 
 
+@unittest.skipIf(pandas is None, "reading DataFrames is tested with pandas and pyarrow")
+class TestDataFrameReading(unittest.TestCase):
+
+    @staticmethod
+    def _get_fds(table):
+        algo = desb.fd.algorithms.HyFD()
+        algo.load_data(table=table)
+        algo.execute()
+        return set(map(str, algo.get_fds()))
+
+    @staticmethod
+    def _get_data_stats(table):
+        algo = desb.statistics.algorithms.DataStats()
+        algo.load_data(table=table)
+        algo.execute()
+        return algo
+
+    @staticmethod
+    def _write_csv(df, directory):
+        # Before columns were read from their buffers, cells were formatted with str while
+        # iterating over the rows, and null cells were replaced with "NULL".
+        rows = [["NULL" if pandas.isna(value) else str(value) for value in row]
+                for row in df.itertuples(index=False)]
+        path = os.path.join(directory, "dataframe.csv")
+        with open(path, "w", encoding="utf-8") as file:
+            for row in [list(df.columns)] + rows:
+                file.write(",".join(row) + "\n")
+        return path, ",", True
+
+    def test_same_fds_as_from_file(self):
+        expected = self._get_fds(("WDC_satellites.csv", ",", True))
+        read = lambda **kwargs: pandas.read_csv("WDC_satellites.csv", na_filter=False, **kwargs)
+        dataframes = {
+            "object": read(),
+            "string[python]": read(dtype_backend="numpy_nullable"),
+            "string[pyarrow]": read(dtype="string[pyarrow]"),
+            "ArrowDtype": read(dtype_backend="pyarrow"),
+        }
+        for name, df in dataframes.items():
+            with self.subTest(dtype=name):
+                self.assertEqual(expected, self._get_fds(df))
+
+    def test_typed_and_nullable_columns(self):
+        # The second row is null in every column.
+        df = pandas.DataFrame({
+            "float64": [0.1, None, 1e20],
+            "float32": pandas.array([0.1, None, 2.5], dtype="float32"),
+            "Float32": pandas.array([0.1, None, 2.5], dtype="Float32"),
+            "Int64": pandas.array([7, None, -3], dtype="Int64"),
+            "UInt8": pandas.array([1, None, 255], dtype="UInt8"),
+            "boolean": pandas.array([True, None, False], dtype="boolean"),
+            "datetime": pandas.to_datetime(
+                ["2020-01-01 00:00:00.5", None, "1969-12-31"], format="ISO8601"),
+            "object": ["a", None, 3],
+            "string[pyarrow]": pandas.array(["ä", None, "b c"], dtype="string[pyarrow]"),
+            "int64[pyarrow]": pandas.array([7, None, -3], dtype="int64[pyarrow]"),
+            "double[pyarrow]": pandas.array([1e-5, None, 0.5], dtype="double[pyarrow]"),
+            "bool[pyarrow]": pandas.array([True, None, False], dtype="bool[pyarrow]"),
+            "string[pyarrow] (ArrowDtype)": pandas.array(
+                ["ä", None, "b c"], dtype=pandas.ArrowDtype(pyarrow.string())),
+            "large_string[pyarrow]": pandas.array(
+                ["ä", None, "b c"], dtype=pandas.ArrowDtype(pyarrow.large_string())),
+        })
+        with tempfile.TemporaryDirectory() as directory:
+            expected = self._get_data_stats(self._write_csv(df, directory))
+        actual = self._get_data_stats(df)
+
+        columns_number = len(df.columns)
+        self.assertEqual(list(range(columns_number)), actual.get_columns_with_null())
+        self.assertEqual(expected.show_sample(1, len(df), 1, columns_number),
+                         actual.show_sample(1, len(df), 1, columns_number))
+        for index, name in enumerate(df.columns):
+            with self.subTest(column=name):
+                self.assertEqual(1, actual.get_num_nulls(index))
+                self.assertEqual(expected.get_number_of_distinct(index),
+                                 actual.get_number_of_distinct(index))
+                self.assertEqual(expected.get_min(index), actual.get_min(index))
+                self.assertEqual(expected.get_max(index), actual.get_max(index))
+
+    def test_several_blocks_of_rows(self):
+        # The reader formats 2^14 rows at a time, the Arrow column has chunks that end inside blocks.
+        rows_number = 3 * (1 << 14) + 5
+        strings = [None if i % 7 == 0 else f"s{i % 1000}" for i in range(rows_number)]
+        chunked = pyarrow.chunked_array([pyarrow.array(strings[:20000]),
+                                         pyarrow.array(strings[20000:])])
+        df = pandas.DataFrame({
+            "chunked string[pyarrow]": pandas.Series(pandas.arrays.ArrowExtensionArray(chunked)),
+            "Int64": pandas.array([None if i % 3 == 0 else i % 500 for i in range(rows_number)],
+                                  dtype="Int64"),
+            "float64": [i % 250 / 8 for i in range(rows_number)],
+            "object": [i % 10 if i % 2 else f"o{i % 20}" for i in range(rows_number)],
+        })
+        with tempfile.TemporaryDirectory() as directory:
+            path = self._write_csv(df, directory)
+            expected_fds = self._get_fds(path)
+            expected = self._get_data_stats(path)
+        self.assertEqual(expected_fds, self._get_fds(df))
+        actual = self._get_data_stats(df)
+        for index, name in enumerate(df.columns):
+            with self.subTest(column=name):
+                self.assertEqual(expected.get_num_nulls(index), actual.get_num_nulls(index))
+                self.assertEqual(expected.get_number_of_distinct(index),
+                                 actual.get_number_of_distinct(index))
+                self.assertEqual(expected.get_min(index), actual.get_min(index))
+                self.assertEqual(expected.get_max(index), actual.get_max(index))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -16,12 +16,21 @@ void BindUccVerification(pybind11::module_& main_module) {
 
     auto ucc_verification_module = main_module.def_submodule("ucc_verification");
 
+    py::class_<UCCStats>(ucc_verification_module, "UCCStats")
+            .def_readonly("holds", &UCCStats::holds)
+            .def_readonly("num_clusters_violating_ucc", &UCCStats::num_clusters_violating_ucc)
+            .def_readonly("num_rows_violating_ucc", &UCCStats::num_rows_violating_ucc)
+            .def_readonly("error", &UCCStats::error);
     BindPrimitiveNoBase<UCCVerifier>(ucc_verification_module, "UccVerifier")
             .def("ucc_holds", &UCCVerifier::UCCHolds)
             .def("get_num_clusters_violating_ucc", &UCCVerifier::GetNumClustersViolatingUCC)
             .def("get_num_rows_violating_ucc", &UCCVerifier::GetNumRowsViolatingUCC)
             .def("get_clusters_violating_ucc", &UCCVerifier::GetClustersViolatingUCC)
-            .def("get_error", &UCCVerifier::GetError);
+            .def("get_error", &UCCVerifier::GetError)
+            .def("is_unique", &UCCVerifier::IsUnique, py::arg("indices"), py::arg("threads") = 1,
+                 py::call_guard<py::gil_scoped_release>())
+            .def("verify_uccs", &UCCVerifier::VerifyUCCs, py::arg("uccs"), py::arg("threads") = 1,
+                 py::call_guard<py::gil_scoped_release>());
     main_module.attr("aucc_verification") = ucc_verification_module;
 }
 }  // namespace python_bindings
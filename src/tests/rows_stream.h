@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "model/table/idataset_stream.h"
+
+namespace tests {
+
+/// a table kept in memory, used to feed algorithms with parts of a dataset
+class RowsStream final : public model::IDatasetStream {
+private:
+    std::vector<std::string> column_names_;
+    std::vector<Row> rows_;
+    std::size_t next_row_ = 0;
+
+public:
+    RowsStream(std::vector<std::string> column_names, std::vector<Row> rows)
+        : column_names_(std::move(column_names)), rows_(std::move(rows)) {}
+
+    Row GetNextRow() final {
+        return rows_[next_row_++];
+    }
+
+    bool HasNextRow() const final {
+        return next_row_ < rows_.size();
+    }
+
+    std::size_t GetNumberOfColumns() const final {
+        return column_names_.size();
+    }
+
+    std::string GetColumnName(std::size_t index) const final {
+        return column_names_[index];
+    }
+
+    std::string GetRelationName() const final {
+        return "Rows";
+    }
+
+    void Reset() final {
+        next_row_ = 0;
+    }
+};
+
+/// column names of the stream
+inline std::vector<std::string> GetColumnNames(model::IDatasetStream const& stream) {
+    std::vector<std::string> column_names;
+    for (std::size_t i = 0; i != stream.GetNumberOfColumns(); ++i) {
+        column_names.push_back(stream.GetColumnName(i));
+    }
+    return column_names;
+}
+
+/// all remaining rows of the stream
+inline std::vector<model::IDatasetStream::Row> ReadRows(model::IDatasetStream& stream) {
+    std::vector<model::IDatasetStream::Row> rows;
+    while (stream.HasNextRow()) {
+        rows.push_back(stream.GetNextRow());
+    }
+    return rows;
+}
+
+}  // namespace tests
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace tests {
+
+/// a fresh directory under the system temporary directory, removed with all its contents on
+/// destruction, so that tests run in parallel or after a failed run do not see each other's files
+class TempDirectory {
+private:
+    std::filesystem::path path_;
+
+public:
+    explicit TempDirectory(std::string const& prefix) {
+        std::random_device random;
+        do {
+            path_ = std::filesystem::temp_directory_path() /
+                    (prefix + '_' + std::to_string(random()) + std::to_string(random()));
+        } while (!std::filesystem::create_directory(path_));
+    }
+
+    TempDirectory(TempDirectory const&) = delete;
+    TempDirectory& operator=(TempDirectory const&) = delete;
+
+    ~TempDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    std::filesystem::path const& GetPath() const noexcept {
+        return path_;
+    }
+};
+
+}  // namespace tests
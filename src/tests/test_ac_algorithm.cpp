@@ -1,3 +1,7 @@
+#include <map>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "algorithms/algebraic_constraints/ac_algorithm.h"
@@ -5,6 +9,8 @@
 #include "algorithms/algo_factory.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
+#include "test_threads_util.h"
 #include "types.h"
 
 namespace {
@@ -48,7 +54,7 @@ public:
     static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config, algos::Binop bin_operation,
                                            double fuzziness, double p_fuzz, double weight,
                                            size_t bumps_limit, size_t iterations_limit,
-                                           double seed) {
+                                           double seed, config::ThreadNumType threads = 1) {
         using namespace config::names;
         return {{kCsvConfig, csv_config},
                 {kBinaryOperation, bin_operation},
@@ -57,16 +63,18 @@ public:
                 {kWeight, weight},
                 {kBumpsLimit, bumps_limit},
                 {kIterationsLimit, iterations_limit},
-                {kACSeed, seed}};
+                {kACSeed, seed},
+                {kThreads, threads}};
     }
 
     static std::unique_ptr<algos::ACAlgorithm> CreateACAlgorithmInstance(
             CSVConfig const& csv_config, algos::Binop bin_operation = algos::Binop::Addition,
             double fuzziness = 0.1, double p_fuzz = 0.9, double weight = 0.1,
-            size_t bumps_limit = 0, size_t iterations_limit = 10, double seed = 0) {
+            size_t bumps_limit = 0, size_t iterations_limit = 10, double seed = 0,
+            config::ThreadNumType threads = 1) {
         return algos::CreateAndLoadAlgorithm<algos::ACAlgorithm>(
                 GetParamMap(csv_config, bin_operation, fuzziness, p_fuzz, weight, bumps_limit,
-                            iterations_limit, seed));
+                            iterations_limit, seed, threads));
     }
 };
 
@@ -202,4 +210,54 @@ TEST_F(ACAlgorithmTest, RangesReconstruction) {
 
     AssertRanges(expected_ranges, ranges_collection);
 }
+
+namespace {
+// Ranges by column pairs and exceptions as (row, column pairs), comparable with ==
+using ACResult = std::pair<std::map<std::pair<size_t, size_t>, std::vector<model::Double>>,
+                           std::vector<std::pair<size_t, std::vector<std::pair<size_t, size_t>>>>>;
+
+ACResult GetACResult(algos::ACAlgorithm& algorithm) {
+    ACResult result;
+    for (algos::RangesCollection const& collection : algorithm.GetRangesCollections()) {
+        model::INumericType const& num_type = *collection.col_pair.num_type;
+        bool const is_int = num_type.GetTypeId() == +model::TypeId::kInt;
+        std::vector<model::Double>& ranges = result.first[collection.col_pair.col_i];
+        for (std::byte const* value : collection.ranges) {
+            ranges.push_back(is_int ? model::Type::GetValue<model::Int>(value)
+                                    : model::Type::GetValue<model::Double>(value));
+        }
+    }
+    algorithm.CollectACExceptions();
+    for (algos::ACException const& exception : algorithm.GetACExceptions()) {
+        result.second.emplace_back(exception.row_i, exception.column_pairs);
+    }
+    return result;
+}
+}  // namespace
+
+TEST_F(ACAlgorithmTest, SameResultForAnyThreadNumber) {
+    // Ranges and exceptions are known from FuzzyBumpsDetection and CollectingACExceptions
+    ACResult const result = CheckSameResultForAnyThreadNumber([](config::ThreadNumType threads) {
+        auto algorithm = CreateACAlgorithmInstance(kTestLong, algos::Binop::Addition, 0.55, 0.41,
+                                                   0.1, 0, 10, 0, threads);
+        algorithm->Execute();
+        return GetACResult(*algorithm);
+    });
+    EXPECT_EQ(result.first.at({0, 1}),
+              (std::vector<model::Double>{3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8}));
+    EXPECT_EQ(result.first.at({0, 2}), (std::vector<model::Double>{2, 2, 8, 9, 12, 13}));
+    EXPECT_EQ(result.first.at({1, 2}), (std::vector<model::Double>{9, 9, 11, 11}));
+    decltype(ACResult::second) const expected_exceptions = {
+            {0, {{1, 2}}}, {1, {{0, 2}, {1, 2}}}, {2, {{0, 2}, {1, 2}}}, {3, {{0, 2}, {1, 2}}}};
+    EXPECT_EQ(result.second, expected_exceptions);
+
+    for (auto bin_operation : {algos::Binop::Addition, algos::Binop::Division}) {
+        CheckSameResultForAnyThreadNumber([bin_operation](config::ThreadNumType threads) {
+            auto algorithm = CreateACAlgorithmInstance(kTestMetric, bin_operation, 0.1, 0.9, 0.05,
+                                                       3, 10, 0, threads);
+            algorithm->Execute();
+            return GetACResult(*algorithm);
+        });
+    }
+}
 }  // namespace tests
@@ -1,14 +1,32 @@
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
+#include "algorithms/fd/hyfd/hyfd.h"
 #include "algorithms/fd/pyro/pyro.h"
+#include "algorithms/ind/mind/mind.h"
+#include "algorithms/ind/spider/spider.h"
+#include "algorithms/od/fastod/fastod.h"
+#include "algorithms/od/order/order.h"
+#include "algorithms/result_cache.h"
+#include "algorithms/statistics/data_stats.h"
+#include "algorithms/ucc/hpivalid/hpivalid.h"
+#include "algorithms/ucc/hyucc/hyucc.h"
+#include "algorithms/ucc/ucc_verifier/ucc_verifier.h"
 #include "all_csv_configs.h"
 #include "config/error/type.h"
+#include "config/indices/type.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
+#include "model/table/relation_session.h"
+#include "temp_directory.h"
 
 namespace tests {
 
@@ -64,4 +82,261 @@ INSTANTIATE_TEST_SUITE_P(, KeysTest,
                                            KeysTestParams({0, 2}, kCIPublicHighway700),
                                            KeysTestParams({}, kAbalone),
                                            KeysTestParams({}, kAdult)));
+
+TEST(CancellationTest, CancelledExecutionThrowsAndNextExecutionRuns) {
+    using namespace config::names;
+    algos::StdParamsMap params_map{{kCsvConfig, kWdcGame}};
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params_map);
+
+    hyfd->Execute();
+    std::size_t const fds_num = hyfd->FdList().size();
+
+    algos::ConfigureFromMap(*hyfd, params_map);
+    hyfd->Cancel();
+    EXPECT_THROW(hyfd->Execute(), algos::ExecutionCancelled);
+
+    algos::ConfigureFromMap(*hyfd, params_map);
+    hyfd->Execute();
+    EXPECT_EQ(hyfd->FdList().size(), fds_num);
+}
+
+TEST(CancellationTest, ClearedCancelRequestIsDropped) {
+    using namespace config::names;
+    algos::StdParamsMap params_map{{kCsvConfig, kWdcGame}};
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(params_map);
+
+    hyfd->Cancel();
+    hyfd->ClearCancelRequest();
+    EXPECT_NO_THROW(hyfd->Execute());
+}
+
+namespace {
+std::vector<std::filesystem::path> GetCacheEntries(algos::ResultCache const& cache) {
+    std::vector<std::filesystem::path> entries;
+    for (auto const& entry : std::filesystem::directory_iterator(cache.GetDirectory())) {
+        entries.push_back(entry.path());
+    }
+    return entries;
+}
+
+template <typename Algorithm>
+std::unique_ptr<Algorithm> ExecuteWithCache(std::shared_ptr<algos::ResultCache> cache,
+                                            algos::StdParamsMap const& params_map) {
+    auto algorithm = std::make_unique<Algorithm>();
+    algorithm->SetResultCache(std::move(cache));
+    algos::LoadAlgorithm(*algorithm, params_map);
+    algos::ConfigureFromMap(*algorithm, params_map);
+    algorithm->Execute();
+    return algorithm;
+}
+}  // namespace
+
+TEST(ResultCacheTest, ResultsAreKeptPerAlgorithmOptionsAndTable) {
+    using namespace config::names;
+    TempDirectory const directory("desbordante_result_cache_test");
+    auto cache = std::make_shared<algos::ResultCache>(directory.GetPath());
+    algos::StdParamsMap const game{{kCsvConfig, kWdcGame}};
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(game);
+    hyfd->Execute();
+    std::string const fds = hyfd->GetJsonFDs();
+
+    EXPECT_EQ(ExecuteWithCache<algos::hyfd::HyFD>(cache, game)->GetJsonFDs(), fds);
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 1u);
+    EXPECT_EQ(ExecuteWithCache<algos::hyfd::HyFD>(cache, game)->GetJsonFDs(), fds);
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 1u);
+
+    // The number of threads does not change the results, so it is not a part of the key
+    algos::StdParamsMap game_with_threads = game;
+    game_with_threads.emplace(kThreads, config::ThreadNumType{4});
+    EXPECT_EQ(ExecuteWithCache<algos::hyfd::HyFD>(cache, game_with_threads)->GetJsonFDs(), fds);
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 1u);
+
+    algos::StdParamsMap game_with_max_lhs = game;
+    game_with_max_lhs.emplace(kMaximumLhs, config::MaxLhsType{1});
+    ExecuteWithCache<algos::hyfd::HyFD>(cache, game_with_max_lhs);
+    ExecuteWithCache<algos::hyfd::HyFD>(cache, {{kCsvConfig, kWdcAge}});
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 3u);
+
+    auto hpivalid = ExecuteWithCache<algos::HPIValid>(cache, game);
+    auto cached_hpivalid = ExecuteWithCache<algos::HPIValid>(cache, game);
+    EXPECT_EQ(cached_hpivalid->UCCList(), hpivalid->UCCList());
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 4u);
+
+    // HyUCC keeps the rows appended by previous executions, its results are not cached
+    ExecuteWithCache<algos::HyUCC>(cache, game);
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 4u);
+    cache->Clear();
+    EXPECT_TRUE(GetCacheEntries(*cache).empty());
+}
+
+TEST(ResultCacheTest, ResultsAreLoadedFromEntry) {
+    using namespace config::names;
+    TempDirectory const directory("desbordante_result_cache_entry_test");
+    auto cache = std::make_shared<algos::ResultCache>(directory.GetPath());
+    algos::StdParamsMap const game{{kCsvConfig, kWdcGame}};
+    std::size_t const fds_num = ExecuteWithCache<algos::hyfd::HyFD>(cache, game)->FdList().size();
+    ASSERT_EQ(GetCacheEntries(*cache).size(), 1u);
+    std::filesystem::path const entry = GetCacheEntries(*cache).front();
+
+    std::ofstream{entry, std::ios::app} << "0 1 -> 2\n";
+    EXPECT_EQ(ExecuteWithCache<algos::hyfd::HyFD>(cache, game)->FdList().size(), fds_num + 1);
+
+    // A broken entry is mined again and replaced
+    std::ofstream{entry, std::ios::app} << "0 1 -> 100\n";
+    EXPECT_EQ(ExecuteWithCache<algos::hyfd::HyFD>(cache, game)->FdList().size(), fds_num);
+    EXPECT_EQ(ExecuteWithCache<algos::hyfd::HyFD>(cache, game)->FdList().size(), fds_num);
+}
+
+namespace {
+std::vector<std::pair<std::string, config::ErrorType>> GetINDs(algos::INDAlgorithm const& algo) {
+    std::vector<std::pair<std::string, config::ErrorType>> inds;
+    for (model::IND const& ind : algo.INDList()) {
+        inds.emplace_back(ind.ToShortString(), ind.GetError());
+    }
+    return inds;
+}
+}  // namespace
+
+TEST(ResultCacheTest, INDAndODResultsAreCached) {
+    using namespace config::names;
+    TempDirectory const directory("desbordante_ind_od_cache_test");
+    auto cache = std::make_shared<algos::ResultCache>(directory.GetPath());
+
+    algos::StdParamsMap const tables{{kCsvConfigs, CSVConfigs{kIndTestNulls, kTestWide}}};
+    auto spider = ExecuteWithCache<algos::Spider>(cache, tables);
+    ASSERT_FALSE(spider->INDList().empty());
+    EXPECT_EQ(GetINDs(*ExecuteWithCache<algos::Spider>(cache, tables)), GetINDs(*spider));
+    algos::StdParamsMap const tables_with_error{{kCsvConfigs, CSVConfigs{kIndTestNulls}},
+                                                {kError, config::ErrorType{0.4}},
+                                                {kMaximumArity, config::MaxArityType{2}}};
+    auto mind = ExecuteWithCache<algos::Mind>(cache, tables_with_error);
+    ASSERT_FALSE(mind->INDList().empty());
+    EXPECT_EQ(GetINDs(*ExecuteWithCache<algos::Mind>(cache, tables_with_error)), GetINDs(*mind));
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 2u);
+
+    algos::StdParamsMap const table{{kCsvConfig, kOdTestNormOd}};
+    auto fastod = ExecuteWithCache<algos::Fastod>(cache, table);
+    auto cached_fastod = ExecuteWithCache<algos::Fastod>(cache, table);
+    EXPECT_EQ(cached_fastod->GetAscendingDependencies(), fastod->GetAscendingDependencies());
+    EXPECT_EQ(cached_fastod->GetDescendingDependencies(), fastod->GetDescendingDependencies());
+    EXPECT_EQ(cached_fastod->GetSimpleDependencies(), fastod->GetSimpleDependencies());
+    EXPECT_TRUE(cached_fastod->IsComplete());
+    auto order = ExecuteWithCache<algos::order::Order>(cache, table);
+    EXPECT_EQ(ExecuteWithCache<algos::order::Order>(cache, table)->GetValidODs(),
+              order->GetValidODs());
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 4u);
+}
+
+namespace {
+// Counts the rows read from the table
+class CountingStream final : public model::IDatasetStream {
+private:
+    config::InputTable table_;
+
+public:
+    std::size_t rows_read = 0;
+
+    explicit CountingStream(config::InputTable table) : table_(std::move(table)) {}
+
+    Row GetNextRow() final {
+        ++rows_read;
+        return table_->GetNextRow();
+    }
+
+    bool HasNextRow() const final {
+        return table_->HasNextRow();
+    }
+
+    std::size_t GetNumberOfColumns() const final {
+        return table_->GetNumberOfColumns();
+    }
+
+    std::string GetColumnName(std::size_t index) const final {
+        return table_->GetColumnName(index);
+    }
+
+    std::string GetRelationName() const final {
+        return table_->GetRelationName();
+    }
+
+    void Reset() final {
+        table_->Reset();
+    }
+};
+
+template <typename Algorithm>
+std::unique_ptr<Algorithm> ExecuteOn(config::InputTable table) {
+    auto algorithm = std::make_unique<Algorithm>();
+    algos::LoadAlgorithm(*algorithm, {{config::names::kTable, std::move(table)}});
+    algorithm->Execute();
+    return algorithm;
+}
+}  // namespace
+
+TEST(RelationSessionTest, AlgorithmsShareOneParse) {
+    auto counting_stream = std::make_shared<CountingStream>(MakeInputTable(kWdcGame));
+    std::shared_ptr<model::RelationSession> session =
+            model::RelationSession::Create(counting_stream);
+
+    auto stats = ExecuteOn<algos::DataStats>(session->Attach());
+    auto hyfd = ExecuteOn<algos::hyfd::HyFD>(session->Attach());
+    auto hpivalid = ExecuteOn<algos::HPIValid>(session->Attach());
+    auto second_stats = ExecuteOn<algos::DataStats>(session->Attach());
+    std::size_t const num_rows = stats->GetData().front().GetNumRows();
+    // Both forms of the table are parsed once
+    EXPECT_EQ(counting_stream->rows_read, 2 * num_rows);
+
+    auto const table = [] { return MakeInputTable(kWdcGame); };
+    EXPECT_EQ(stats->ToString(), ExecuteOn<algos::DataStats>(table())->ToString());
+    EXPECT_EQ(second_stats->ToString(), stats->ToString());
+    EXPECT_EQ(hyfd->GetJsonFDs(), ExecuteOn<algos::hyfd::HyFD>(table())->GetJsonFDs());
+    EXPECT_EQ(hpivalid->UCCList(), ExecuteOn<algos::HPIValid>(table())->UCCList());
+
+    EXPECT_EQ(ExecuteOn<algos::HyUCC>(session->Attach())->UCCList().size(),
+              hpivalid->UCCList().size());
+    EXPECT_EQ(counting_stream->rows_read, 2 * num_rows);
+
+    session->Release();
+    counting_stream->rows_read = 0;
+    ExecuteOn<algos::hyfd::HyFD>(session->Attach());
+    EXPECT_EQ(counting_stream->rows_read, num_rows);
+}
+
+TEST(RelationSessionTest, MinersDoNotReorderSharedClusters) {
+    using namespace config::names;
+    std::shared_ptr<model::RelationSession> session =
+            model::RelationSession::Create(MakeInputTable(kTestFD));
+    auto const get_clusters = [](config::InputTable table) {
+        auto verifier = algos::CreateAndLoadAlgorithm<algos::UCCVerifier>(
+                {{kTable, std::move(table)}, {kUCCIndices, config::IndicesType{0}}});
+        verifier->Execute();
+        return verifier->GetClustersViolatingUCC();
+    };
+
+    // The samplers of HyFD and HyUCC sort the clusters of the first column
+    ExecuteOn<algos::hyfd::HyFD>(session->Attach());
+    ExecuteOn<algos::HyUCC>(session->Attach());
+    EXPECT_EQ(get_clusters(session->Attach()), get_clusters(MakeInputTable(kTestFD)));
+}
+
+TEST(RelationSessionTest, TableFingerprintIsTakenOnce) {
+    TempDirectory const directory("desbordante_session_cache_test");
+    auto cache = std::make_shared<algos::ResultCache>(directory.GetPath());
+    auto counting_stream = std::make_shared<CountingStream>(MakeInputTable(kWdcGame));
+    std::shared_ptr<model::RelationSession> session =
+            model::RelationSession::Create(counting_stream);
+
+    auto hyfd = ExecuteWithCache<algos::hyfd::HyFD>(cache,
+                                                    {{config::names::kTable, session->Attach()}});
+    // The table is parsed once and read once more for its fingerprint
+    std::size_t const num_rows =
+            ExecuteOn<algos::DataStats>(MakeInputTable(kWdcGame))->GetData().front().GetNumRows();
+    EXPECT_EQ(counting_stream->rows_read, 2 * num_rows);
+
+    auto cached_hyfd = ExecuteWithCache<algos::hyfd::HyFD>(
+            cache, {{config::names::kTable, session->Attach()}});
+    EXPECT_EQ(counting_stream->rows_read, 2 * num_rows);
+    EXPECT_EQ(cached_hyfd->GetJsonFDs(), hyfd->GetJsonFDs());
+    EXPECT_EQ(GetCacheEntries(*cache).size(), 1u);
+}
 }  // namespace tests
@@ -8,6 +8,8 @@
 #include "algorithms/cfd/fd_first_algorithm.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
+#include "test_threads_util.h"
 
 namespace tests {
 
@@ -24,11 +26,51 @@ static void CheckCfdSetsEquality(std::set<std::string> const& actual,
     SUCCEED();
 }
 
+static std::set<std::string> GetCfdStrings(algos::cfd::FDFirstAlgorithm const& algorithm) {
+    std::set<std::string> cfds;
+    for (auto const& cfd : algorithm.GetItemsetCfds()) {
+        cfds.insert(algorithm.GetCfdString(cfd));
+    }
+    return cfds;
+}
+
+static std::set<std::string> GetPartialMushroomCfds() {
+    return {"(edible=p) => cap-shape=x",
+            "(cap-shape=b) => edible=e",
+            "(cap-color=y) => edible=e",
+            "(cap-color, edible=p) => cap-shape",
+            "(edible=p, cap-color=n) => cap-shape=x",
+            "(cap-surface=f) => edible=e",
+            "(cap-color, cap-surface=s) => edible",
+            "(cap-surface, edible=p) => cap-shape",
+            "(edible=p, cap-surface=y) => cap-shape=x",
+            "(cap-surface, cap-shape=f) => edible",
+            "(cap-shape, edible=p, cap-surface=s) => cap-color",
+            "(cap-color, edible, cap-shape=f) => cap-surface",
+            "(cap-shape, edible=p, cap-color=w) => cap-surface",
+            "(edible=p, cap-shape=x, cap-color=w) => cap-surface=y",
+            "(cap-color, cap-surface, edible=p) => cap-shape",
+            "(cap-color, cap-surface, cap-shape) => edible",
+            "(cap-color, cap-shape, cap-surface=s) => edible",
+            "(cap-color, cap-surface, cap-shape=x) => edible"};
+}
+
+// Processes partitions of any size on several threads, so that small tables reach the parallel code
+class AlwaysParallelFDFirstAlgorithm : public algos::cfd::FDFirstAlgorithm {
+public:
+    AlwaysParallelFDFirstAlgorithm() {
+        min_parallel_intersection_size_ = 0;
+        min_parallel_scan_size_ = 0;
+    }
+};
+
 class CFDAlgorithmTest : public ::testing::Test {
 protected:
-    static std::unique_ptr<algos::cfd::FDFirstAlgorithm> CreateAlgorithmInstance(
+    template <typename Algorithm = algos::cfd::FDFirstAlgorithm>
+    static std::unique_ptr<Algorithm> CreateAlgorithmInstance(
             CSVConfig const& csv_config, unsigned minsup, double minconf, char const* substrategy,
-            unsigned int max_lhs, unsigned columns_number = 0, unsigned tuples_number = 0) {
+            unsigned int max_lhs, unsigned columns_number = 0, unsigned tuples_number = 0,
+            config::ThreadNumType threads = 1) {
         using namespace config::names;
 
         algos::StdParamsMap params{
@@ -38,8 +80,9 @@ protected:
                 {kCfdMaximumLhs, max_lhs},
                 {kCfdSubstrategy, algos::cfd::Substrategy::_from_string(substrategy)},
                 {kCfdTuplesNumber, tuples_number},
-                {kCfdColumnsNumber, columns_number}};
-        return algos::CreateAndLoadAlgorithm<algos::cfd::FDFirstAlgorithm>(params);
+                {kCfdColumnsNumber, columns_number},
+                {kThreads, threads}};
+        return algos::CreateAndLoadAlgorithm<Algorithm>(params);
     }
 };
 
@@ -93,29 +136,28 @@ TEST_F(CFDAlgorithmTest, FullTennisDataset) {
 TEST_F(CFDAlgorithmTest, PartialMushroomDataset) {
     auto algorithm = CreateAlgorithmInstance(kMushroom, 4, 0.9, "dfs", 4, 4, 50);
     algorithm->Execute();
-    std::set<std::string> actual_cfds;
-    for (auto const& cfd : algorithm->GetItemsetCfds()) {
-        actual_cfds.insert(algorithm->GetCfdString(cfd));
+    CheckCfdSetsEquality(GetCfdStrings(*algorithm), GetPartialMushroomCfds());
+}
+
+TEST_F(CFDAlgorithmTest, SameResultForAnyThreadNumber) {
+    for (char const* substrategy : {"dfs", "bfs"}) {
+        auto const cfds = CheckSameResultForAnyThreadNumber(
+                [substrategy](config::ThreadNumType threads) {
+                    auto algorithm = CreateAlgorithmInstance(kMushroom, 300, 0.9, substrategy, 3,
+                                                             10, 8124, threads);
+                    algorithm->Execute();
+                    return algorithm->GetItemsetCfds();
+                });
+        EXPECT_FALSE(cfds.empty()) << substrategy;
     }
-    std::set<std::string> expected_cfds = {"(edible=p) => cap-shape=x",
-                                           "(cap-shape=b) => edible=e",
-                                           "(cap-color=y) => edible=e",
-                                           "(cap-color, edible=p) => cap-shape",
-                                           "(edible=p, cap-color=n) => cap-shape=x",
-                                           "(cap-surface=f) => edible=e",
-                                           "(cap-color, cap-surface=s) => edible",
-                                           "(cap-surface, edible=p) => cap-shape",
-                                           "(edible=p, cap-surface=y) => cap-shape=x",
-                                           "(cap-surface, cap-shape=f) => edible",
-                                           "(cap-shape, edible=p, cap-surface=s) => cap-color",
-                                           "(cap-color, edible, cap-shape=f) => cap-surface",
-                                           "(cap-shape, edible=p, cap-color=w) => cap-surface",
-                                           "(edible=p, cap-shape=x, cap-color=w) => cap-surface=y",
-                                           "(cap-color, cap-surface, edible=p) => cap-shape",
-                                           "(cap-color, cap-surface, cap-shape) => edible",
-                                           "(cap-color, cap-shape, cap-surface=s) => edible",
-                                           "(cap-color, cap-surface, cap-shape=x) => edible"};
+}
 
-    CheckCfdSetsEquality(actual_cfds, expected_cfds);
+TEST_F(CFDAlgorithmTest, PartialMushroomDatasetParallel) {
+    for (config::ThreadNumType threads : {2, 4}) {
+        auto algorithm = CreateAlgorithmInstance<AlwaysParallelFDFirstAlgorithm>(
+                kMushroom, 4, 0.9, "dfs", 4, 4, 50, threads);
+        algorithm->Execute();
+        CheckCfdSetsEquality(GetCfdStrings(*algorithm), GetPartialMushroomCfds());
+    }
 }
 }  // namespace tests
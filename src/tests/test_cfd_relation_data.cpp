@@ -1,8 +1,12 @@
+#include <algorithm>
+#include <iterator>
 #include <memory>
 
 #include <gtest/gtest.h>
 
 #include "algorithms/cfd/model/cfd_relation_data.h"
+#include "algorithms/cfd/model/compressed_tidlist.h"
+#include "algorithms/cfd/model/partition_tidlist.h"
 #include "all_csv_configs.h"
 #include "csv_config_util.h"
 
@@ -57,4 +61,72 @@ TEST(TestCFDRelationData, TennisDataSet) {
     ASSERT_EQ(new_relation->GetStringFormat(), tennis_string);
 }
 
+TEST(TestCFDRelationData, ItemsOfValues) {
+    auto input_table = MakeInputTable(kTennis);
+    auto relation = algos::cfd::CFDRelationData::CreateFrom(*input_table, 0, 0, 1, 1);
+
+    ASSERT_EQ(relation->GetItem(0, "sunny"), relation->GetRow(0)[0]);
+    ASSERT_EQ(relation->GetItem(0, "overcast"), relation->GetRow(2)[0]);
+    ASSERT_EQ(relation->GetValue(relation->GetItem(4, "no")), "no");
+    ASSERT_EQ(relation->GetAttrIndex(relation->GetItem(4, "no")), 4);
+    ASSERT_EQ(relation->Frequency(relation->GetItem(0, "sunny")), 5);
+    ASSERT_THROW(relation->GetItem(0, "hot"), std::out_of_range);
+}
+
+TEST(TestCFDRelationData, PartitionIntersection) {
+    using algos::cfd::PartitionTIdList;
+    int const sep = PartitionTIdList::kSep;
+    PartitionTIdList const lhs({0, 1, 2, sep, 3, 4, 5}, 2);
+
+    PartitionTIdList const pairs({5, 0, sep, 1, 3, sep, 2, 4}, 3);
+    PartitionTIdList const halves({0, 1, 3, sep, 2, 4, 5}, 2);
+
+    PartitionTIdList const singletons = lhs.Intersection(pairs);
+    ASSERT_EQ(singletons, PartitionTIdList({0, sep, 5, sep, 1, sep, 3, sep, 2, sep, 4}, 6));
+    ASSERT_EQ(lhs.PartitionError(singletons), 4);
+
+    auto const intersections = lhs.Intersections({&lhs, &singletons, &halves});
+    ASSERT_EQ(intersections.size(), 3);
+    ASSERT_EQ(intersections[0], lhs);
+    ASSERT_EQ(intersections[1], singletons);
+    ASSERT_EQ(intersections[2], PartitionTIdList({0, 1, sep, 3, sep, 2, sep, 4, 5}, 4));
+    ASSERT_EQ(lhs.PartitionError(intersections[0]), 0);
+    ASSERT_EQ(lhs.PartitionError(intersections[2]), 2);
+}
+
+TEST(TestCFDRelationData, CompressedTIdListIntersection) {
+    using algos::cfd::CompressedTIdList;
+    using algos::cfd::SimpleTIdList;
+    // Every step-th tid of [begin, end), dense lists have chunks stored as bitmaps
+    auto every = [](int begin, int end, int step) {
+        SimpleTIdList tids;
+        for (int tid = begin; tid < end; tid += step) tids.push_back(tid);
+        return tids;
+    };
+    std::vector<SimpleTIdList> const lists = {
+            {},
+            {7},
+            every(0, 100, 3),
+            every(0, 200000, 2),
+            every(1, 200000, 3),
+            every(0, 200000, 5),
+            every(50000, 150000, 7),
+            every(0, 200000, 97),
+            every(65530, 65550, 1),
+    };
+    for (SimpleTIdList const& lhs : lists) {
+        CompressedTIdList const compressed_lhs(lhs);
+        ASSERT_EQ(compressed_lhs.ToVector(), lhs);
+        for (SimpleTIdList const& rhs : lists) {
+            SimpleTIdList expected;
+            std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                  std::back_inserter(expected));
+            CompressedTIdList const intersection =
+                    compressed_lhs.Intersection(CompressedTIdList(rhs));
+            ASSERT_EQ(intersection.ToVector(), expected);
+            ASSERT_EQ(intersection.Size(), expected.size());
+        }
+    }
+}
+
 }  // namespace tests
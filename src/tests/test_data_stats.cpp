@@ -1,10 +1,22 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <easylogging++.h>
 #include <gmock/gmock.h>
 
 #include "algorithms/algo_factory.h"
+#include "algorithms/statistics/column_summary.h"
 #include "algorithms/statistics/data_stats.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "csv_config_util.h"
+#include "rows_stream.h"
 
 namespace tests {
 namespace mo = model;
@@ -468,4 +480,145 @@ TEST(TestDataStats, MultipleExecutionConsistentResults) {
     }
 }
 
+namespace {
+
+double ToDouble(algos::Statistic const& stat) {
+    if (stat.GetType()->GetTypeId() == +mo::TypeId::kInt) {
+        return mo::Type::GetValue<mo::Int>(stat.GetData());
+    }
+    return mo::Type::GetValue<mo::Double>(stat.GetData());
+}
+
+void ExpectNear(std::optional<double> actual, std::optional<double> expected) {
+    ASSERT_EQ(actual.has_value(), expected.has_value());
+    // Skewness and kurtosis of a column of equal numbers are NaN, as in DataStats
+    if (expected.has_value() && !(std::isnan(*expected) && std::isnan(*actual))) {
+        EXPECT_NEAR(*actual, *expected, 1e-9 * std::max(1.0, std::abs(*expected)));
+    }
+}
+
+std::vector<algos::ColumnSummary> SummarizeShards(CSVConfig const& csv_config,
+                                                  std::size_t shards) {
+    config::InputTable stream = MakeInputTable(csv_config);
+    std::vector<std::string> const column_names = GetColumnNames(*stream);
+    std::vector<mo::IDatasetStream::Row> const rows = ReadRows(*stream);
+    std::size_t const shard_size = rows.size() / shards + 1;
+
+    std::vector<algos::ColumnSummary> merged(column_names.size());
+    for (std::size_t begin = 0; begin < rows.size(); begin += shard_size) {
+        std::size_t const end = std::min(rows.size(), begin + shard_size);
+        config::InputTable shard = std::make_shared<RowsStream>(
+                column_names, std::vector(rows.begin() + begin, rows.begin() + end));
+        auto stats = algos::CreateAndLoadAlgorithm<algos::DataStats>(
+                {{config::names::kTable, shard}, {config::names::kEqualNulls, true}});
+        std::vector<algos::ColumnSummary> const summaries = stats->GetSummaries();
+        for (std::size_t i = 0; i != summaries.size(); ++i) {
+            merged[i].Merge(summaries[i]);
+        }
+    }
+    return merged;
+}
+
+}  // namespace
+
+TEST(TestDataStats, SummaryMatchesStatistics) {
+    auto stats_ptr = MakeStatAlgorithm(kTestDataStats);
+    algos::DataStats& stats = *stats_ptr;
+    for (std::size_t index = 0; index != stats.GetNumberOfColumns(); ++index) {
+        algos::ColumnSummary const summary = stats.GetSummary(index);
+        EXPECT_EQ(summary.GetCount(), stats.NumberOfValues(index));
+        EXPECT_EQ(summary.GetNumNulls(), stats.GetNumNulls(index));
+        if (!stats.GetData()[index].IsNumeric()) continue;
+
+        EXPECT_EQ(summary.GetDistinct(), stats.Distinct(index));
+        ExpectNear(summary.GetSum(), ToDouble(stats.GetSum(index)));
+        ExpectNear(summary.GetAvg(), ToDouble(stats.GetAvg(index)));
+        ExpectNear(summary.GetCorrectedSTD(), ToDouble(stats.GetCorrectedSTD(index)));
+        ExpectNear(summary.GetSkewness(), ToDouble(stats.GetSkewness(index)));
+        ExpectNear(summary.GetKurtosis(), ToDouble(stats.GetKurtosis(index)));
+        ExpectNear(summary.GetSumOfSquares(), ToDouble(stats.GetSumOfSquares(index)));
+        ExpectNear(summary.GetMinNumber(), ToDouble(stats.GetMin(index)));
+        ExpectNear(summary.GetMaxNumber(), ToDouble(stats.GetMax(index)));
+        for (double part : {0.25, 0.5, 0.75}) {
+            ExpectNear(summary.GetQuantile(part), ToDouble(stats.GetQuantile(part, index)));
+        }
+    }
+    EXPECT_EQ(stats.GetSummary(6).GetMinString(), stats.GetMin(6).ToString());
+    EXPECT_EQ(stats.GetSummary(6).GetMaxString(), stats.GetMax(6).ToString());
+}
+
+TEST(TestDataStats, MergedShardSummariesMatchTable) {
+    for (CSVConfig const& csv_config :
+         {kTestDataStats, kBernoulliRelation, kWdcSatellites, kCIPublicHighway700}) {
+        std::vector<algos::ColumnSummary> const merged = SummarizeShards(csv_config, 3);
+        std::vector<algos::ColumnSummary> const whole =
+                MakeStatAlgorithm(csv_config)->GetSummaries();
+        ASSERT_EQ(merged.size(), whole.size());
+        for (std::size_t i = 0; i != whole.size(); ++i) {
+            SCOPED_TRACE(csv_config.path.filename().string() + ", column " + std::to_string(i));
+            EXPECT_EQ(merged[i].GetNumRows(), whole[i].GetNumRows());
+            EXPECT_EQ(merged[i].GetNumNulls(), whole[i].GetNumNulls());
+            EXPECT_EQ(merged[i].GetNumEmpties(), whole[i].GetNumEmpties());
+            EXPECT_EQ(merged[i].GetNumNumbers(), whole[i].GetNumNumbers());
+            EXPECT_EQ(merged[i].GetDistinct(), whole[i].GetDistinct());
+            ExpectNear(merged[i].GetAvg(), whole[i].GetAvg());
+            ExpectNear(merged[i].GetCorrectedSTD(), whole[i].GetCorrectedSTD());
+            ExpectNear(merged[i].GetSkewness(), whole[i].GetSkewness());
+            ExpectNear(merged[i].GetKurtosis(), whole[i].GetKurtosis());
+            ExpectNear(merged[i].GetMinNumber(), whole[i].GetMinNumber());
+            ExpectNear(merged[i].GetMaxNumber(), whole[i].GetMaxNumber());
+            EXPECT_EQ(merged[i].GetMinString(), whole[i].GetMinString());
+            EXPECT_EQ(merged[i].GetMaxString(), whole[i].GetMaxString());
+            if (whole[i].GetNumNumbers() < algos::QuantileSketch::kCapacity) {
+                ExpectNear(merged[i].GetQuantile(0.5), whole[i].GetQuantile(0.5));
+            }
+        }
+    }
+}
+
+TEST(TestDataStats, SummarySerialization) {
+    std::vector<algos::ColumnSummary> const summaries = SummarizeShards(kCIPublicHighway700, 2);
+    for (algos::ColumnSummary const& summary : summaries) {
+        std::string const data = summary.Serialize();
+        algos::ColumnSummary const restored = algos::ColumnSummary::Deserialize(data);
+        EXPECT_EQ(restored.Serialize(), data);
+        EXPECT_EQ(restored.GetDistinct(), summary.GetDistinct());
+        ExpectNear(restored.GetQuantile(0.5), summary.GetQuantile(0.5));
+    }
+    std::string const data = summaries.front().Serialize();
+    EXPECT_THROW(algos::ColumnSummary::Deserialize("not a summary"), std::invalid_argument);
+    EXPECT_THROW(algos::ColumnSummary::Deserialize(data.substr(0, data.size() - 1)),
+                 std::invalid_argument);
+}
+
+TEST(TestDataStats, SketchesApproximateLargeColumns) {
+    constexpr std::size_t kNumbers = 100000;
+    std::vector<double> numbers(kNumbers);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    std::shuffle(numbers.begin(), numbers.end(), std::mt19937{0});
+
+    algos::QuantileSketch quantiles;
+    algos::DistinctSketch distinct;
+    for (std::size_t shard = 0; shard != 4; ++shard) {
+        algos::QuantileSketch shard_quantiles;
+        algos::DistinctSketch shard_distinct;
+        for (std::size_t i = shard; i < kNumbers; i += 4) {
+            shard_quantiles.Add(numbers[i]);
+            shard_distinct.Add(std::hash<std::string>{}(std::to_string(numbers[i])));
+            // Every value is added twice, to different shards
+            shard_distinct.Add(
+                    std::hash<std::string>{}(std::to_string(numbers[(i + 1) % kNumbers])));
+        }
+        quantiles.Merge(shard_quantiles);
+        distinct.Merge(shard_distinct);
+    }
+
+    EXPECT_EQ(quantiles.GetCount(), kNumbers);
+    for (double part : {0.01, 0.25, 0.5, 0.75, 0.99}) {
+        EXPECT_NEAR(*quantiles.GetQuantile(part), kNumbers * part, kNumbers * 0.02);
+    }
+    EXPECT_FALSE(distinct.IsExact());
+    EXPECT_NEAR(distinct.Estimate(), kNumbers, kNumbers * 0.05);
+}
+
 };  // namespace tests
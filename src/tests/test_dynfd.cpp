@@ -0,0 +1,248 @@
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "algorithms/algo_factory.h"
+#include "algorithms/fd/dynfd/dynfd.h"
+#include "algorithms/fd/hyfd/hyfd.h"
+#include "all_csv_configs.h"
+#include "config/exceptions.h"
+#include "config/names.h"
+#include "csv_config_util.h"
+#include "model/table/idataset_stream.h"
+#include "rows_stream.h"
+
+namespace tests {
+
+namespace {
+
+namespace onam = config::names;
+
+using FDSet = std::set<std::pair<std::vector<model::ColumnIndex>, model::ColumnIndex>>;
+
+FDSet ToFDSet(std::list<FD> const& fds) {
+    FDSet set;
+    for (FD const& fd : fds) {
+        set.emplace(fd.GetLhsIndices(), fd.GetRhsIndex());
+    }
+    return set;
+}
+
+/* The table as DynFD sees it: row ids are kept by deleted and updated rows */
+class Table {
+private:
+    std::vector<std::string> column_names_;
+    std::vector<model::IDatasetStream::Row> rows_;
+    std::vector<bool> deleted_;
+
+public:
+    Table(std::vector<std::string> column_names, std::vector<model::IDatasetStream::Row> rows)
+        : column_names_(std::move(column_names)),
+          rows_(std::move(rows)),
+          deleted_(rows_.size(), false) {}
+
+    std::vector<std::string> const& GetColumnNames() const {
+        return column_names_;
+    }
+
+    std::vector<std::size_t> GetRowIds() const {
+        std::vector<std::size_t> ids;
+        for (std::size_t id = 0; id != rows_.size(); ++id) {
+            if (!deleted_[id]) ids.push_back(id);
+        }
+        return ids;
+    }
+
+    model::IDatasetStream::Row const& GetRow(std::size_t id) const {
+        return rows_[id];
+    }
+
+    void Insert(model::IDatasetStream::Row row) {
+        rows_.push_back(std::move(row));
+        deleted_.push_back(false);
+    }
+
+    void Update(std::size_t id, model::IDatasetStream::Row row) {
+        rows_[id] = std::move(row);
+    }
+
+    void Delete(std::size_t id) {
+        deleted_[id] = true;
+    }
+
+    config::InputTable MakeStream() const {
+        std::vector<model::IDatasetStream::Row> rows;
+        for (std::size_t id : GetRowIds()) {
+            rows.push_back(rows_[id]);
+        }
+        return std::make_shared<RowsStream>(column_names_, std::move(rows));
+    }
+};
+
+Table ReadTable(CSVConfig const& csv_config) {
+    config::InputTable stream = MakeInputTable(csv_config);
+    return {GetColumnNames(*stream), ReadRows(*stream)};
+}
+
+FDSet MineFromScratch(Table const& table) {
+    auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(
+            {{onam::kTable, table.MakeStream()}, {onam::kEqualNulls, true}});
+    hyfd->Execute();
+    return ToFDSet(hyfd->FdList());
+}
+
+/* Loads the first part of the rows, then applies batches of inserts, updates and deletes,
+ * comparing the maintained FDs with a full rerun after every batch */
+void TestBatchesMatchRerun(CSVConfig const& csv_config, std::size_t batches) {
+    Table const source = ReadTable(csv_config);
+    std::vector<std::size_t> const source_ids = source.GetRowIds();
+    std::size_t const initial_size = source_ids.size() / 2;
+    std::size_t const batch_size = (source_ids.size() - initial_size) / batches + 1;
+
+    std::vector<model::IDatasetStream::Row> initial_rows;
+    for (std::size_t i = 0; i != initial_size; ++i) {
+        initial_rows.push_back(source.GetRow(i));
+    }
+    Table table{source.GetColumnNames(), initial_rows};
+
+    auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            {{onam::kTable, table.MakeStream()}, {onam::kEqualNulls, true}});
+    dynfd->Execute();
+    ASSERT_EQ(ToFDSet(dynfd->FdList()), MineFromScratch(table));
+
+    std::mt19937 gen{csv_config.path.filename().string().size()};
+    std::size_t next_source_row = initial_size;
+    for (std::size_t batch = 0; batch != batches; ++batch) {
+        std::vector<model::IDatasetStream::Row> inserts;
+        for (; next_source_row != source_ids.size() && inserts.size() != batch_size;
+             ++next_source_row) {
+            inserts.push_back(source.GetRow(next_source_row));
+        }
+
+        std::vector<std::size_t> ids = table.GetRowIds();
+        std::shuffle(ids.begin(), ids.end(), gen);
+        std::size_t const changed = std::min(ids.size(), batch_size / 2 + 1);
+        std::unordered_set<std::size_t> deletes(ids.begin(), ids.begin() + changed / 2);
+        std::vector<model::IDatasetStream::Row> updates;
+        for (std::size_t i = changed / 2; i != changed; ++i) {
+            // Another row of the table with the last value of this one
+            model::IDatasetStream::Row row = table.GetRow(ids[ids.size() - 1 - i]);
+            row.back() = table.GetRow(ids[i]).back();
+            table.Update(ids[i], row);
+            row.insert(row.begin(), std::to_string(ids[i]));
+            updates.push_back(std::move(row));
+        }
+        for (std::size_t id : deletes) {
+            table.Delete(id);
+        }
+        for (model::IDatasetStream::Row const& row : inserts) {
+            table.Insert(row);
+        }
+
+        std::vector<std::string> update_names = table.GetColumnNames();
+        update_names.insert(update_names.begin(), "_id");
+        algos::ConfigureFromMap(
+                *dynfd,
+                {{onam::kInsertStatements,
+                  config::InputTable{std::make_shared<RowsStream>(table.GetColumnNames(),
+                                                                  std::move(inserts))}},
+                 {onam::kUpdateStatements,
+                  config::InputTable{std::make_shared<RowsStream>(std::move(update_names),
+                                                                  std::move(updates))}},
+                 {onam::kDeleteStatements, std::move(deletes)}});
+        dynfd->Execute();
+        ASSERT_EQ(ToFDSet(dynfd->FdList()), MineFromScratch(table))
+                << csv_config.path.filename() << ", batch " << batch;
+    }
+}
+
+}  // namespace
+
+TEST(DynFDTest, MatchesRerunOnDynamicFDTables) {
+    Table table = ReadTable(kTestDynamicFDInit);
+    auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            {{onam::kCsvConfig, kTestDynamicFDInit},
+             {onam::kEqualNulls, true},
+             {onam::kInsertStatements, MakeInputTable(kTestDynamicFDInsert)},
+             {onam::kUpdateStatements, MakeInputTable(kTestDynamicFDUpdate)},
+             {onam::kDeleteStatements, std::unordered_set<std::size_t>{1, 6, 3}}});
+    dynfd->Execute();
+
+    for (std::size_t id : {1, 6, 3}) {
+        table.Delete(id);
+    }
+    Table const updates = ReadTable(kTestDynamicFDUpdate);
+    for (std::size_t id : updates.GetRowIds()) {
+        model::IDatasetStream::Row row = updates.GetRow(id);
+        std::size_t const row_id = std::stoull(row.front());
+        row.erase(row.begin());
+        table.Update(row_id, std::move(row));
+    }
+    Table const inserts = ReadTable(kTestDynamicFDInsert);
+    for (std::size_t id : inserts.GetRowIds()) {
+        table.Insert(inserts.GetRow(id));
+    }
+    EXPECT_EQ(ToFDSet(dynfd->FdList()), MineFromScratch(table));
+}
+
+TEST(DynFDTest, DeletingViolationsRestoresFDs) {
+    auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+            {{onam::kCsvConfig, kTestDynamicFDInit}, {onam::kEqualNulls, true}});
+    dynfd->Execute();
+    FDSet const initial = ToFDSet(dynfd->FdList());
+
+    algos::ConfigureFromMap(*dynfd, {{onam::kInsertStatements,
+                                      MakeInputTable(kTestDynamicFDInsert)}});
+    dynfd->Execute();
+    EXPECT_NE(ToFDSet(dynfd->FdList()), initial);
+
+    std::size_t const initial_rows = ReadTable(kTestDynamicFDInit).GetRowIds().size();
+    std::size_t const inserted_rows = ReadTable(kTestDynamicFDInsert).GetRowIds().size();
+    std::unordered_set<std::size_t> inserted_ids;
+    for (std::size_t i = 0; i != inserted_rows; ++i) {
+        inserted_ids.insert(initial_rows + i);
+    }
+    algos::ConfigureFromMap(*dynfd, {{onam::kDeleteStatements, std::move(inserted_ids)}});
+    dynfd->Execute();
+    EXPECT_EQ(ToFDSet(dynfd->FdList()), initial);
+}
+
+TEST(DynFDTest, ThrowsOnDeletingMissingRow) {
+    EXPECT_THROW(algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+                         {{onam::kCsvConfig, kTestDynamicFDInit},
+                          {onam::kEqualNulls, true},
+                          {onam::kDeleteStatements, std::unordered_set<std::size_t>{100}}}),
+                 config::ConfigurationError);
+}
+
+TEST(DynFDTest, InitialFDsWithNulls) {
+    // A -> B holds only if nulls are not equal to each other
+    Table const table{{"A", "B", "C"},
+                      {{"", "x", "1"}, {"", "y", "1"}, {"1", "x", ""}, {"2", "y", ""}}};
+    for (bool is_null_equal_null : {true, false}) {
+        SCOPED_TRACE(is_null_equal_null);
+        auto dynfd = algos::CreateAndLoadAlgorithm<algos::dynfd::DynFD>(
+                {{onam::kTable, table.MakeStream()}, {onam::kEqualNulls, is_null_equal_null}});
+        dynfd->Execute();
+        auto hyfd = algos::CreateAndLoadAlgorithm<algos::hyfd::HyFD>(
+                {{onam::kTable, table.MakeStream()}, {onam::kEqualNulls, is_null_equal_null}});
+        hyfd->Execute();
+        EXPECT_EQ(ToFDSet(dynfd->FdList()), ToFDSet(hyfd->FdList()));
+        EXPECT_EQ(ToFDSet(dynfd->FdList()).contains({{0}, 1}), !is_null_equal_null);
+    }
+}
+
+TEST(DynFDTest, BatchesMatchRerun) {
+    for (CSVConfig const& csv_config : {kTestFD, kWdcSatellites, kCIPublicHighway700, kLineItem}) {
+        TestBatchesMatchRerun(csv_config, 4);
+    }
+}
+
+}  // namespace tests
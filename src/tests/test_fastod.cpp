@@ -8,16 +8,18 @@
 #include "algorithms/od/fastod/hashing/hashing.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "csv_config_util.h"
+#include "test_threads_util.h"
 
 namespace tests {
 
 namespace {
 
-size_t RunFastod(CSVConfig const& csv_config) {
+size_t RunFastod(CSVConfig const& csv_config, config::ThreadNumType threads = 1) {
     using namespace config::names;
 
-    algos::StdParamsMap params{{kCsvConfig, csv_config}};
+    algos::StdParamsMap params{{kCsvConfig, csv_config}, {kThreads, threads}};
     std::unique_ptr<algos::Fastod> fastod = algos::CreateAndLoadAlgorithm<algos::Fastod>(params);
 
     fastod->Execute();
@@ -53,6 +55,15 @@ TEST_P(FastodResultHashTest, CorrectnessTest) {
     EXPECT_EQ(actual_hash, csv_config_hash.hash);
 }
 
+TEST_P(FastodResultHashTest, ParallelCorrectnessTest) {
+    CSVConfigHash csv_config_hash = GetParam();
+    size_t actual_hash = CheckSameResultForAnyThreadNumber(
+            [&csv_config_hash](config::ThreadNumType threads) {
+                return RunFastod(csv_config_hash.config, threads);
+            });
+    EXPECT_EQ(actual_hash, csv_config_hash.hash);
+}
+
 INSTANTIATE_TEST_SUITE_P(
         TestFastodSuite, FastodResultHashTest,
         ::testing::Values(CSVConfigHash{kOdTestNormOd, 8741296102670149192ULL},
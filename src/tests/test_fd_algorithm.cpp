@@ -5,6 +5,7 @@
 
 #include "algorithms/fd/depminer/depminer.h"
 #include "algorithms/fd/dfd/dfd.h"
+#include "algorithms/fd/dynfd/dynfd.h"
 #include "algorithms/fd/fastfds/fastfds.h"
 #include "algorithms/fd/fdep/fdep.h"
 #include "algorithms/fd/fun/fun.h"
@@ -14,6 +15,7 @@
 #include "algorithms/fd/tane/tane.h"
 #include "model/table/relational_schema.h"
 #include "test_fd_util.h"
+#include "test_threads_util.h"
 
 using std::string, std::vector;
 using ::testing::ContainerEq, ::testing::Eq;
@@ -156,9 +158,41 @@ REGISTER_TYPED_TEST_SUITE_P(AlgorithmTest, ThrowsOnEmpty, ReturnsEmptyOnSingleNo
                             HeavyDatasetsConsistentHash, ConsistentRepeatedExecution,
                             MaxLHSOptionWork);
 
+namespace {
+template <typename Algorithm>
+void TestSameResultForAnyThreadNumber() {
+    using namespace config::names;
+    // Hashes of the FDs are known from AlgorithmTest::kLightDatasets
+    for (CSVConfigHash const& config_hash : {CSVConfigHash{kWdcAstronomical, 22281},
+                                             CSVConfigHash{kWdcKepler, 63730}}) {
+        auto run = [&config_hash](config::ThreadNumType threads) {
+            auto algorithm = algos::CreateAndLoadAlgorithm<Algorithm>(
+                    {{kCsvConfig, config_hash.config}, {kThreads, threads}});
+            algorithm->Execute();
+            return algorithm->Fletcher16();
+        };
+        EXPECT_EQ(CheckSameResultForAnyThreadNumber(run), config_hash.hash)
+                << config_hash.config.path.filename();
+    }
+}
+}  // namespace
+
+TEST(DFDTest, SameResultForAnyThreadNumber) {
+    TestSameResultForAnyThreadNumber<algos::DFD>();
+}
+
+TEST(FUNTest, SameResultForAnyThreadNumber) {
+    TestSameResultForAnyThreadNumber<algos::FUN>();
+}
+
+TEST(DepminerTest, SameResultForAnyThreadNumber) {
+    TestSameResultForAnyThreadNumber<algos::Depminer>();
+}
+
 using Algorithms =
         ::testing::Types<algos::Tane, algos::Pyro, algos::FastFDs, algos::DFD, algos::Depminer,
-                         algos::FDep, algos::FUN, algos::hyfd::HyFD, algos::PFDTane>;
+                         algos::FDep, algos::FUN, algos::hyfd::HyFD, algos::PFDTane,
+                         algos::dynfd::DynFD>;
 INSTANTIATE_TYPED_TEST_SUITE_P(AlgorithmTest, AlgorithmTest, Algorithms);
 
 }  // namespace tests
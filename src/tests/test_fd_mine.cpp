@@ -11,9 +11,11 @@
 #include "algorithms/fd/tane/tane.h"
 #include "config/error/type.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "csv_config_util.h"
 #include "model/table/relational_schema.h"
 #include "test_fd_util.h"
+#include "test_threads_util.h"
 
 namespace tests {
 using ::testing::ContainerEq, ::testing::Eq;
@@ -188,4 +190,28 @@ TEST_F(FDMineAlgorithmTest, FD_Mine_ReturnsSameAsPyro) {
     SUCCEED();
 }
 
+TEST(AlgorithmSyntheticTest, FD_Mine_SameResultForAnyThreadNumber) {
+    using namespace config::names;
+    for (CSVConfig const& csv_config : {kCIPublicHighway700, kWdcAstronomical, kWdcKepler}) {
+        auto run = [&csv_config](config::ThreadNumType threads) {
+            auto algorithm = algos::CreateAndLoadAlgorithm<FdMine>(
+                    {{kCsvConfig, csv_config}, {kThreads, threads}});
+            algorithm->Execute();
+            return algorithm->GetJsonFDs();
+        };
+        SCOPED_TRACE(csv_config.path.filename());
+        CheckSameResultForAnyThreadNumber(run);
+    }
+}
+
+TEST(AlgorithmSyntheticTest, FD_Mine_ParallelWorksOnLongDataset) {
+    using namespace config::names;
+    std::set<std::pair<std::vector<unsigned int>, unsigned int>> true_fd_collection{{{2}, 1}};
+
+    auto algorithm = algos::CreateAndLoadAlgorithm<FdMine>(
+            {{kCsvConfig, tests::kTestLong}, {kThreads, config::ThreadNumType{4}}});
+    algorithm->Execute();
+    ASSERT_TRUE(FdMineCheckFdListEquality(true_fd_collection, algorithm->FdList()));
+}
+
 }  // namespace tests
@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -123,4 +125,28 @@ INSTANTIATE_TEST_SUITE_P(
             ));
 // clang-format on
 
+TEST(FDVerifierBatchTest, BatchMatchesSingleVerification) {
+    std::vector<std::pair<config::IndicesType, config::IndicesType>> const fds = {
+            {{4}, {3}},       {{3}, {4}},    {{1, 3}, {5}},       {{1, 3}, {4}},
+            {{1, 3}, {0, 3}}, {{3, 1}, {5}}, {{1, 4}, {2, 3, 5}}, {{1, 4}, {0, 3}},
+            {{0}, {2, 3}},    {{0}, {1}},    {{5}, {0, 1, 2, 3, 4}}};
+    // The FD given through the options is not used by VerifyFDs
+    auto batch_verifier =
+            algos::CreateAndLoadAlgorithm<FDVerifier>(FDVerifyingParams({0}, {1}).params);
+
+    for (config::ThreadNumType threads : {1, 2}) {
+        std::vector<FDStats> stats = batch_verifier->VerifyFDs(fds, threads);
+        ASSERT_EQ(stats.size(), fds.size());
+        for (std::size_t i = 0; i < fds.size(); ++i) {
+            FDVerifyingParams single(fds[i].first, fds[i].second);
+            auto verifier = algos::CreateAndLoadAlgorithm<FDVerifier>(single.params);
+            verifier->Execute();
+            EXPECT_EQ(stats[i].holds, verifier->FDHolds());
+            EXPECT_EQ(stats[i].num_error_clusters, verifier->GetNumErrorClusters());
+            EXPECT_EQ(stats[i].num_error_rows, verifier->GetNumErrorRows());
+            EXPECT_DOUBLE_EQ(stats[i].error, verifier->GetError());
+        }
+    }
+}
+
 }  // namespace tests
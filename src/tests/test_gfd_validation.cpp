@@ -1,10 +1,19 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
 #include "algorithms/gfd/gfd_validation.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "csv_config_util.h"
+#include "parser/graph_parser/graph_parser.h"
+#include "temp_directory.h"
 
 using namespace algos;
 using algos::StdParamsMap;
@@ -51,13 +60,119 @@ TYPED_TEST_P(GfdValidationTest, TestExistingMatches) {
     ASSERT_EQ(expected_size, gfd_list.size());
 }
 
-REGISTER_TYPED_TEST_SUITE_P(GfdValidationTest, TestTrivially, TestExistingMatches);
+TYPED_TEST_P(GfdValidationTest, TestSeveralGfds) {
+    auto graph_path = current_path / "directors.dot";
+    std::vector<std::filesystem::path> gfd_paths = {current_path / "quadrangle_gfd.dot",
+                                                    current_path / "directors_gfd.dot"};
+    auto algorithm = TestFixture::CreateGfdValidationInstance(graph_path, gfd_paths);
+    int expected_size = 1;
+    algorithm->Execute();
+    std::vector<Gfd> gfd_list = algorithm->GfdList();
+    ASSERT_EQ(expected_size, gfd_list.size());
+    ASSERT_EQ(gfd_list[0].GetPremises().size(), 0);
+}
+
+TYPED_TEST_P(GfdValidationTest, TestEdgeListGraph) {
+    auto graph_path = current_path / "directors_csv";
+    std::vector<std::filesystem::path> gfd_paths = {current_path / "directors_gfd.dot"};
+    auto algorithm = TestFixture::CreateGfdValidationInstance(graph_path, gfd_paths);
+    int expected_size = 0;
+    algorithm->Execute();
+    std::vector<Gfd> gfd_list = algorithm->GfdList();
+    ASSERT_EQ(expected_size, gfd_list.size());
+}
+
+TYPED_TEST_P(GfdValidationTest, TestGraphSnapshot) {
+    TempDirectory directory("desbordante_gfd_snapshot_test");
+    auto snapshot_path = directory.GetPath() / "directors.graph";
+    graph_t graph = parser::graph_parser::ReadGraph(current_path / "directors.dot");
+    parser::graph_parser::WriteGraphSnapshot(snapshot_path, graph);
+    std::vector<std::filesystem::path> gfd_paths = {current_path / "directors_gfd.dot"};
+    auto algorithm = TestFixture::CreateGfdValidationInstance(snapshot_path, gfd_paths);
+    int expected_size = 0;
+    algorithm->Execute();
+    std::vector<Gfd> gfd_list = algorithm->GfdList();
+    ASSERT_EQ(expected_size, gfd_list.size());
+}
+
+REGISTER_TYPED_TEST_SUITE_P(GfdValidationTest, TestTrivially, TestExistingMatches,
+                            TestSeveralGfds, TestEdgeListGraph, TestGraphSnapshot);
 
 using GfdAlgorithms =
         ::testing::Types<algos::NaiveGfdValidation, algos::GfdValidation, algos::EGfdValidation>;
 
 INSTANTIATE_TYPED_TEST_SUITE_P(GfdValidationTest, GfdValidationTest, GfdAlgorithms);
 
+template <typename T>
+class GfdMatchesValidationTest : public GfdValidationTest<T> {};
+
+using GfdMatchingAlgorithms = ::testing::Types<algos::GfdValidation, algos::EGfdValidation>;
+
+TYPED_TEST_SUITE(GfdMatchesValidationTest, GfdMatchingAlgorithms);
+
+// GFDs with matches that are satisfied and violated in different ways
+TYPED_TEST(GfdMatchesValidationTest, TestSeveralGfdsWithMatches) {
+    auto graph_path = current_path / "studios.dot";
+    // Only the genre GFD holds among the ones having matches in the graph, the quadrangle GFD has
+    // no matches at all.
+    std::vector<std::filesystem::path> gfd_paths = {
+            current_path / "studios_studio_gfd.dot", current_path / "quadrangle_gfd.dot",
+            current_path / "studios_genre_gfd.dot", current_path / "studios_rating_gfd.dot"};
+    auto algorithm = TestFixture::CreateGfdValidationInstance(graph_path, gfd_paths);
+    algorithm->Execute();
+    std::vector<Gfd> gfd_list = algorithm->GfdList();
+    ASSERT_EQ(gfd_list.size(), 2);
+    std::vector<Literal> const genre_premises = {{{0, "genre"}, {2, "genre"}}};
+    EXPECT_TRUE(gfd_list[0].GetPremises().empty());
+    EXPECT_EQ(gfd_list[1].GetPremises(), genre_premises);
+}
+
+TEST(GraphSnapshotTest, CorruptedSnapshot) {
+    TempDirectory directory("desbordante_gfd_snapshot_test");
+    auto snapshot_path = directory.GetPath() / "directors.graph";
+    graph_t graph = parser::graph_parser::ReadGraph(current_path / "directors.dot");
+    parser::graph_parser::WriteGraphSnapshot(snapshot_path, graph);
+    std::uintmax_t const size = std::filesystem::file_size(snapshot_path);
+
+    auto write_bytes = [&snapshot_path](std::uintmax_t offset, std::string const& bytes) {
+        std::fstream file(snapshot_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+    // Offsets and indices in the middle of the file turn into huge numbers, the size stays valid.
+    write_bytes(size / 2, std::string(16, '\xff'));
+    EXPECT_THROW(parser::graph_parser::ReadGraphSnapshot(snapshot_path), std::runtime_error);
+
+    std::filesystem::resize_file(snapshot_path, size / 2);
+    EXPECT_THROW(parser::graph_parser::ReadGraphSnapshot(snapshot_path), std::runtime_error);
+}
+
+// Every director in studios.dot has more films than the split threshold of GfdValidation, so the
+// search subtrees below the directors are spread over the workers.
+TEST(GfdValidationParallelTest, SameResultForAnyThreadNumber) {
+    std::vector<std::filesystem::path> gfd_paths = {current_path / "studios_genre_gfd.dot",
+                                                    current_path / "studios_studio_gfd.dot",
+                                                    current_path / "studios_rating_gfd.dot"};
+    auto run = [&gfd_paths](config::ThreadNumType threads) {
+        StdParamsMap option_map = {{config::names::kGraphData, current_path / "studios.dot"},
+                                   {config::names::kGfdData, gfd_paths},
+                                   {config::names::kThreads, threads}};
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::GfdValidation>(option_map);
+        algorithm->Execute();
+        std::vector<std::vector<Literal>> conclusions;
+        for (Gfd const& gfd : algorithm->GfdList()) {
+            conclusions.push_back(gfd.GetConclusion());
+        }
+        return conclusions;
+    };
+
+    std::vector<std::vector<Literal>> const expected = {{{{0, "studio"}, {2, "studio"}}}};
+    ASSERT_EQ(run(1), expected);
+    for (config::ThreadNumType threads : {2, 4, 8}) {
+        EXPECT_EQ(run(threads), expected) << threads << " threads";
+    }
+}
+
 }  // namespace
 
 }  // namespace tests
@@ -11,6 +11,7 @@
 #include "max_arity/type.h"
 #include "test_hash_util.h"
 #include "test_ind_util.h"
+#include "test_threads_util.h"
 
 namespace tests {
 namespace {
@@ -198,10 +199,12 @@ namespace {
 template <typename Algorithm>
 class NaryINDAlgorithmTest : public ::testing::Test {
 protected:
-    static std::unique_ptr<Algorithm> CreateAlgorithmInstance(CSVConfigs const& csv_configs) {
+    static std::unique_ptr<Algorithm> CreateAlgorithmInstance(CSVConfigs const& csv_configs,
+                                                              config::ThreadNumType threads = 1) {
         using namespace config::names;
         return algos::CreateAndLoadAlgorithm<Algorithm>(algos::StdParamsMap{
                 {kCsvConfigs, csv_configs},
+                {kThreads, threads},
         });
     }
 };
@@ -220,4 +223,23 @@ TYPED_TEST(NaryINDAlgorithmTest, EqualityTest) {
     }
 }
 
+TYPED_TEST(NaryINDAlgorithmTest, ParallelEqualityTest) {
+    for (INDEqualityTestConfig const& test_config : kINDEqualityTestConfigs) {
+        // INDs are kept in discovery order, which must not depend on the number of threads.
+        auto run = [&test_config](config::ThreadNumType threads) {
+            auto algorithm = TestFixture::CreateAlgorithmInstance(test_config.csv_configs, threads);
+            algorithm->Execute();
+            std::vector<INDTest> inds;
+            for (model::IND const& ind : algorithm->INDList()) {
+                inds.push_back(ToINDTest(ind));
+            }
+            return inds;
+        };
+        SCOPED_TRACE(TableNamesToString(test_config.csv_configs));
+        std::vector<INDTest> const inds = CheckSameResultForAnyThreadNumber(run);
+        EXPECT_EQ(inds.size(), test_config.expected_inds.size());
+        EXPECT_EQ(INDTestSet(inds.begin(), inds.end()), test_config.expected_inds);
+    }
+}
+
 }  // namespace tests
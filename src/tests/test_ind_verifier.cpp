@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <filesystem>
 #include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -7,7 +10,10 @@
 #include "config/names.h"
 #include "csv_config_util.h"
 #include "error/type.h"
+#include "ind/ind_verifier/fingerprint_partitions.h"
 #include "ind/ind_verifier/ind_verifier.h"
+#include "temp_directory.h"
+#include "test_threads_util.h"
 
 namespace tests {
 
@@ -26,38 +32,58 @@ struct INDVerifierTestConfig {
 };
 
 namespace {
-static std::unique_ptr<algos::INDVerifier> CreateINDVerfier(INDVerifierTestConfig const& config) {
+static std::unique_ptr<algos::INDVerifier> CreateINDVerfier(INDVerifierTestConfig const& config,
+                                                            config::ThreadNumType threads = 1) {
     using namespace config::names;
     return algos::CreateAndLoadAlgorithm<algos::INDVerifier>(algos::StdParamsMap{
             {kCsvConfigs, config.csv_configs},
             {kRhsIndices, config.ind.rhs},
             {kLhsIndices, config.ind.lhs},
+            {kThreads, threads},
     });
 }
 }  // namespace
 
 class TestINDVerifier : public ::testing::TestWithParam<INDVerifierTestConfig> {};
 
-TEST_P(TestINDVerifier, DefaultTest) {
-    using namespace config::names;
-
-    INDVerifierTestConfig const& config = GetParam();
-    std::unique_ptr<algos::INDVerifier> verifier = CreateINDVerfier(config);
-    verifier->Execute();
-
+static void CheckVerifierResult(INDVerifierTestConfig const& config,
+                                algos::INDVerifier const& verifier) {
     static INDVerifierErrorInfo const kINDHolds{
             .num_violating_rows = 0,
             .num_violating_clusters = 0,
             .error = config::ErrorType{0.0},
     };
 
-    EXPECT_NE(verifier->Holds(), config.error_opt.has_value());
+    EXPECT_NE(verifier.Holds(), config.error_opt.has_value());
     INDVerifierErrorInfo const& error_info =
             config.error_opt ? config.error_opt.value() : kINDHolds;
 
-    EXPECT_DOUBLE_EQ(verifier->GetError(), error_info.error);
-    EXPECT_EQ(verifier->GetViolatingClustersCount(), error_info.num_violating_clusters);
-    EXPECT_EQ(verifier->GetViolatingRowsCount(), error_info.num_violating_rows);
+    EXPECT_DOUBLE_EQ(verifier.GetError(), error_info.error);
+    EXPECT_EQ(verifier.GetViolatingClustersCount(), error_info.num_violating_clusters);
+    EXPECT_EQ(verifier.GetViolatingRowsCount(), error_info.num_violating_rows);
+
+    std::size_t rows_in_clusters = 0;
+    for (algos::INDVerifier::Cluster const& cluster : verifier.GetViolatingClusters()) {
+        rows_in_clusters += cluster.size();
+    }
+    EXPECT_EQ(rows_in_clusters, error_info.num_violating_rows);
+}
+
+TEST_P(TestINDVerifier, DefaultTest) {
+    std::unique_ptr<algos::INDVerifier> verifier = CreateINDVerfier(GetParam());
+    verifier->Execute();
+    CheckVerifierResult(GetParam(), *verifier);
+}
+
+TEST_P(TestINDVerifier, ParallelTest) {
+    INDVerifierTestConfig const& test_config = GetParam();
+    auto run = [&test_config](config::ThreadNumType threads) {
+        std::unique_ptr<algos::INDVerifier> verifier = CreateINDVerfier(test_config, threads);
+        verifier->Execute();
+        CheckVerifierResult(test_config, *verifier);
+        return verifier->GetViolatingClusters();
+    };
+    CheckSameResultForAnyThreadNumber(run);
 }
 
 // clang-format off
@@ -81,6 +107,38 @@ INSTANTIATE_TEST_SUITE_P(
             ));
 // clang-format on
 
+TEST(TestFingerprintPartitions, SpilledPartitionsKeepAllFingerprints) {
+    using algos::ind_verifier::Fingerprint, algos::ind_verifier::FingerprintPartitions;
+    TempDirectory const directory("desbordante_test_fingerprint_partitions");
+    std::filesystem::path const spill_dir = directory.GetPath() / "spill";
+    std::vector<Fingerprint> expected;
+    for (std::size_t i = 0; i != 1000; ++i) {
+        expected.push_back(Fingerprint::Of({std::to_string(i % 300), "value"}));
+    }
+
+    std::vector<Fingerprint> taken;
+    {
+        /* Buffers for 10 fingerprints */
+        FingerprintPartitions partitions{spill_dir, 10 * sizeof(Fingerprint)};
+        for (Fingerprint const& fingerprint : expected) {
+            partitions.Add(fingerprint);
+        }
+        ASSERT_TRUE(partitions.IsSpilled());
+        for (std::size_t i = 0; i != FingerprintPartitions::kPartitionsCount; ++i) {
+            for (Fingerprint const& fingerprint : partitions.TakePartition(i)) {
+                EXPECT_EQ(FingerprintPartitions::GetPartition(fingerprint), i);
+                taken.push_back(fingerprint);
+            }
+        }
+    }
+    EXPECT_FALSE(std::filesystem::exists(spill_dir));
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(taken.begin(), taken.end());
+    EXPECT_EQ(taken, expected);
+    EXPECT_EQ(std::unique(expected.begin(), expected.end()) - expected.begin(), 300);
+}
+
 class TestINDVerifierRuntimeError : public ::testing::TestWithParam<INDVerifierTestConfig> {};
 
 TEST_F(TestINDVerifierRuntimeError, TestEmptyTable) {
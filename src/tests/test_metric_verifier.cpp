@@ -1,5 +1,8 @@
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -10,6 +13,10 @@
 #include "algorithms/metric/metric_verifier.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/tabular_data/input_table_type.h"
+#include "config/thread_number/type.h"
+#include "rows_stream.h"
+#include "util/convex_hull.h"
 
 namespace tests {
 namespace onam = config::names;
@@ -63,6 +70,8 @@ class TestMetricVerifying : public ::testing::TestWithParam<MetricVerifyingParam
 
 class TestHighlights : public ::testing::TestWithParam<HighlightTestParams> {};
 
+class TestParallelMetricVerifying : public ::testing::TestWithParam<MetricVerifyingParams> {};
+
 static std::unique_ptr<algos::metric::MetricVerifier> CreateMetricVerifier(
         algos::StdParamsMap const& map) {
     auto mp = algos::StdParamsMap(map);
@@ -124,6 +133,57 @@ TEST_P(TestHighlights, DefaultTest) {  // Assumes that highlights are sorted by
     }
 }
 
+TEST_P(TestParallelMetricVerifying, SameResultForAnyThreadNumber) {
+    auto get_result = [](algos::StdParamsMap params, config::ThreadNumType threads) {
+        params[onam::kThreads] = threads;
+        auto verifier = CreateMetricVerifier(params);
+        verifier->Execute();
+        std::vector<std::vector<std::tuple<algos::metric::ClusterIndex,
+                                           algos::metric::ClusterIndex, long double>>>
+                highlights;
+        for (auto const& cluster_highlights : verifier->GetHighlights()) {
+            auto& tuples = highlights.emplace_back();
+            for (auto const& highlight : cluster_highlights) {
+                tuples.push_back(highlight.ToTuple());
+            }
+        }
+        return std::make_pair(verifier->GetResult(), std::move(highlights));
+    };
+    auto const& params = GetParam().params;
+    auto const expected = get_result(params, 1);
+    ASSERT_EQ(expected.first, GetParam().expected);
+    for (config::ThreadNumType threads : {2, 4}) {
+        ASSERT_EQ(get_result(params, threads), expected) << "threads: " << threads;
+    }
+}
+
+// Parameters equal to the largest distance as util::EuclideanDistance computes it and the nearest
+// smaller ones, so that any change in how distances are rounded changes the results.
+TEST(TestMetricVerifyingBoundaries, EuclideanDistanceEqualToParameter) {
+    config::InputTable const table = std::make_shared<RowsStream>(
+            std::vector<std::string>{"A", "X", "Y"},
+            std::vector<model::IDatasetStream::Row>{
+                    {"1", "0.1", "0.7"}, {"1", "0.5", "1.1"}, {"1", "1.3", "2.9"}});
+    long double const max_dist = util::EuclideanDistance({0.1, 0.7}, {1.3, 2.9});
+    auto holds = [&table](MetricAlgo algo, long double parameter) {
+        table->Reset();
+        auto verifier = CreateMetricVerifier({{onam::kTable, table},
+                                              {onam::kParameter, parameter},
+                                              {onam::kLhsIndices, std::vector<unsigned>{0}},
+                                              {onam::kRhsIndices, std::vector<unsigned>{1, 2}},
+                                              {onam::kEqualNulls, true},
+                                              {onam::kMetric, Metric(Metric::euclidean)},
+                                              {onam::kMetricAlgorithm, algo},
+                                              {onam::kDistFromNullIsInfinity, false}});
+        return GetResult(*verifier);
+    };
+    EXPECT_TRUE(holds(MetricAlgo::brute, max_dist));
+    EXPECT_FALSE(holds(MetricAlgo::brute, std::nextafter(max_dist, 0.0L)));
+    // Approx measures the distances from the first point, the last one is the furthest from it
+    EXPECT_TRUE(holds(MetricAlgo::approx, max_dist * 2));
+    EXPECT_FALSE(holds(MetricAlgo::approx, std::nextafter(max_dist * 2, 0.0L)));
+}
+
 INSTANTIATE_TEST_SUITE_P(
         MetricVerifierTestSuite, TestMetricVerifying,
         ::testing::Values(
@@ -166,6 +226,21 @@ INSTANTIATE_TEST_SUITE_P(
                 MetricVerifyingParams(kTestMetric, Metric::euclidean, 6.0091679956547, {0},
                                       {13, 14, 15})));
 
+INSTANTIATE_TEST_SUITE_P(
+        ParallelMetricVerifierTestSuite, TestParallelMetricVerifying,
+        ::testing::Values(
+                MetricVerifyingParams(kLineItem, Metric::euclidean, 49, {3}, {4}),
+                MetricVerifyingParams(kLineItem, Metric::euclidean, 10, {3}, {4},
+                                      MetricAlgo::brute, false, false),
+                MetricVerifyingParams(kLineItem, Metric::euclidean, 100, {3}, {5, 6},
+                                      MetricAlgo::brute, false, false),
+                MetricVerifyingParams(kLineItem, Metric::euclidean, 100, {3}, {5, 6},
+                                      MetricAlgo::calipers, false, false),
+                MetricVerifyingParams(kLineItem, Metric::euclidean, 10, {3}, {4, 7},
+                                      MetricAlgo::approx, false, false),
+                MetricVerifyingParams(kLineItem, Metric::levenshtein, 10, {3}, {15},
+                                      MetricAlgo::brute, false, false)));
+
 constexpr long double kInf = std::numeric_limits<long double>::infinity();
 
 INSTANTIATE_TEST_SUITE_P(
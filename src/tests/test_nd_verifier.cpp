@@ -1,3 +1,8 @@
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
@@ -5,6 +10,9 @@
 #include "algorithms/nd/nd_verifier/nd_verifier.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
+#include "rows_stream.h"
+#include "test_threads_util.h"
 
 namespace tests {
 namespace onam = config::names;
@@ -32,6 +40,55 @@ TEST_P(TestNDVerifying, DefaultTest) {
     EXPECT_TRUE(verifier->NDHolds());
 }
 
+TEST_P(TestNDVerifying, ParallelTest) {
+    auto run = [this](config::ThreadNumType threads) {
+        auto mp = algos::StdParamsMap(GetParam().params);
+        mp.emplace(onam::kThreads, threads);
+        auto verifier = algos::CreateAndLoadAlgorithm<algos::nd_verifier::NDVerifier>(mp);
+        verifier->Execute();
+        std::vector<std::string> highlights;
+        for (auto const& highlight : verifier->GetHighlights()) {
+            highlights.push_back(highlight.ToValuesString());
+        }
+        return std::make_tuple(verifier->NDHolds(), verifier->GetRealWeight(),
+                               verifier->GetGlobalMinWeight(), verifier->GetLhsFrequencies(),
+                               verifier->GetRhsFrequencies(), std::move(highlights));
+    };
+    EXPECT_TRUE(std::get<0>(CheckSameResultForAnyThreadNumber(run)));
+}
+
+namespace {
+std::unique_ptr<algos::nd_verifier::NDVerifier> CreateNDVerifier(
+        std::vector<model::IDatasetStream::Row> rows, config::ThreadNumType threads = 1) {
+    config::InputTable table =
+            std::make_shared<RowsStream>(std::vector<std::string>{"A", "B"}, std::move(rows));
+    return algos::CreateAndLoadAlgorithm<algos::nd_verifier::NDVerifier>(
+            {{onam::kTable, std::move(table)},
+             {onam::kLhsIndices, config::IndicesType{0}},
+             {onam::kRhsIndices, config::IndicesType{1}},
+             {onam::kWeight, model::WeightType{1}},
+             {onam::kThreads, threads}});
+}
+}  // namespace
+
+TEST(TestNDVerifierTables, ZeroRows) {
+    for (config::ThreadNumType threads : {1, 4}) {
+        auto verifier = CreateNDVerifier({}, threads);
+        verifier->Execute();
+        EXPECT_TRUE(verifier->NDHolds()) << "threads: " << threads;
+        EXPECT_EQ(verifier->GetRealWeight(), 0) << "threads: " << threads;
+        EXPECT_TRUE(verifier->GetHighlights().empty()) << "threads: " << threads;
+    }
+}
+
+// Doubles are told apart exactly, not within the epsilon of DoubleType::Compare
+TEST(TestNDVerifierTables, DoublesAreComparedExactly) {
+    auto verifier =
+            CreateNDVerifier({{"1.0", "a"}, {"1.0000000000000002", "b"}, {"1.0", "a"}});
+    verifier->Execute();
+    EXPECT_EQ(verifier->GetRealWeight(), 1);
+}
+
 // clang-format off
 INSTANTIATE_TEST_SUITE_P(
         NDVerifierTestSuite, TestNDVerifying,
@@ -9,7 +9,9 @@
 #include "algorithms/od/order/order.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "csv_config_util.h"
+#include "test_threads_util.h"
 
 namespace tests {
 
@@ -21,13 +23,18 @@ public:
         using namespace config::names;
         return algos::CreateAndLoadAlgorithm<algos::order::Order>({{kCsvConfig, info}});
     }
+
+    static std::unique_ptr<algos::order::Order> CreateOrderInstance(
+            CSVConfig const& info, config::ThreadNumType threads) {
+        using namespace config::names;
+        return algos::CreateAndLoadAlgorithm<algos::order::Order>(
+                {{kCsvConfig, info}, {kThreads, threads}});
+    }
 };
 
-TEST_F(OrderTest, SmallDataset) {
-    auto a = CreateOrderInstance(kODnorm6);
-    a->Execute();
-    OD actual = a->GetValidODs();
+namespace {
 
+OD GetODnorm6ODs() {
     OD expected;
     expected[{0}] = {{1}, {3}, {4}};
     expected[{1}] = {{4}, {0, 2}, {0, 5}, {3, 2}, {3, 5}};
@@ -50,8 +57,17 @@ TEST_F(OrderTest, SmallDataset) {
     expected[{1, 2, 3}] = {{4}, {0, 5}};
     expected[{0, 2, 3}] = {{4}, {1, 5}};
     expected[{2, 1, 3}] = {{5}};
+    return expected;
+}
 
-    EXPECT_EQ(expected, actual);
+}  // namespace
+
+TEST_F(OrderTest, SmallDataset) {
+    auto a = CreateOrderInstance(kODnorm6);
+    a->Execute();
+    OD actual = a->GetValidODs();
+
+    EXPECT_EQ(GetODnorm6ODs(), actual);
 }
 
 TEST_F(OrderTest, BigWithDifferentTypes) {
@@ -76,4 +92,18 @@ TEST_F(OrderTest, OrderTest_Epic_Test) {
     EXPECT_EQ(expected, actual);
 }
 
+TEST_F(OrderTest, SameResultForAnyThreadNumber) {
+    auto run_on = [](CSVConfig const& info) {
+        return [&info](config::ThreadNumType threads) {
+            auto algorithm = CreateOrderInstance(info, threads);
+            algorithm->Execute();
+            return algorithm->GetValidODs();
+        };
+    };
+    EXPECT_EQ(CheckSameResultForAnyThreadNumber(run_on(kODnorm6)), GetODnorm6ODs());
+    for (CSVConfig const& info : {kWdcAstronomical, kCIPublicHighway700}) {
+        CheckSameResultForAnyThreadNumber(run_on(info));
+    }
+}
+
 }  // namespace tests
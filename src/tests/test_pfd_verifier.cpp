@@ -72,4 +72,20 @@ INSTANTIATE_TEST_SUITE_P(
                           PFDVerifyingParams({5}, {1}, +algos::PfdErrorMeasure::per_tuple, 0.0, 0,
                                              0, {}, kTestFD)));
 
+TEST(PFDVerifierBatchTest, VerifyPFDs) {
+    auto verifier = algos::CreateAndLoadAlgorithm<algos::PFDVerifier>(
+            PFDVerifyingParams({2}, {3}, +algos::PfdErrorMeasure::per_value, 0, 0, 0, {}, kTestFD)
+                    .params);
+    std::vector<algos::PFDStats> stats =
+            verifier->VerifyPFDs({{{4}, {5}}, {{0, 1}, {4}}, {{2}, {3}}, {{5}, {1}}, {{1, 0}, {4}}},
+                                 +algos::PfdErrorMeasure::per_tuple, 2);
+    ASSERT_EQ(stats.size(), 5u);
+    std::vector<std::pair<std::size_t, config::ErrorType>> const expected = {
+            {4, 0.3334}, {2, 0.1667}, {1, 0.0834}, {0, 0.0}, {2, 0.1667}};
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        EXPECT_EQ(stats[i].num_violating_clusters, expected[i].first);
+        EXPECT_NEAR(stats[i].error, expected[i].second, 0.0001);
+    }
+}
+
 }  // namespace tests
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -11,8 +14,10 @@
 #include "config/equal_nulls/option.h"
 #include "config/max_lhs/type.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "csv_config_util.h"
 #include "model/table/column_layout_typed_relation_data.h"
+#include "test_threads_util.h"
 
 namespace {
 void AssertVectors(std::vector<Column> const& expected,
@@ -104,6 +109,41 @@ TEST(TestCordsUtils, FrequenciesOfIris) {
     }
 }
 
+TEST(TestCordsUtils, SketchFrequencies) {
+    auto table = MakeInputTable(kLineItem);
+    std::unique_ptr<model::ColumnLayoutTypedRelationData> typed_relation =
+            model::ColumnLayoutTypedRelationData::CreateFrom(*table, false);
+    std::vector<model::TypedColumnData> const& data = typed_relation->GetColumnData();
+
+    algos::FrequencyHandler exact;
+    exact.InitFrequencyHandler(data, data.size(), 10);
+    algos::FrequencyHandler sketch;
+    sketch.InitFrequencyHandler(data, data.size(), 10, true);
+
+    for (model::ColumnIndex i = 0; i < data.size(); i++) {
+        EXPECT_NEAR(sketch.GetColumnCardinality(i), exact.GetColumnCardinality(i),
+                    0.02 * exact.GetColumnCardinality(i));
+        ASSERT_EQ(sketch.ColumnFrequencyMapSize(i), exact.ColumnFrequencyMapSize(i));
+
+        std::unordered_map<std::string, size_t> frequencies;
+        for (model::TupleIndex row = 0; row < data[i].GetNumRows(); row++) {
+            frequencies[data[i].GetDataAsString(row)]++;
+        }
+        auto most_frequent = std::max_element(
+                frequencies.begin(), frequencies.end(),
+                [](auto const& left, auto const& right) { return left.second < right.second; });
+        size_t const max_frequency = most_frequent->second;
+        // Estimates are exact unless values collide in every row of the sketch, so a value that
+        // is more frequent than any other must be found
+        if (std::ranges::count_if(frequencies, [max_frequency](auto const& value_frequency) {
+                return value_frequency.second == max_frequency;
+            }) == 1) {
+            EXPECT_TRUE(sketch.ContainsValAtColumn(most_frequent->first, i));
+            EXPECT_EQ(sketch.GetValueOrdinalNumberAtColumn(most_frequent->first, i), 0);
+        }
+    }
+}
+
 TEST(TestCordsUtils, SampleSize) {
     ASSERT_EQ(algos::Sample::CalculateSampleSize(465, 4, 1e-06, 0.05), 4215);
     ASSERT_EQ(algos::Sample::CalculateSampleSize(472, 7, 1e-06, 0.05), 3005);
@@ -128,6 +168,8 @@ public:
         long double delta;
         size_t max_amount_of_categories;
         config::MaxLhsType max_lhs;
+        bool frequency_sketch = false;
+        config::ThreadNumType threads = 1;
     };
 
     static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config, Config const& test_config) {
@@ -147,7 +189,9 @@ public:
                 {kDelta, test_config.delta},
                 {kMaxAmountOfCategories, test_config.max_amount_of_categories},
                 {kMaximumLhs, test_config.max_lhs},
-                {kFixedSample, test_config.fixed_sample}};
+                {kFixedSample, test_config.fixed_sample},
+                {kFrequencySketch, test_config.frequency_sketch},
+                {kThreads, test_config.threads}};
     }
 
     static std::unique_ptr<algos::Cords> CreateCordsInstance(CSVConfig const& csv_config,
@@ -218,4 +262,40 @@ TEST_F(CordsAlgorithmTest, CIPublicHighway10k) {
                                            {13, 12}});
 }
 
+TEST_F(CordsAlgorithmTest, SameResultForAnyThreadNumber) {
+    using ColumnPairs = std::vector<std::pair<model::ColumnIndex, model::ColumnIndex>>;
+    // Soft keys, soft FDs and correlations
+    using CordsResult = std::tuple<std::vector<model::ColumnIndex>, ColumnPairs, ColumnPairs>;
+    auto run_on = [](CSVConfig const& csv_config) {
+        return [&csv_config](config::ThreadNumType threads) {
+            TestConfig test_config = kTestConfigDefault;
+            test_config.threads = threads;
+            auto algorithm = CreateCordsInstance(csv_config, test_config);
+            algorithm->Execute();
+            CordsResult result;
+            for (Column const& column : algorithm->GetSoftKeys()) {
+                std::get<0>(result).push_back(column.GetIndex());
+            }
+            for (FD const& fd : algorithm->FdList()) {
+                std::get<1>(result).emplace_back(fd.GetLhsIndices()[0], fd.GetRhsIndex());
+            }
+            for (algos::Correlation const& correlation : algorithm->GetCorrelations()) {
+                std::get<2>(result).emplace_back(correlation.GetLhsIndex(),
+                                                 correlation.GetRhsIndex());
+            }
+            return result;
+        };
+    };
+
+    // Known from the LineItem test
+    CordsResult const line_item = CheckSameResultForAnyThreadNumber(run_on(kLineItem));
+    EXPECT_EQ(std::get<0>(line_item), (std::vector<model::ColumnIndex>{1, 2, 5, 15}));
+    EXPECT_EQ(std::get<1>(line_item),
+              (ColumnPairs{{0, 8},   {0, 9},   {10, 3},  {11, 3},  {12, 3},  {10, 6},
+                           {11, 6},  {12, 6},  {10, 7},  {11, 7},  {12, 7},  {8, 9},
+                           {10, 8},  {11, 8},  {12, 8},  {10, 9},  {11, 9},  {12, 9},
+                           {10, 13}, {10, 14}, {11, 13}, {11, 14}, {12, 13}, {12, 14}}));
+    CheckSameResultForAnyThreadNumber(run_on(kCIPublicHighway700));
+}
+
 }  // namespace tests
@@ -2,13 +2,18 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
 #include "all_csv_configs.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
 #include "csv_config_util.h"
+#include "rows_stream.h"
+#include "test_threads_util.h"
 
 namespace tests {
 
@@ -45,6 +50,16 @@ public:
         return algos::CreateAndLoadAlgorithm<algos::dd::Split>(
                 GetParamMap(csv_config, dif_table_csv_config));
     }
+
+    static std::list<model::DDString> RunSplit(CSVConfig const& csv_config,
+                                               std::optional<CSVConfig> const& dif_table_csv_config,
+                                               config::ThreadNumType threads) {
+        algos::StdParamsMap params = GetParamMap(csv_config, dif_table_csv_config);
+        params.emplace(config::names::kThreads, threads);
+        auto algo = algos::CreateAndLoadAlgorithm<algos::dd::Split>(std::move(params));
+        algo->Execute();
+        return algo->GetDDStringList();
+    }
 };
 
 TEST_F(SplitAlgorithmTest, Test0) {
@@ -140,4 +155,55 @@ TEST_F(SplitAlgorithmTest, Test4) {
     CompareDDStringLists(expected_results, actual_results);
 }
 
+TEST_F(SplitAlgorithmTest, ParallelTest) {
+    std::vector<std::pair<CSVConfig, std::optional<CSVConfig>>> const configs = {
+            {kTestDD, kTestDif}, {kTestDD1, std::nullopt}, {kTestDD2, kTestDif2}};
+    for (auto const& [csv_config, dif_table_csv_config] : configs) {
+        SCOPED_TRACE(csv_config.path.filename().string());
+        auto run = [&](config::ThreadNumType threads) {
+            std::vector<std::string> dds;
+            for (model::DDString const& dd : RunSplit(csv_config, dif_table_csv_config, threads)) {
+                dds.push_back(dd.ToString());
+            }
+            return dds;
+        };
+        CheckSameResultForAnyThreadNumber(run);
+    }
+}
+
+TEST_F(SplitAlgorithmTest, ParallelTestKnownResult) {
+    std::set<std::pair<std::set<model::DFStringConstraint>, std::set<model::DFStringConstraint>>>
+            expected_results = {{{{"Col4", 2, 4}}, {{"Col0", 3, 4}}},
+                                {{{"Col1", 2, 5}}, {{"Col0", 1, 1}}}};
+    CompareDDStringLists(expected_results, RunSplit(kTestDD, kTestDif, 4));
+
+    expected_results = {{{{"Col1", 2, 3}}, {{"Col0", 1, 1}}},
+                        {{{"Col0", 1, 1}}, {{"Col1", 2, 2}}}};
+    CompareDDStringLists(expected_results, RunSplit(kTestDD1, std::nullopt, 4));
+}
+
+TEST_F(SplitAlgorithmTest, ManyPairsKnownResult) {
+    // 200 rows make 19900 pairs, their bitmaps take 311 words, more than one block of words.
+    // Rows with equal A also have equal B, except for the last two rows: their pair is the last
+    // one, and it is the only one that violates A [0, 0] -> B [0, 0].
+    std::vector<model::IDatasetStream::Row> rows;
+    for (int i = 0; i < 198; i++) {
+        rows.push_back({std::to_string(i % 10 * 10), std::to_string(i % 10 * 10)});
+    }
+    rows.push_back({"1000", "2000"});
+    rows.push_back({"1000", "2005"});
+
+    std::set<std::pair<std::set<model::DFStringConstraint>, std::set<model::DFStringConstraint>>>
+            expected_results = {{{{"B", 0, 4}}, {{"A", 0, 0}}}};
+    for (config::ThreadNumType threads : {1, 4}) {
+        SCOPED_TRACE(threads);
+        config::InputTable table =
+                std::make_shared<RowsStream>(std::vector<std::string>{"A", "B"}, rows);
+        auto algo = algos::CreateAndLoadAlgorithm<algos::dd::Split>(
+                {{config::names::kTable, std::move(table)}, {config::names::kThreads, threads}});
+        algo->Execute();
+        CompareDDStringLists(expected_results, algo->GetDDStringList());
+    }
+}
+
 }  // namespace tests
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+
+#include "config/thread_number/type.h"
+
+namespace tests {
+
+/* Calls run(threads) with one thread and then with each of parallel_threads, expecting every
+ * parallel run to give the result of the sequential one. run must return a value comparable with
+ * ==, e.g. a list of dependencies or a hash of it. The sequential result is returned, so that it
+ * can also be checked against the known answer.
+ */
+template <typename Run>
+auto CheckSameResultForAnyThreadNumber(
+        Run run, std::initializer_list<config::ThreadNumType> parallel_threads = {2, 4}) {
+    auto const sequential = run(config::ThreadNumType{1});
+    for (config::ThreadNumType threads : parallel_threads) {
+        EXPECT_EQ(run(threads), sequential) << "threads: " << threads;
+    }
+    return sequential;
+}
+
+}  // namespace tests
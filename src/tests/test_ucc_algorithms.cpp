@@ -1,6 +1,8 @@
 #include <memory>
 #include <ostream>
+#include <set>
 #include <string>
+#include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 #include <gmock/gmock.h>
@@ -14,6 +16,7 @@
 #include "config/names.h"
 #include "config/thread_number/type.h"
 #include "csv_config_util.h"
+#include "rows_stream.h"
 #include "test_hash_util.h"
 
 std::ostream& operator<<(std::ostream& os, Vertical const& v) {
@@ -119,8 +122,65 @@ public:
 template <typename AlgorithmUnderTest>
 config::ThreadNumType UCCAlgorithmTest<AlgorithmUnderTest>::threads_ = 1;
 
+std::set<std::vector<unsigned>> ToUCCSet(std::list<model::UCC> const& uccs) {
+    std::set<std::vector<unsigned>> set;
+    for (model::UCC const& ucc : uccs) {
+        set.insert(ucc.GetColumnIndicesAsVector());
+    }
+    return set;
+}
+
+/* Appends the second half of the dataset to the first one in several batches and compares the
+ * UCCs after every batch with the UCCs mined from scratch */
+void TestAppendMatchesRerun(CSVConfig const& csv_config, bool is_null_equal_null,
+                            config::ThreadNumType threads) {
+    using namespace config::names;
+    config::InputTable stream = MakeInputTable(csv_config);
+    std::vector<std::string> const column_names = GetColumnNames(*stream);
+    std::vector<model::IDatasetStream::Row> const rows = ReadRows(*stream);
+    auto make_stream = [&](std::size_t rows_count) {
+        return std::make_shared<RowsStream>(
+                column_names, std::vector(rows.begin(), rows.begin() + rows_count));
+    };
+    std::size_t constexpr kBatches = 3;
+    std::size_t rows_count = rows.size() / 2;
+    std::size_t const batch_size = (rows.size() - rows_count) / kBatches + 1;
+
+    auto hyucc = algos::CreateAndLoadAlgorithm<algos::HyUCC>(
+            {{kTable, config::InputTable{make_stream(rows_count)}},
+             {kEqualNulls, is_null_equal_null},
+             {kThreads, threads}});
+    hyucc->Execute();
+    for (std::size_t batch = 0; batch != kBatches; ++batch) {
+        std::size_t const next_rows_count = std::min(rows.size(), rows_count + batch_size);
+        algos::ConfigureFromMap(
+                *hyucc, {{kInsertStatements,
+                          config::InputTable{std::make_shared<RowsStream>(
+                                  column_names, std::vector(rows.begin() + rows_count,
+                                                            rows.begin() + next_rows_count))}},
+                         {kThreads, threads}});
+        hyucc->Execute();
+        rows_count = next_rows_count;
+
+        auto rerun = algos::CreateAndLoadAlgorithm<algos::HyUCC>(
+                {{kTable, config::InputTable{make_stream(rows_count)}},
+                 {kEqualNulls, is_null_equal_null}});
+        rerun->Execute();
+        ASSERT_EQ(ToUCCSet(hyucc->UCCList()), ToUCCSet(rerun->UCCList()))
+                << csv_config.path.filename() << ", batch " << batch;
+    }
+}
+
 }  // namespace
 
+TEST(HyUCCAppendTest, MatchesRerun) {
+    for (CSVConfig const& csv_config :
+         {kTestFD, kWdcSatellites, kWdcAstronomical, kWdcKepler, kCIPublicHighway700, kNullEmpty}) {
+        TestAppendMatchesRerun(csv_config, true, 1);
+        TestAppendMatchesRerun(csv_config, false, 4);
+    }
+}
+
 TYPED_TEST_SUITE_P(UCCAlgorithmTest);
 
 TYPED_TEST_P(UCCAlgorithmTest, ConsistentHashOnLightDatasets) {
@@ -1,3 +1,6 @@
+#include <numeric>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "algorithms/algo_factory.h"
@@ -5,6 +8,8 @@
 #include "all_csv_configs.h"
 #include "config/indices/type.h"
 #include "config/names.h"
+#include "config/thread_number/type.h"
+#include "csv_config_util.h"
 
 namespace tests {
 namespace onam = config::names;
@@ -14,6 +19,8 @@ namespace {
 class UCCVerifierSimpleParams {
 private:
     algos::StdParamsMap params_map_;
+    CSVConfig csv_config_;
+    config::IndicesType column_indices_;
     size_t num_clusters_violating_ucc_ = 0;
     size_t num_rows_violating_ucc_ = 0;
     double expected_error_ = 0.0;
@@ -25,6 +32,8 @@ public:
                             size_t const num_rows_violating_ucc, double const expected_error,
                             std::vector<model::PLI::Cluster> clusters_violating_ucc)
         : params_map_({{onam::kCsvConfig, csv_config}, {onam::kEqualNulls, true}}),
+          csv_config_(csv_config),
+          column_indices_(column_indices),
           num_clusters_violating_ucc_(num_clusters_violating_ucc),
           num_rows_violating_ucc_(num_rows_violating_ucc),
           expected_error_(expected_error),
@@ -41,6 +50,14 @@ public:
         return params_map_;
     }
 
+    CSVConfig const& GetCSVConfig() const {
+        return csv_config_;
+    }
+
+    config::IndicesType const& GetColumnIndices() const {
+        return column_indices_;
+    }
+
     size_t GetExpectedNumClustersViolatingUCC() const {
         return num_clusters_violating_ucc_;
     }
@@ -74,6 +91,19 @@ TEST_P(TestUCCVerifierSimple, DefaultTest) {
     EXPECT_DOUBLE_EQ(verifier->GetError(), p.GetExpectedError());
 }
 
+TEST_P(TestUCCVerifierSimple, IsUniqueTest) {
+    UCCVerifierSimpleParams const& p(GetParam());
+    auto verifier = algos::CreateAndLoadAlgorithm<algos::UCCVerifier>(p.GetParamsMap());
+    config::IndicesType indices = p.GetColumnIndices();
+    if (indices.empty()) {
+        indices.resize(MakeInputTable(p.GetCSVConfig())->GetNumberOfColumns());
+        std::iota(indices.begin(), indices.end(), 0);
+    }
+    bool const expected = p.GetExpectedNumClustersViolatingUCC() == 0;
+    EXPECT_EQ(verifier->IsUnique(indices), expected);
+    EXPECT_EQ(verifier->IsUnique(indices, 4), expected);
+}
+
 INSTANTIATE_TEST_SUITE_P(
         UCCVerifierSimpleTestSuite, TestUCCVerifierSimple,
         ::testing::Values(
@@ -156,6 +186,42 @@ TEST_P(TestUCCVerifierWithHyUCC, TestWithHyUCC) {
     }
 }
 
+TEST_P(TestUCCVerifierWithHyUCC, BatchAndFastPathTest) {
+    UCCVerifierWithHyUCCParams const& p(GetParam());
+
+    algos::StdParamsMap hyucc_params_map = p.GetHyUCCParamsMap();
+    auto hyucc = algos::CreateAndLoadAlgorithm<algos::HyUCC>(std::move(hyucc_params_map));
+    hyucc->Execute();
+
+    // Minimal UCCs and the same UCCs without their last column, which are not UCCs
+    std::vector<config::IndicesType> candidates;
+    for (auto const& ucc : hyucc->UCCList()) {
+        candidates.push_back(ucc.GetColumnIndicesAsVector());
+        if (candidates.back().size() > 1) {
+            candidates.push_back(candidates.back());
+            candidates.back().pop_back();
+        }
+    }
+
+    auto batch_verifier =
+            algos::CreateAndLoadAlgorithm<algos::UCCVerifier>(p.GetUCCVerifierParamsMap());
+    for (config::ThreadNumType threads : {1, 3}) {
+        std::vector<algos::UCCStats> stats = batch_verifier->VerifyUCCs(candidates, threads);
+        ASSERT_EQ(stats.size(), candidates.size());
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            auto verifier = CreateAndExecuteUCCVerifier(
+                    p.GetUCCVerifierParamsMap(),
+                    std::vector<unsigned int>(candidates[i].begin(), candidates[i].end()));
+            EXPECT_EQ(stats[i].holds, verifier->UCCHolds());
+            EXPECT_EQ(stats[i].num_clusters_violating_ucc,
+                      verifier->GetNumClustersViolatingUCC());
+            EXPECT_EQ(stats[i].num_rows_violating_ucc, verifier->GetNumRowsViolatingUCC());
+            EXPECT_DOUBLE_EQ(stats[i].error, verifier->GetError());
+            EXPECT_EQ(batch_verifier->IsUnique(candidates[i], threads), stats[i].holds);
+        }
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(UCCVerifierWithHyUCCTestSuite, TestUCCVerifierWithHyUCC,
                          ::testing::Values(UCCVerifierWithHyUCCParams(kAbalone),
                                            UCCVerifierWithHyUCCParams(kBreastCancer),
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <set>
 #include <thread>
 
 #include <gmock/gmock.h>
@@ -180,6 +181,40 @@ TEST(AgreeSetFactoryTest, UsingMCAndGetAgreeSet) {
     TestAgreeSetFactory(c);
 }
 
+TEST(AgreeSetFactoryTest, UsingCompressedRows) {
+    AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingCompressedRows);
+    TestAgreeSetFactory(c);
+}
+
+TEST(AgreeSetFactoryTest, UsingCompressedRowsParallel) {
+    AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingCompressedRows,
+                                     MCGenMethod::kUsingCalculateSupersets, 4);
+    TestAgreeSetFactory(c);
+}
+
+TEST(AgreeSetFactoryTest, CompressedRowsMatchMCAndGetAgreeSet) {
+    auto gen_agree_sets = [](ColumnLayoutRelationData const& relation,
+                             AgreeSetFactory::Configuration const& c) {
+        std::set<std::string> agree_sets;
+        for (model::AgreeSet const& agree_set : AgreeSetFactory(&relation, c).GenAgreeSets()) {
+            agree_sets.insert(agree_set.ToString());
+        }
+        return agree_sets;
+    };
+    for (CSVConfig const& csv_config : {kCIPublicHighway700, kLineItem}) {
+        auto input_table = MakeInputTable(csv_config);
+        auto relation = ColumnLayoutRelationData::CreateFrom(*input_table, true);
+        auto const expected =
+                gen_agree_sets(*relation, AgreeSetFactory::Configuration(
+                                                  AgreeSetsGenMethod::kUsingMCAndGetAgreeSet));
+        for (unsigned short threads : {1, 4}) {
+            AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingCompressedRows,
+                                             MCGenMethod::kUsingCalculateSupersets, threads);
+            ASSERT_THAT(gen_agree_sets(*relation, c), ContainerEq(expected));
+        }
+    }
+}
+
 TEST(AgreeSetFactoryTest, UsingHandleEqvClass) {
     AgreeSetFactory::Configuration c(MCGenMethod::kUsingHandleEqvClass);
     TestAgreeSetFactory(c);